@@ -72,6 +72,21 @@ namespace sm {
       /** @}
         */
 
+    protected:
+      /** \name Batch conversions
+        @{
+        */
+      /// Returns the rotation matrices of a block of parameters
+      void parametersToRotationMatricesBlock(const Eigen::Ref<const
+        Eigen::Matrix3Xd>& parameters, Eigen::Ref<RotationMatrices> out_C)
+        const override;
+      /// Returns the parameters of a block of rotation matrices
+      void rotationMatricesToParametersBlock(const Eigen::Ref<const
+        RotationMatrices>& C, Eigen::Ref<Eigen::Matrix3Xd> out_parameters)
+        const override;
+      /** @}
+        */
+
     };
 
   }
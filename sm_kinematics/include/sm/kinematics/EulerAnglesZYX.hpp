@@ -15,6 +15,10 @@ namespace sm { namespace kinematics {
       Eigen::Matrix3d parametersToSMatrix(const Eigen::Vector3d & parameters) const override;
       Eigen::Vector3d angularVelocityAndJacobian(const Eigen::Vector3d & p, const Eigen::Vector3d & pdot, Eigen::Matrix<double,3,6> * Jacobian) const override;
     
+    protected:
+      void parametersToRotationMatricesBlock(const Eigen::Ref<const Eigen::Matrix3Xd> & parameters, Eigen::Ref<RotationMatrices> out_C) const override;
+      void rotationMatricesToParametersBlock(const Eigen::Ref<const RotationMatrices> & C, Eigen::Ref<Eigen::Matrix3Xd> out_parameters) const override;
+
     private:
       // A helper function
       Eigen::Matrix3d buildSMatrix(double sz, double cz, double sy, double cy) const;
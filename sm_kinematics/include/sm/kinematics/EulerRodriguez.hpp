@@ -14,6 +14,10 @@ namespace sm { namespace kinematics {
       Eigen::Vector3d rotationMatrixToParameters(const Eigen::Matrix3d & rotationMatrix) const override;
       Eigen::Matrix3d parametersToSMatrix(const Eigen::Vector3d & parameters) const override;
       Eigen::Vector3d angularVelocityAndJacobian(const Eigen::Vector3d & p, const Eigen::Vector3d & pdot, Eigen::Matrix<double,3,6> * Jacobian) const override;    
+
+    protected:
+      void parametersToRotationMatricesBlock(const Eigen::Ref<const Eigen::Matrix3Xd> & parameters, Eigen::Ref<RotationMatrices> out_C) const override;
+      void rotationMatricesToParametersBlock(const Eigen::Ref<const RotationMatrices> & C, Eigen::Ref<Eigen::Matrix3Xd> out_parameters) const override;
     };
 
 
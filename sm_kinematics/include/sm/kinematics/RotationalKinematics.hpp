@@ -20,6 +20,38 @@ namespace sm { namespace kinematics {
       virtual Eigen::Vector3d rotationMatrixToParameters(const Eigen::Matrix3d & rotationMatrix) const = 0;
       virtual Eigen::Matrix3d parametersToSMatrix(const Eigen::Vector3d & parameters) const = 0;
       virtual Eigen::Vector3d angularVelocityAndJacobian(const Eigen::Vector3d & /* p */, const Eigen::Vector3d & /* pdot */, Eigen::Matrix<double,3,6> * /* Jacobian */) const {SM_THROW(Exception,"Not implemented"); return Eigen::Vector3d::Zero();}
+
+      /// One column-major rotation matrix per column.
+      typedef Eigen::Matrix<double,9,Eigen::Dynamic> RotationMatrices;
+
+      /// \brief the rotation matrices of many parameter sets.
+      ///
+      /// parameters holds one parameter set per column. Column i of out_C
+      /// is the rotation matrix of column i, stored column-major, so that
+      /// Eigen::Map<Eigen::Matrix3d>(out_C.col(i).data()) is the matrix.
+      /// With numThreads > 1 the columns are split over that many threads,
+      /// which only pays off for large batches.
+      void parametersToRotationMatrices(const Eigen::Ref<const Eigen::Matrix3Xd> & parameters, Eigen::Ref<RotationMatrices> out_C, int numThreads = 1) const;
+
+      /// \brief the parameters of many rotation matrices, stored as in parametersToRotationMatrices().
+      void rotationMatricesToParameters(const Eigen::Ref<const RotationMatrices> & C, Eigen::Ref<Eigen::Matrix3Xd> out_parameters, int numThreads = 1) const;
+
+    protected:
+      /// The batch conversions hand the columns to the block functions
+      /// below in blocks of at most this many columns.
+      enum { BlockSize = 256 };
+
+      /// A row of a block, on the stack.
+      typedef Eigen::Array<double,1,Eigen::Dynamic,Eigen::RowMajor,1,BlockSize> BlockArray;
+
+      /// \brief convert one block of columns. The default calls
+      ///        parametersToRotationMatrix() for every column, the
+      ///        parameterizations override it with array code.
+      virtual void parametersToRotationMatricesBlock(const Eigen::Ref<const Eigen::Matrix3Xd> & parameters, Eigen::Ref<RotationMatrices> out_C) const;
+
+      /// \brief convert one block of columns. The default calls
+      ///        rotationMatrixToParameters() for every column.
+      virtual void rotationMatricesToParametersBlock(const Eigen::Ref<const RotationMatrices> & C, Eigen::Ref<Eigen::Matrix3Xd> out_parameters) const;
     };
 
 
@@ -0,0 +1,121 @@
+#ifndef SM_TRAJECTORY_INTERPOLATOR_HPP
+#define SM_TRAJECTORY_INTERPOLATOR_HPP
+
+#include <sm/kinematics/Transformation.hpp>
+#include <sm/kinematics/TransformationT.hpp>
+#include <sm/timing/NsecTimeUtilities.hpp>
+#include <atomic>
+#include <vector>
+
+namespace sm {
+  namespace kinematics {
+
+    ///
+    /// @class TrajectoryInterpolator
+    /// @brief interpolates a trajectory of timestamped poses T_a_b(t).
+    ///
+    /// The poses are stored contiguously, sorted by strictly increasing
+    /// time. A query first looks at the segment of the previous query and
+    /// walks forward from there, so a batch of sorted query times costs
+    /// amortised O(1) per query. Other queries fall back to a binary search.
+    /// Queries outside [minTime(), maxTime()] throw std::runtime_error.
+    ///
+    /// The interpolation schemes are:
+    ///   - Slerp:  qslerp() of the rotation and linear interpolation of the
+    ///             translation, as slerpTransformations().
+    ///   - Linear: normalized linear interpolation of the quaternion, which is
+    ///             cheaper than slerp and close to it for nearby poses.
+    ///   - Cubic:  cubic Hermite interpolation of the translation and of the
+    ///             rotation vector relative to the segment start, with the
+    ///             velocities at the poses taken from their neighbours. The
+    ///             angular velocity at the segment end is mapped to the rate
+    ///             of the rotation vector through the inverse of its left
+    ///             Jacobian, logDiffMat(). This passes through the poses and
+    ///             the angular velocity is continuous across them.
+    ///
+    /// Concurrent queries on a const TrajectoryInterpolator are safe.
+    ///
+    class TrajectoryInterpolator
+    {
+    public:
+      enum Method { Slerp, Linear, Cubic };
+
+      TrajectoryInterpolator(Method method = Slerp);
+
+      TrajectoryInterpolator(const TrajectoryInterpolator & rhs);
+
+      TrajectoryInterpolator & operator=(const TrajectoryInterpolator & rhs);
+
+      Method method() const;
+      void setMethod(Method method);
+
+      /// \brief append a pose, later than all poses so far.
+      void addPose(sm::timing::NsecTime time, const Transformation & T_a_b);
+
+      /// \brief replace the trajectory, the times must be strictly increasing.
+      void setPoses(const std::vector<sm::timing::NsecTime> & times, const std::vector<Transformation> & poses);
+
+      void clear();
+
+      size_t size() const;
+
+      sm::timing::NsecTime minTime() const;
+      sm::timing::NsecTime maxTime() const;
+
+      /// @return the stored times and poses.
+      const std::vector<sm::timing::NsecTime> & times() const;
+      const std::vector<TransformationD> & poses() const;
+
+      /// @return the pose at time
+      Transformation getPose(sm::timing::NsecTime time) const;
+
+      /// \brief the poses at n times into out, which must have room for n.
+      ///
+      /// Sorted times are the fast case, but any order is correct.
+      void getPoses(const sm::timing::NsecTime * times, size_t n, TransformationD * out) const;
+
+      /// \brief the poses at times
+      void getPoses(const std::vector<sm::timing::NsecTime> & times, std::vector<Transformation> & out_poses) const;
+
+    private:
+      /// The rates of change at a pose and the rotation to the next pose,
+      /// used by Cubic.
+      struct Knot
+      {
+        /// angular velocity, in the perturbation of Transformation::oplus()
+        double omega[3];
+        /// linear velocity
+        double v[3];
+        /// rotation vector from this pose to the next one
+        double dphi[3];
+        /// angular velocity of the next pose as the rate of change of
+        /// the rotation vector relative to this pose, logDiffMat(dphi) * omega
+        double dphiRateEnd[3];
+      };
+
+      /// \brief the segment [i, i+1] that contains time, starting the search at hint.
+      size_t findSegment(sm::timing::NsecTime time, size_t hint) const;
+
+      /// \brief interpolate on segment i.
+      void interpolate(size_t i, sm::timing::NsecTime time, TransformationD & out) const;
+
+      /// \brief recompute the knot of pose i from its neighbours.
+      void updateKnot(size_t i);
+
+      /// \brief recompute the rate at the end of segment i, after the knots
+      ///        of poses i and i+1 were updated.
+      void updateSegmentEnd(size_t i);
+
+      Method _method;
+      std::vector<sm::timing::NsecTime> _times;
+      std::vector<TransformationD> _poses;
+      std::vector<Knot> _knots;
+
+      /// The segment of the last query. It is only a hint for the next one.
+      mutable std::atomic<size_t> _lastSegment;
+    };
+
+  } // namespace kinematics
+} // namespace sm
+
+#endif /* SM_TRAJECTORY_INTERPOLATOR_HPP */
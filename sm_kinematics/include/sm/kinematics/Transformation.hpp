@@ -9,12 +9,14 @@
 #include <boost/serialization/split_member.hpp>
 #include <boost/serialization/version.hpp>
 #include <sm/kinematics/UncertainVector.hpp>
+#include <memory>
 
 namespace sm {
   namespace kinematics {
     
     class UncertainTransformation;
     class UncertainHomogeneousPoint;
+    template<typename Scalar_> struct TransformationT;
 
       ///
     /// @class Transformation
@@ -48,6 +50,10 @@ namespace sm {
       ///
       Transformation(const Eigen::Vector4d & q_a_b, const Eigen::Vector3d & t_a_b_a);
 
+      Transformation(const Transformation & rhs);
+
+      Transformation & operator=(const Transformation & rhs);
+
       virtual ~Transformation();
 
       /// 
@@ -102,10 +108,56 @@ namespace sm {
         /// \brief rotate a point (do not translate)
         UncertainVector3 rotate(const UncertainVector3 & p) const;
 
+        /// \brief transform a batch of points, one per column: p_a = T_a_b * p_b.
+        ///
+        /// The rotation matrix is computed once for the batch. p_a may be the
+        /// same matrix as p_b. With numThreads > 1 the columns are split over
+        /// that many threads, which only pays off for large batches.
+        void transformPoints(const Eigen::Ref<const Eigen::Matrix3Xd> & p_b, Eigen::Ref<Eigen::Matrix3Xd> p_a, int numThreads = 1) const;
+
+        /// \brief transform a batch of homogeneous points, one per column: p_a = T_a_b * p_b.
+        void transformHomogeneousPoints(const Eigen::Ref<const Eigen::Matrix4Xd> & p_b, Eigen::Ref<Eigen::Matrix4Xd> p_a, int numThreads = 1) const;
+
+        /// \brief compose T_a_c = T_a_b * T_b_c with the Jacobians of T_a_c.
+        ///
+        /// The Jacobians are with respect to the minimal perturbations of
+        /// oplus(), the result is perturbed the same way: for a small dt,
+        /// (T_a_b oplus dt) * T_b_c ~= T_a_c oplus (J_a_b * dt).
+        Transformation composeAndJacobians(const Transformation & T_b_c,
+                                           Eigen::Matrix<double,6,6> & out_J_a_b,
+                                           Eigen::Matrix<double,6,6> & out_J_b_c) const;
+
+        /// \brief transform p_a = T_a_b * p_b with the Jacobians with respect
+        ///        to the oplus() perturbation of T_a_b and to p_b.
+        Eigen::Vector3d transformAndJacobians(const Eigen::Vector3d & p_b,
+                                              Eigen::Matrix<double,3,6> & out_J_T,
+                                              Eigen::Matrix3d & out_J_p) const;
+
+        /// \brief transform p_a = T_a_b * p_b with the Jacobians with respect
+        ///        to the oplus() perturbation of T_a_b and to p_b.
+        Eigen::Vector4d transformAndJacobians(const Eigen::Vector4d & p_b,
+                                              Eigen::Matrix<double,4,6> & out_J_T,
+                                              Eigen::Matrix4d & out_J_p) const;
+
         
+        /// \brief direct access to the quaternion, this turns the rotation cache off.
         double * qptr();
         double * tptr();
 
+        /// \brief Keep the rotation matrix once it has been computed from the
+        ///        quaternion. Off by default.
+        ///
+        /// The cache lives on the heap, so a Transformation without it only
+        /// carries an extra pointer. While it is on, C(), T(), inverse(),
+        /// rotate() and the point operators all use the matrix, so their
+        /// results do not depend on which of them was called first. Every
+        /// member that changes the rotation invalidates the cache, and
+        /// concurrent reads of a const Transformation are safe. Copies and
+        /// inverse() keep the setting. qptr() turns the cache off, as the
+        /// quaternion may be written through the pointer at any time.
+        void setRotationCacheEnabled(bool enabled);
+        bool isRotationCacheEnabled() const;
+
       
         enum {CLASS_SERIALIZATION_VERSION = 0};
 
@@ -136,14 +188,31 @@ namespace sm {
 
       
     protected:
+
+      /// \brief fill C_a_b with the rotation matrix, from the cache if possible.
+      void rotationMatrix(Eigen::Matrix3d & C_a_b) const;
+
+      /// \brief called after _q_a_b has been changed.
+      void invalidateRotationCache();
         
       /// The quaternion that will become a rotation matrix C_a_b that 
-      /// transforms vectors from b to a.
+      /// transforms vectors from b to a. Subclasses that write it must
+      /// call invalidateRotationCache() afterwards.
       Eigen::Vector4d _q_a_b;
 
       /// The vector from the origin of a to the origin of b, expressed in a
       Eigen::Vector3d _t_a_b_a;
 
+    private:
+      // converts from a TransformationD without normalizing the quaternion again
+      template<typename Scalar_> friend struct TransformationT;
+
+      enum RotationCacheState { CacheInvalid, CacheWriting, CacheValid };
+      struct RotationCache;
+
+      /// NULL while the rotation cache is off
+      std::unique_ptr<RotationCache> _C_cache;
+
     };
 
     
@@ -160,6 +229,7 @@ namespace sm {
         SM_ASSERT_LE(std::runtime_error, version, (unsigned int)CLASS_SERIALIZATION_VERSION, "Unsupported serialization version");
         ar >> BOOST_SERIALIZATION_NVP(_q_a_b);
         ar >> BOOST_SERIALIZATION_NVP(_t_a_b_a);
+        invalidateRotationCache();
     }
 
 
@@ -0,0 +1,92 @@
+#ifndef SM_TRANSFORMATION_T_HPP
+#define SM_TRANSFORMATION_T_HPP
+
+#include <Eigen/Core>
+
+namespace sm {
+  namespace kinematics {
+
+    class Transformation;
+
+    ///
+    /// @class TransformationT
+    /// @brief a transformation as a plain value type for dense storage.
+    ///
+    /// It holds the same quaternion q_a_b and translation t_a_b_a as
+    /// Transformation, but in plain arrays and without virtual functions. The
+    /// type is trivially copyable and standard-layout: seven scalars, no vptr
+    /// and no alignment requirement. A std::vector of them is contiguous and
+    /// can be copied with memcpy. The default constructor leaves the values
+    /// uninitialized; use Identity() for the identity.
+    ///
+    /// The float and double versions are instantiated in the library.
+    ///
+    template<typename Scalar_>
+    struct TransformationT
+    {
+      typedef Scalar_ Scalar;
+      typedef Eigen::Matrix<Scalar, 4, 1> Vector4;
+      typedef Eigen::Matrix<Scalar, 3, 1> Vector3;
+      typedef Eigen::Matrix<Scalar, 3, 3> Matrix3;
+      typedef Eigen::Matrix<Scalar, 4, 4> Matrix4;
+
+      TransformationT() = default;
+
+      /// @param q_a_b The quaternion that transforms vectors from b to a
+      /// @param t_a_b_a the vector from the origin of frame a, to the origin of frame b, expresessed in frame a.
+      TransformationT(const Vector4 & q_a_b, const Vector3 & t_a_b_a);
+
+      /// \brief convert from a Transformation, exact for double.
+      explicit TransformationT(const Transformation & T_a_b);
+
+      /// \brief convert to a Transformation, exact for double.
+      Transformation toTransformation() const;
+
+      static TransformationT Identity();
+
+      /// @return the quaternion q_a_b
+      Eigen::Map<Vector4> q() { return Eigen::Map<Vector4>(q_a_b); }
+      Eigen::Map<const Vector4> q() const { return Eigen::Map<const Vector4>(q_a_b); }
+
+      /// @return the translation vector t_a_b_a
+      Eigen::Map<Vector3> t() { return Eigen::Map<Vector3>(t_a_b_a); }
+      Eigen::Map<const Vector3> t() const { return Eigen::Map<const Vector3>(t_a_b_a); }
+
+      /// @return the rotation matrix
+      Matrix3 C() const;
+
+      /// @return the 4x4 transformation matrix
+      Matrix4 T() const;
+
+      TransformationT inverse() const;
+
+      TransformationT operator*(const TransformationT & rhs) const;
+      Vector3 operator*(const Vector3 & rhs) const;
+      Vector4 operator*(const Vector4 & rhs) const;
+
+      /// \brief convert to another scalar type.
+      template<typename OtherScalar>
+      TransformationT<OtherScalar> cast() const
+      {
+        return TransformationT<OtherScalar>(q().template cast<OtherScalar>(), t().template cast<OtherScalar>());
+      }
+
+      /// The quaternion [x, y, z, w] that will become a rotation matrix C_a_b
+      /// that transforms vectors from b to a.
+      Scalar q_a_b[4];
+
+      /// The vector from the origin of a to the origin of b, expressed in a
+      Scalar t_a_b_a[3];
+    };
+
+    typedef TransformationT<double> TransformationD;
+    typedef TransformationT<float> TransformationF;
+
+    extern template struct TransformationT<double>;
+    extern template struct TransformationT<float>;
+
+  } // namespace kinematics
+} // namespace sm
+
+
+#endif /* SM_TRANSFORMATION_T_HPP */
@@ -0,0 +1,99 @@
+#ifndef SM_UNCERTAIN_TRANSFORMATION_CHAIN_HPP
+#define SM_UNCERTAIN_TRANSFORMATION_CHAIN_HPP
+
+#include <sm/kinematics/UncertainTransformation.hpp>
+#include <sm/kinematics/TransformationT.hpp>
+#include <vector>
+
+namespace sm {
+  namespace kinematics {
+
+    /// The 21 entries of the upper triangle of a symmetric 6x6 covariance,
+    /// row by row.
+    typedef Eigen::Matrix<double,21,1> PackedCovariance;
+
+    /// Packed covariances, one per column.
+    typedef Eigen::Matrix<double,21,Eigen::Dynamic> PackedCovariances;
+
+    /// \brief pack the upper triangle of the symmetric covariance U.
+    void packCovariance(const UncertainTransformation::covariance_t & U, Eigen::Ref<PackedCovariance> out_packed);
+
+    /// \brief the symmetric covariance of a packed one.
+    void unpackCovariance(const Eigen::Ref<const PackedCovariance> & packed, UncertainTransformation::covariance_t & out_U);
+
+    ///
+    /// @class UncertainTransformationChain
+    /// @brief composes a chain T_0_n = T_0_1 * T_1_2 * ... * T_n-1_n of
+    ///        uncertain transformations in place.
+    ///
+    /// Every append() has the same result as UncertainTransformation::operator*(),
+    /// U_0_m = U_0_n + T_0_n^boxtimes U_n_m T_0_n^boxtimes^T, but it updates
+    /// the pose and the covariance of the chain in place and uses the
+    /// symmetry of the covariances.
+    ///
+    class UncertainTransformationChain
+    {
+    public:
+      EIGEN_MAKE_ALIGNED_OPERATOR_NEW
+
+      typedef UncertainTransformation::covariance_t covariance_t;
+
+      /// \brief an empty chain, the identity with zero uncertainty.
+      UncertainTransformationChain();
+
+      /// \brief a chain that starts with T_0_1.
+      explicit UncertainTransformationChain(const UncertainTransformation & T_0_1);
+
+      /// \brief T_0_m = T_0_n * T_n_m
+      void append(const UncertainTransformation & T_n_m);
+
+      /// \brief T_0_m = T_0_n * T_n_m for a transformation without uncertainty.
+      void append(const Transformation & T_n_m);
+
+      /// \brief T_0_m = T_0_n * T_n_m with a packed covariance of T_n_m.
+      void append(const TransformationD & T_n_m, const Eigen::Ref<const PackedCovariance> & U_n_m);
+
+      /// \brief restart the chain at the identity with zero uncertainty.
+      void reset();
+
+      /// @return T_0_n
+      UncertainTransformation toUncertainTransformation() const;
+
+      /// @return T_0_n without its uncertainty
+      TransformationD toTransformation() const;
+
+      const covariance_t & U() const;
+
+      /// \brief the packed covariance of T_0_n.
+      void packedU(Eigen::Ref<PackedCovariance> out_packed) const;
+
+      /// \brief compose all prefixes of a chain of relative poses.
+      ///
+      /// For relative poses T_i_i+1 with packed covariances U_i_i+1 (one
+      /// column each), this computes T_0_i+1 and U_0_i+1 for every i. The
+      /// poses after the chain are appended to the current T_0_n.
+      void appendAll(const std::vector<TransformationD> & T_i_ip1, const PackedCovariances & U_i_ip1,
+                     std::vector<TransformationD> & out_T_0_i, PackedCovariances & out_U_0_i);
+
+    private:
+      /// \brief U_0_m = U_0_n + T_0_n^boxtimes U_n_m T_0_n^boxtimes^T, then T_0_m = T_0_n * T_n_m.
+      void appendInternal(const Eigen::Vector4d & q_n_m, const Eigen::Vector3d & t_n_m, const covariance_t * U_n_m);
+
+      Eigen::Vector4d _q_0_n;
+      Eigen::Vector3d _t_0_n;
+      /// The rotation matrix of _q_0_n
+      Eigen::Matrix3d _C_0_n;
+      covariance_t _U_0_n;
+    };
+
+    /// \brief transform the covariances of many poses into another frame.
+    ///
+    /// For T_a_b and packed covariances U_b_i, one per column, this computes
+    /// out_U_a_i = U_a_b + T_a_b^boxtimes U_b_i T_a_b^boxtimes^T, which is the
+    /// covariance of T_a_b * T_b_i. out_U_a_i may be the same matrix as U_b_i.
+    void composeCovariances(const UncertainTransformation & T_a_b, const PackedCovariances & U_b_i, PackedCovariances & out_U_a_i);
+
+  } // namespace kinematics
+} // namespace sm
+
+#endif /* SM_UNCERTAIN_TRANSFORMATION_CHAIN_HPP */
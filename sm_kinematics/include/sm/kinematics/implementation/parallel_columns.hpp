@@ -0,0 +1,48 @@
+#ifndef SM_KINEMATICS_PARALLEL_COLUMNS_HPP
+#define SM_KINEMATICS_PARALLEL_COLUMNS_HPP
+
+#include <Eigen/Core>
+#include <boost/thread.hpp>
+#include <algorithm>
+
+namespace sm { namespace kinematics {
+
+    namespace detail {
+
+      /// Split the columns [0, numColumns) over up to numThreads threads and
+      /// call processBlock(begin, size) for every block of at most blockSize
+      /// columns. The calling thread takes the first range, and every thread
+      /// gets at least a few blocks.
+      template<typename ProcessBlock>
+      void forEachColumnBlock(Eigen::Index numColumns, int numThreads, Eigen::Index blockSize, const ProcessBlock & processBlock)
+      {
+        auto processRange = [&](Eigen::Index begin, Eigen::Index end)
+          {
+            for(Eigen::Index i = begin; i < end; i += blockSize)
+            {
+              processBlock(i, std::min(blockSize, end - i));
+            }
+          };
+        numThreads = static_cast<int>(std::min<Eigen::Index>(std::max(numThreads, 1), numColumns / (4 * blockSize) + 1));
+        if(numThreads == 1)
+        {
+          processRange(0, numColumns);
+          return;
+        }
+        boost::thread_group threads;
+        // Whole blocks per thread, so that only the last block is partial.
+        const Eigen::Index chunk = ((numColumns + numThreads - 1) / numThreads + blockSize - 1) / blockSize * blockSize;
+        for(Eigen::Index begin = chunk; begin < numColumns; begin += chunk)
+        {
+          const Eigen::Index end = std::min(begin + chunk, numColumns);
+          threads.create_thread([&processRange, begin, end]() { processRange(begin, end); });
+        }
+        processRange(0, std::min(chunk, numColumns));
+        threads.join_all();
+      }
+
+    } // namespace detail
+
+}} // namespace sm::kinematics
+
+#endif /* SM_KINEMATICS_PARALLEL_COLUMNS_HPP */
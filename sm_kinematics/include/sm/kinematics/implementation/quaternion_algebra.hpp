@@ -0,0 +1,245 @@
+#include <sm/assert_macros.hpp>
+#include <cmath>
+#include <limits>
+
+namespace sm { namespace kinematics {
+
+        template <typename Scalar_ = double>
+        inline bool isLessThenEpsilons4thRoot(Scalar_ x){
+          static const Scalar_ epsilon4thRoot = pow(std::numeric_limits<Scalar_>::epsilon(), 1.0/4.0);
+          return x < epsilon4thRoot;
+        }
+
+        template <typename Scalar_>
+        inline Eigen::Matrix<Scalar_, 3, 3> quat2r(Eigen::Matrix<Scalar_, 4, 1> const & q){
+
+            SM_ASSERT_NEAR_DBG(std::runtime_error,q.norm(),1.f,1e-4, "The quaternion must be a unit vector to represent a rotation");
+
+            Eigen::Matrix<Scalar_, 3, 3> R;
+
+            // [ q0^2 - q1^2 - q2^2 + q3^2,           2*q0*q1 + 2*q2*q3,           2*q0*q2 - 2*q1*q3]
+            // [         2*q0*q1 - 2*q2*q3, - q0^2 + q1^2 - q2^2 + q3^2,           2*q0*q3 + 2*q1*q2]
+            // [         2*q0*q2 + 2*q1*q3,           2*q1*q2 - 2*q0*q3, - q0^2 - q1^2 + q2^2 + q3^2]
+            R(0,0) = q[0]*q[0]-q[1]*q[1]-q[2]*q[2]+q[3]*q[3];
+            R(0,1) = q[0]*q[1]*Scalar_(2)+q[2]*q[3]*Scalar_(2);
+            R(0,2) = q[0]*q[2]*Scalar_(2)-q[1]*q[3]*Scalar_(2);
+            R(1,0) = q[0]*q[1]*Scalar_(2)-q[2]*q[3]*Scalar_(2);
+            R(1,1) = -q[0]*q[0]+q[1]*q[1]-q[2]*q[2]+q[3]*q[3];
+            R(1,2) = q[0]*q[3]*Scalar_(2)+q[1]*q[2]*Scalar_(2);
+            R(2,0) = q[0]*q[2]*Scalar_(2)+q[1]*q[3]*Scalar_(2);
+            R(2,1) = q[0]*q[3]*Scalar_(-2)+q[1]*q[2]*Scalar_(2);
+            R(2,2) = -q[0]*q[0]-q[1]*q[1]+q[2]*q[2]+q[3]*q[3];
+
+            return R;
+        }
+
+        template <typename Scalar_>
+        inline Eigen::Matrix<Scalar_, 4, 1> r2quat(Eigen::Matrix<Scalar_, 3, 3> const & R){
+
+            const Scalar_ & c1 = R(0,0);
+            const Scalar_ & c2 = R(1,0);
+            const Scalar_ & c3 = R(2,0);
+            const Scalar_ & c4 = R(0,1);
+            const Scalar_ & c5 = R(1,1);
+            const Scalar_ & c6 = R(2,1);
+            const Scalar_ & c7 = R(0,2);
+            const Scalar_ & c8 = R(1,2);
+            const Scalar_ & c9 = R(2,2);
+
+            const Scalar_ one(1);
+            Eigen::Matrix<Scalar_, 4, 1> dc(std::abs(one+c1-c5-c9),
+                                            std::abs(one-c1+c5-c9),
+                                            std::abs(one-c1-c5+c9),
+                                            std::abs(one+c1+c5+c9));
+
+            unsigned maxq = 0;
+            Scalar_ maxqval = dc(0);
+
+            for(unsigned i = 1; i < 4; i++) {
+                if(dc(i) > maxqval) {
+                    maxq = i;
+                    maxqval = dc(i);
+                }
+            }
+
+            const Scalar_ half(0.5), quarter(0.25);
+            Scalar_ c;
+            Eigen::Matrix<Scalar_, 4, 1> q;
+            if(maxq == 0){
+                q(0)=half*std::sqrt(dc(0));
+                c = quarter/q(0);
+                q(1)=c*(c4+c2);
+                q(2)=c*(c7+c3);
+                q(3)=c*(c8-c6);
+            } else if(maxq == 1){
+                q(1)=half*std::sqrt(dc(1));
+                c = quarter/q(1);
+                q(0)=c*(c4+c2);
+                q(2)=c*(c6+c8);
+                q(3)=c*(c3-c7);
+            } else if(maxq == 2){
+                q(2)=half*std::sqrt(dc(2));
+                c = quarter/q(2);
+                q(0)=c*(c3+c7);
+                q(1)=c*(c6+c8);
+                q(3)=c*(c4-c2);
+            } else {
+                q(3)=half*std::sqrt(dc(3));
+                c = quarter/q(3);
+                q(0)=c*(c8-c6);
+                q(1)=c*(c3-c7);
+                q(2)=c*(c4-c2);
+            }
+
+            if(q(3) < 0)
+                q = -q;
+
+            return q;
+        }
+
+        template <typename Scalar_>
+        inline Eigen::Matrix<Scalar_, 4, 1> axisAngle2quat(Eigen::Matrix<Scalar_, 3, 1> const & a)
+        {
+            // Method of implementing this function that is accurate to numerical precision from
+            // Grassia, F. S. (1998). Practical parameterization of rotations using the exponential map. journal of graphics, gpu, and game tools, 3(3):29–48.
+
+            Scalar_ theta = a.norm();
+
+            // na is 1/theta sin(theta/2)
+            Scalar_ na;
+            if(isLessThenEpsilons4thRoot(theta))
+            {
+                na = Scalar_(0.5) - (theta * theta) * Scalar_(1.0/48.0);
+            }
+            else
+            {
+                na = std::sin(theta*Scalar_(0.5)) / theta;
+            }
+            Eigen::Matrix<Scalar_, 3, 1> axis = a*na;
+            Scalar_ ct = std::cos(theta*Scalar_(0.5));
+            return Eigen::Matrix<Scalar_, 4, 1>(axis[0],axis[1],axis[2],ct);
+        }
+
+        template <typename Scalar_>
+        inline Eigen::Matrix<Scalar_, 4, 4> quatPlus(Eigen::Matrix<Scalar_, 4, 1> const & q)
+        {
+            // [  q3,  q2, -q1, q0]
+            // [ -q2,  q3,  q0, q1]
+            // [  q1, -q0,  q3, q2]
+            // [ -q0, -q1, -q2, q3]
+            Eigen::Matrix<Scalar_, 4, 4> Q;
+            Q(0,0) =  q[3]; Q(0,1) =  q[2]; Q(0,2) = -q[1]; Q(0,3) =  q[0];
+            Q(1,0) = -q[2]; Q(1,1) =  q[3]; Q(1,2) =  q[0]; Q(1,3) =  q[1];
+            Q(2,0) =  q[1]; Q(2,1) = -q[0]; Q(2,2) =  q[3]; Q(2,3) =  q[2];
+            Q(3,0) = -q[0]; Q(3,1) = -q[1]; Q(3,2) = -q[2]; Q(3,3) =  q[3];
+
+            return Q;
+        }
+
+        template <typename Scalar_>
+        inline Eigen::Matrix<Scalar_, 4, 4> quatOPlus(Eigen::Matrix<Scalar_, 4, 1> const & q)
+        {
+            // [  q3, -q2,  q1, q0]
+            // [  q2,  q3, -q0, q1]
+            // [ -q1,  q0,  q3, q2]
+            // [ -q0, -q1, -q2, q3]
+            Eigen::Matrix<Scalar_, 4, 4> Q;
+            Q(0,0) =  q[3]; Q(0,1) = -q[2]; Q(0,2) =  q[1]; Q(0,3) =  q[0];
+            Q(1,0) =  q[2]; Q(1,1) =  q[3]; Q(1,2) = -q[0]; Q(1,3) =  q[1];
+            Q(2,0) = -q[1]; Q(2,1) =  q[0]; Q(2,2) =  q[3]; Q(2,3) =  q[2];
+            Q(3,0) = -q[0]; Q(3,1) = -q[1]; Q(3,2) = -q[2]; Q(3,3) =  q[3];
+
+            return Q;
+        }
+
+        template <typename Scalar_>
+        inline Eigen::Matrix<Scalar_, 4, 1> qplus(Eigen::Matrix<Scalar_, 4, 1> const & q, Eigen::Matrix<Scalar_, 4, 1> const & p)
+        {
+            Eigen::Matrix<Scalar_, 4, 1> qplus_p;
+            // p0*q3 + p1*q2 - p2*q1 + p3*q0
+            qplus_p[0] = p[0]*q[3] + p[1]*q[2] - p[2]*q[1] + p[3]*q[0];
+            // p2*q0 - p0*q2 + p1*q3 + p3*q1
+            qplus_p[1] = p[2]*q[0] - p[0]*q[2] + p[1]*q[3] + p[3]*q[1];
+            // p0*q1 - p1*q0 + p2*q3 + p3*q2
+            qplus_p[2] = p[0]*q[1] - p[1]*q[0] + p[2]*q[3] + p[3]*q[2];
+            // p3*q3 - p1*q1 - p2*q2 - p0*q0
+            qplus_p[3] = p[3]*q[3] - p[1]*q[1] - p[2]*q[2] - p[0]*q[0];
+
+            return qplus_p;
+        }
+
+        template <typename Scalar_>
+        inline Eigen::Matrix<Scalar_, 4, 1> qoplus(Eigen::Matrix<Scalar_, 4, 1> const & q, Eigen::Matrix<Scalar_, 4, 1> const & p)
+        {
+            Eigen::Matrix<Scalar_, 4, 1> qoplus_p;
+            // p0*q3 - p1*q2 + p2*q1 + p3*q0
+            qoplus_p[0] = p[0]*q[3] - p[1]*q[2] + p[2]*q[1] + p[3]*q[0];
+            // p0*q2 - p2*q0 + p1*q3 + p3*q1
+            qoplus_p[1] = p[0]*q[2] - p[2]*q[0] + p[1]*q[3] + p[3]*q[1];
+            // p1*q0 - p0*q1 + p2*q3 + p3*q2
+            qoplus_p[2] = p[1]*q[0] - p[0]*q[1] + p[2]*q[3] + p[3]*q[2];
+            // p3*q3 - p1*q1 - p2*q2 - p0*q0
+            qoplus_p[3] = p[3]*q[3] - p[1]*q[1] - p[2]*q[2] - p[0]*q[0];
+
+            return qoplus_p;
+        }
+
+        template <typename Scalar_>
+        inline Eigen::Matrix<Scalar_, 4, 1> quatInv(Eigen::Matrix<Scalar_, 4, 1> const & q)
+        {
+            return Eigen::Matrix<Scalar_, 4, 1>(-q[0], -q[1], -q[2], q[3]);
+        }
+
+        template <typename Scalar_>
+        inline Eigen::Matrix<Scalar_, 3, 1> quatRotate(Eigen::Matrix<Scalar_, 4, 1> const & q_a_b, Eigen::Matrix<Scalar_, 3, 1> const & v_b)
+        {
+            return v_b + Scalar_(2) * q_a_b.template head<3>().cross(q_a_b.template head<3>().cross(v_b) - q_a_b[3] * v_b);
+        }
+
+        template <typename Scalar_>
+        inline Eigen::Matrix<Scalar_, 4, 1> quatIdentity()
+        {
+            return Eigen::Matrix<Scalar_, 4, 1>(0,0,0,1);
+        }
+
+        template <typename Scalar_>
+        inline Eigen::Matrix<Scalar_, 4, 1> updateQuat(Eigen::Matrix<Scalar_, 4, 1> const & q, Eigen::Matrix<Scalar_, 3, 1> const & dq)
+        {
+            // the following code is an optimized version of:
+            // Eigen::Vector4d dq4 = axisAngle2quat(dq);
+            // Eigen::Vector4d retq = quatPlus(dq4)*q;
+            // return retq;
+
+            Eigen::Matrix<Scalar_, 4, 1> dq3 = axisAngle2quat(dq);
+            Scalar_ ca = dq3[3];
+            Eigen::Matrix<Scalar_, 4, 1> retq;
+            retq[0] = q[0]*ca+dq3[0]*q[3]-dq3[1]*q[2]+dq3[2]*q[1];
+            retq[1] = q[1]*ca+dq3[0]*q[2]+dq3[1]*q[3]-dq3[2]*q[0];
+            retq[2] = q[2]*ca-dq3[0]*q[1]+dq3[1]*q[0]+dq3[2]*q[3];
+            retq[3] = q[3]*ca-dq3[0]*q[0]-dq3[1]*q[1]-dq3[2]*q[2];
+
+            return retq;
+        }
+
+        template <typename Scalar_>
+        inline Eigen::Matrix<Scalar_, 4, 1> qslerp(Eigen::Matrix<Scalar_, 4, 1> const & q0, Eigen::Matrix<Scalar_, 4, 1> const & q1, Scalar_ t)
+        {
+          if(t <= Scalar_(0))
+            {
+                return q0;
+            }
+            else if(t >= Scalar_(1))
+            {
+                return q1;
+            }
+            else
+            {
+              // The quaternions are far away from eachother on the sphere
+              // if this is true. Flip one around so that this works out.
+              const Eigen::Matrix<Scalar_, 4, 1> q1_near = (q0-q1).squaredNorm() > (q0 + q1).squaredNorm() ? Eigen::Matrix<Scalar_, 4, 1>(-q1) : q1;
+              const Eigen::Matrix<Scalar_, 3, 1> a = quat2AxisAngle<Scalar_>(qplus<Scalar_>(quatInv<Scalar_>(q0), q1_near));
+              return qplus<Scalar_>(q0, axisAngle2quat<Scalar_>(Eigen::Matrix<Scalar_, 3, 1>(t * a)));
+            }
+        }
+
+}} // namespace sm::kinematics
@@ -0,0 +1,367 @@
+#include <sm/kinematics/quaternion_algebra.hpp>
+#include <cmath>
+#include <limits>
+
+namespace sm { namespace kinematics {
+
+    namespace detail {
+
+      /// Below this angle the four term Taylor series of the coefficients are
+      /// exact to rounding, as the first omitted term is of order theta^8.
+      template <typename Scalar_>
+      inline Scalar_ smallAngleThreshold(){
+        static const Scalar_ threshold = std::pow(std::numeric_limits<Scalar_>::epsilon(), Scalar_(1.0/8.0));
+        return threshold;
+      }
+
+      /// c0 + c1 x + c2 x^2 + c3 x^3
+      template <typename Scalar_>
+      inline Scalar_ series(Scalar_ x, double c0, double c1, double c2, double c3){
+        return Scalar_(c0) + x * (Scalar_(c1) + x * (Scalar_(c2) + x * Scalar_(c3)));
+      }
+
+      template <typename Scalar_>
+      inline Eigen::Matrix<Scalar_, 3, 3> skew(const Eigen::Matrix<Scalar_, 3, 1> & v){
+        Eigen::Matrix<Scalar_, 3, 3> S;
+        S << Scalar_(0), -v[2],      v[1],
+             v[2],       Scalar_(0), -v[0],
+             -v[1],      v[0],       Scalar_(0);
+        return S;
+      }
+
+    } // namespace detail
+
+    namespace so3 {
+
+      template <typename Scalar_>
+      inline Kernel<Scalar_>::Kernel(const Vector3 & phi) : _phi(phi)
+      {
+        const Scalar_ theta2 = phi.squaredNorm();
+        _theta = std::sqrt(theta2);
+        _phiCross = detail::skew(phi);
+        // phi^ phi^ = phi phi^T - theta^2 I
+        _phiCross2.noalias() = phi * phi.transpose();
+        _phiCross2.diagonal().array() -= theta2;
+
+        if(_theta < detail::smallAngleThreshold<Scalar_>())
+        {
+          _a = detail::series(theta2, 1.0, -1.0/6.0, 1.0/120.0, -1.0/5040.0);
+          _b = detail::series(theta2, 1.0/2.0, -1.0/24.0, 1.0/720.0, -1.0/40320.0);
+          _c = detail::series(theta2, 1.0/6.0, -1.0/120.0, 1.0/5040.0, -1.0/362880.0);
+          _d = detail::series(theta2, 1.0/12.0, 1.0/720.0, 1.0/30240.0, 1.0/1209600.0);
+          _halfSinc = detail::series(theta2, 1.0/2.0, -1.0/48.0, 1.0/3840.0, -1.0/645120.0);
+          _halfCos = detail::series(theta2, 1.0, -1.0/8.0, 1.0/384.0, -1.0/46080.0);
+        }
+        else
+        {
+          // Everything follows from the sine and cosine of the half angle:
+          // sin(theta) = 2 sh ch and 1 - cos(theta) = 2 sh^2.
+          const Scalar_ sh = std::sin(Scalar_(0.5) * _theta);
+          const Scalar_ ch = std::cos(Scalar_(0.5) * _theta);
+          const Scalar_ invTheta2 = Scalar_(1) / theta2;
+          _a = Scalar_(2) * sh * ch / _theta;
+          _b = Scalar_(2) * sh * sh * invTheta2;
+          _c = (Scalar_(1) - _a) * invTheta2;
+          _d = (Scalar_(1) - Scalar_(0.5) * _theta * ch / sh) * invTheta2;
+          _halfSinc = sh / _theta;
+          _halfCos = ch;
+        }
+      }
+
+      template <typename Scalar_>
+      inline typename Kernel<Scalar_>::Matrix3 Kernel<Scalar_>::exp() const
+      {
+        Matrix3 C = _b * _phiCross2 - _a * _phiCross;
+        C.diagonal().array() += Scalar_(1);
+        return C;
+      }
+
+      template <typename Scalar_>
+      inline typename Kernel<Scalar_>::Vector4 Kernel<Scalar_>::quaternion() const
+      {
+        Vector4 q;
+        q.template head<3>() = _halfSinc * _phi;
+        q[3] = _halfCos;
+        return q;
+      }
+
+      template <typename Scalar_>
+      inline typename Kernel<Scalar_>::Matrix3 Kernel<Scalar_>::Jl() const
+      {
+        Matrix3 J = _c * _phiCross2 - _b * _phiCross;
+        J.diagonal().array() += Scalar_(1);
+        return J;
+      }
+
+      template <typename Scalar_>
+      inline typename Kernel<Scalar_>::Matrix3 Kernel<Scalar_>::Jr() const
+      {
+        Matrix3 J = _c * _phiCross2 + _b * _phiCross;
+        J.diagonal().array() += Scalar_(1);
+        return J;
+      }
+
+      template <typename Scalar_>
+      inline typename Kernel<Scalar_>::Matrix3 Kernel<Scalar_>::JlInverse() const
+      {
+        Matrix3 J = _d * _phiCross2 + Scalar_(0.5) * _phiCross;
+        J.diagonal().array() += Scalar_(1);
+        return J;
+      }
+
+      template <typename Scalar_>
+      inline typename Kernel<Scalar_>::Matrix3 Kernel<Scalar_>::JrInverse() const
+      {
+        Matrix3 J = _d * _phiCross2 - Scalar_(0.5) * _phiCross;
+        J.diagonal().array() += Scalar_(1);
+        return J;
+      }
+
+      template <typename Scalar_>
+      inline Eigen::Matrix<Scalar_, 3, 3> exp(const Eigen::Matrix<Scalar_, 3, 1> & phi)
+      {
+        return Kernel<Scalar_>(phi).exp();
+      }
+
+      template <typename Scalar_>
+      inline Eigen::Matrix<Scalar_, 3, 1> logQuaternion(const Eigen::Matrix<Scalar_, 4, 1> & q)
+      {
+        // q and -q are the same rotation; the one with a non-negative scalar
+        // part has the angle in [0, pi].
+        const Scalar_ sign = q[3] < Scalar_(0) ? Scalar_(-1) : Scalar_(1);
+        const Scalar_ w = sign * q[3];
+        const Scalar_ n = q.template head<3>().norm();
+        Scalar_ scale;
+        if(n < detail::smallAngleThreshold<Scalar_>() * w)
+        {
+          // 2 atan(x) / (x w) with x = n / w
+          const Scalar_ x2 = n * n / (w * w);
+          scale = Scalar_(2) / w * detail::series(x2, 1.0, -1.0/3.0, 1.0/5.0, -1.0/7.0);
+        }
+        else
+        {
+          scale = Scalar_(2) * std::atan2(n, w) / n;
+        }
+        return (sign * scale) * q.template head<3>();
+      }
+
+      template <typename Scalar_>
+      inline Eigen::Matrix<Scalar_, 3, 1> log(const Eigen::Matrix<Scalar_, 3, 3> & C)
+      {
+        return logQuaternion<Scalar_>(r2quat<Scalar_>(C));
+      }
+
+      template <typename Scalar_>
+      inline Eigen::Matrix<Scalar_, 3, 3> Jl(const Eigen::Matrix<Scalar_, 3, 1> & phi)
+      {
+        return Kernel<Scalar_>(phi).Jl();
+      }
+
+      template <typename Scalar_>
+      inline Eigen::Matrix<Scalar_, 3, 3> Jr(const Eigen::Matrix<Scalar_, 3, 1> & phi)
+      {
+        return Kernel<Scalar_>(phi).Jr();
+      }
+
+      template <typename Scalar_>
+      inline Eigen::Matrix<Scalar_, 3, 3> JlInverse(const Eigen::Matrix<Scalar_, 3, 1> & phi)
+      {
+        return Kernel<Scalar_>(phi).JlInverse();
+      }
+
+      template <typename Scalar_>
+      inline Eigen::Matrix<Scalar_, 3, 3> JrInverse(const Eigen::Matrix<Scalar_, 3, 1> & phi)
+      {
+        return Kernel<Scalar_>(phi).JrInverse();
+      }
+
+    } // namespace so3
+
+    namespace se3 {
+
+      template <typename Scalar_>
+      inline Kernel<Scalar_>::Kernel(const Vector6 & xi) :
+        _rotation(xi.template tail<3>()), _rho(xi.template head<3>())
+      {
+      }
+
+      template <typename Scalar_>
+      inline typename Kernel<Scalar_>::Vector3 Kernel<Scalar_>::translation() const
+      {
+        // so3::Jl(phi) rho = rho - b phi^ rho + c phi^ phi^ rho
+        const Vector3 & phi = _rotation.phi();
+        const Vector3 u = phi.cross(_rho);
+        return _rho - _rotation.b() * u + _rotation.c() * phi.cross(u);
+      }
+
+      template <typename Scalar_>
+      inline typename Kernel<Scalar_>::Matrix4 Kernel<Scalar_>::exp() const
+      {
+        Matrix4 T;
+        T.template topLeftCorner<3,3>() = _rotation.exp();
+        T.template topRightCorner<3,1>() = translation();
+        T.template bottomLeftCorner<1,3>().setZero();
+        T(3,3) = Scalar_(1);
+        return T;
+      }
+
+      template <typename Scalar_>
+      inline void Kernel<Scalar_>::Q(Matrix3 * out_Ql, Matrix3 * out_Qr) const
+      {
+        // With P = phi^ and R = rho^ the left coupling term is
+        //   Ql = R/2 - c1 (PR + RP - PRP) + c2 (PPR + RPP - 3 PRP) - c3 (PRPP + PPRP)
+        // and the right one Qr = Ql(-rho, -phi). RP = (PR)^T, RPP = -(PPR)^T and
+        // PPRP = (PRPP)^T, so four products are enough.
+        const Scalar_ theta2 = _rotation.theta() * _rotation.theta();
+        const Scalar_ c1 = _rotation.c();
+        Scalar_ c2, c3;
+        if(_rotation.theta() < detail::smallAngleThreshold<Scalar_>())
+        {
+          c2 = detail::series(theta2, 1.0/24.0, -1.0/720.0, 1.0/40320.0, -1.0/3628800.0);
+          c3 = detail::series(theta2, 1.0/120.0, -1.0/2520.0, 1.0/120960.0, -1.0/9979200.0);
+        }
+        else
+        {
+          // c2 = (theta^2 + 2 cos(theta) - 2) / (2 theta^4)
+          // c3 = (2 theta - 3 sin(theta) + theta cos(theta)) / (2 theta^5)
+          c2 = (Scalar_(0.5) - _rotation.b()) / theta2;
+          c3 = (Scalar_(3) * c1 - _rotation.b()) / (Scalar_(2) * theta2);
+        }
+
+        const Matrix3 & P = _rotation.phiCross();
+        const Matrix3 R = detail::skew(_rho);
+        const Matrix3 PR = P * R;
+        const Matrix3 PRP = PR * P;
+        const Matrix3 PPR = P * PR;
+        const Matrix3 PRPP = PRP * P;
+
+        // The parts that are odd and even in (rho, phi).
+        const Matrix3 odd = Scalar_(0.5) * R + (c1 - Scalar_(3) * c2) * PRP + c2 * (PPR - PPR.transpose());
+        const Matrix3 even = -c1 * (PR + PR.transpose()) - c3 * (PRPP + PRPP.transpose());
+        if(out_Ql)
+        {
+          *out_Ql = even + odd;
+        }
+        if(out_Qr)
+        {
+          *out_Qr = even - odd;
+        }
+      }
+
+      template <typename Scalar_>
+      inline typename Kernel<Scalar_>::Matrix6 Kernel<Scalar_>::Jl() const
+      {
+        Matrix3 Ql;
+        Q(&Ql, NULL);
+        Matrix6 J;
+        J.template topLeftCorner<3,3>() = _rotation.Jl();
+        J.template topRightCorner<3,3>() = -Ql;
+        J.template bottomLeftCorner<3,3>().setZero();
+        J.template bottomRightCorner<3,3>() = J.template topLeftCorner<3,3>();
+        return J;
+      }
+
+      template <typename Scalar_>
+      inline typename Kernel<Scalar_>::Matrix6 Kernel<Scalar_>::Jr() const
+      {
+        Matrix3 Qr;
+        Q(NULL, &Qr);
+        Matrix6 J;
+        J.template topLeftCorner<3,3>() = _rotation.Jr();
+        J.template topRightCorner<3,3>() = -Qr;
+        J.template bottomLeftCorner<3,3>().setZero();
+        J.template bottomRightCorner<3,3>() = J.template topLeftCorner<3,3>();
+        return J;
+      }
+
+      template <typename Scalar_>
+      inline typename Kernel<Scalar_>::Matrix6 Kernel<Scalar_>::JlInverse() const
+      {
+        Matrix3 Ql;
+        Q(&Ql, NULL);
+        const Matrix3 Ji = _rotation.JlInverse();
+        Matrix6 J;
+        J.template topLeftCorner<3,3>() = Ji;
+        J.template topRightCorner<3,3>().noalias() = Ji * Ql * Ji;
+        J.template bottomLeftCorner<3,3>().setZero();
+        J.template bottomRightCorner<3,3>() = Ji;
+        return J;
+      }
+
+      template <typename Scalar_>
+      inline typename Kernel<Scalar_>::Matrix6 Kernel<Scalar_>::JrInverse() const
+      {
+        Matrix3 Qr;
+        Q(NULL, &Qr);
+        const Matrix3 Ji = _rotation.JrInverse();
+        Matrix6 J;
+        J.template topLeftCorner<3,3>() = Ji;
+        J.template topRightCorner<3,3>().noalias() = Ji * Qr * Ji;
+        J.template bottomLeftCorner<3,3>().setZero();
+        J.template bottomRightCorner<3,3>() = Ji;
+        return J;
+      }
+
+      template <typename Scalar_>
+      inline Eigen::Matrix<Scalar_, 4, 4> exp(const Eigen::Matrix<Scalar_, 6, 1> & xi)
+      {
+        return Kernel<Scalar_>(xi).exp();
+      }
+
+      template <typename Scalar_>
+      inline Eigen::Matrix<Scalar_, 6, 1> log(const Eigen::Matrix<Scalar_, 4, 4> & T)
+      {
+        const Eigen::Matrix<Scalar_, 3, 3> C = T.template topLeftCorner<3,3>();
+        const Eigen::Matrix<Scalar_, 3, 1> t = T.template topRightCorner<3,1>();
+        Eigen::Matrix<Scalar_, 6, 1> xi;
+        xi.template tail<3>() = so3::log<Scalar_>(C);
+        // rho = so3::JlInverse(phi) t = t + phi^ t / 2 + d phi^ phi^ t
+        const so3::Kernel<Scalar_> rotation(xi.template tail<3>());
+        const Eigen::Matrix<Scalar_, 3, 1> u = rotation.phi().cross(t);
+        xi.template head<3>() = t + Scalar_(0.5) * u + rotation.d() * rotation.phi().cross(u);
+        return xi;
+      }
+
+      template <typename Scalar_>
+      inline Eigen::Matrix<Scalar_, 6, 6> Jl(const Eigen::Matrix<Scalar_, 6, 1> & xi)
+      {
+        return Kernel<Scalar_>(xi).Jl();
+      }
+
+      template <typename Scalar_>
+      inline Eigen::Matrix<Scalar_, 6, 6> Jr(const Eigen::Matrix<Scalar_, 6, 1> & xi)
+      {
+        return Kernel<Scalar_>(xi).Jr();
+      }
+
+      template <typename Scalar_>
+      inline Eigen::Matrix<Scalar_, 6, 6> JlInverse(const Eigen::Matrix<Scalar_, 6, 1> & xi)
+      {
+        return Kernel<Scalar_>(xi).JlInverse();
+      }
+
+      template <typename Scalar_>
+      inline Eigen::Matrix<Scalar_, 6, 6> JrInverse(const Eigen::Matrix<Scalar_, 6, 1> & xi)
+      {
+        return Kernel<Scalar_>(xi).JrInverse();
+      }
+
+      template <typename Scalar_>
+      inline Eigen::Matrix<Scalar_, 6, 6> adjoint(const Eigen::Matrix<Scalar_, 4, 4> & T)
+      {
+        const Eigen::Matrix<Scalar_, 3, 1> t = T.template topRightCorner<3,1>();
+        Eigen::Matrix<Scalar_, 6, 6> A;
+        A.template topLeftCorner<3,3>() = T.template topLeftCorner<3,3>();
+        // -t^ C, column by column
+        for(int i = 0; i < 3; ++i)
+        {
+          A.template block<3,1>(0,3+i) = T.template block<3,1>(0,i).cross(t);
+        }
+        A.template bottomLeftCorner<3,3>().setZero();
+        A.template bottomRightCorner<3,3>() = A.template topLeftCorner<3,3>();
+        return A;
+      }
+
+    } // namespace se3
+
+}} // namespace sm::kinematics
@@ -0,0 +1,101 @@
+#include <sm/assert_macros.hpp>
+#include <sm/kinematics/rotations.hpp>
+#include <Eigen/SVD>
+#include <Eigen/LU>
+#include <Eigen/Eigenvalues>
+#include <cmath>
+
+namespace sm { namespace kinematics {
+
+        // Original code from the ROS vslam package pe3d.cpp
+        // uses the SVD procedure for aligning point clouds
+        //   SEE: Arun, Huang, Blostein: Least-Squares Fitting of Two 3D Point Sets
+        template<typename Derived0_, typename Derived1_>
+        inline Eigen::Matrix4d threePointSvd(const Eigen::MatrixBase<Derived0_> & p0, const Eigen::MatrixBase<Derived1_> & p1)
+        {
+            using namespace Eigen;
+
+            SM_ASSERT_EQ_DBG(std::runtime_error, p0.rows(), 3, "p0 must be a 3xK matrix");
+            SM_ASSERT_EQ_DBG(std::runtime_error, p1.rows(), 3, "p1 must be a 3xK matrix");
+            SM_ASSERT_EQ_DBG(std::runtime_error, p0.cols(), p1.cols(), "p0 and p1 must have the same number of columns");
+
+            const Vector3d c0 = p0.rowwise().mean();
+            const Vector3d c1 = p1.rowwise().mean();
+
+            // The cross covariance is accumulated column by column, so that
+            // no 3xK temporaries are needed.
+            Matrix3d H(Matrix3d::Zero());
+            for(Index i = 0; i < p0.cols(); ++i)
+            {
+                H.noalias() += (p0.col(i) - c0) * (p1.col(i) - c1).transpose();
+            }
+
+            // do the SVD thang
+            JacobiSVD<Matrix3d> svd(H, ComputeFullU | ComputeFullV);
+            Matrix3d V = svd.matrixV();
+            Matrix3d R = V * svd.matrixU().transpose();
+
+            if (R.determinant() < 0.0)
+            {
+                V.col(2) = V.col(2) * -1.0;
+                R = V * svd.matrixU().transpose();
+            }
+            const Vector3d tr = c0 - R.transpose() * c1;    // translation
+
+            Matrix4d tfm(Matrix4d::Identity());
+            tfm.topLeftCorner<3,3>() = R.transpose();
+            tfm.topRightCorner<3,1>() = tr;
+
+            return tfm;
+        }
+
+        template<typename Derived0_, typename Derived1_, typename DerivedW_>
+        inline Eigen::Matrix3d qMethod(const Eigen::MatrixBase<Derived0_> & p0, const Eigen::MatrixBase<Derived1_> & p1, const Eigen::MatrixBase<DerivedW_> & w)
+        {
+            SM_ASSERT_EQ_DBG(std::runtime_error, p0.rows(), 3, "p0 must be a 3xK matrix");
+            SM_ASSERT_EQ_DBG(std::runtime_error, p1.rows(), 3, "p1 must be a 3xK matrix");
+            SM_ASSERT_EQ_DBG(std::runtime_error, p0.cols(), p1.cols(), "p0 and p1 must have the same number of columns");
+            SM_ASSERT_EQ_DBG(std::runtime_error, w.size(), p0.cols(),  "w must have the same number of columns as p0");
+
+            // B = sum_i w_i p0_i p1_i^T, which is W * V^T for the columns
+            // scaled by sqrt(w_i).
+            Eigen::Matrix3d B(Eigen::Matrix3d::Zero());
+            for(Eigen::Index i = 0; i < p0.cols(); i++)
+            {
+                SM_ASSERT_NEAR_DBG(std::runtime_error, p0.col(i).norm(),1.0,1e-4,"Column " << i << " of p0 was not a unit vector");
+                SM_ASSERT_NEAR_DBG(std::runtime_error, p1.col(i).norm(),1.0,1e-4,"Column " << i << " of p1 was not a unit vector");
+
+                B.noalias() += w[i] * p0.col(i) * p1.col(i).transpose();
+            }
+
+            const Eigen::Vector3d Z(B(1,2) - B(2,1),
+                                    B(2,0) - B(0,2),
+                                    B(0,1) - B(1,0));
+            const double sigma = B(0,0) + B(1,1) + B(2,2);
+
+            Eigen::Matrix4d K;
+            K.topLeftCorner<3,3>() = B + B.transpose() - sigma * Eigen::Matrix3d::Identity();
+            K.topRightCorner<3,1>() = Z;
+            K.bottomLeftCorner<1,3>() = Z.transpose();
+            K(3,3) = sigma;
+
+            Eigen::SelfAdjointEigenSolver<Eigen::Matrix4d> eigensolver(K);
+
+            // The eigenvalues are sorted in increasing order, the eigenvector
+            // of the maximum eigenvalue is the quaternion q_01.
+            Eigen::Vector4d q_01 = eigensolver.eigenvectors().col(3);
+            q_01 /= q_01.norm();
+
+            const Eigen::Vector3d qv = q_01.head<3>();
+            const double qs = q_01(3);
+
+            return (qs*qs - qv.dot(qv))*Eigen::Matrix3d::Identity() + 2.0 * qv * qv.transpose() - 2.0 * qs * crossMx(qv);
+        }
+
+        template<typename Derived0_, typename Derived1_>
+        inline Eigen::Matrix3d qMethod(const Eigen::MatrixBase<Derived0_> & p0, const Eigen::MatrixBase<Derived1_> & p1)
+        {
+            return qMethod(p0, p1, Eigen::Matrix<double, Derived0_::ColsAtCompileTime, 1>::Ones(p0.cols()));
+        }
+
+}} // namespace sm::kinematics
@@ -0,0 +1,172 @@
+/**
+ * @file   packed_quaternion_algebra.hpp
+ *
+ * @brief  The quaternion algebra of quaternion_algebra.hpp for batches of
+ *         quaternions stored as a structure of arrays.
+ *
+ * A batch of N quaternions is an N x 4 column-major array: the columns
+ * hold all x, all y, all z and all w components contiguously, and a
+ * batch of vectors is an N x 3 array the same way. The functions are
+ * written as Eigen array expressions over the columns, so Eigen
+ * processes as many quaternions per instruction as the SIMD instruction
+ * set the code is compiled for allows (e.g. 4 doubles or 8 floats with
+ * AVX). This pays off most for float and for the trigonometric functions;
+ * the pure products of qplus() are bound by memory either way. The
+ * results are those of the single quaternion functions up to rounding.
+ *
+ * The output may be the same array as an input.
+ */
+
+#ifndef SM_PACKED_QUATERNION_ALGEBRA_HPP
+#define SM_PACKED_QUATERNION_ALGEBRA_HPP
+
+#include <sm/kinematics/quaternion_algebra.hpp>
+#include <sm/assert_macros.hpp>
+#include <algorithm>
+#include <cmath>
+#include <limits>
+
+namespace sm { namespace kinematics {
+
+    namespace detail {
+      // The batches are processed in blocks of rows, with the temporaries
+      // on the stack and in the cache, which also makes in-place calls safe.
+      const Eigen::Index kPackedBlockSize = 64;
+
+      template <typename Scalar_>
+      struct PackedBlock
+      {
+        typedef Eigen::Array<Scalar_, Eigen::Dynamic, 1, Eigen::ColMajor, kPackedBlockSize, 1> column_t;
+      };
+
+      // qplus() of a block of rows. The result is computed completely
+      // before it is written, so out may overlap the input.
+      template <typename Scalar_, typename Q_, typename P_, typename Out_>
+      inline void qplusBlock(const Q_ & q0, const Q_ & q1, const Q_ & q2, const Q_ & q3,
+                             const P_ & p0, const P_ & p1, const P_ & p2, const P_ & p3,
+                             Out_ out)
+      {
+        typedef typename PackedBlock<Scalar_>::column_t column_t;
+        const column_t r0 = p0*q3 + p1*q2 - p2*q1 + p3*q0;
+        const column_t r1 = p2*q0 - p0*q2 + p1*q3 + p3*q1;
+        const column_t r2 = p0*q1 - p1*q0 + p2*q3 + p3*q2;
+        out.col(3) = p3*q3 - p1*q1 - p2*q2 - p0*q0;
+        out.col(0) = r0;
+        out.col(1) = r1;
+        out.col(2) = r2;
+      }
+
+      // axisAngle2quat() of a block of rows, see there.
+      template <typename Scalar_, typename In_>
+      inline void axisAngle2quatBlock(const In_ & a,
+                                      typename PackedBlock<Scalar_>::column_t & q0, typename PackedBlock<Scalar_>::column_t & q1,
+                                      typename PackedBlock<Scalar_>::column_t & q2, typename PackedBlock<Scalar_>::column_t & q3)
+      {
+        typedef typename PackedBlock<Scalar_>::column_t column_t;
+        const Scalar_ epsilon4thRoot = std::pow(std::numeric_limits<Scalar_>::epsilon(), Scalar_(0.25));
+        const column_t theta = (a.col(0).square() + a.col(1).square() + a.col(2).square()).sqrt();
+        const column_t halfTheta = Scalar_(0.5) * theta;
+        // na is 1/theta sin(theta/2), with its series below the 4th root of epsilon
+        const column_t na = (theta < epsilon4thRoot).select(Scalar_(0.5) - theta.square() * Scalar_(1.0/48.0),
+                                                            halfTheta.sin() / theta);
+        q0 = a.col(0) * na;
+        q1 = a.col(1) * na;
+        q2 = a.col(2) * na;
+        q3 = halfTheta.cos();
+      }
+    } // namespace detail
+
+    /// \brief qplus(q, p) for every row of q and p.
+    template <typename Scalar_>
+    void qplusPacked(Eigen::Array<Scalar_, Eigen::Dynamic, 4> const & q,
+                     Eigen::Array<Scalar_, Eigen::Dynamic, 4> const & p,
+                     Eigen::Array<Scalar_, Eigen::Dynamic, 4> & out)
+    {
+      SM_ASSERT_EQ(std::runtime_error, q.rows(), p.rows(), "The batches must have the same size");
+      const Eigen::Index n = q.rows();
+      out.resize(n, 4);
+      for(Eigen::Index i = 0; i < n; i += detail::kPackedBlockSize)
+      {
+        const Eigen::Index m = std::min(detail::kPackedBlockSize, n - i);
+        detail::qplusBlock<Scalar_>(q.col(0).segment(i, m), q.col(1).segment(i, m), q.col(2).segment(i, m), q.col(3).segment(i, m),
+                                    p.col(0).segment(i, m), p.col(1).segment(i, m), p.col(2).segment(i, m), p.col(3).segment(i, m),
+                                    out.middleRows(i, m));
+      }
+    }
+
+    /// \brief quatRotate(q_a_b, v_b) for every row of q_a_b and v_b.
+    template <typename Scalar_>
+    void quatRotatePacked(Eigen::Array<Scalar_, Eigen::Dynamic, 4> const & q_a_b,
+                          Eigen::Array<Scalar_, Eigen::Dynamic, 3> const & v_b,
+                          Eigen::Array<Scalar_, Eigen::Dynamic, 3> & out)
+    {
+      typedef typename detail::PackedBlock<Scalar_>::column_t column_t;
+      SM_ASSERT_EQ(std::runtime_error, q_a_b.rows(), v_b.rows(), "The batches must have the same size");
+      const Eigen::Index n = q_a_b.rows();
+      out.resize(n, 3);
+      for(Eigen::Index i = 0; i < n; i += detail::kPackedBlockSize)
+      {
+        const Eigen::Index m = std::min(detail::kPackedBlockSize, n - i);
+        const column_t q0 = q_a_b.col(0).segment(i, m), q1 = q_a_b.col(1).segment(i, m), q2 = q_a_b.col(2).segment(i, m), q3 = q_a_b.col(3).segment(i, m);
+        const column_t v0 = v_b.col(0).segment(i, m), v1 = v_b.col(1).segment(i, m), v2 = v_b.col(2).segment(i, m);
+        // u = eps x v - eta v, then v + 2 eps x u
+        const column_t u0 = q1*v2 - q2*v1 - q3*v0;
+        const column_t u1 = q2*v0 - q0*v2 - q3*v1;
+        const column_t u2 = q0*v1 - q1*v0 - q3*v2;
+        out.col(0).segment(i, m) = v0 + Scalar_(2) * (q1*u2 - q2*u1);
+        out.col(1).segment(i, m) = v1 + Scalar_(2) * (q2*u0 - q0*u2);
+        out.col(2).segment(i, m) = v2 + Scalar_(2) * (q0*u1 - q1*u0);
+      }
+    }
+
+    /// \brief axisAngle2quat(a) for every row of a.
+    template <typename Scalar_>
+    void axisAngle2quatPacked(Eigen::Array<Scalar_, Eigen::Dynamic, 3> const & a,
+                              Eigen::Array<Scalar_, Eigen::Dynamic, 4> & out)
+    {
+      typedef typename detail::PackedBlock<Scalar_>::column_t column_t;
+      const Eigen::Index n = a.rows();
+      out.resize(n, 4);
+      column_t q0, q1, q2, q3;
+      for(Eigen::Index i = 0; i < n; i += detail::kPackedBlockSize)
+      {
+        const Eigen::Index m = std::min(detail::kPackedBlockSize, n - i);
+        detail::axisAngle2quatBlock<Scalar_>(a.middleRows(i, m), q0, q1, q2, q3);
+        out.col(0).segment(i, m) = q0;
+        out.col(1).segment(i, m) = q1;
+        out.col(2).segment(i, m) = q2;
+        out.col(3).segment(i, m) = q3;
+      }
+    }
+
+    /// \brief updateQuat(q, dq) for every row of q and dq.
+    template <typename Scalar_>
+    void updateQuatPacked(Eigen::Array<Scalar_, Eigen::Dynamic, 4> const & q,
+                          Eigen::Array<Scalar_, Eigen::Dynamic, 3> const & dq,
+                          Eigen::Array<Scalar_, Eigen::Dynamic, 4> & out)
+    {
+      typedef typename detail::PackedBlock<Scalar_>::column_t column_t;
+      SM_ASSERT_EQ(std::runtime_error, q.rows(), dq.rows(), "The batches must have the same size");
+      const Eigen::Index n = q.rows();
+      out.resize(n, 4);
+      column_t d0, d1, d2, d3;
+      for(Eigen::Index i = 0; i < n; i += detail::kPackedBlockSize)
+      {
+        const Eigen::Index m = std::min(detail::kPackedBlockSize, n - i);
+        detail::axisAngle2quatBlock<Scalar_>(dq.middleRows(i, m), d0, d1, d2, d3);
+        detail::qplusBlock<Scalar_>(d0, d1, d2, d3,
+                                    q.col(0).segment(i, m), q.col(1).segment(i, m), q.col(2).segment(i, m), q.col(3).segment(i, m),
+                                    out.middleRows(i, m));
+      }
+    }
+
+    /// \brief scale every row of q to unit length.
+    template <typename Scalar_>
+    void normalizeQuatPacked(Eigen::Array<Scalar_, Eigen::Dynamic, 4> & q)
+    {
+      q.colwise() *= (q.col(0).square() + q.col(1).square() + q.col(2).square() + q.col(3).square()).rsqrt();
+    }
+
+}} // namespace sm::kinematics
+
+#endif /* SM_PACKED_QUATERNION_ALGEBRA_HPP */
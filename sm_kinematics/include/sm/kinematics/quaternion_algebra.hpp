@@ -15,10 +15,26 @@
 
 namespace sm { namespace kinematics {
     
-    Eigen::Matrix3d quat2r(Eigen::Vector4d const & q);
-    Eigen::Vector4d r2quat(Eigen::Matrix3d const & C);
-    Eigen::Vector4d r2quat(Eigen::Matrix3d const & C);
-    Eigen::Vector4d axisAngle2quat(Eigen::Vector3d const & a);
+    // The core of the algebra is defined inline for any scalar type in
+    // implementation/quaternion_algebra.hpp. The double versions below
+    // forward to it, so that existing callers that pass Eigen expressions
+    // keep working.
+    template <typename Scalar_> Eigen::Matrix<Scalar_, 3, 3> quat2r(Eigen::Matrix<Scalar_, 4, 1> const & q);
+    template <typename Scalar_> Eigen::Matrix<Scalar_, 4, 1> r2quat(Eigen::Matrix<Scalar_, 3, 3> const & C);
+    template <typename Scalar_> Eigen::Matrix<Scalar_, 4, 1> axisAngle2quat(Eigen::Matrix<Scalar_, 3, 1> const & a);
+    template <typename Scalar_> Eigen::Matrix<Scalar_, 4, 4> quatPlus(Eigen::Matrix<Scalar_, 4, 1> const & q);
+    template <typename Scalar_> Eigen::Matrix<Scalar_, 4, 1> qplus(Eigen::Matrix<Scalar_, 4, 1> const & q, Eigen::Matrix<Scalar_, 4, 1> const & p);
+    template <typename Scalar_> Eigen::Matrix<Scalar_, 4, 4> quatOPlus(Eigen::Matrix<Scalar_, 4, 1> const & q);
+    template <typename Scalar_> Eigen::Matrix<Scalar_, 4, 1> qoplus(Eigen::Matrix<Scalar_, 4, 1> const & q, Eigen::Matrix<Scalar_, 4, 1> const & p);
+    template <typename Scalar_> Eigen::Matrix<Scalar_, 4, 1> quatInv(Eigen::Matrix<Scalar_, 4, 1> const & q);
+    template <typename Scalar_> Eigen::Matrix<Scalar_, 3, 1> quatRotate(Eigen::Matrix<Scalar_, 4, 1> const & q_a_b, Eigen::Matrix<Scalar_, 3, 1> const & v_b);
+    template <typename Scalar_> Eigen::Matrix<Scalar_, 4, 1> quatIdentity();
+    template <typename Scalar_> Eigen::Matrix<Scalar_, 4, 1> updateQuat(Eigen::Matrix<Scalar_, 4, 1> const & q, Eigen::Matrix<Scalar_, 3, 1> const & dq);
+    template <typename Scalar_> Eigen::Matrix<Scalar_, 4, 1> qslerp(Eigen::Matrix<Scalar_, 4, 1> const & q0, Eigen::Matrix<Scalar_, 4, 1> const & q1, Scalar_ t);
+
+    inline Eigen::Matrix3d quat2r(Eigen::Vector4d const & q) { return quat2r<double>(q); }
+    inline Eigen::Vector4d r2quat(Eigen::Matrix3d const & C) { return r2quat<double>(C); }
+    inline Eigen::Vector4d axisAngle2quat(Eigen::Vector3d const & a) { return axisAngle2quat<double>(a); }
 
     template <typename Scalar_>
     Eigen::Matrix<Scalar_, 3, 1> quat2AxisAngle(Eigen::Matrix<Scalar_, 4, 1> const & q);
@@ -26,20 +42,20 @@ namespace sm { namespace kinematics {
     extern template Eigen::Matrix<float, 3, 1> quat2AxisAngle(Eigen::Matrix<float, 4, 1> const & q);
     inline Eigen::Vector3d quat2AxisAngle(Eigen::Vector4d const & q) { return quat2AxisAngle<>(q); }
 
-    Eigen::Matrix4d quatPlus(Eigen::Vector4d const & q);
-    Eigen::Vector4d qplus(Eigen::Vector4d const & q, Eigen::Vector4d const & p);
-    Eigen::Matrix4d quatOPlus(Eigen::Vector4d const & q);
-    Eigen::Vector4d qoplus(Eigen::Vector4d const & q, Eigen::Vector4d const & p);
-    Eigen::Vector4d quatInv(Eigen::Vector4d const & q);
-    Eigen::Vector3d quatRotate(Eigen::Vector4d const & q_a_b, Eigen::Vector3d const & v_b);
+    inline Eigen::Matrix4d quatPlus(Eigen::Vector4d const & q) { return quatPlus<double>(q); }
+    inline Eigen::Vector4d qplus(Eigen::Vector4d const & q, Eigen::Vector4d const & p) { return qplus<double>(q, p); }
+    inline Eigen::Matrix4d quatOPlus(Eigen::Vector4d const & q) { return quatOPlus<double>(q); }
+    inline Eigen::Vector4d qoplus(Eigen::Vector4d const & q, Eigen::Vector4d const & p) { return qoplus<double>(q, p); }
+    inline Eigen::Vector4d quatInv(Eigen::Vector4d const & q) { return quatInv<double>(q); }
+    inline Eigen::Vector3d quatRotate(Eigen::Vector4d const & q_a_b, Eigen::Vector3d const & v_b) { return quatRotate<double>(q_a_b, v_b); }
     Eigen::Vector4d quatRandom();
-    Eigen::Vector4d quatIdentity();
+    inline Eigen::Vector4d quatIdentity() { return quatIdentity<double>(); }
     void invertQuat(Eigen::Vector4d & q);
     Eigen::Vector3d qeps(Eigen::Vector4d const & q);
     double qeta(Eigen::Vector4d const & q);
     // For estimation functions to handle a constraint-sensitive minimal parameterization for a quaternion update
     Eigen::Matrix<double,4,3> quatJacobian(Eigen::Vector4d const & q);
-    Eigen::Vector4d updateQuat(Eigen::Vector4d const & q, Eigen::Vector3d const & dq);
+    inline Eigen::Vector4d updateQuat(Eigen::Vector4d const & q, Eigen::Vector3d const & dq) { return updateQuat<double>(q, dq); }
     Eigen::Matrix<double,3,4> quatS(Eigen::Vector4d q);
     Eigen::Matrix<double,4,3> quatInvS(Eigen::Vector4d q);
 
@@ -47,7 +63,7 @@ namespace sm { namespace kinematics {
    inline Eigen::Vector4d qexp(const Eigen::Vector3d & theta){ return axisAngle2quat(theta); }
 
    /// \brief do spherical linear interpolation between q0 and q1 for times t = [0.0,1.0]
-   Eigen::Vector4d qslerp(const Eigen::Vector4d & q0, const Eigen::Vector4d & q1, double t);
+   inline Eigen::Vector4d qslerp(const Eigen::Vector4d & q0, const Eigen::Vector4d & q1, double t) { return qslerp<double>(q0, q1, t); }
 
    /// \brief do linear interpolation between p0 and p1 for times t = [0.0,1.0]
    Eigen::VectorXd lerp(const Eigen::VectorXd & p0, const Eigen::VectorXd & p1, double t);
@@ -85,6 +101,6 @@ namespace sm { namespace kinematics {
    extern template Eigen::Matrix<float, 3, 3> expDiffMat(const Eigen::Matrix<float, 3, 1> & vec);
 }} // namespace sm::kinematics
 
-
+#include "implementation/quaternion_algebra.hpp"
 
 #endif /* SM_QUATERNION_ALGEBRA_HPP */
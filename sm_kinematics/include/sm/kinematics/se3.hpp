@@ -0,0 +1,220 @@
+/**
+ * @file   se3.hpp
+ *
+ * @brief  Exponential and logarithmic maps of SO(3) and SE(3) together with
+ *         their left and right Jacobians.
+ *
+ * The maps follow the conventions of quaternion_algebra.hpp and
+ * transformations.hpp:
+ *
+ *  - so3::exp(phi) == quat2r(axisAngle2quat(phi)) == I - a phi^ + b phi^ phi^
+ *    with phi^ = crossMx(phi).
+ *  - so3::Jl(phi) == expDiffMat(phi) and so3::JlInverse(phi) == logDiffMat(phi):
+ *    exp(phi + dphi) ~= exp(Jl(phi) dphi) exp(phi).
+ *  - An SE(3) tangent vector xi = [rho; phi] has the translational part first,
+ *    as in Transformation::oplus(), and
+ *    se3::exp(xi) = [exp(phi), Jl(phi) rho; 0, 1].
+ *  - se3::adjoint(T) == boxTimes(T), such that
+ *    exp(adjoint(T) xi) == T exp(xi) T^-1.
+ *
+ * All trigonometric terms of a tangent vector are computed once by
+ * so3::Kernel and se3::Kernel, so that exp() and the Jacobians of the same
+ * vector share them. The free functions are shortcuts for a single
+ * quantity.
+ */
+
+#ifndef SM_KINEMATICS_SE3_HPP
+#define SM_KINEMATICS_SE3_HPP
+
+#include <Eigen/Core>
+
+namespace sm { namespace kinematics {
+
+    namespace so3 {
+
+      ///
+      /// @class Kernel
+      /// @brief the coefficients of the exponential map of SO(3) and of its
+      ///        Jacobians for one rotation vector phi.
+      ///
+      /// For theta = |phi| below a small angle threshold the coefficients are
+      /// evaluated by their Taylor series, so that they are exact to rounding
+      /// and no trigonometric function is called.
+      ///
+      template <typename Scalar_>
+      class Kernel
+      {
+      public:
+        EIGEN_MAKE_ALIGNED_OPERATOR_NEW
+
+        typedef Eigen::Matrix<Scalar_, 3, 1> Vector3;
+        typedef Eigen::Matrix<Scalar_, 3, 3> Matrix3;
+        typedef Eigen::Matrix<Scalar_, 4, 1> Vector4;
+
+        explicit Kernel(const Vector3 & phi);
+
+        /// @return quat2r(axisAngle2quat(phi))
+        Matrix3 exp() const;
+
+        /// @return axisAngle2quat(phi)
+        Vector4 quaternion() const;
+
+        /// \brief the left Jacobian, exp(phi + dphi) ~= exp(Jl() dphi) exp(phi).
+        Matrix3 Jl() const;
+
+        /// \brief the right Jacobian, exp(phi + dphi) ~= exp(phi) exp(Jr() dphi).
+        Matrix3 Jr() const;
+
+        Matrix3 JlInverse() const;
+
+        Matrix3 JrInverse() const;
+
+        const Vector3 & phi() const { return _phi; }
+
+        /// @return phi^
+        const Matrix3 & phiCross() const { return _phiCross; }
+
+        /// @return phi^ phi^
+        const Matrix3 & phiCross2() const { return _phiCross2; }
+
+        /// @return |phi|
+        Scalar_ theta() const { return _theta; }
+
+        /// @return sin(theta) / theta
+        Scalar_ a() const { return _a; }
+
+        /// @return (1 - cos(theta)) / theta^2
+        Scalar_ b() const { return _b; }
+
+        /// @return (theta - sin(theta)) / theta^3
+        Scalar_ c() const { return _c; }
+
+        /// @return (1 - theta/2 cot(theta/2)) / theta^2
+        Scalar_ d() const { return _d; }
+
+      private:
+        Vector3 _phi;
+        Matrix3 _phiCross;
+        Matrix3 _phiCross2;
+        Scalar_ _theta;
+        Scalar_ _a;
+        Scalar_ _b;
+        Scalar_ _c;
+        Scalar_ _d;
+        /// sin(theta/2) / theta
+        Scalar_ _halfSinc;
+        /// cos(theta/2)
+        Scalar_ _halfCos;
+      };
+
+      template <typename Scalar_>
+      Eigen::Matrix<Scalar_, 3, 3> exp(const Eigen::Matrix<Scalar_, 3, 1> & phi);
+
+      /// \brief the rotation vector of C with |phi| <= pi.
+      template <typename Scalar_>
+      Eigen::Matrix<Scalar_, 3, 1> log(const Eigen::Matrix<Scalar_, 3, 3> & C);
+
+      /// \brief the rotation vector of the unit quaternion q with |phi| <= pi.
+      template <typename Scalar_>
+      Eigen::Matrix<Scalar_, 3, 1> logQuaternion(const Eigen::Matrix<Scalar_, 4, 1> & q);
+
+      template <typename Scalar_>
+      Eigen::Matrix<Scalar_, 3, 3> Jl(const Eigen::Matrix<Scalar_, 3, 1> & phi);
+
+      template <typename Scalar_>
+      Eigen::Matrix<Scalar_, 3, 3> Jr(const Eigen::Matrix<Scalar_, 3, 1> & phi);
+
+      template <typename Scalar_>
+      Eigen::Matrix<Scalar_, 3, 3> JlInverse(const Eigen::Matrix<Scalar_, 3, 1> & phi);
+
+      template <typename Scalar_>
+      Eigen::Matrix<Scalar_, 3, 3> JrInverse(const Eigen::Matrix<Scalar_, 3, 1> & phi);
+
+    } // namespace so3
+
+    namespace se3 {
+
+      ///
+      /// @class Kernel
+      /// @brief the exponential map of SE(3) and its Jacobians for one
+      ///        tangent vector xi = [rho; phi].
+      ///
+      /// The 6x6 left Jacobian is [J, -Q; 0, J] with J = so3::Jl(phi) and Q
+      /// the coupling term of Barfoot and Furgale, "Associating Uncertainty
+      /// With Three-Dimensional Poses for Use in Estimation Problems", IEEE
+      /// TRO 2014, written in the rotation convention of this library. Q is
+      /// only computed by the functions that need it.
+      ///
+      template <typename Scalar_>
+      class Kernel
+      {
+      public:
+        EIGEN_MAKE_ALIGNED_OPERATOR_NEW
+
+        typedef Eigen::Matrix<Scalar_, 3, 1> Vector3;
+        typedef Eigen::Matrix<Scalar_, 6, 1> Vector6;
+        typedef Eigen::Matrix<Scalar_, 3, 3> Matrix3;
+        typedef Eigen::Matrix<Scalar_, 4, 4> Matrix4;
+        typedef Eigen::Matrix<Scalar_, 6, 6> Matrix6;
+
+        explicit Kernel(const Vector6 & xi);
+
+        /// @return the transformation matrix [so3::exp(phi), so3::Jl(phi) rho; 0, 1]
+        Matrix4 exp() const;
+
+        /// @return the translation so3::Jl(phi) rho of exp()
+        Vector3 translation() const;
+
+        /// \brief the left Jacobian, exp(xi + dxi) ~= exp(Jl() dxi) exp(xi).
+        Matrix6 Jl() const;
+
+        /// \brief the right Jacobian, exp(xi + dxi) ~= exp(xi) exp(Jr() dxi).
+        Matrix6 Jr() const;
+
+        Matrix6 JlInverse() const;
+
+        Matrix6 JrInverse() const;
+
+        /// \brief the rotational part of the kernel.
+        const so3::Kernel<Scalar_> & rotation() const { return _rotation; }
+
+        const Vector3 & rho() const { return _rho; }
+
+      private:
+        /// \brief the coupling terms of the left and the right Jacobian.
+        void Q(Matrix3 * out_Ql, Matrix3 * out_Qr) const;
+
+        so3::Kernel<Scalar_> _rotation;
+        Vector3 _rho;
+      };
+
+      template <typename Scalar_>
+      Eigen::Matrix<Scalar_, 4, 4> exp(const Eigen::Matrix<Scalar_, 6, 1> & xi);
+
+      /// \brief the tangent vector [rho; phi] of T with |phi| <= pi.
+      template <typename Scalar_>
+      Eigen::Matrix<Scalar_, 6, 1> log(const Eigen::Matrix<Scalar_, 4, 4> & T);
+
+      template <typename Scalar_>
+      Eigen::Matrix<Scalar_, 6, 6> Jl(const Eigen::Matrix<Scalar_, 6, 1> & xi);
+
+      template <typename Scalar_>
+      Eigen::Matrix<Scalar_, 6, 6> Jr(const Eigen::Matrix<Scalar_, 6, 1> & xi);
+
+      template <typename Scalar_>
+      Eigen::Matrix<Scalar_, 6, 6> JlInverse(const Eigen::Matrix<Scalar_, 6, 1> & xi);
+
+      template <typename Scalar_>
+      Eigen::Matrix<Scalar_, 6, 6> JrInverse(const Eigen::Matrix<Scalar_, 6, 1> & xi);
+
+      /// @return the adjoint [C, -t^ C; 0, C] of T = [C, t; 0, 1], the same as boxTimes(T).
+      template <typename Scalar_>
+      Eigen::Matrix<Scalar_, 6, 6> adjoint(const Eigen::Matrix<Scalar_, 4, 4> & T);
+
+    } // namespace se3
+
+}} // namespace sm::kinematics
+
+#include "implementation/se3.hpp"
+
+#endif /* SM_KINEMATICS_SE3_HPP */
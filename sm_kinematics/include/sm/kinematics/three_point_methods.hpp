@@ -40,8 +40,29 @@ namespace sm { namespace kinematics {
      * @return the 3x3 transformation matrix that is the best fit rotation \f$p_0 = \mathbf C_{0,1} p_1\f$ between the two point sets.
      */
     Eigen::Matrix3d qMethod(Eigen::MatrixXd const & p0, Eigen::MatrixXd const & p1);
-    
+
+    // The versions below are defined inline in
+    // implementation/three_point_methods.hpp. They take fixed-size inputs
+    // and Eigen expressions without copying them and do not allocate, which
+    // makes them the kernels of choice for the minimal problems in a RANSAC
+    // loop, e.g. threePointSvd(Eigen::Matrix3d, Eigen::Matrix3d). The
+    // Eigen::MatrixXd versions above forward to them.
+
+    /// \brief threePointSvd() for 3xK inputs of any type.
+    template<typename Derived0_, typename Derived1_>
+    Eigen::Matrix4d threePointSvd(const Eigen::MatrixBase<Derived0_> & p0, const Eigen::MatrixBase<Derived1_> & p1);
+
+    /// \brief qMethod() for 3xK inputs and a weight vector of any type.
+    template<typename Derived0_, typename Derived1_, typename DerivedW_>
+    Eigen::Matrix3d qMethod(const Eigen::MatrixBase<Derived0_> & p0, const Eigen::MatrixBase<Derived1_> & p1, const Eigen::MatrixBase<DerivedW_> & w);
+
+    /// \brief qMethod() for 3xK inputs of any type, all weighted equally.
+    template<typename Derived0_, typename Derived1_>
+    Eigen::Matrix3d qMethod(const Eigen::MatrixBase<Derived0_> & p0, const Eigen::MatrixBase<Derived1_> & p1);
+
 
   }} // namespace sm::kinematics
 
+#include "implementation/three_point_methods.hpp"
+
 #endif /* SM_THREE_POINT_METHODS */
@@ -0,0 +1,80 @@
+#ifndef SM_THREE_POINT_RANSAC
+#define SM_THREE_POINT_RANSAC
+
+#include <Eigen/Core>
+#include <vector>
+
+namespace sm { namespace kinematics {
+
+    /// \brief the settings of threePointSvdRansac() and qMethodRansac().
+    struct RansacOptions
+    {
+      RansacOptions();
+
+      /// A pair is an inlier if its residual norm is below this threshold.
+      double inlierThreshold;
+      /// The probability to draw at least one all-inlier sample. It bounds
+      /// the iterations adaptively from the best inlier ratio found so far.
+      double confidence;
+      /// The upper bound of the number of hypotheses.
+      int maxIterations;
+      /// Refit to the inliers of every new best hypothesis (LO-RANSAC).
+      bool localOptimization;
+      /// The maximum number of refits per local optimization.
+      int localOptimizationIterations;
+      /// The hypotheses are spread over this many threads.
+      int numThreads;
+      /// The seed of the sampling. With one thread the result is repeatable.
+      unsigned int seed;
+    };
+
+    /// \brief the outcome of a RANSAC run.
+    struct RansacResult
+    {
+      RansacResult();
+
+      /// The indices of the inlier pairs of the returned model, in increasing order.
+      std::vector<int> inliers;
+      /// The number of hypotheses that were drawn.
+      int iterations;
+      /// The number of local optimization refits.
+      int refits;
+    };
+
+    /**
+     * Robustly compute the transformation between two sets of points with
+     * RANSAC on the minimal three-point SVD problem.
+     *
+     * The residual of a pair is \f$\| p_0 - \mathbf T_{0,1} p_1 \|\f$. It is
+     * scored for blocks of pairs at once, and a hypothesis is abandoned as
+     * soon as it can no longer beat the best one.
+     *
+     * @param p0 a 3xK matrix where each column is a point expressed in frame zero
+     * @param p1 a 3xK matrix where each column is a point expressed in frame one
+     * @param options the RANSAC settings
+     * @param out_result the inliers and statistics of the run, may be NULL
+     * @return the 4x4 transformation matrix \f$\mathbf T_{0,1}\f$ with the most inliers, refit to all of them.
+     */
+    Eigen::Matrix4d threePointSvdRansac(const Eigen::Matrix3Xd & p0, const Eigen::Matrix3Xd & p1,
+                                        const RansacOptions & options = RansacOptions(),
+                                        RansacResult * out_result = NULL);
+
+    /**
+     * Robustly compute the rotation between two sets of unit vectors with
+     * RANSAC on the minimal two-vector q-method problem.
+     *
+     * The residual of a pair is \f$\| p_0 - \mathbf C_{0,1} p_1 \|\f$.
+     *
+     * @param p0 a 3xK matrix where each column is a unit vector expressed in frame zero
+     * @param p1 a 3xK matrix where each column is a unit vector expressed in frame one
+     * @param options the RANSAC settings
+     * @param out_result the inliers and statistics of the run, may be NULL
+     * @return the 3x3 rotation matrix \f$\mathbf C_{0,1}\f$ with the most inliers, refit to all of them.
+     */
+    Eigen::Matrix3d qMethodRansac(const Eigen::Matrix3Xd & p0, const Eigen::Matrix3Xd & p1,
+                                  const RansacOptions & options = RansacOptions(),
+                                  RansacResult * out_result = NULL);
+
+  }} // namespace sm::kinematics
+
+#endif /* SM_THREE_POINT_RANSAC */
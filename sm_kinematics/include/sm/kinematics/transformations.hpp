@@ -172,6 +172,22 @@ namespace sm { namespace kinematics {
      */
     Eigen::Matrix<double,6,6> boxTimes(Eigen::Matrix4d const & T_ba);
 
+    /** 
+     * Compute \f$ \mathbf T_{ba}^\boxtimes \mathbf U \mathbf T_{ba}^{\boxtimes^T} \f$ for a symmetric
+     * \f$6 \times 6\f$ covariance \f$ \mathbf U \f$ without forming \f$ \mathbf T_{ba}^\boxtimes \f$.
+     *
+     * The product is split into the rotation of the 3x3 blocks of \f$ \mathbf U \f$ and the
+     * shear by the translation, and only the upper blocks of the symmetric result are computed.
+     * out_U may be the same matrix as U.
+     * 
+     * @param C_ba  The rotation matrix of \f$ \mathbf T_{ba} \f$
+     * @param rho_b_ab The translation of \f$ \mathbf T_{ba} \f$
+     * @param U     The covariance to transform
+     * @param out_U Output: the transformed covariance
+     */
+    void boxTimesCovariance(Eigen::Matrix3d const & C_ba, Eigen::Vector3d const & rho_b_ab,
+                            Eigen::Matrix<double,6,6> const & U, Eigen::Matrix<double,6,6> & out_U);
+
 
 
     // inline void transformationBMatrix(VEC_T const & v, MX_T & out_B)
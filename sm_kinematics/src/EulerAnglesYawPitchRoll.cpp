@@ -98,4 +98,35 @@ namespace sm { namespace kinematics {
 
 
 
+    void EulerAnglesYawPitchRoll::parametersToRotationMatricesBlock(const Eigen::Ref<const Eigen::Matrix3Xd> & parameters, Eigen::Ref<RotationMatrices> out_C) const
+    {
+      // The matrix of parametersToRotationMatrix() as array expressions
+      // over the block.
+      const BlockArray cx = parameters.row(2).array().cos();
+      const BlockArray sx = parameters.row(2).array().sin();
+      const BlockArray cy = parameters.row(1).array().cos();
+      const BlockArray sy = parameters.row(1).array().sin();
+      const BlockArray cz = parameters.row(0).array().cos();
+      const BlockArray sz = parameters.row(0).array().sin();
+      // column-major rows: C(0,0), C(1,0), C(2,0), C(0,1), ...
+      out_C.row(0).array() = cz*cy;
+      out_C.row(1).array() = sz*cy;
+      out_C.row(2).array() = -sy;
+      out_C.row(3).array() = -sz*cx + cz*sy*sx;
+      out_C.row(4).array() = cz*cx + sz*sy*sx;
+      out_C.row(5).array() = cy*sx;
+      out_C.row(6).array() = sz*sx + cz*sy*cx;
+      out_C.row(7).array() = -cz*sx + sz*sy*cx;
+      out_C.row(8).array() = cy*cx;
+    }
+
+    void EulerAnglesYawPitchRoll::rotationMatricesToParametersBlock(const Eigen::Ref<const RotationMatrices> & C, Eigen::Ref<Eigen::Matrix3Xd> out_parameters) const
+    {
+      for(Eigen::Index i = 0; i < C.cols(); ++i)
+      {
+        out_parameters.col(i) = EulerAnglesYawPitchRoll::rotationMatrixToParameters(Eigen::Map<const Eigen::Matrix3d>(C.col(i).data()));
+      }
+    }
+
+
   }} // sm::kinematics
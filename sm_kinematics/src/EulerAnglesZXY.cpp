@@ -105,5 +105,35 @@ namespace sm {
       return S * pdot;
     }
 
+    void EulerAnglesZXY::parametersToRotationMatricesBlock(
+        const Eigen::Ref<const Eigen::Matrix3Xd>& parameters,
+        Eigen::Ref<RotationMatrices> out_C) const {
+      const BlockArray cx = parameters.row(1).array().cos();
+      const BlockArray sx = parameters.row(1).array().sin();
+      const BlockArray cy = parameters.row(2).array().cos();
+      const BlockArray sy = parameters.row(2).array().sin();
+      const BlockArray cz = parameters.row(0).array().cos();
+      const BlockArray sz = parameters.row(0).array().sin();
+      // column-major rows: C(0,0), C(1,0), C(2,0), C(0,1), ...
+      out_C.row(0).array() = cz * cy - sz * sx * sy;
+      out_C.row(1).array() = sz * cy + cz * sx * sy;
+      out_C.row(2).array() = -cx * sy;
+      out_C.row(3).array() = -sz * cx;
+      out_C.row(4).array() = cz * cx;
+      out_C.row(5).array() = sx;
+      out_C.row(6).array() = cz * sy + sz * sx * cy;
+      out_C.row(7).array() = sz * sy - cz * sx * cy;
+      out_C.row(8).array() = cx * cy;
+    }
+
+    void EulerAnglesZXY::rotationMatricesToParametersBlock(
+        const Eigen::Ref<const RotationMatrices>& C,
+        Eigen::Ref<Eigen::Matrix3Xd> out_parameters) const {
+      for (Eigen::Index i = 0; i < C.cols(); ++i)
+        out_parameters.col(i) = EulerAnglesZXY::rotationMatrixToParameters(
+          Eigen::Map<const Eigen::Matrix3d>(C.col(i).data()));
+    }
+
+
   }
 }
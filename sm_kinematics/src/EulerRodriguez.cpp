@@ -87,4 +87,35 @@ namespace sm { namespace kinematics {
 
 
 
+    void EulerRodriguez::parametersToRotationMatricesBlock(const Eigen::Ref<const Eigen::Matrix3Xd> & parameters, Eigen::Ref<RotationMatrices> out_C) const
+    {
+      // With crossp * crossp = p p^T - |p|^2 I the matrix of
+      // parametersToRotationMatrix() is I + k (p p^T - |p|^2 I - crossp).
+      const BlockArray x = parameters.row(0).array();
+      const BlockArray y = parameters.row(1).array();
+      const BlockArray z = parameters.row(2).array();
+      const BlockArray n = x*x + y*y + z*z;
+      const BlockArray k = 2.0 / (1.0 + n);
+
+      // column-major rows: C(0,0), C(1,0), C(2,0), C(0,1), ...
+      out_C.row(0).array() = 1.0 + k*(x*x - n);
+      out_C.row(1).array() = k*(x*y - z);
+      out_C.row(2).array() = k*(x*z + y);
+      out_C.row(3).array() = k*(x*y + z);
+      out_C.row(4).array() = 1.0 + k*(y*y - n);
+      out_C.row(5).array() = k*(y*z - x);
+      out_C.row(6).array() = k*(x*z - y);
+      out_C.row(7).array() = k*(y*z + x);
+      out_C.row(8).array() = 1.0 + k*(z*z - n);
+    }
+
+    void EulerRodriguez::rotationMatricesToParametersBlock(const Eigen::Ref<const RotationMatrices> & C, Eigen::Ref<Eigen::Matrix3Xd> out_parameters) const
+    {
+      for(Eigen::Index i = 0; i < C.cols(); ++i)
+      {
+        out_parameters.col(i) = EulerRodriguez::rotationMatrixToParameters(Eigen::Map<const Eigen::Matrix3d>(C.col(i).data()));
+      }
+    }
+
+
   }} // sm::kinematics
@@ -201,4 +201,46 @@ namespace sm { namespace kinematics {
         }
 
 
+        void RotationVector::parametersToRotationMatricesBlock(const Eigen::Ref<const Eigen::Matrix3Xd> & parameters, Eigen::Ref<RotationMatrices> out_C) const
+        {
+            // The matrix of parametersToRotationMatrix() as array expressions
+            // over the block. The small angles are set to identity after.
+            const BlockArray angle = parameters.colwise().norm().array();
+            const BlockArray recip_angle = (angle < 1e-14).select(BlockArray::Zero(angle.size()), angle.inverse());
+            const BlockArray ax = parameters.row(0).array() * recip_angle;
+            const BlockArray ay = parameters.row(1).array() * recip_angle;
+            const BlockArray az = parameters.row(2).array() * recip_angle;
+            const BlockArray sa = angle.sin();
+            const BlockArray ca = angle.cos();
+            const BlockArray ca1 = 1.0 - ca;
+
+            // column-major rows: C(0,0), C(1,0), C(2,0), C(0,1), ...
+            out_C.row(0).array() = ax*ax + ca*(1.0 - ax*ax);
+            out_C.row(1).array() = ax*ay*ca1 - sa*az;
+            out_C.row(2).array() = ax*az*ca1 + sa*ay;
+            out_C.row(3).array() = ax*ay*ca1 + sa*az;
+            out_C.row(4).array() = ay*ay + ca*(1.0 - ay*ay);
+            out_C.row(5).array() = ay*az*ca1 - sa*ax;
+            out_C.row(6).array() = ax*az*ca1 - sa*ay;
+            out_C.row(7).array() = ay*az*ca1 + sa*ax;
+            out_C.row(8).array() = az*az + ca*(1.0 - az*az);
+
+            for(Eigen::Index i = 0; i < angle.size(); ++i)
+            {
+                if(angle[i] < 1e-14)
+                {
+                    Eigen::Map<Eigen::Matrix3d>(out_C.col(i).data()).setIdentity();
+                }
+            }
+        }
+
+        void RotationVector::rotationMatricesToParametersBlock(const Eigen::Ref<const RotationMatrices> & C, Eigen::Ref<Eigen::Matrix3Xd> out_parameters) const
+        {
+            for(Eigen::Index i = 0; i < C.cols(); ++i)
+            {
+                out_parameters.col(i) = RotationVector::rotationMatrixToParameters(Eigen::Map<const Eigen::Matrix3d>(C.col(i).data()));
+            }
+        }
+
+
     }} // sm::kinematics
@@ -1,12 +1,41 @@
 #include <sm/kinematics/RotationalKinematics.hpp>
+#include <sm/kinematics/implementation/parallel_columns.hpp>
 
 namespace sm { namespace kinematics {
 
-
     RotationalKinematics::~RotationalKinematics()
     {
 
     }
 
+    void RotationalKinematics::parametersToRotationMatrices(const Eigen::Ref<const Eigen::Matrix3Xd> & parameters, Eigen::Ref<RotationMatrices> out_C, int numThreads) const
+    {
+      SM_ASSERT_EQ(Exception, parameters.cols(), out_C.cols(), "The input and output must have the same number of columns");
+      detail::forEachColumnBlock(parameters.cols(), numThreads, BlockSize,
+                                 [&](Eigen::Index begin, Eigen::Index n) { parametersToRotationMatricesBlock(parameters.middleCols(begin, n), out_C.middleCols(begin, n)); });
+    }
+
+    void RotationalKinematics::rotationMatricesToParameters(const Eigen::Ref<const RotationMatrices> & C, Eigen::Ref<Eigen::Matrix3Xd> out_parameters, int numThreads) const
+    {
+      SM_ASSERT_EQ(Exception, C.cols(), out_parameters.cols(), "The input and output must have the same number of columns");
+      detail::forEachColumnBlock(C.cols(), numThreads, BlockSize,
+                                 [&](Eigen::Index begin, Eigen::Index n) { rotationMatricesToParametersBlock(C.middleCols(begin, n), out_parameters.middleCols(begin, n)); });
+    }
+
+    void RotationalKinematics::parametersToRotationMatricesBlock(const Eigen::Ref<const Eigen::Matrix3Xd> & parameters, Eigen::Ref<RotationMatrices> out_C) const
+    {
+      for(Eigen::Index i = 0; i < parameters.cols(); ++i)
+      {
+        Eigen::Map<Eigen::Matrix3d>(out_C.col(i).data()) = parametersToRotationMatrix(parameters.col(i));
+      }
+    }
+
+    void RotationalKinematics::rotationMatricesToParametersBlock(const Eigen::Ref<const RotationMatrices> & C, Eigen::Ref<Eigen::Matrix3Xd> out_parameters) const
+    {
+      for(Eigen::Index i = 0; i < C.cols(); ++i)
+      {
+        out_parameters.col(i) = rotationMatrixToParameters(Eigen::Map<const Eigen::Matrix3d>(C.col(i).data()));
+      }
+    }
 
   }} // sm::kinematics
@@ -0,0 +1,292 @@
+#include <sm/kinematics/TrajectoryInterpolator.hpp>
+#include <sm/assert_macros.hpp>
+#include <algorithm>
+
+namespace sm {
+  namespace kinematics {
+
+    namespace {
+      // A forward walk over at most this many segments before a query falls
+      // back to the binary search.
+      const size_t kMaxWalk = 8;
+
+      // The rotation vector phi with q1 = axisAngle2quat(phi) (+) q0, on the
+      // shorter way around.
+      Eigen::Vector3d rotationBetween(const Eigen::Vector4d & q0, const Eigen::Vector4d & q1)
+      {
+        Eigen::Vector4d dq = qplus(q1, quatInv(q0));
+        if(dq[3] < 0.0)
+        {
+          dq = -dq;
+        }
+        return quat2AxisAngle(dq);
+      }
+    } // namespace
+
+    TrajectoryInterpolator::TrajectoryInterpolator(Method method) :
+      _method(method), _lastSegment(0)
+    {
+    }
+
+    TrajectoryInterpolator::TrajectoryInterpolator(const TrajectoryInterpolator & rhs) :
+      _method(rhs._method), _times(rhs._times), _poses(rhs._poses), _knots(rhs._knots),
+      _lastSegment(rhs._lastSegment.load(std::memory_order_relaxed))
+    {
+    }
+
+    TrajectoryInterpolator & TrajectoryInterpolator::operator=(const TrajectoryInterpolator & rhs)
+    {
+      _method = rhs._method;
+      _times = rhs._times;
+      _poses = rhs._poses;
+      _knots = rhs._knots;
+      _lastSegment.store(rhs._lastSegment.load(std::memory_order_relaxed), std::memory_order_relaxed);
+      return *this;
+    }
+
+    TrajectoryInterpolator::Method TrajectoryInterpolator::method() const
+    {
+      return _method;
+    }
+
+    void TrajectoryInterpolator::setMethod(Method method)
+    {
+      _method = method;
+    }
+
+    void TrajectoryInterpolator::addPose(sm::timing::NsecTime time, const Transformation & T_a_b)
+    {
+      if(!_times.empty())
+      {
+        SM_ASSERT_GT(std::runtime_error, time, _times.back(), "The poses must be added in strictly increasing time");
+      }
+      _times.push_back(time);
+      _poses.push_back(TransformationD(T_a_b));
+      _knots.push_back(Knot());
+      // The new pose is the next neighbour of the previous one, which
+      // changes the end of the two segments before it.
+      const size_t n = _times.size();
+      updateKnot(n - 1);
+      if(n > 1)
+      {
+        updateKnot(n - 2);
+        updateSegmentEnd(n - 2);
+      }
+      if(n > 2)
+      {
+        updateSegmentEnd(n - 3);
+      }
+    }
+
+    void TrajectoryInterpolator::setPoses(const std::vector<sm::timing::NsecTime> & times, const std::vector<Transformation> & poses)
+    {
+      SM_ASSERT_EQ(std::runtime_error, times.size(), poses.size(), "There must be one time per pose");
+      for(size_t i = 1; i < times.size(); ++i)
+      {
+        SM_ASSERT_GT(std::runtime_error, times[i], times[i-1], "The times must be strictly increasing, see index " << i);
+      }
+      _times = times;
+      _poses.resize(poses.size());
+      for(size_t i = 0; i < poses.size(); ++i)
+      {
+        _poses[i] = TransformationD(poses[i]);
+      }
+      _knots.resize(poses.size());
+      for(size_t i = 0; i < poses.size(); ++i)
+      {
+        updateKnot(i);
+      }
+      for(size_t i = 0; i + 1 < poses.size(); ++i)
+      {
+        updateSegmentEnd(i);
+      }
+      _lastSegment.store(0, std::memory_order_relaxed);
+    }
+
+    void TrajectoryInterpolator::clear()
+    {
+      _times.clear();
+      _poses.clear();
+      _knots.clear();
+      _lastSegment.store(0, std::memory_order_relaxed);
+    }
+
+    size_t TrajectoryInterpolator::size() const
+    {
+      return _times.size();
+    }
+
+    sm::timing::NsecTime TrajectoryInterpolator::minTime() const
+    {
+      SM_ASSERT_FALSE(std::runtime_error, _times.empty(), "The trajectory is empty");
+      return _times.front();
+    }
+
+    sm::timing::NsecTime TrajectoryInterpolator::maxTime() const
+    {
+      SM_ASSERT_FALSE(std::runtime_error, _times.empty(), "The trajectory is empty");
+      return _times.back();
+    }
+
+    const std::vector<sm::timing::NsecTime> & TrajectoryInterpolator::times() const
+    {
+      return _times;
+    }
+
+    const std::vector<TransformationD> & TrajectoryInterpolator::poses() const
+    {
+      return _poses;
+    }
+
+    Transformation TrajectoryInterpolator::getPose(sm::timing::NsecTime time) const
+    {
+      const size_t i = findSegment(time, _lastSegment.load(std::memory_order_relaxed));
+      _lastSegment.store(i, std::memory_order_relaxed);
+      TransformationD T_a_b;
+      interpolate(i, time, T_a_b);
+      return T_a_b.toTransformation();
+    }
+
+    void TrajectoryInterpolator::getPoses(const sm::timing::NsecTime * times, size_t n, TransformationD * out) const
+    {
+      size_t i = _lastSegment.load(std::memory_order_relaxed);
+      for(size_t k = 0; k < n; ++k)
+      {
+        i = findSegment(times[k], i);
+        interpolate(i, times[k], out[k]);
+      }
+      _lastSegment.store(i, std::memory_order_relaxed);
+    }
+
+    void TrajectoryInterpolator::getPoses(const std::vector<sm::timing::NsecTime> & times, std::vector<Transformation> & out_poses) const
+    {
+      std::vector<TransformationD> poses(times.size());
+      getPoses(times.data(), times.size(), poses.data());
+      out_poses.resize(times.size());
+      for(size_t k = 0; k < times.size(); ++k)
+      {
+        out_poses[k] = poses[k].toTransformation();
+      }
+    }
+
+    size_t TrajectoryInterpolator::findSegment(sm::timing::NsecTime time, size_t hint) const
+    {
+      SM_ASSERT_FALSE(std::runtime_error, _times.empty(), "The trajectory is empty");
+      SM_ASSERT_GE(std::runtime_error, time, _times.front(), "The time is before the trajectory");
+      SM_ASSERT_LE(std::runtime_error, time, _times.back(), "The time is after the trajectory");
+      if(_times.size() == 1)
+      {
+        return 0;
+      }
+      // Segment i spans [_times[i], _times[i+1]], the last one includes its end.
+      const size_t last = _times.size() - 2;
+      size_t i = std::min(hint, last);
+      std::vector<sm::timing::NsecTime>::const_iterator it;
+      if(time >= _times[i])
+      {
+        for(size_t k = 0; k < kMaxWalk; ++k, ++i)
+        {
+          if(i == last || time < _times[i+1])
+          {
+            return i;
+          }
+        }
+        it = std::upper_bound(_times.begin() + i + 1, _times.end(), time);
+      }
+      else
+      {
+        it = std::upper_bound(_times.begin(), _times.begin() + i + 1, time);
+      }
+      return std::min(static_cast<size_t>(it - _times.begin()) - 1, last);
+    }
+
+    void TrajectoryInterpolator::interpolate(size_t i, sm::timing::NsecTime time, TransformationD & out) const
+    {
+      if(_times.size() == 1)
+      {
+        out = _poses[0];
+        return;
+      }
+      const TransformationD & T0 = _poses[i];
+      const TransformationD & T1 = _poses[i+1];
+      // The integer differences are exact, the division is not.
+      const double h = static_cast<double>(_times[i+1] - _times[i]);
+      const double u = static_cast<double>(time - _times[i]) / h;
+      switch(_method)
+      {
+      case Slerp:
+        out.q() = qslerp(Eigen::Vector4d(T0.q()), Eigen::Vector4d(T1.q()), u);
+        out.t() = (1.0 - u) * T0.t() + u * T1.t();
+        break;
+      case Linear:
+        {
+          const double sign = T0.q().dot(T1.q()) < 0.0 ? -1.0 : 1.0;
+          out.q() = ((1.0 - u) * T0.q() + (sign * u) * T1.q()).normalized();
+          out.t() = (1.0 - u) * T0.t() + u * T1.t();
+        }
+        break;
+      case Cubic:
+        {
+          typedef Eigen::Map<const Eigen::Vector3d> ConstMap3;
+          const Knot & k0 = _knots[i];
+          const Knot & k1 = _knots[i+1];
+          // the cubic Hermite basis
+          const double u2 = u * u, u3 = u2 * u;
+          const double h00 = 2.0 * u3 - 3.0 * u2 + 1.0;
+          const double h10 = u3 - 2.0 * u2 + u;
+          const double h01 = -2.0 * u3 + 3.0 * u2;
+          const double h11 = u3 - u2;
+          // At the segment start the rotation vector is 0 and its rate is omega.
+          const Eigen::Vector3d phi = h01 * ConstMap3(k0.dphi) + h * (h10 * ConstMap3(k0.omega) + h11 * ConstMap3(k0.dphiRateEnd));
+          out.q() = qplus(axisAngle2quat(phi), Eigen::Vector4d(T0.q())).normalized();
+          out.t() = h00 * T0.t() + h01 * T1.t() + h * (h10 * ConstMap3(k0.v) + h11 * ConstMap3(k1.v));
+        }
+        break;
+      default:
+        SM_THROW(std::runtime_error, "Unknown interpolation method " << _method);
+      }
+    }
+
+    void TrajectoryInterpolator::updateKnot(size_t i)
+    {
+      typedef Eigen::Map<Eigen::Vector3d> Map3;
+      Knot & knot = _knots[i];
+      const size_t n = _times.size();
+      const size_t prev = i > 0 ? i - 1 : i;
+      const size_t next = i + 1 < n ? i + 1 : i;
+      if(prev == next)
+      {
+        Map3(knot.omega).setZero();
+        Map3(knot.v).setZero();
+      }
+      else
+      {
+        const double dt = static_cast<double>(_times[next] - _times[prev]);
+        Map3(knot.omega) = rotationBetween(_poses[prev].q(), _poses[next].q()) / dt;
+        Map3(knot.v) = (_poses[next].t() - _poses[prev].t()) / dt;
+      }
+      if(next != i)
+      {
+        Map3(knot.dphi) = rotationBetween(_poses[i].q(), _poses[next].q());
+      }
+      else
+      {
+        Map3(knot.dphi).setZero();
+      }
+      Map3(knot.dphiRateEnd).setZero();
+    }
+
+    void TrajectoryInterpolator::updateSegmentEnd(size_t i)
+    {
+      typedef Eigen::Map<Eigen::Vector3d> Map3;
+      typedef Eigen::Map<const Eigen::Vector3d> ConstMap3;
+      Knot & knot = _knots[i];
+      // exp(phi + dphi) ~= exp(expDiffMat(phi) dphi) exp(phi), so the rate of
+      // the rotation vector that gives the angular velocity omega is
+      // expDiffMat(phi)^-1 omega = logDiffMat(phi) omega.
+      const Eigen::Vector3d dphi = ConstMap3(knot.dphi);
+      Map3(knot.dphiRateEnd) = logDiffMat(dphi) * ConstMap3(_knots[i+1].omega);
+    }
+
+  } // namespace kinematics
+} // namespace sm
@@ -6,12 +6,71 @@
 #include <sm/kinematics/UncertainTransformation.hpp>
 #include <sm/kinematics/transformations.hpp>
 #include <sm/serialization_macros.hpp>
+#include <sm/kinematics/implementation/parallel_columns.hpp>
+#include <atomic>
 
 
 namespace sm {
   namespace kinematics {
+
+      namespace {
+          // Points are transformed in blocks through a small buffer on the
+          // stack, which keeps in-place transformation correct and the data
+          // in the cache.
+          const int kPointBlockSize = 256;
+
+          // transform the n <= kPointBlockSize columns starting at i
+          void transformBlock(const Eigen::Matrix3d & C_a_b, const Eigen::Vector3d & t_a_b_a,
+                              const Eigen::Ref<const Eigen::Matrix3Xd> & p_b, Eigen::Ref<Eigen::Matrix3Xd> p_a,
+                              Eigen::Index i, Eigen::Index n)
+          {
+              Eigen::Matrix<double, 3, kPointBlockSize> block;
+              block.leftCols(n).noalias() = C_a_b * p_b.middleCols(i, n);
+              p_a.middleCols(i, n) = block.leftCols(n).colwise() + t_a_b_a;
+          }
+
+          void transformBlock(const Eigen::Matrix3d & C_a_b, const Eigen::Vector3d & t_a_b_a,
+                              const Eigen::Ref<const Eigen::Matrix4Xd> & p_b, Eigen::Ref<Eigen::Matrix4Xd> p_a,
+                              Eigen::Index i, Eigen::Index n)
+          {
+              Eigen::Matrix<double, 3, kPointBlockSize> block;
+              block.leftCols(n).noalias() = C_a_b * p_b.block(0, i, 3, n);
+              block.leftCols(n).noalias() += t_a_b_a * p_b.block(3, i, 1, n);
+              p_a.block(0, i, 3, n) = block.leftCols(n);
+              p_a.block(3, i, 1, n) = p_b.block(3, i, 1, n);
+          }
+
+          template<typename InputPoints, typename OutputPoints>
+          void transformPointsParallel(const Eigen::Matrix3d & C_a_b, const Eigen::Vector3d & t_a_b_a,
+                                       const InputPoints & p_b, OutputPoints & p_a, int numThreads)
+          {
+              SM_ASSERT_EQ(std::runtime_error, p_b.cols(), p_a.cols(), "The input and output must have the same number of points");
+              detail::forEachColumnBlock(p_b.cols(), numThreads, kPointBlockSize,
+                                         [&](Eigen::Index i, Eigen::Index n) { transformBlock(C_a_b, t_a_b_a, p_b, p_a, i, n); });
+          }
+      } // namespace
+
+    struct Transformation::RotationCache
+    {
+      RotationCache() : state(CacheInvalid) {}
+      RotationCache(const RotationCache & rhs) { assign(rhs); }
+
+      void assign(const RotationCache & rhs)
+      {
+        const int rhsState = rhs.state.load(std::memory_order_acquire);
+        if(rhsState == CacheValid)
+        {
+          C_a_b = rhs.C_a_b;
+        }
+        state.store(rhsState == CacheValid ? CacheValid : CacheInvalid, std::memory_order_relaxed);
+      }
+
+      /// quat2r(_q_a_b) when state is CacheValid
+      Eigen::Matrix3d C_a_b;
+      std::atomic<int> state;
+    };
     
-      double * Transformation::qptr() { return &_q_a_b[0]; }
+      double * Transformation::qptr() { setRotationCacheEnabled(false); return &_q_a_b[0]; }
       double * Transformation::tptr() { return &_t_a_b_a[0]; }
     
     Transformation::Transformation() :
@@ -34,12 +93,87 @@ namespace sm {
         _q_a_b.normalize();
     }
 
+    Transformation::Transformation(const Transformation & rhs) :
+      _q_a_b(rhs._q_a_b), _t_a_b_a(rhs._t_a_b_a),
+      _C_cache(rhs._C_cache ? new RotationCache(*rhs._C_cache) : NULL)
+    {
+    }
+
+    Transformation & Transformation::operator=(const Transformation & rhs)
+    {
+      _q_a_b = rhs._q_a_b;
+      _t_a_b_a = rhs._t_a_b_a;
+      if(!rhs._C_cache)
+      {
+        _C_cache.reset();
+      }
+      else if(_C_cache)
+      {
+        _C_cache->assign(*rhs._C_cache);
+      }
+      else
+      {
+        _C_cache.reset(new RotationCache(*rhs._C_cache));
+      }
+      return *this;
+    }
+
     Transformation::~Transformation(){}
 
+    void Transformation::rotationMatrix(Eigen::Matrix3d & C_a_b) const
+    {
+      if(!_C_cache)
+      {
+        C_a_b = quat2r(_q_a_b);
+        return;
+      }
+      int state = _C_cache->state.load(std::memory_order_acquire);
+      if(state == CacheValid)
+      {
+        C_a_b = _C_cache->C_a_b;
+        return;
+      }
+      C_a_b = quat2r(_q_a_b);
+      // The first reader to get here fills the cache, the others, if any,
+      // use their own result.
+      if(state == CacheInvalid && _C_cache->state.compare_exchange_strong(state, CacheWriting, std::memory_order_acquire))
+      {
+        _C_cache->C_a_b = C_a_b;
+        _C_cache->state.store(CacheValid, std::memory_order_release);
+      }
+    }
+
+    void Transformation::invalidateRotationCache()
+    {
+      if(_C_cache)
+      {
+        _C_cache->state.store(CacheInvalid, std::memory_order_relaxed);
+      }
+    }
+
+    void Transformation::setRotationCacheEnabled(bool enabled)
+    {
+      if(!enabled)
+      {
+        _C_cache.reset();
+      }
+      else if(!_C_cache)
+      {
+        _C_cache.reset(new RotationCache());
+      }
+    }
+
+    bool Transformation::isRotationCacheEnabled() const
+    {
+      return _C_cache != NULL;
+    }
+
     /// @return the rotation matrix
     Eigen::Matrix3d Transformation::C() const
     {
-      return quat2r(_q_a_b);
+      Eigen::Matrix3d C_a_b;
+      rotationMatrix(C_a_b);
+      return C_a_b;
     }
 
     /// @return the translation vector
@@ -58,13 +192,15 @@ namespace sm {
       {
           _q_a_b = r2quat(T_a_b.topLeftCorner<3,3>());
           _t_a_b_a = T_a_b.topRightCorner<3,1>();
+          invalidateRotationCache();
       }
 
     Eigen::Matrix4d Transformation::T() const
     {
       Eigen::Matrix4d T_a_b;
-      // \todo...make this do less copying.
-      T_a_b.topLeftCorner<3,3>() = quat2r(_q_a_b);
+      Eigen::Matrix3d C_a_b;
+      rotationMatrix(C_a_b);
+      T_a_b.topLeftCorner<3,3>() = C_a_b;
       T_a_b.topRightCorner<3,1>() = _t_a_b_a;
       T_a_b.bottomLeftCorner<1,3>().setZero();
       T_a_b(3,3) = 1.0;
@@ -74,16 +210,31 @@ namespace sm {
     Eigen::Matrix<double, 3, 4> Transformation::T3x4() const
     {
       Eigen::Matrix<double, 3, 4> T3x4;
-      // \todo...make this do less copying.
-      T3x4.topLeftCorner<3,3>() = quat2r(_q_a_b);
+      Eigen::Matrix3d C_a_b;
+      rotationMatrix(C_a_b);
+      T3x4.topLeftCorner<3,3>() = C_a_b;
       T3x4.topRightCorner<3,1>() = _t_a_b_a;
       return T3x4;
     }
 
     Transformation Transformation::inverse() const
     {      
-      // \todo Make this do less copying.
-      return Transformation(quatInv(_q_a_b), quatRotate(quatInv(_q_a_b), -_t_a_b_a));
+      Transformation T_b_a;
+      T_b_a._q_a_b << -_q_a_b[0], -_q_a_b[1], -_q_a_b[2], _q_a_b[3];
+      if(!_C_cache)
+      {
+        T_b_a._t_a_b_a = quatRotate(T_b_a._q_a_b, -_t_a_b_a);
+        return T_b_a;
+      }
+      // The inverse quaternion has the same norm, and its rotation matrix
+      // is exactly the transpose of ours.
+      T_b_a._C_cache.reset(new RotationCache());
+      Eigen::Matrix3d & C_b_a = T_b_a._C_cache->C_a_b;
+      rotationMatrix(C_b_a);
+      C_b_a.transposeInPlace();
+      T_b_a._t_a_b_a.noalias() = -C_b_a * _t_a_b_a;
+      T_b_a._C_cache->state.store(CacheValid, std::memory_order_relaxed);
+      return T_b_a;
     }
 
     void Transformation::checkTransformationIsValid( void ) const
@@ -94,18 +245,22 @@ namespace sm {
 
     Transformation Transformation::operator*(const Transformation & rhs) const
     {
-      return Transformation(qplus(_q_a_b, rhs._q_a_b), quatRotate(_q_a_b, rhs._t_a_b_a) + _t_a_b_a);
+      Transformation T_a_c;
+      T_a_c._q_a_b = qplus(_q_a_b, rhs._q_a_b);
+      T_a_c._q_a_b.normalize();
+      T_a_c._t_a_b_a = rotate(rhs._t_a_b_a) + _t_a_b_a;
+      return T_a_c;
     }
 
     Eigen::Vector3d Transformation::operator*(const Eigen::Vector3d & rhs) const
     {
-      return quatRotate(_q_a_b, rhs) + _t_a_b_a;
+      return rotate(rhs) + _t_a_b_a;
     }
 
     Eigen::Vector4d Transformation::operator*(const Eigen::Vector4d & rhs) const
     {
       Eigen::Vector4d rval;
-      rval.head<3>() = quatRotate(_q_a_b, rhs.head<3>()) + rhs[3] * _t_a_b_a;
+      rval.head<3>() = rotate(Eigen::Vector3d(rhs.head<3>())) + rhs[3] * _t_a_b_a;
       rval[3] = rhs[3];
       
       return rval;
@@ -116,7 +271,7 @@ namespace sm {
     HomogeneousPoint Transformation::operator*(const HomogeneousPoint & rhs) const
     {
       Eigen::Vector4d rval = rhs.toHomogeneous();
-      rval.head<3>() = (quatRotate(_q_a_b, rhs.toHomogeneous().head<3>()) + rval[3] * _t_a_b_a).eval();
+      rval.head<3>() = rotate(Eigen::Vector3d(rval.head<3>())) + rval[3] * _t_a_b_a;
       return HomogeneousPoint(rval);
       
     }
@@ -126,6 +281,7 @@ namespace sm {
     {
       _q_a_b = quatRandom();
       _t_a_b_a = (Eigen::Vector3d::Random().array() - 0.5) * 100.0;
+      invalidateRotationCache();
     }
 
     bool Transformation::isBinaryEqual(const Transformation & rhs) const
@@ -138,6 +294,7 @@ namespace sm {
     {
       _q_a_b = updateQuat( _q_a_b, dt.tail<3>() );
       _t_a_b_a += dt.head<3>();
+      invalidateRotationCache();
     }
 
     Eigen::Matrix<double,6,6> Transformation::S() const
@@ -152,6 +309,7 @@ namespace sm {
     {
       _q_a_b = quatIdentity();
       _t_a_b_a.setZero();
+      invalidateRotationCache();
     }
 
     /// \brief Set this to a random transformation.
@@ -174,6 +332,7 @@ namespace sm {
 
       _q_a_b = axisAngle2quat(axis);
       _t_a_b_a = t;
+      invalidateRotationCache();
 
     }
 
@@ -184,9 +343,8 @@ namespace sm {
 
       const Transformation & T_b_c = UT_b_c;
       Transformation T_a_c = T_a_b * T_b_c;
-      UncertainTransformation::covariance_t T_a_b_boxtimes = boxTimes(T_a_b.T());
-      
-      UncertainTransformation::covariance_t U_a_c = T_a_b_boxtimes * UT_b_c.U() * T_a_b_boxtimes.transpose();
+      UncertainTransformation::covariance_t U_a_c;
+      boxTimesCovariance(T_a_b.C(), T_a_b.t(), UT_b_c.U(), U_a_c);
 
       return UncertainTransformation(T_a_c, U_a_c);
       
@@ -207,17 +365,88 @@ namespace sm {
       /// \brief rotate a point (do not translate)
       Eigen::Vector3d Transformation::rotate(const Eigen::Vector3d & p) const
       {
-          return quatRotate(_q_a_b, p);
+          if(!_C_cache)
+          {
+              return quatRotate(_q_a_b, p);
+          }
+          // Always through the matrix, so the result does not depend on
+          // whether the cache was filled before.
+          Eigen::Matrix3d C_a_b;
+          rotationMatrix(C_a_b);
+          return C_a_b * p;
       }
 
       /// \brief rotate a point (do not translate)
       Eigen::Vector4d Transformation::rotate(const Eigen::Vector4d & p) const
       {
           Eigen::Vector4d rval = p;
-          rval.head<3>() = quatRotate(_q_a_b, rval.head<3>());
+          rval.head<3>() = rotate(Eigen::Vector3d(p.head<3>()));
           return rval;
       }
 
+      void Transformation::transformPoints(const Eigen::Ref<const Eigen::Matrix3Xd> & p_b, Eigen::Ref<Eigen::Matrix3Xd> p_a, int numThreads) const
+      {
+          transformPointsParallel(C(), _t_a_b_a, p_b, p_a, numThreads);
+      }
+
+      void Transformation::transformHomogeneousPoints(const Eigen::Ref<const Eigen::Matrix4Xd> & p_b, Eigen::Ref<Eigen::Matrix4Xd> p_a, int numThreads) const
+      {
+          transformPointsParallel(C(), _t_a_b_a, p_b, p_a, numThreads);
+      }
+
+      // The Jacobians follow from oplus(): C(dq) ~= I - crossMx(dq), so
+      // rotating the transformation by dq moves a point C * p by
+      // crossMx(C * p) * dq.
+      Transformation Transformation::composeAndJacobians(const Transformation & T_b_c,
+                                                         Eigen::Matrix<double,6,6> & out_J_a_b,
+                                                         Eigen::Matrix<double,6,6> & out_J_b_c) const
+      {
+          const Eigen::Matrix3d C_a_b = C();
+          const Eigen::Vector3d t_a_c_b = C_a_b * T_b_c._t_a_b_a;
+
+          out_J_a_b.setIdentity();
+          out_J_a_b.topRightCorner<3,3>() = crossMx(t_a_c_b);
+
+          out_J_b_c.topLeftCorner<3,3>() = C_a_b;
+          out_J_b_c.topRightCorner<3,3>().setZero();
+          out_J_b_c.bottomLeftCorner<3,3>().setZero();
+          out_J_b_c.bottomRightCorner<3,3>() = C_a_b;
+
+          return Transformation(qplus(_q_a_b, T_b_c._q_a_b), t_a_c_b + _t_a_b_a);
+      }
+
+      Eigen::Vector3d Transformation::transformAndJacobians(const Eigen::Vector3d & p_b,
+                                                            Eigen::Matrix<double,3,6> & out_J_T,
+                                                            Eigen::Matrix3d & out_J_p) const
+      {
+          out_J_p = C();
+          const Eigen::Vector3d Cp = out_J_p * p_b;
+          out_J_T.leftCols<3>().setIdentity();
+          out_J_T.rightCols<3>() = crossMx(Cp);
+          return Cp + _t_a_b_a;
+      }
+
+      Eigen::Vector4d Transformation::transformAndJacobians(const Eigen::Vector4d & p_b,
+                                                            Eigen::Matrix<double,4,6> & out_J_T,
+                                                            Eigen::Matrix4d & out_J_p) const
+      {
+          const Eigen::Matrix3d C_a_b = C();
+          const Eigen::Vector3d Cp = C_a_b * p_b.head<3>();
+
+          out_J_p.topLeftCorner<3,3>() = C_a_b;
+          out_J_p.topRightCorner<3,1>() = _t_a_b_a;
+          out_J_p.bottomRows<1>() << 0.0, 0.0, 0.0, 1.0;
+
+          out_J_T.topLeftCorner<3,3>() = p_b[3] * Eigen::Matrix3d::Identity();
+          out_J_T.topRightCorner<3,3>() = crossMx(Cp);
+          out_J_T.bottomRows<1>().setZero();
+
+          Eigen::Vector4d p_a;
+          p_a.head<3>() = Cp + p_b[3] * _t_a_b_a;
+          p_a[3] = p_b[3];
+          return p_a;
+      }
+
       UncertainVector3 Transformation::rotate(const UncertainVector3 & p) const
       {
           
@@ -0,0 +1,130 @@
+#include <sm/kinematics/TransformationT.hpp>
+#include <sm/kinematics/Transformation.hpp>
+#include <cmath>
+#include <limits>
+#include <type_traits>
+
+namespace sm {
+  namespace kinematics {
+
+    static_assert(std::is_trivially_copyable<TransformationD>::value && std::is_standard_layout<TransformationD>::value,
+                  "TransformationT must stay a plain value type");
+    static_assert(sizeof(TransformationD) == 7 * sizeof(double) && sizeof(TransformationF) == 7 * sizeof(float),
+                  "TransformationT must not carry padding");
+
+    namespace {
+      // q_a_b (x) v_b with the quaternion conventions of quatRotate()
+      template<typename Scalar_>
+      Eigen::Matrix<Scalar_, 3, 1> rotate(const Eigen::Map<const Eigen::Matrix<Scalar_, 4, 1> > & q,
+                                          const Eigen::Matrix<Scalar_, 3, 1> & v)
+      {
+        return v + Scalar_(2) * q.template head<3>().cross(q.template head<3>().cross(v) - q[3] * v);
+      }
+    } // namespace
+
+    template<typename Scalar_>
+    TransformationT<Scalar_>::TransformationT(const Vector4 & q_a_b, const Vector3 & t_a_b_a)
+    {
+      q() = q_a_b;
+      t() = t_a_b_a;
+    }
+
+    template<typename Scalar_>
+    TransformationT<Scalar_>::TransformationT(const Transformation & T_a_b)
+    {
+      q() = T_a_b.q().cast<Scalar_>();
+      t() = T_a_b.t().cast<Scalar_>();
+    }
+
+    template<typename Scalar_>
+    Transformation TransformationT<Scalar_>::toTransformation() const
+    {
+      const Eigen::Vector4d q_a_b = q().template cast<double>();
+      Transformation T_a_b(q_a_b, t().template cast<double>());
+      // Normalizing a unit quaternion again may change its last bit, so keep
+      // one that is unit length to double precision as it is.
+      if(std::abs(q_a_b.squaredNorm() - 1.0) <= 4.0 * std::numeric_limits<double>::epsilon())
+      {
+        T_a_b._q_a_b = q_a_b;
+        T_a_b.invalidateRotationCache();
+      }
+      return T_a_b;
+    }
+
+    template<typename Scalar_>
+    TransformationT<Scalar_> TransformationT<Scalar_>::Identity()
+    {
+      return TransformationT(Vector4(0, 0, 0, 1), Vector3::Zero());
+    }
+
+    template<typename Scalar_>
+    typename TransformationT<Scalar_>::Matrix3 TransformationT<Scalar_>::C() const
+    {
+      // see quat2r()
+      const Scalar_ * q = q_a_b;
+      Matrix3 R;
+      R(0,0) = q[0]*q[0]-q[1]*q[1]-q[2]*q[2]+q[3]*q[3];
+      R(0,1) = (q[0]*q[1]+q[2]*q[3])*2;
+      R(0,2) = (q[0]*q[2]-q[1]*q[3])*2;
+      R(1,0) = (q[0]*q[1]-q[2]*q[3])*2;
+      R(1,1) = -q[0]*q[0]+q[1]*q[1]-q[2]*q[2]+q[3]*q[3];
+      R(1,2) = (q[0]*q[3]+q[1]*q[2])*2;
+      R(2,0) = (q[0]*q[2]+q[1]*q[3])*2;
+      R(2,1) = (q[1]*q[2]-q[0]*q[3])*2;
+      R(2,2) = -q[0]*q[0]-q[1]*q[1]+q[2]*q[2]+q[3]*q[3];
+      return R;
+    }
+
+    template<typename Scalar_>
+    typename TransformationT<Scalar_>::Matrix4 TransformationT<Scalar_>::T() const
+    {
+      Matrix4 T_a_b = Matrix4::Identity();
+      T_a_b.template topLeftCorner<3,3>() = C();
+      T_a_b.template topRightCorner<3,1>() = t();
+      return T_a_b;
+    }
+
+    template<typename Scalar_>
+    TransformationT<Scalar_> TransformationT<Scalar_>::inverse() const
+    {
+      TransformationT T_b_a;
+      T_b_a.q() << -q_a_b[0], -q_a_b[1], -q_a_b[2], q_a_b[3];
+      T_b_a.t() = -rotate<Scalar_>(static_cast<const TransformationT &>(T_b_a).q(), t());
+      return T_b_a;
+    }
+
+    template<typename Scalar_>
+    TransformationT<Scalar_> TransformationT<Scalar_>::operator*(const TransformationT & rhs) const
+    {
+      // qplus(q_a_b, rhs.q_a_b)
+      const Scalar_ * a = q_a_b;
+      const Scalar_ * p = rhs.q_a_b;
+      TransformationT T_a_c;
+      T_a_c.q_a_b[0] = p[0]*a[3] + p[1]*a[2] - p[2]*a[1] + p[3]*a[0];
+      T_a_c.q_a_b[1] = p[2]*a[0] - p[0]*a[2] + p[1]*a[3] + p[3]*a[1];
+      T_a_c.q_a_b[2] = p[0]*a[1] - p[1]*a[0] + p[2]*a[3] + p[3]*a[2];
+      T_a_c.q_a_b[3] = p[3]*a[3] - p[1]*a[1] - p[2]*a[2] - p[0]*a[0];
+      T_a_c.t() = rotate<Scalar_>(q(), Vector3(rhs.t())) + t();
+      return T_a_c;
+    }
+
+    template<typename Scalar_>
+    typename TransformationT<Scalar_>::Vector3 TransformationT<Scalar_>::operator*(const Vector3 & rhs) const
+    {
+      return rotate<Scalar_>(q(), rhs) + t();
+    }
+
+    template<typename Scalar_>
+    typename TransformationT<Scalar_>::Vector4 TransformationT<Scalar_>::operator*(const Vector4 & rhs) const
+    {
+      Vector4 rval;
+      rval.template head<3>() = rotate<Scalar_>(q(), rhs.template head<3>()) + rhs[3] * t();
+      rval[3] = rhs[3];
+      return rval;
+    }
+
+    template struct TransformationT<double>;
+    template struct TransformationT<float>;
+
+  } // namespace kinematics
+} // namespace sm
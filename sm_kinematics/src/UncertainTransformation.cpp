@@ -125,9 +125,9 @@ namespace sm {
 
       const Transformation & T_b_c = UT_b_c;
       Transformation T_a_c = Transformation::operator*(T_b_c);
-      covariance_t T_a_b_boxtimes = boxTimes(UT_a_b.T());
-      
-      covariance_t U_a_c = UT_a_b.U() + T_a_b_boxtimes * UT_b_c.U() * T_a_b_boxtimes.transpose();
+      covariance_t U_a_c;
+      boxTimesCovariance(UT_a_b.C(), UT_a_b.t(), UT_b_c.U(), U_a_c);
+      U_a_c += UT_a_b.U();
 
       return UncertainTransformation(T_a_c, U_a_c);
     }
@@ -140,8 +140,8 @@ namespace sm {
       Transformation T_b_a = T_a_b.inverse();
       
       // Invert the uncertainty.
-      covariance_t T_b_a_boxtimes = boxTimes(T_b_a.T());
-      covariance_t U_b_a = T_b_a_boxtimes * _U * T_b_a_boxtimes.transpose();
+      covariance_t U_b_a;
+      boxTimesCovariance(T_b_a.C(), T_b_a.t(), _U, U_b_a);
       
       return UncertainTransformation(T_b_a,U_b_a);
 
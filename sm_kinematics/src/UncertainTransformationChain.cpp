@@ -0,0 +1,138 @@
+#include <sm/kinematics/UncertainTransformationChain.hpp>
+#include <sm/kinematics/quaternion_algebra.hpp>
+#include <sm/kinematics/transformations.hpp>
+
+namespace sm {
+  namespace kinematics {
+
+    void packCovariance(const UncertainTransformation::covariance_t & U, Eigen::Ref<PackedCovariance> out_packed)
+    {
+      int k = 0;
+      for(int r = 0; r < 6; ++r)
+      {
+        for(int c = r; c < 6; ++c)
+        {
+          out_packed[k++] = U(r,c);
+        }
+      }
+    }
+
+    void unpackCovariance(const Eigen::Ref<const PackedCovariance> & packed, UncertainTransformation::covariance_t & out_U)
+    {
+      int k = 0;
+      for(int r = 0; r < 6; ++r)
+      {
+        for(int c = r; c < 6; ++c)
+        {
+          out_U(r,c) = out_U(c,r) = packed[k++];
+        }
+      }
+    }
+
+    UncertainTransformationChain::UncertainTransformationChain()
+    {
+      reset();
+    }
+
+    UncertainTransformationChain::UncertainTransformationChain(const UncertainTransformation & T_0_1) :
+      _q_0_n(T_0_1.q()), _t_0_n(T_0_1.t()), _C_0_n(T_0_1.C()), _U_0_n(T_0_1.U())
+    {
+    }
+
+    void UncertainTransformationChain::reset()
+    {
+      _q_0_n = quatIdentity();
+      _t_0_n.setZero();
+      _C_0_n.setIdentity();
+      _U_0_n.setZero();
+    }
+
+    void UncertainTransformationChain::append(const UncertainTransformation & T_n_m)
+    {
+      appendInternal(T_n_m.q(), T_n_m.t(), &T_n_m.U());
+    }
+
+    void UncertainTransformationChain::append(const Transformation & T_n_m)
+    {
+      appendInternal(T_n_m.q(), T_n_m.t(), NULL);
+    }
+
+    void UncertainTransformationChain::append(const TransformationD & T_n_m, const Eigen::Ref<const PackedCovariance> & U_n_m)
+    {
+      covariance_t U;
+      unpackCovariance(U_n_m, U);
+      appendInternal(T_n_m.q(), T_n_m.t(), &U);
+    }
+
+    void UncertainTransformationChain::appendInternal(const Eigen::Vector4d & q_n_m, const Eigen::Vector3d & t_n_m, const covariance_t * U_n_m)
+    {
+      if(U_n_m)
+      {
+        covariance_t U_0_m;
+        boxTimesCovariance(_C_0_n, _t_0_n, *U_n_m, U_0_m);
+        _U_0_n += U_0_m;
+      }
+      // The same composition as Transformation::operator*(). The rotation
+      // matrix is recomputed from the quaternion, so that it does not drift
+      // along long chains.
+      _t_0_n += _C_0_n * t_n_m;
+      _q_0_n = qplus(_q_0_n, q_n_m);
+      _q_0_n.normalize();
+      _C_0_n = quat2r(_q_0_n);
+    }
+
+    UncertainTransformation UncertainTransformationChain::toUncertainTransformation() const
+    {
+      return UncertainTransformation(_q_0_n, _t_0_n, _U_0_n);
+    }
+
+    TransformationD UncertainTransformationChain::toTransformation() const
+    {
+      return TransformationD(_q_0_n, _t_0_n);
+    }
+
+    const UncertainTransformationChain::covariance_t & UncertainTransformationChain::U() const
+    {
+      return _U_0_n;
+    }
+
+    void UncertainTransformationChain::packedU(Eigen::Ref<PackedCovariance> out_packed) const
+    {
+      packCovariance(_U_0_n, out_packed);
+    }
+
+    void UncertainTransformationChain::appendAll(const std::vector<TransformationD> & T_i_ip1, const PackedCovariances & U_i_ip1,
+                                                 std::vector<TransformationD> & out_T_0_i, PackedCovariances & out_U_0_i)
+    {
+      SM_ASSERT_EQ(std::runtime_error, static_cast<Eigen::Index>(T_i_ip1.size()), U_i_ip1.cols(), "There must be one covariance per pose");
+      const size_t n = T_i_ip1.size();
+      out_T_0_i.resize(n);
+      out_U_0_i.resize(Eigen::NoChange, n);
+      covariance_t U;
+      for(size_t i = 0; i < n; ++i)
+      {
+        unpackCovariance(U_i_ip1.col(i), U);
+        appendInternal(T_i_ip1[i].q(), T_i_ip1[i].t(), &U);
+        out_T_0_i[i] = toTransformation();
+        packCovariance(_U_0_n, out_U_0_i.col(i));
+      }
+    }
+
+    void composeCovariances(const UncertainTransformation & T_a_b, const PackedCovariances & U_b_i, PackedCovariances & out_U_a_i)
+    {
+      const Eigen::Matrix3d C_a_b = T_a_b.C();
+      const Eigen::Vector3d & t_a_b = T_a_b.t();
+      const Eigen::Index n = U_b_i.cols();
+      out_U_a_i.resize(Eigen::NoChange, n);
+      UncertainTransformation::covariance_t U;
+      for(Eigen::Index i = 0; i < n; ++i)
+      {
+        unpackCovariance(U_b_i.col(i), U);
+        boxTimesCovariance(C_a_b, t_a_b, U, U);
+        U += T_a_b.U();
+        packCovariance(U, out_U_a_i.col(i));
+      }
+    }
+
+  } // namespace kinematics
+} // namespace sm
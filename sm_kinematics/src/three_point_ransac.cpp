@@ -0,0 +1,345 @@
+#include <sm/kinematics/three_point_ransac.hpp>
+#include <sm/kinematics/three_point_methods.hpp>
+#include <sm/assert_macros.hpp>
+#include <boost/thread.hpp>
+#include <algorithm>
+#include <atomic>
+#include <cmath>
+#include <random>
+
+namespace sm { namespace kinematics {
+
+    namespace {
+        // Residuals are computed for this many pairs at once, in a buffer
+        // on the stack that Eigen evaluates with packet operations.
+        const int kResidualBlockSize = 256;
+
+        // The hypothesis p0 = C * p1 + t.
+        struct Model
+        {
+            Eigen::Matrix3d C;
+            Eigen::Vector3d t;
+        };
+
+        void gather(const Eigen::Matrix3Xd & p, const std::vector<int> & indices, Eigen::Matrix3Xd & out_p)
+        {
+            out_p.resize(3, indices.size());
+            for(size_t i = 0; i < indices.size(); ++i)
+            {
+                out_p.col(i) = p.col(indices[i]);
+            }
+        }
+
+        struct ThreePointSvdProblem
+        {
+            enum { SampleSize = 3 };
+
+            ThreePointSvdProblem(const Eigen::Matrix3Xd & p0, const Eigen::Matrix3Xd & p1) : p0(p0), p1(p1) {}
+
+            void fitSample(const int * sample, Model & out_model) const
+            {
+                Eigen::Matrix3d s0, s1;
+                for(int i = 0; i < SampleSize; ++i)
+                {
+                    s0.col(i) = p0.col(sample[i]);
+                    s1.col(i) = p1.col(sample[i]);
+                }
+                setModel(threePointSvd(s0, s1), out_model);
+            }
+
+            void fitInliers(const std::vector<int> & inliers, Model & out_model) const
+            {
+                Eigen::Matrix3Xd s0, s1;
+                gather(p0, inliers, s0);
+                gather(p1, inliers, s1);
+                setModel(threePointSvd(s0, s1), out_model);
+            }
+
+            static void setModel(const Eigen::Matrix4d & T_0_1, Model & out_model)
+            {
+                out_model.C = T_0_1.topLeftCorner<3,3>();
+                out_model.t = T_0_1.topRightCorner<3,1>();
+            }
+
+            const Eigen::Matrix3Xd & p0;
+            const Eigen::Matrix3Xd & p1;
+        };
+
+        struct QMethodProblem
+        {
+            enum { SampleSize = 2 };
+
+            QMethodProblem(const Eigen::Matrix3Xd & p0, const Eigen::Matrix3Xd & p1) : p0(p0), p1(p1) {}
+
+            void fitSample(const int * sample, Model & out_model) const
+            {
+                Eigen::Matrix<double, 3, SampleSize> s0, s1;
+                for(int i = 0; i < SampleSize; ++i)
+                {
+                    s0.col(i) = p0.col(sample[i]);
+                    s1.col(i) = p1.col(sample[i]);
+                }
+                out_model.C = qMethod(s0, s1);
+                out_model.t.setZero();
+            }
+
+            void fitInliers(const std::vector<int> & inliers, Model & out_model) const
+            {
+                Eigen::Matrix3Xd s0, s1;
+                gather(p0, inliers, s0);
+                gather(p1, inliers, s1);
+                out_model.C = qMethod(s0, s1);
+                out_model.t.setZero();
+            }
+
+            const Eigen::Matrix3Xd & p0;
+            const Eigen::Matrix3Xd & p1;
+        };
+
+        template<typename Problem>
+        class Ransac
+        {
+        public:
+            Ransac(const Problem & problem, const RansacOptions & options) :
+                _problem(problem), _options(options),
+                _numPoints(static_cast<int>(problem.p0.cols())),
+                _threshold2(options.inlierThreshold * options.inlierThreshold),
+                _next(0), _drawn(0), _bound(options.maxIterations), _bestCount(0), _refits(0)
+            {
+                SM_ASSERT_EQ(std::runtime_error, problem.p0.cols(), problem.p1.cols(), "p0 and p1 must have the same number of columns");
+                SM_ASSERT_GE(std::runtime_error, _numPoints, static_cast<int>(Problem::SampleSize), "There are fewer pairs than the minimal sample");
+                SM_ASSERT_GT(std::runtime_error, options.inlierThreshold, 0.0, "The inlier threshold must be positive");
+                SM_ASSERT_GT(std::runtime_error, options.confidence, 0.0, "The confidence must be in (0, 1)");
+                SM_ASSERT_LT(std::runtime_error, options.confidence, 1.0, "The confidence must be in (0, 1)");
+                _best.C.setIdentity();
+                _best.t.setZero();
+            }
+
+            void run(Model & out_model, RansacResult & out_result)
+            {
+                const int numThreads = std::max(1, std::min(_options.numThreads, _options.maxIterations));
+                if(numThreads == 1)
+                {
+                    work(0);
+                }
+                else
+                {
+                    boost::thread_group threads;
+                    for(int i = 1; i < numThreads; ++i)
+                    {
+                        threads.create_thread([this, i]() { work(i); });
+                    }
+                    work(0);
+                    threads.join_all();
+                }
+
+                out_model = _best;
+                out_result.iterations = _drawn.load();
+                out_result.refits = _refits.load();
+                out_result.inliers.clear();
+                if(_bestCount.load() < Problem::SampleSize)
+                {
+                    return;
+                }
+                collectInliers(out_model, out_result.inliers);
+                // The final refit to all inliers, which local optimization
+                // has done already for the best hypothesis.
+                if(!_options.localOptimization)
+                {
+                    Model refit;
+                    _problem.fitInliers(out_result.inliers, refit);
+                    if(countInliers(refit, static_cast<int>(out_result.inliers.size()) - 1) >= static_cast<int>(out_result.inliers.size()))
+                    {
+                        out_model = refit;
+                        collectInliers(out_model, out_result.inliers);
+                    }
+                }
+            }
+
+        private:
+            void work(int thread)
+            {
+                std::mt19937 generator(_options.seed + 7919u * thread);
+                std::uniform_int_distribution<int> uniform(0, _numPoints - 1);
+                int sample[Problem::SampleSize];
+                std::vector<int> inliers;
+                Model model;
+                while(_next.fetch_add(1) < _bound.load())
+                {
+                    ++_drawn;
+                    for(int i = 0; i < Problem::SampleSize; ++i)
+                    {
+                        do
+                        {
+                            sample[i] = uniform(generator);
+                        } while(std::find(sample, sample + i, sample[i]) != sample + i);
+                    }
+                    _problem.fitSample(sample, model);
+                    if(!model.C.allFinite() || !model.t.allFinite())
+                    {
+                        continue;
+                    }
+                    int count = countInliers(model, _bestCount.load());
+                    if(count <= _bestCount.load())
+                    {
+                        continue;
+                    }
+                    if(_options.localOptimization)
+                    {
+                        localOptimize(model, count, inliers);
+                    }
+                    update(model, count);
+                }
+            }
+
+            // Refit to the inliers while that gains inliers.
+            void localOptimize(Model & model, int & count, std::vector<int> & inliers)
+            {
+                Model refit;
+                for(int k = 0; k < _options.localOptimizationIterations; ++k)
+                {
+                    collectInliers(model, inliers);
+                    _problem.fitInliers(inliers, refit);
+                    ++_refits;
+                    const int refitCount = countInliers(refit, count - 1);
+                    if(refitCount < count || !refit.C.allFinite() || !refit.t.allFinite())
+                    {
+                        break;
+                    }
+                    model = refit;
+                    const bool gained = refitCount > count;
+                    count = refitCount;
+                    if(!gained)
+                    {
+                        break;
+                    }
+                }
+            }
+
+            void update(const Model & model, int count)
+            {
+                boost::mutex::scoped_lock lock(_mutex);
+                if(count <= _bestCount.load())
+                {
+                    return;
+                }
+                _best = model;
+                _bestCount.store(count);
+                // The number of samples that contain an all-inlier sample
+                // with the requested confidence for the current inlier ratio.
+                const double sampleInlierRatio = std::pow(static_cast<double>(count) / _numPoints, static_cast<int>(Problem::SampleSize));
+                double bound = _options.maxIterations;
+                if(sampleInlierRatio >= 1.0)
+                {
+                    bound = 1.0;
+                }
+                else if(sampleInlierRatio > 0.0)
+                {
+                    bound = std::ceil(std::log(1.0 - _options.confidence) / std::log1p(-sampleInlierRatio));
+                }
+                _bound.store(static_cast<int>(std::min<double>(bound, _options.maxIterations)));
+            }
+
+            // The number of inliers of model. The count stops early once it
+            // can no longer exceed mustBeat and is then at most mustBeat.
+            int countInliers(const Model & model, int mustBeat) const
+            {
+                Eigen::Matrix<double, 3, kResidualBlockSize> r;
+                int count = 0;
+                for(int i = 0; i < _numPoints; i += kResidualBlockSize)
+                {
+                    const int n = std::min(kResidualBlockSize, _numPoints - i);
+                    r.leftCols(n).noalias() = model.C * _problem.p1.middleCols(i, n);
+                    r.leftCols(n) -= _problem.p0.middleCols(i, n);
+                    r.leftCols(n).colwise() += model.t;
+                    count += static_cast<int>((r.leftCols(n).colwise().squaredNorm().array() < _threshold2).count());
+                    if(count + (_numPoints - i - n) <= mustBeat)
+                    {
+                        break;
+                    }
+                }
+                return count;
+            }
+
+            void collectInliers(const Model & model, std::vector<int> & out_inliers) const
+            {
+                Eigen::Matrix<double, 3, kResidualBlockSize> r;
+                out_inliers.clear();
+                for(int i = 0; i < _numPoints; i += kResidualBlockSize)
+                {
+                    const int n = std::min(kResidualBlockSize, _numPoints - i);
+                    r.leftCols(n).noalias() = model.C * _problem.p1.middleCols(i, n);
+                    r.leftCols(n) -= _problem.p0.middleCols(i, n);
+                    r.leftCols(n).colwise() += model.t;
+                    for(int j = 0; j < n; ++j)
+                    {
+                        if(r.col(j).squaredNorm() < _threshold2)
+                        {
+                            out_inliers.push_back(i + j);
+                        }
+                    }
+                }
+            }
+
+            const Problem & _problem;
+            const RansacOptions & _options;
+            const int _numPoints;
+            const double _threshold2;
+
+            /// The index of the next hypothesis, it may overshoot _bound.
+            std::atomic<int> _next;
+            std::atomic<int> _drawn;
+            /// The adaptive iteration bound.
+            std::atomic<int> _bound;
+            std::atomic<int> _bestCount;
+            std::atomic<int> _refits;
+
+            boost::mutex _mutex;
+            Model _best;
+        };
+    } // namespace
+
+    RansacOptions::RansacOptions() :
+        inlierThreshold(0.01), confidence(0.99), maxIterations(1000),
+        localOptimization(true), localOptimizationIterations(4), numThreads(1), seed(0)
+    {
+    }
+
+    RansacResult::RansacResult() : iterations(0), refits(0)
+    {
+    }
+
+    Eigen::Matrix4d threePointSvdRansac(const Eigen::Matrix3Xd & p0, const Eigen::Matrix3Xd & p1,
+                                        const RansacOptions & options, RansacResult * out_result)
+    {
+        ThreePointSvdProblem problem(p0, p1);
+        Ransac<ThreePointSvdProblem> ransac(problem, options);
+        Model model;
+        RansacResult result;
+        ransac.run(model, result);
+        if(out_result)
+        {
+            *out_result = result;
+        }
+        Eigen::Matrix4d T_0_1(Eigen::Matrix4d::Identity());
+        T_0_1.topLeftCorner<3,3>() = model.C;
+        T_0_1.topRightCorner<3,1>() = model.t;
+        return T_0_1;
+    }
+
+    Eigen::Matrix3d qMethodRansac(const Eigen::Matrix3Xd & p0, const Eigen::Matrix3Xd & p1,
+                                  const RansacOptions & options, RansacResult * out_result)
+    {
+        QMethodProblem problem(p0, p1);
+        Ransac<QMethodProblem> ransac(problem, options);
+        Model model;
+        RansacResult result;
+        ransac.run(model, result);
+        if(out_result)
+        {
+            *out_result = result;
+        }
+        return model.C;
+    }
+
+  }} // namespace sm::kinematics
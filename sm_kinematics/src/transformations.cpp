@@ -141,5 +141,29 @@ namespace sm { namespace kinematics {
       return Tbp;
     }
 
+    void boxTimesCovariance(Eigen::Matrix3d const & C_ba, Eigen::Vector3d const & rho_b_ab,
+                            Eigen::Matrix<double,6,6> const & U, Eigen::Matrix<double,6,6> & out_U)
+    {
+      // boxTimes(T_ba) = [I X; 0 I] * diag(C, C) with X = -rho^x. With the
+      // rotated blocks A, B, D of U the result is
+      //   [A + X B^T + (X B^T)^T + X D X^T,  B + X D]
+      //   [                    (B + X D)^T,        D]
+      Eigen::Matrix3d CU = C_ba * U.topLeftCorner<3,3>();
+      const Eigen::Matrix3d A = CU * C_ba.transpose();
+      CU.noalias() = C_ba * U.topRightCorner<3,3>();
+      const Eigen::Matrix3d B = CU * C_ba.transpose();
+      CU.noalias() = C_ba * U.bottomRightCorner<3,3>();
+      const Eigen::Matrix3d D = CU * C_ba.transpose();
+
+      const Eigen::Matrix3d X = -crossMx(rho_b_ab);
+      const Eigen::Matrix3d XD = X * D;
+      const Eigen::Matrix3d XBt = X * B.transpose();
+
+      out_U.topLeftCorner<3,3>() = A + XBt + XBt.transpose() + XD * X.transpose();
+      out_U.topRightCorner<3,3>() = B + XD;
+      out_U.bottomLeftCorner<3,3>() = out_U.topRightCorner<3,3>().transpose();
+      out_U.bottomRightCorner<3,3>() = D;
+    }
+
 
   }} // namespace asrl::math
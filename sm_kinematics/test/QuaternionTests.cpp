@@ -9,7 +9,9 @@
 // Helpful functions from libsm
 #include <sm/eigen/gtest.hpp>
 #include <sm/eigen/NumericalDiff.hpp>
+#include "RandomTestData.hpp"
 #include <sm/kinematics/quaternion_algebra.hpp>
+#include <sm/kinematics/packed_quaternion_algebra.hpp>
 
 
 TEST(QuaternionAlgebraTestSuite, testRotation)
@@ -147,3 +149,83 @@ TEST(QuaternionAlgebraTestSuite, testLogJacobian)
   }
 }
 
+
+namespace {
+  Eigen::Vector3d randomAxisAngle()
+  {
+    return sm::kinematics::test::randomVector(1.8);
+  }
+} // namespace
+
+TEST(QuaternionAlgebraTestSuite, testFloatMatchesDouble)
+{
+  using namespace sm::kinematics;
+  for(int i = 0; i < 100; i++)
+    {
+      const Eigen::Vector4d q = axisAngle2quat(randomAxisAngle());
+      const Eigen::Vector4d p = axisAngle2quat(randomAxisAngle());
+      const Eigen::Vector3d v = randomAxisAngle();
+      const Eigen::Vector4f qf = q.cast<float>(), pf = p.cast<float>();
+      const Eigen::Vector3f vf = v.cast<float>();
+
+      sm::eigen::assertNear(quat2r(qf).cast<double>(), quat2r(q), 1e-5, SM_SOURCE_FILE_POS, "quat2r");
+      sm::eigen::assertNear(r2quat(quat2r(qf)).cast<double>(), r2quat(quat2r(q)), 1e-5, SM_SOURCE_FILE_POS, "r2quat");
+      sm::eigen::assertNear(axisAngle2quat(vf).cast<double>(), axisAngle2quat(v), 1e-5, SM_SOURCE_FILE_POS, "axisAngle2quat");
+      sm::eigen::assertNear(qplus(qf, pf).cast<double>(), qplus(q, p), 1e-5, SM_SOURCE_FILE_POS, "qplus");
+      sm::eigen::assertNear(qoplus(qf, pf).cast<double>(), qoplus(q, p), 1e-5, SM_SOURCE_FILE_POS, "qoplus");
+      sm::eigen::assertNear(quatPlus(qf).cast<double>(), quatPlus(q), 1e-5, SM_SOURCE_FILE_POS, "quatPlus");
+      sm::eigen::assertNear(quatOPlus(qf).cast<double>(), quatOPlus(q), 1e-5, SM_SOURCE_FILE_POS, "quatOPlus");
+      sm::eigen::assertNear(quatInv(qf).cast<double>(), quatInv(q), 1e-5, SM_SOURCE_FILE_POS, "quatInv");
+      sm::eigen::assertNear(quatRotate(qf, vf).cast<double>(), quatRotate(q, v), 1e-5, SM_SOURCE_FILE_POS, "quatRotate");
+      sm::eigen::assertNear(updateQuat(qf, vf).cast<double>(), updateQuat(q, v), 1e-5, SM_SOURCE_FILE_POS, "updateQuat");
+      sm::eigen::assertNear(qslerp(qf, pf, 0.3f).cast<double>(), qslerp(q, p, 0.3), 1e-5, SM_SOURCE_FILE_POS, "qslerp");
+    }
+  sm::eigen::assertEqual(quatIdentity<float>(), Eigen::Vector4f(0, 0, 0, 1), SM_SOURCE_FILE_POS, "quatIdentity");
+}
+
+TEST(QuaternionAlgebraTestSuite, testPackedMatchesSingle)
+{
+  using namespace sm::kinematics;
+  // not a multiple of the packet sizes, with small angles for the series
+  const int N = 37;
+  Eigen::Array<double, Eigen::Dynamic, 4> q(N, 4), p(N, 4);
+  Eigen::Array<double, Eigen::Dynamic, 3> v(N, 3), a(N, 3);
+  for(int i = 0; i < N; i++)
+    {
+      q.row(i) = axisAngle2quat(randomAxisAngle()).transpose().array();
+      p.row(i) = axisAngle2quat(randomAxisAngle()).transpose().array();
+      v.row(i) = randomAxisAngle().transpose().array();
+      a.row(i) = (i % 5 == 0 ? Eigen::Vector3d(randomAxisAngle() * 1e-5) : randomAxisAngle()).transpose().array();
+    }
+  a.row(1).setZero();
+
+  Eigen::Array<double, Eigen::Dynamic, 4> qp, dq, updated;
+  Eigen::Array<double, Eigen::Dynamic, 3> rotated;
+  qplusPacked(q, p, qp);
+  quatRotatePacked(q, v, rotated);
+  axisAngle2quatPacked(a, dq);
+  updateQuatPacked(q, a, updated);
+  for(int i = 0; i < N; i++)
+    {
+      const Eigen::Vector4d qi = q.row(i).transpose();
+      const Eigen::Vector4d pi = p.row(i).transpose();
+      const Eigen::Vector3d vi = v.row(i).transpose();
+      const Eigen::Vector3d ai = a.row(i).transpose();
+      sm::eigen::assertNear(Eigen::Vector4d(qp.row(i).transpose()), qplus(qi, pi), 1e-14, SM_SOURCE_FILE_POS, "qplusPacked");
+      sm::eigen::assertNear(Eigen::Vector3d(rotated.row(i).transpose()), quatRotate(qi, vi), 1e-14, SM_SOURCE_FILE_POS, "quatRotatePacked");
+      sm::eigen::assertNear(Eigen::Vector4d(dq.row(i).transpose()), axisAngle2quat(ai), 1e-14, SM_SOURCE_FILE_POS, "axisAngle2quatPacked");
+      sm::eigen::assertNear(Eigen::Vector4d(updated.row(i).transpose()), updateQuat(qi, ai), 1e-14, SM_SOURCE_FILE_POS, "updateQuatPacked");
+    }
+
+  // in place, in float
+  Eigen::Array<float, Eigen::Dynamic, 4> qf = q.cast<float>();
+  updateQuatPacked<float>(qf, a.cast<float>(), qf);
+  normalizeQuatPacked(qf);
+  for(int i = 0; i < N; i++)
+    {
+      const Eigen::Vector4d qi = q.row(i).transpose();
+      const Eigen::Vector3d ai = a.row(i).transpose();
+      sm::eigen::assertNear(Eigen::Vector4d(qf.row(i).transpose().cast<double>()), updateQuat(qi, ai), 1e-5, SM_SOURCE_FILE_POS, "updateQuatPacked in float");
+      EXPECT_NEAR(1.0f, qf.row(i).matrix().norm(), 1e-6f);
+    }
+}
@@ -0,0 +1,49 @@
+#ifndef SM_KINEMATICS_RANDOM_TEST_DATA_HPP
+#define SM_KINEMATICS_RANDOM_TEST_DATA_HPP
+
+#include <Eigen/Core>
+#include <random>
+
+namespace sm {
+  namespace kinematics {
+    namespace test {
+
+      /// \brief The seeded generator of the random test data.
+      ///
+      /// The older tests draw from std::rand() through Eigen's setRandom(). The
+      /// newer tests use this generator instead, so adding them did not change
+      /// the data the older tests see.
+      inline std::mt19937 & randomGenerator()
+      {
+        static std::mt19937 generator(7);
+        return generator;
+      }
+
+      /// \brief A Rows x cols matrix drawn uniformly from [-bound, bound].
+      template<int Rows>
+      Eigen::Matrix<double, Rows, Eigen::Dynamic> randomMatrix(int cols, double bound)
+      {
+        std::uniform_real_distribution<double> uniform(-bound, bound);
+        Eigen::Matrix<double, Rows, Eigen::Dynamic> m(Rows, cols);
+        for(int j = 0; j < cols; ++j)
+        {
+          for(int i = 0; i < Rows; ++i)
+          {
+            m(i, j) = uniform(randomGenerator());
+          }
+        }
+        return m;
+      }
+
+      /// \brief A vector drawn uniformly from [-bound, bound].
+      template<int N = 3>
+      Eigen::Matrix<double, N, 1> randomVector(double bound)
+      {
+        return randomMatrix<N>(1, bound);
+      }
+
+    } // namespace test
+  } // namespace kinematics
+} // namespace sm
+
+#endif /* SM_KINEMATICS_RANDOM_TEST_DATA_HPP */
@@ -13,6 +13,7 @@
 // Helpful functions from libsm
 #include <sm/eigen/gtest.hpp>
 #include <sm/eigen/NumericalDiff.hpp>
+#include "RandomTestData.hpp"
 
 #include <Eigen/LU>
 
@@ -251,11 +252,38 @@ public:
       }
   }
 
+  void testBatchConversions()
+  {
+    // Enough columns for several threads and a partial last block.
+    const int N = 3000;
+    Eigen::Matrix3Xd p = sm::kinematics::test::randomMatrix<3>(N, 1.0);
+    p.col(0).setZero();
+    RotationalKinematics::RotationMatrices C(9, N);
+    rotation.parametersToRotationMatrices(p, C);
+    Eigen::Matrix3Xd pp(3, N);
+    rotation.rotationMatricesToParameters(C, pp);
+    for(int i = 0; i < N; i++)
+      {
+	SCOPED_TRACE(i);
+	Eigen::Matrix3d Ci = rotation.parametersToRotationMatrix(p.col(i));
+	sm::eigen::assertNear(Ci, Eigen::Map<const Eigen::Matrix3d>(C.col(i).data()), 1e-12, SM_SOURCE_FILE_POS);
+	sm::eigen::assertNear(rotation.rotationMatrixToParameters(Ci), pp.col(i), 1e-12, SM_SOURCE_FILE_POS);
+      }
+
+    RotationalKinematics::RotationMatrices Cthreads(9, N);
+    rotation.parametersToRotationMatrices(p, Cthreads, 4);
+    sm::eigen::assertEqual(C, Cthreads, SM_SOURCE_FILE_POS);
+    Eigen::Matrix3Xd ppthreads(3, N);
+    rotation.rotationMatricesToParameters(C, ppthreads, 4);
+    sm::eigen::assertEqual(pp, ppthreads, SM_SOURCE_FILE_POS);
+  }
+
   void testAll()
   {
     testParametersToRotationMatrix();
     testInvertibleParameterTransformation();
     testSMatrix();
+    testBatchConversions();
     //testAngularVelocity();
   }
 };
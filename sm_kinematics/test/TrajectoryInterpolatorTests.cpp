@@ -0,0 +1,206 @@
+// Bring in gtest
+#include <gtest/gtest.h>
+#include <algorithm>
+#include <random>
+#include <vector>
+
+// Helpful functions from libsm
+#include <sm/eigen/gtest.hpp>
+#include <sm/kinematics/TrajectoryInterpolator.hpp>
+#include "RandomTestData.hpp"
+
+namespace {
+  using sm::kinematics::test::randomGenerator;
+  using sm::kinematics::test::randomVector;
+
+  // A trajectory with irregular steps between 10 and 50 ms.
+  void randomTrajectory(size_t n, std::vector<sm::timing::NsecTime> & times, std::vector<sm::kinematics::Transformation> & poses)
+  {
+    using namespace sm::kinematics;
+    std::uniform_int_distribution<sm::timing::NsecTime> step(10000000, 50000000);
+    sm::timing::NsecTime time = 1374000000000000000LL;
+    Eigen::Vector4d q = axisAngle2quat(randomVector(3.0));
+    Eigen::Vector3d t = randomVector(10.0);
+    for(size_t i = 0; i < n; ++i)
+    {
+      times.push_back(time);
+      poses.push_back(Transformation(q, t));
+      time += step(randomGenerator());
+      q = qplus(axisAngle2quat(randomVector(0.3)), q);
+      t += randomVector(0.5);
+    }
+  }
+
+  void expectNear(const sm::kinematics::Transformation & T0, const sm::kinematics::Transformation & T1, double tolerance, const std::string & message)
+  {
+    sm::eigen::assertNear(T0.T(), T1.T(), tolerance, SM_SOURCE_FILE_POS, message);
+  }
+} // namespace
+
+TEST(TrajectoryInterpolatorTestSuite, testPassesThroughPoses)
+{
+  using namespace sm::kinematics;
+  std::vector<sm::timing::NsecTime> times;
+  std::vector<Transformation> poses;
+  randomTrajectory(20, times, poses);
+  const TrajectoryInterpolator::Method methods[] = { TrajectoryInterpolator::Slerp, TrajectoryInterpolator::Linear, TrajectoryInterpolator::Cubic };
+  for(TrajectoryInterpolator::Method method : methods)
+  {
+    TrajectoryInterpolator interpolator(method);
+    for(size_t i = 0; i < times.size(); ++i)
+    {
+      interpolator.addPose(times[i], poses[i]);
+    }
+    ASSERT_EQ(times.size(), interpolator.size());
+    EXPECT_EQ(times.front(), interpolator.minTime());
+    EXPECT_EQ(times.back(), interpolator.maxTime());
+    for(size_t i = 0; i < times.size(); ++i)
+    {
+      expectNear(poses[i], interpolator.getPose(times[i]), 1e-9, "pose " + std::to_string(i));
+    }
+  }
+}
+
+TEST(TrajectoryInterpolatorTestSuite, testSlerpMatchesInterpolateTransformations)
+{
+  using namespace sm::kinematics;
+  std::vector<sm::timing::NsecTime> times;
+  std::vector<Transformation> poses;
+  randomTrajectory(10, times, poses);
+  TrajectoryInterpolator interpolator(TrajectoryInterpolator::Slerp);
+  interpolator.setPoses(times, poses);
+  for(size_t i = 0; i + 1 < times.size(); ++i)
+  {
+    const sm::timing::NsecTime time = times[i] + (times[i+1] - times[i]) / 3;
+    Transformation expected = interpolateTransformations(poses[i], static_cast<double>(times[i] - times[0]),
+                                                         poses[i+1], static_cast<double>(times[i+1] - times[0]),
+                                                         static_cast<double>(time - times[0]));
+    expectNear(expected, interpolator.getPose(time), 1e-9, "segment " + std::to_string(i));
+  }
+}
+
+TEST(TrajectoryInterpolatorTestSuite, testBatchMatchesSingleQueries)
+{
+  using namespace sm::kinematics;
+  std::vector<sm::timing::NsecTime> times;
+  std::vector<Transformation> poses;
+  randomTrajectory(200, times, poses);
+  TrajectoryInterpolator interpolator(TrajectoryInterpolator::Cubic);
+  interpolator.setPoses(times, poses);
+
+  // Dense and sparse sorted queries, then the same times shuffled.
+  std::vector<sm::timing::NsecTime> queries;
+  std::uniform_int_distribution<sm::timing::NsecTime> uniform(times.front(), times.back());
+  for(int i = 0; i < 500; ++i)
+  {
+    queries.push_back(uniform(randomGenerator()));
+  }
+  queries.push_back(times.front());
+  queries.push_back(times.back());
+  std::sort(queries.begin(), queries.end());
+  std::vector<sm::timing::NsecTime> sparse;
+  for(size_t i = 0; i < queries.size(); i += 50)
+  {
+    sparse.push_back(queries[i]);
+  }
+  std::vector<sm::timing::NsecTime> shuffled = queries;
+  std::shuffle(shuffled.begin(), shuffled.end(), randomGenerator());
+
+  const std::vector<sm::timing::NsecTime> * batches[] = { &queries, &sparse, &shuffled };
+  for(const std::vector<sm::timing::NsecTime> * batch : batches)
+  {
+    std::vector<Transformation> result;
+    interpolator.getPoses(*batch, result);
+    ASSERT_EQ(batch->size(), result.size());
+    // a copy answers the single queries with its own cursor
+    TrajectoryInterpolator single(interpolator);
+    for(size_t i = 0; i < batch->size(); ++i)
+    {
+      sm::kinematics::Transformation T = single.getPose((*batch)[i]);
+      EXPECT_TRUE(T.q() == result[i].q() && T.t() == result[i].t()) << "query " << i;
+    }
+  }
+}
+
+TEST(TrajectoryInterpolatorTestSuite, testCubicIsExactForConstantVelocity)
+{
+  using namespace sm::kinematics;
+  // Constant angular velocity about a fixed axis and constant linear velocity,
+  // sampled at irregular times.
+  const Eigen::Vector3d omega(0.2, -0.5, 0.3); // rad/s
+  const Eigen::Vector3d v(1.0, 2.0, -0.5);     // m/s
+  const Eigen::Vector4d q0 = axisAngle2quat(Eigen::Vector3d(0.1, 0.2, 0.3));
+  const Eigen::Vector3d t0(1.0, 0.0, 2.0);
+  const sm::timing::NsecTime start = 1000000000LL;
+  const sm::timing::NsecTime offsets[] = { 0, 100000000LL, 350000000LL, 400000000LL, 900000000LL, 1000000000LL };
+  TrajectoryInterpolator interpolator(TrajectoryInterpolator::Cubic);
+  for(sm::timing::NsecTime offset : offsets)
+  {
+    const double s = offset * 1e-9;
+    interpolator.addPose(start + offset, Transformation(qplus(axisAngle2quat(Eigen::Vector3d(s * omega)), q0), t0 + s * v));
+  }
+  for(sm::timing::NsecTime offset = 0; offset <= 1000000000LL; offset += 12345678LL)
+  {
+    const double s = offset * 1e-9;
+    Transformation expected(qplus(axisAngle2quat(Eigen::Vector3d(s * omega)), q0), t0 + s * v);
+    expectNear(expected, interpolator.getPose(start + offset), 1e-9, "offset " + std::to_string(offset));
+  }
+}
+
+TEST(TrajectoryInterpolatorTestSuite, testCubicAngularVelocityIsContinuous)
+{
+  using namespace sm::kinematics;
+  // The random trajectory turns about a different axis in every segment.
+  std::vector<sm::timing::NsecTime> times;
+  std::vector<Transformation> poses;
+  randomTrajectory(20, times, poses);
+  TrajectoryInterpolator interpolator(TrajectoryInterpolator::Cubic);
+  interpolator.setPoses(times, poses);
+  TrajectoryInterpolator incremental(TrajectoryInterpolator::Cubic);
+  for(size_t i = 0; i < times.size(); ++i)
+  {
+    incremental.addPose(times[i], poses[i]);
+  }
+
+  // The angular velocity in the perturbation of Transformation::oplus()
+  // from the pose at time to the pose at time + step.
+  auto omega = [&](sm::timing::NsecTime time, sm::timing::NsecTime step) {
+    const Eigen::Vector4d q0 = interpolator.getPose(time).q();
+    const Eigen::Vector4d q1 = interpolator.getPose(time + step).q();
+    return Eigen::Vector3d(quat2AxisAngle(qplus(q1, quatInv(q0))) / (step * 1e-9));
+  };
+  const sm::timing::NsecTime step = 1000;
+  for(size_t i = 1; i + 1 < times.size(); ++i)
+  {
+    // One sided differences on both sides of the pose.
+    const Eigen::Vector3d before = omega(times[i] - step, step);
+    const Eigen::Vector3d after = omega(times[i], step);
+    sm::eigen::assertNear(before, after, 1e-2 * std::max(1.0, after.norm()), SM_SOURCE_FILE_POS, "pose " + std::to_string(i));
+  }
+
+  // addPose() keeps the segments before the new pose up to date.
+  for(size_t i = 0; i + 1 < times.size(); ++i)
+  {
+    const sm::timing::NsecTime time = times[i] + (times[i+1] - times[i]) / 3;
+    expectNear(interpolator.getPose(time), incremental.getPose(time), 1e-12, "segment " + std::to_string(i));
+  }
+}
+
+TEST(TrajectoryInterpolatorTestSuite, testInvalidInputThrows)
+{
+  using namespace sm::kinematics;
+  TrajectoryInterpolator interpolator;
+  EXPECT_THROW(interpolator.getPose(0), std::runtime_error);
+  interpolator.addPose(10, Transformation());
+  EXPECT_NO_THROW(interpolator.getPose(10));
+  interpolator.addPose(20, Transformation());
+  EXPECT_THROW(interpolator.addPose(20, Transformation()), std::runtime_error);
+  EXPECT_THROW(interpolator.getPose(9), std::runtime_error);
+  EXPECT_THROW(interpolator.getPose(21), std::runtime_error);
+
+  std::vector<sm::timing::NsecTime> times = { 0, 2, 1 };
+  std::vector<Transformation> poses(3);
+  EXPECT_THROW(interpolator.setPoses(times, poses), std::runtime_error);
+  poses.pop_back();
+  EXPECT_THROW(interpolator.setPoses(times, poses), std::runtime_error);
+}
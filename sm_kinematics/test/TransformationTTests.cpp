@@ -0,0 +1,72 @@
+// Bring in gtest
+#include <gtest/gtest.h>
+#include <cstring>
+#include <type_traits>
+#include <vector>
+
+// Helpful functions from libsm
+#include <sm/eigen/gtest.hpp>
+#include <sm/kinematics/TransformationT.hpp>
+#include <sm/kinematics/Transformation.hpp>
+#include "RandomTestData.hpp"
+
+namespace {
+  using sm::kinematics::test::randomVector;
+
+  sm::kinematics::Transformation randomTransformation()
+  {
+    return sm::kinematics::Transformation(sm::kinematics::axisAngle2quat(randomVector(3.0)), randomVector(50.0));
+  }
+} // namespace
+
+TEST(TransformationTTestSuite, testPlainValueType)
+{
+  using namespace sm::kinematics;
+  EXPECT_TRUE(std::is_trivially_copyable<TransformationD>::value);
+  EXPECT_TRUE(std::is_standard_layout<TransformationD>::value);
+  EXPECT_EQ(7 * sizeof(double), sizeof(TransformationD));
+  EXPECT_EQ(7 * sizeof(float), sizeof(TransformationF));
+
+  std::vector<TransformationD> trajectory(3);
+  Transformation T = randomTransformation();
+  trajectory[1] = TransformationD(T);
+  TransformationD copy;
+  memcpy(&copy, &trajectory[1], sizeof(copy));
+  EXPECT_TRUE(copy.toTransformation().isBinaryEqual(T));
+}
+
+TEST(TransformationTTestSuite, testConversion)
+{
+  using namespace sm::kinematics;
+  for(int i = 0; i < 10; ++i)
+    {
+      Transformation T = randomTransformation();
+      // lossless for double
+      EXPECT_TRUE(TransformationD(T).toTransformation().isBinaryEqual(T));
+      sm::eigen::assertNear(TransformationF(T).toTransformation().T(), T.T(), 1e-4, SM_SOURCE_FILE_POS, "Checking the float conversion");
+      EXPECT_TRUE(TransformationD(T).cast<float>().cast<double>().toTransformation().isBinaryEqual(TransformationF(T).toTransformation()));
+    }
+  sm::eigen::assertEqual(TransformationD::Identity().T(), Eigen::Matrix4d::Identity(), SM_SOURCE_FILE_POS, "Checking the identity");
+}
+
+TEST(TransformationTTestSuite, testOperationsMatchTransformation)
+{
+  using namespace sm::kinematics;
+  for(int i = 0; i < 10; ++i)
+    {
+      Transformation T_a_b = randomTransformation(), T_b_c = randomTransformation();
+      const TransformationD D_a_b(T_a_b), D_b_c(T_b_c);
+      const TransformationF F_a_b(T_a_b), F_b_c(T_b_c);
+
+      sm::eigen::assertNear(D_a_b.C(), T_a_b.C(), 1e-14, SM_SOURCE_FILE_POS, "Checking C()");
+      sm::eigen::assertNear(D_a_b.T(), T_a_b.T(), 1e-14, SM_SOURCE_FILE_POS, "Checking T()");
+      sm::eigen::assertNear((D_a_b * D_b_c).T(), (T_a_b * T_b_c).T(), 1e-10, SM_SOURCE_FILE_POS, "Checking composition");
+      sm::eigen::assertNear(D_a_b.inverse().T(), T_a_b.inverse().T(), 1e-10, SM_SOURCE_FILE_POS, "Checking the inverse");
+      sm::eigen::assertNear((F_a_b * F_b_c).T().cast<double>(), (T_a_b * T_b_c).T(), 1e-3, SM_SOURCE_FILE_POS, "Checking float composition");
+
+      Eigen::Vector3d v3 = randomVector(10.0);
+      Eigen::Vector4d v(v3[0], v3[1], v3[2], 0.5);
+      sm::eigen::assertNear(D_a_b * v, T_a_b * v, 1e-10, SM_SOURCE_FILE_POS, "Checking homogeneous points");
+      sm::eigen::assertNear(D_a_b * v3, T_a_b * v3, 1e-10, SM_SOURCE_FILE_POS, "Checking points");
+    }
+}
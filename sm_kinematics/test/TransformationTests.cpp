@@ -1,10 +1,13 @@
 // Bring in gtest
 #include <gtest/gtest.h>
 #include <boost/cstdint.hpp>
+#include <boost/thread.hpp>
 
 // Helpful functions from libsm
 #include <sm/eigen/gtest.hpp>
+#include <sm/eigen/NumericalDiff.hpp>
 #include <sm/kinematics/quaternion_algebra.hpp>
+#include "RandomTestData.hpp"
 #include <sm/kinematics/Transformation.hpp>
 
 
@@ -134,3 +137,181 @@ TEST(TransformationTestSuite, testInvertProducesIdentity)
 
 
 }
+
+TEST(TransformationTestSuite, testTransformPoints)
+{
+  using namespace sm::kinematics;
+
+  Transformation T_a_b(axisAngle2quat(Eigen::Vector3d(0.3, -1.2, 0.7)), Eigen::Vector3d(12.0, -40.0, 3.5));
+  // more than one block and enough points to split over threads
+  const int N = 5000;
+  Eigen::Matrix3Xd p_b = test::randomMatrix<3>(N, 100.0);
+  Eigen::Matrix4Xd ph_b = test::randomMatrix<4>(N, 100.0);
+
+  for(int numThreads = 1; numThreads <= 4; numThreads *= 4)
+    {
+      Eigen::Matrix3Xd p_a(3, N);
+      T_a_b.transformPoints(p_b, p_a, numThreads);
+      Eigen::Matrix4Xd ph_a(4, N);
+      T_a_b.transformHomogeneousPoints(ph_b, ph_a, numThreads);
+      for(int i = 0; i < N; ++i)
+        {
+          Eigen::Vector3d v_b = p_b.col(i);
+          sm::eigen::assertNear(p_a.col(i), T_a_b * v_b, 1e-10, SM_SOURCE_FILE_POS, "Checking for the batch equal to single points");
+          Eigen::Vector4d vh_b = ph_b.col(i);
+          sm::eigen::assertNear(ph_a.col(i), T_a_b * vh_b, 1e-10, SM_SOURCE_FILE_POS, "Checking for the batch equal to single homogeneous points");
+        }
+    }
+
+  // in place
+  Eigen::Matrix3Xd p = p_b;
+  T_a_b.transformPoints(p, p);
+  Eigen::Matrix3Xd p_a(3, N);
+  T_a_b.transformPoints(p_b, p_a);
+  sm::eigen::assertNear(p, p_a, 1e-10, SM_SOURCE_FILE_POS, "Checking for in place transformation");
+
+  Eigen::Matrix3Xd wrongSize(3, N - 1);
+  EXPECT_THROW(T_a_b.transformPoints(p_b, wrongSize), std::runtime_error);
+}
+
+namespace {
+  // the minimal difference d with T1 = T0 oplus d
+  Eigen::Matrix<double,6,1> ominus(const sm::kinematics::Transformation & T1, const sm::kinematics::Transformation & T0)
+  {
+    using namespace sm::kinematics;
+    Eigen::Matrix<double,6,1> d;
+    d.head<3>() = T1.t() - T0.t();
+    d.tail<3>() = quat2AxisAngle(qplus(T1.q(), quatInv(T0.q())));
+    return d;
+  }
+
+  sm::kinematics::Transformation perturbed(sm::kinematics::Transformation T, const Eigen::Matrix<double,6,1> & dt)
+  {
+    T.oplus(dt);
+    return T;
+  }
+} // namespace
+
+TEST(TransformationTestSuite, testComposeAndJacobians)
+{
+  using namespace sm::kinematics;
+  typedef Eigen::Matrix<double,6,1> Vector6d;
+
+  const Transformation T_a_b(axisAngle2quat(Eigen::Vector3d(0.3, -1.2, 0.7)), Eigen::Vector3d(12.0, -40.0, 3.5));
+  const Transformation T_b_c(axisAngle2quat(Eigen::Vector3d(-2.1, 0.4, 0.2)), Eigen::Vector3d(-5.0, 7.5, 20.0));
+
+  Eigen::Matrix<double,6,6> J_a_b, J_b_c;
+  const Transformation T_a_c = T_a_b.composeAndJacobians(T_b_c, J_a_b, J_b_c);
+  sm::eigen::assertNear(T_a_c.T(), (T_a_b * T_b_c).T(), 1e-10, SM_SOURCE_FILE_POS, "Checking the composition");
+
+  std::function<Vector6d(const Vector6d &)> f_a_b = [&](const Vector6d & dt) { return ominus(perturbed(T_a_b, dt) * T_b_c, T_a_c); };
+  std::function<Vector6d(const Vector6d &)> f_b_c = [&](const Vector6d & dt) { return ominus(T_a_b * perturbed(T_b_c, dt), T_a_c); };
+  sm::eigen::assertNear(J_a_b, sm::eigen::numericalDiff(f_a_b, Vector6d::Zero().eval()), 1e-5, SM_SOURCE_FILE_POS, "Checking the Jacobian with respect to T_a_b");
+  sm::eigen::assertNear(J_b_c, sm::eigen::numericalDiff(f_b_c, Vector6d::Zero().eval()), 1e-5, SM_SOURCE_FILE_POS, "Checking the Jacobian with respect to T_b_c");
+}
+
+TEST(TransformationTestSuite, testTransformAndJacobians)
+{
+  using namespace sm::kinematics;
+  typedef Eigen::Matrix<double,6,1> Vector6d;
+
+  const Transformation T_a_b(axisAngle2quat(Eigen::Vector3d(0.3, -1.2, 0.7)), Eigen::Vector3d(12.0, -40.0, 3.5));
+  const Eigen::Vector3d p_b(4.0, -3.0, 11.0);
+  const Eigen::Vector4d ph_b(4.0, -3.0, 11.0, 0.5);
+
+  Eigen::Matrix<double,3,6> J_T;
+  Eigen::Matrix3d J_p;
+  sm::eigen::assertNear(T_a_b.transformAndJacobians(p_b, J_T, J_p), T_a_b * p_b, 1e-10, SM_SOURCE_FILE_POS, "Checking the point");
+  std::function<Eigen::Vector3d(const Vector6d &)> f_T = [&](const Vector6d & dt) { return perturbed(T_a_b, dt) * p_b; };
+  std::function<Eigen::Vector3d(const Eigen::Vector3d &)> f_p = [&](const Eigen::Vector3d & p) { return T_a_b * p; };
+  sm::eigen::assertNear(J_T, sm::eigen::numericalDiff(f_T, Vector6d::Zero().eval()), 1e-5, SM_SOURCE_FILE_POS, "Checking the Jacobian with respect to the transformation");
+  sm::eigen::assertNear(J_p, sm::eigen::numericalDiff(f_p, p_b), 1e-5, SM_SOURCE_FILE_POS, "Checking the Jacobian with respect to the point");
+
+  Eigen::Matrix<double,4,6> Jh_T;
+  Eigen::Matrix4d Jh_p;
+  sm::eigen::assertNear(T_a_b.transformAndJacobians(ph_b, Jh_T, Jh_p), T_a_b * ph_b, 1e-10, SM_SOURCE_FILE_POS, "Checking the homogeneous point");
+  std::function<Eigen::Vector4d(const Vector6d &)> fh_T = [&](const Vector6d & dt) { return perturbed(T_a_b, dt) * ph_b; };
+  std::function<Eigen::Vector4d(const Eigen::Vector4d &)> fh_p = [&](const Eigen::Vector4d & p) { return T_a_b * p; };
+  sm::eigen::assertNear(Jh_T, sm::eigen::numericalDiff(fh_T, Vector6d::Zero().eval()), 1e-5, SM_SOURCE_FILE_POS, "Checking the Jacobian of the homogeneous point with respect to the transformation");
+  sm::eigen::assertNear(Jh_p, sm::eigen::numericalDiff(fh_p, ph_b), 1e-5, SM_SOURCE_FILE_POS, "Checking the Jacobian with respect to the homogeneous point");
+}
+
+TEST(TransformationTestSuite, testRotationCache)
+{
+  using namespace sm::kinematics;
+
+  Transformation T_a_b(axisAngle2quat(Eigen::Vector3d(0.3, -1.2, 0.7)), Eigen::Vector3d(12.0, -40.0, 3.5));
+  EXPECT_FALSE(T_a_b.isRotationCacheEnabled());
+  T_a_b.setRotationCacheEnabled(true);
+  ASSERT_TRUE(T_a_b.isRotationCacheEnabled());
+
+  // rotate() gives the same bits before and after the matrix was cached
+  const Eigen::Vector3d p(1.5, -2.0, 0.25);
+  const Eigen::Vector3d p_before = T_a_b.rotate(p);
+  sm::eigen::assertEqual(T_a_b.C(), quat2r(T_a_b.q()), SM_SOURCE_FILE_POS, "Checking the first C()");
+  sm::eigen::assertEqual(T_a_b.C(), quat2r(T_a_b.q()), SM_SOURCE_FILE_POS, "Checking the cached C()");
+  sm::eigen::assertEqual(T_a_b.rotate(p), p_before, SM_SOURCE_FILE_POS, "Checking rotate() with the cached C()");
+
+  // every change of the rotation invalidates the cache
+  Eigen::Matrix<double,6,1> dt;
+  dt << 0.1, 0.2, 0.3, 0.4, -0.5, 0.6;
+  T_a_b.oplus(dt);
+  sm::eigen::assertEqual(T_a_b.C(), quat2r(T_a_b.q()), SM_SOURCE_FILE_POS, "Checking C() after oplus()");
+  const Transformation copy = T_a_b;
+  T_a_b.set(Transformation(axisAngle2quat(Eigen::Vector3d(-2.0, 0.1, 0.5)), Eigen::Vector3d::Zero()).T());
+  sm::eigen::assertEqual(T_a_b.C(), quat2r(T_a_b.q()), SM_SOURCE_FILE_POS, "Checking C() after set()");
+  sm::eigen::assertEqual(copy.C(), quat2r(copy.q()), SM_SOURCE_FILE_POS, "Checking C() of a copy");
+  T_a_b.setIdentity();
+  sm::eigen::assertEqual(T_a_b.C(), Eigen::Matrix3d::Identity(), SM_SOURCE_FILE_POS, "Checking C() after setIdentity()");
+  T_a_b = copy;
+  sm::eigen::assertEqual(T_a_b.C(), quat2r(T_a_b.q()), SM_SOURCE_FILE_POS, "Checking C() after an assignment");
+
+  EXPECT_TRUE(copy.isRotationCacheEnabled());
+
+  // the inverse gets the transposed matrix
+  const Transformation T_b_a = copy.inverse();
+  EXPECT_TRUE(T_b_a.isRotationCacheEnabled());
+  sm::eigen::assertEqual(T_b_a.C(), quat2r(T_b_a.q()), SM_SOURCE_FILE_POS, "Checking C() of the inverse");
+
+  // assigning a transformation without the cache turns it off
+  T_a_b = Transformation();
+  EXPECT_FALSE(T_a_b.isRotationCacheEnabled());
+  T_a_b = copy;
+  EXPECT_TRUE(T_a_b.isRotationCacheEnabled());
+
+  // writes through qptr() are seen
+  double * q = T_a_b.qptr();
+  EXPECT_FALSE(T_a_b.isRotationCacheEnabled());
+  q[0] = 0.0; q[1] = 0.0; q[2] = 0.0; q[3] = 1.0;
+  sm::eigen::assertEqual(T_a_b.C(), Eigen::Matrix3d::Identity(), SM_SOURCE_FILE_POS, "Checking C() after a write through qptr()");
+}
+
+TEST(TransformationTestSuite, testRotationCacheConcurrentReads)
+{
+  using namespace sm::kinematics;
+  for(int i = 0; i < 20; ++i)
+    {
+      Transformation cached(axisAngle2quat(Eigen::Vector3d(0.3, -1.2, 0.1 * i)), Eigen::Vector3d(12.0, -40.0, 3.5));
+      cached.setRotationCacheEnabled(true);
+      const Transformation & T_a_b = cached;
+      const Eigen::Matrix3d expected = quat2r(T_a_b.q());
+      bool ok[4] = { false, false, false, false };
+      boost::thread_group threads;
+      for(int t = 0; t < 4; ++t)
+        {
+          threads.create_thread([&, t]() {
+              bool same = true;
+              for(int k = 0; k < 100; ++k)
+                {
+                  same = same && T_a_b.C() == expected;
+                }
+              ok[t] = same;
+            });
+        }
+      threads.join_all();
+      for(int t = 0; t < 4; ++t)
+        {
+          EXPECT_TRUE(ok[t]);
+        }
+    }
+}
@@ -0,0 +1,129 @@
+// Bring in gtest
+#include <gtest/gtest.h>
+
+// Helpful functions from libsm
+#include <sm/eigen/gtest.hpp>
+#include <sm/kinematics/transformations.hpp>
+#include <sm/kinematics/UncertainTransformationChain.hpp>
+
+
+TEST(UncertainTransformationChainTestSuite, testBoxTimesCovariance)
+{
+  using namespace sm::kinematics;
+
+  for(int i = 0; i < 100; i++)
+    {
+      UncertainTransformation T_a_b;
+      T_a_b.setRandom();
+      UncertainTransformation::covariance_t U;
+      U.setRandom();
+      U = U * U.transpose();
+
+      const UncertainTransformation::covariance_t Tbox = boxTimes(T_a_b.T());
+      const UncertainTransformation::covariance_t expected = Tbox * U * Tbox.transpose();
+      UncertainTransformation::covariance_t U_a;
+      boxTimesCovariance(T_a_b.C(), T_a_b.t(), U, U_a);
+      sm::eigen::assertNear(expected, U_a, 1e-10, SM_SOURCE_FILE_POS, "Checking the covariance against the dense product");
+      // in place
+      boxTimesCovariance(T_a_b.C(), T_a_b.t(), U, U);
+      sm::eigen::assertEqual(U_a, U, SM_SOURCE_FILE_POS, "Checking the covariance computed in place");
+    }
+}
+
+TEST(UncertainTransformationChainTestSuite, testPacking)
+{
+  using namespace sm::kinematics;
+
+  UncertainTransformation::covariance_t U;
+  U.setRandom();
+  U = U * U.transpose();
+  PackedCovariance packed;
+  packCovariance(U, packed);
+  EXPECT_EQ(U(0,0), packed[0]);
+  EXPECT_EQ(U(0,5), packed[5]);
+  EXPECT_EQ(U(1,1), packed[6]);
+  EXPECT_EQ(U(5,5), packed[20]);
+  UncertainTransformation::covariance_t unpacked;
+  unpackCovariance(packed, unpacked);
+  sm::eigen::assertEqual(U, unpacked, SM_SOURCE_FILE_POS, "Checking the round trip");
+}
+
+TEST(UncertainTransformationChainTestSuite, testChainMatchesComposition)
+{
+  using namespace sm::kinematics;
+
+  const int N = 50;
+  std::vector<UncertainTransformation> T_i_ip1(N);
+  std::vector<TransformationD> poses(N);
+  PackedCovariances U_i_ip1(21, N);
+  for(int i = 0; i < N; i++)
+    {
+      T_i_ip1[i].setRandom(1.0, 0.3);
+      UncertainTransformation::covariance_t U = T_i_ip1[i].U() * 1e-3;
+      T_i_ip1[i].setU(U);
+      poses[i] = TransformationD(T_i_ip1[i]);
+      packCovariance(U, U_i_ip1.col(i));
+    }
+
+  UncertainTransformationChain chain;
+  std::vector<TransformationD> T_0_i;
+  PackedCovariances U_0_i;
+  UncertainTransformationChain batch;
+  batch.appendAll(poses, U_i_ip1, T_0_i, U_0_i);
+  ASSERT_EQ(N, static_cast<int>(T_0_i.size()));
+  ASSERT_EQ(N, U_0_i.cols());
+
+  UncertainTransformation expected;
+  for(int i = 0; i < N; i++)
+    {
+      expected = expected * T_i_ip1[i];
+      chain.append(T_i_ip1[i]);
+      UncertainTransformation result = chain.toUncertainTransformation();
+      sm::eigen::assertNear(expected.T(), result.T(), 1e-10, SM_SOURCE_FILE_POS, "Checking the pose of the chain");
+      sm::eigen::assertNear(expected.U(), result.U(), 1e-8, SM_SOURCE_FILE_POS, "Checking the covariance of the chain");
+
+      sm::eigen::assertNear(expected.T(), T_0_i[i].T(), 1e-10, SM_SOURCE_FILE_POS, "Checking the batched pose");
+      UncertainTransformation::covariance_t U;
+      unpackCovariance(U_0_i.col(i), U);
+      sm::eigen::assertNear(expected.U(), U, 1e-8, SM_SOURCE_FILE_POS, "Checking the batched covariance");
+    }
+
+  // Appending a certain transformation moves the pose only.
+  Transformation T;
+  T.setRandom();
+  expected = expected * T;
+  chain.append(T);
+  sm::eigen::assertNear(expected.T(), chain.toUncertainTransformation().T(), 1e-10, SM_SOURCE_FILE_POS, "Checking the pose after a certain transformation");
+  sm::eigen::assertNear(expected.U(), chain.U(), 1e-8, SM_SOURCE_FILE_POS, "Checking the covariance after a certain transformation");
+
+  chain.reset();
+  sm::eigen::assertEqual(UncertainTransformation::covariance_t::Zero().eval(), chain.U(), SM_SOURCE_FILE_POS, "Checking the reset");
+}
+
+TEST(UncertainTransformationChainTestSuite, testComposeCovariances)
+{
+  using namespace sm::kinematics;
+
+  UncertainTransformation T_a_b;
+  T_a_b.setRandom();
+  const int N = 20;
+  std::vector<UncertainTransformation> T_b_i(N);
+  PackedCovariances U_b_i(21, N);
+  for(int i = 0; i < N; i++)
+    {
+      T_b_i[i].setRandom();
+      packCovariance(T_b_i[i].U(), U_b_i.col(i));
+    }
+  PackedCovariances U_a_i;
+  composeCovariances(T_a_b, U_b_i, U_a_i);
+  ASSERT_EQ(N, U_a_i.cols());
+  for(int i = 0; i < N; i++)
+    {
+      UncertainTransformation::covariance_t U;
+      unpackCovariance(U_a_i.col(i), U);
+      sm::eigen::assertNear((T_a_b * T_b_i[i]).U(), U, 1e-10, SM_SOURCE_FILE_POS, "Checking the covariance of pose " + std::to_string(i));
+    }
+  // in place
+  composeCovariances(T_a_b, U_b_i, U_b_i);
+  sm::eigen::assertEqual(U_a_i, U_b_i, SM_SOURCE_FILE_POS, "Checking the in place composition");
+}
@@ -0,0 +1,173 @@
+// Bring in gtest
+#include <gtest/gtest.h>
+
+// Helpful functions from libsm
+#include <sm/eigen/gtest.hpp>
+#include <sm/kinematics/se3.hpp>
+#include <sm/kinematics/quaternion_algebra.hpp>
+#include <sm/kinematics/transformations.hpp>
+#include <sm/kinematics/Transformation.hpp>
+#include "RandomTestData.hpp"
+
+namespace {
+  using sm::kinematics::test::randomVector;
+
+  // A random tangent vector [rho; phi] with |phi| = theta.
+  Eigen::Matrix<double, 6, 1> randomTangent(double theta)
+  {
+    Eigen::Matrix<double, 6, 1> xi = randomVector<6>(2.0);
+    xi.tail<3>() = xi.tail<3>().normalized() * theta;
+    return xi;
+  }
+
+  Eigen::Matrix4d inverse(const Eigen::Matrix4d & T)
+  {
+    Eigen::Matrix4d Ti = Eigen::Matrix4d::Identity();
+    Ti.topLeftCorner<3,3>() = T.topLeftCorner<3,3>().transpose();
+    Ti.topRightCorner<3,1>() = -Ti.topLeftCorner<3,3>() * T.topRightCorner<3,1>();
+    return Ti;
+  }
+
+  // Central differences of log(exp(xi + dxi) exp(xi)^-1) or log(exp(xi)^-1 exp(xi + dxi)).
+  Eigen::Matrix<double, 6, 6> numericalJacobian(const Eigen::Matrix<double, 6, 1> & xi, bool left)
+  {
+    using namespace sm::kinematics;
+    const double h = 1e-6;
+    const Eigen::Matrix4d Ti = inverse(se3::exp(xi));
+    Eigen::Matrix<double, 6, 6> J;
+    for(int i = 0; i < 6; ++i)
+    {
+      Eigen::Matrix<double, 6, 1> dxi = Eigen::Matrix<double, 6, 1>::Zero();
+      dxi[i] = h;
+      const Eigen::Matrix<double, 6, 1> xp = xi + dxi, xm = xi - dxi;
+      const Eigen::Matrix4d Tp = left ? Eigen::Matrix4d(se3::exp(xp) * Ti) : Eigen::Matrix4d(Ti * se3::exp(xp));
+      const Eigen::Matrix4d Tm = left ? Eigen::Matrix4d(se3::exp(xm) * Ti) : Eigen::Matrix4d(Ti * se3::exp(xm));
+      J.col(i) = (se3::log(Tp) - se3::log(Tm)) / (2 * h);
+    }
+    return J;
+  }
+
+  const double angles[] = { 0.0, 1e-9, 1e-4, 5e-3, 0.011, 0.05, 0.5, 2.0, 3.1 };
+} // namespace
+
+TEST(Se3TestSuite, testSo3MatchesQuaternionAlgebra)
+{
+  using namespace sm::kinematics;
+  for(double theta : angles)
+  {
+    for(int i = 0; i < 10; i++)
+    {
+      const Eigen::Vector3d phi = randomTangent(theta).tail<3>();
+      const std::string msg = "theta " + std::to_string(theta);
+      const so3::Kernel<double> kernel(phi);
+      sm::eigen::assertNear(quat2r(axisAngle2quat(phi)), kernel.exp(), 1e-14, SM_SOURCE_FILE_POS, msg);
+      sm::eigen::assertNear(axisAngle2quat(phi), kernel.quaternion(), 1e-15, SM_SOURCE_FILE_POS, msg);
+      sm::eigen::assertNear(expDiffMat(phi), kernel.Jl(), 1e-12, SM_SOURCE_FILE_POS, msg);
+      sm::eigen::assertNear(expDiffMat<double>(-phi), kernel.Jr(), 1e-12, SM_SOURCE_FILE_POS, msg);
+      sm::eigen::assertNear(Eigen::Matrix3d::Identity(), kernel.JlInverse() * kernel.Jl(), 1e-14, SM_SOURCE_FILE_POS, msg);
+      sm::eigen::assertNear(Eigen::Matrix3d::Identity(), kernel.JrInverse() * kernel.Jr(), 1e-14, SM_SOURCE_FILE_POS, msg);
+      sm::eigen::assertNear(phi, so3::log(kernel.exp()), 1e-12, SM_SOURCE_FILE_POS, msg);
+      sm::eigen::assertNear(phi, so3::logQuaternion<double>(-kernel.quaternion()), 1e-14, SM_SOURCE_FILE_POS, msg);
+    }
+  }
+}
+
+TEST(Se3TestSuite, testExpMatchesTransformation)
+{
+  using namespace sm::kinematics;
+  for(double theta : angles)
+  {
+    for(int i = 0; i < 10; i++)
+    {
+      const Eigen::Matrix<double, 6, 1> xi = randomTangent(theta);
+      const Eigen::Vector3d phi = xi.tail<3>();
+      const Eigen::Matrix4d T = se3::exp(xi);
+      const std::string msg = "theta " + std::to_string(theta);
+      sm::eigen::assertNear(quat2r(axisAngle2quat(phi)), T.topLeftCorner<3,3>(), 1e-14, SM_SOURCE_FILE_POS, msg);
+      sm::eigen::assertNear(expDiffMat(phi) * xi.head<3>(), T.topRightCorner<3,1>(), 1e-12, SM_SOURCE_FILE_POS, msg);
+      sm::eigen::assertNear(Eigen::RowVector4d(0, 0, 0, 1), T.row(3), 0.0, SM_SOURCE_FILE_POS, msg);
+      sm::eigen::assertNear(xi, se3::log(T), 1e-12, SM_SOURCE_FILE_POS, msg);
+    }
+  }
+
+  // log() of a Transformation and exp() back.
+  for(int i = 0; i < 100; i++)
+  {
+    Transformation T;
+    T.setRandom();
+    sm::eigen::assertNear(T.T(), se3::exp(se3::log(T.T())), 1e-12, SM_SOURCE_FILE_POS);
+  }
+}
+
+TEST(Se3TestSuite, testAdjoint)
+{
+  using namespace sm::kinematics;
+  for(int i = 0; i < 100; i++)
+  {
+    Transformation T;
+    T.setRandom();
+    const Eigen::Matrix<double, 6, 6> A = se3::adjoint(T.T());
+    sm::eigen::assertNear(boxTimes(T.T()), A, 1e-14, SM_SOURCE_FILE_POS);
+
+    const Eigen::Matrix<double, 6, 1> xi = randomTangent(1.0);
+    sm::eigen::assertNear(T.T() * se3::exp(xi) * T.inverse().T(), se3::exp<double>(A * xi), 1e-12, SM_SOURCE_FILE_POS);
+  }
+}
+
+TEST(Se3TestSuite, testJacobians)
+{
+  using namespace sm::kinematics;
+  for(double theta : angles)
+  {
+    for(int i = 0; i < 5; i++)
+    {
+      const Eigen::Matrix<double, 6, 1> xi = randomTangent(theta);
+      const se3::Kernel<double> kernel(xi);
+      const std::string msg = "theta " + std::to_string(theta);
+      sm::eigen::assertNear(numericalJacobian(xi, true), kernel.Jl(), 1e-7, SM_SOURCE_FILE_POS, msg);
+      sm::eigen::assertNear(numericalJacobian(xi, false), kernel.Jr(), 1e-7, SM_SOURCE_FILE_POS, msg);
+      sm::eigen::assertNear(se3::Jl<double>(-xi), kernel.Jr(), 1e-14, SM_SOURCE_FILE_POS, msg);
+      sm::eigen::assertNear(kernel.Jl(), se3::adjoint(kernel.exp()) * kernel.Jr(), 1e-12, SM_SOURCE_FILE_POS, msg);
+
+      const Eigen::Matrix<double, 6, 6> I = Eigen::Matrix<double, 6, 6>::Identity();
+      sm::eigen::assertNear(I, kernel.JlInverse() * kernel.Jl(), 1e-12, SM_SOURCE_FILE_POS, msg);
+      sm::eigen::assertNear(I, kernel.JrInverse() * kernel.Jr(), 1e-12, SM_SOURCE_FILE_POS, msg);
+    }
+  }
+}
+
+TEST(Se3TestSuite, testSmallAngleContinuity)
+{
+  using namespace sm::kinematics;
+  // The series and the closed forms agree at the threshold.
+  const double threshold = std::pow(std::numeric_limits<double>::epsilon(), 1.0/8.0);
+  const Eigen::Matrix<double, 6, 1> xi = randomTangent(1.0);
+  const Eigen::Vector3d axis = xi.tail<3>();
+  Eigen::Matrix<double, 6, 1> below = xi, above = xi;
+  below.tail<3>() = axis * threshold * (1 - 1e-12);
+  above.tail<3>() = axis * threshold * (1 + 1e-12);
+  const se3::Kernel<double> kb(below), ka(above);
+  EXPECT_NEAR(ka.rotation().a(), kb.rotation().a(), 1e-15);
+  EXPECT_NEAR(ka.rotation().b(), kb.rotation().b(), 1e-15);
+  EXPECT_NEAR(ka.rotation().c(), kb.rotation().c(), 1e-11);
+  EXPECT_NEAR(ka.rotation().d(), kb.rotation().d(), 1e-11);
+  sm::eigen::assertNear(ka.Jl(), kb.Jl(), 1e-12, SM_SOURCE_FILE_POS);
+  sm::eigen::assertNear(ka.JrInverse(), kb.JrInverse(), 1e-12, SM_SOURCE_FILE_POS);
+}
+
+TEST(Se3TestSuite, testFloat)
+{
+  using namespace sm::kinematics;
+  for(double theta : angles)
+  {
+    const Eigen::Matrix<double, 6, 1> xi = randomTangent(theta);
+    const Eigen::Matrix<float, 6, 1> xif = xi.cast<float>();
+    const se3::Kernel<float> kernel(xif);
+    const se3::Kernel<double> reference(xi);
+    const std::string msg = "theta " + std::to_string(theta);
+    sm::eigen::assertNear(reference.exp(), kernel.exp().cast<double>(), 1e-5, SM_SOURCE_FILE_POS, msg);
+    sm::eigen::assertNear(reference.Jl(), kernel.Jl().cast<double>(), 1e-5, SM_SOURCE_FILE_POS, msg);
+    sm::eigen::assertNear(reference.JrInverse(), kernel.JrInverse().cast<double>(), 1e-5, SM_SOURCE_FILE_POS, msg);
+    sm::eigen::assertNear(xi, se3::log(kernel.exp()).cast<double>(), 1e-4, SM_SOURCE_FILE_POS, msg);
+  }
+}
@@ -0,0 +1,124 @@
+#include <gtest/gtest.h>
+#include <sm/kinematics/three_point_methods.hpp>
+#include <sm/kinematics/three_point_ransac.hpp>
+#include <sm/kinematics/rotations.hpp>
+#include <sm/kinematics/Transformation.hpp>
+#include <sm/eigen/gtest.hpp>
+#include "RandomTestData.hpp"
+
+namespace {
+  Eigen::Matrix3Xd randomPoints(int n, double bound)
+  {
+    return sm::kinematics::test::randomMatrix<3>(n, bound);
+  }
+
+  // p0 = T_0_1 * p1 with noise, and every outlierStride-th pair replaced by an outlier.
+  void makeProblem(const Eigen::Matrix4d & T_0_1, int n, int outlierStride, bool unitVectors,
+                   Eigen::Matrix3Xd & p0, Eigen::Matrix3Xd & p1, std::vector<int> & inliers)
+  {
+    p1 = randomPoints(n, 20.0);
+    if(unitVectors)
+    {
+      p1.colwise().normalize();
+    }
+    p0 = (T_0_1.topLeftCorner<3,3>() * p1).colwise() + T_0_1.topRightCorner<3,1>();
+    p0 += randomPoints(n, 1e-3);
+    const Eigen::Matrix3Xd outliers = randomPoints(n, 20.0);
+    inliers.clear();
+    for(int i = 0; i < n; ++i)
+    {
+      if(i % outlierStride == 0)
+      {
+        p0.col(i) = outliers.col(i);
+      }
+      else
+      {
+        inliers.push_back(i);
+      }
+      if(unitVectors)
+      {
+        p0.col(i).normalize();
+      }
+    }
+  }
+} // namespace
+
+TEST(SmKinematicsTests, testThreePointFixedSizeKernels)
+{
+  using namespace sm::kinematics;
+  for(int i = 0; i < 20; ++i)
+  {
+    Eigen::Matrix3d p0 = randomPoints(3, 10.0);
+    Eigen::Matrix3d p1 = randomPoints(3, 10.0);
+    Eigen::MatrixXd d0 = p0, d1 = p1;
+    sm::eigen::assertNear(threePointSvd(d0, d1), threePointSvd(p0, p1), 1e-12, SM_SOURCE_FILE_POS);
+
+    Eigen::Matrix<double, 3, 2> u0 = p0.leftCols<2>().colwise().normalized();
+    Eigen::Matrix<double, 3, 2> u1 = p1.leftCols<2>().colwise().normalized();
+    Eigen::MatrixXd du0 = u0, du1 = u1;
+    sm::eigen::assertNear(qMethod(du0, du1), qMethod(u0, u1), 1e-12, SM_SOURCE_FILE_POS);
+    Eigen::VectorXd w = Eigen::Vector2d(0.3, 2.0);
+    sm::eigen::assertNear(qMethod(du0, du1, w), qMethod(u0, u1, Eigen::Vector2d(0.3, 2.0)), 1e-12, SM_SOURCE_FILE_POS);
+  }
+}
+
+TEST(SmKinematicsTests, testThreePointSvdRansac)
+{
+  using namespace sm::kinematics;
+  Transformation T;
+  T.setRandom(10.0, M_PI);
+  Eigen::Matrix3Xd p0, p1;
+  std::vector<int> inliers;
+  // every third pair is an outlier
+  makeProblem(T.T(), 600, 3, false, p0, p1, inliers);
+
+  const int numThreads[] = { 1, 4 };
+  const bool localOptimization[] = { true, false };
+  for(int threads : numThreads)
+  {
+    for(bool lo : localOptimization)
+    {
+      RansacOptions options;
+      options.inlierThreshold = 0.05;
+      options.numThreads = threads;
+      options.localOptimization = lo;
+      RansacResult result;
+      Eigen::Matrix4d T_0_1 = threePointSvdRansac(p0, p1, options, &result);
+      sm::eigen::assertNear(T.T(), T_0_1, 1e-3, SM_SOURCE_FILE_POS, "threads " + std::to_string(threads) + ", lo " + std::to_string(lo));
+      EXPECT_EQ(inliers, result.inliers);
+      // The adaptive bound is far below the maximum for 2/3 inliers.
+      EXPECT_LT(result.iterations, 100);
+      EXPECT_EQ(lo, result.refits > 0);
+    }
+  }
+}
+
+TEST(SmKinematicsTests, testQMethodRansac)
+{
+  using namespace sm::kinematics;
+  Transformation T;
+  T.setRandom(0.0, M_PI);
+  Eigen::Matrix3Xd p0, p1;
+  std::vector<int> inliers;
+  // every other pair is an outlier
+  makeProblem(T.T(), 400, 2, true, p0, p1, inliers);
+
+  RansacOptions options;
+  options.inlierThreshold = 0.01;
+  RansacResult result;
+  Eigen::Matrix3d C_0_1 = qMethodRansac(p0, p1, options, &result);
+  sm::eigen::assertNear(T.C(), C_0_1, 1e-3, SM_SOURCE_FILE_POS);
+  EXPECT_EQ(inliers, result.inliers);
+}
+
+TEST(SmKinematicsTests, testRansacInvalidInput)
+{
+  using namespace sm::kinematics;
+  Eigen::Matrix3Xd p0 = randomPoints(2, 1.0);
+  EXPECT_THROW(threePointSvdRansac(p0, p0), std::runtime_error);
+  Eigen::Matrix3Xd p1 = randomPoints(10, 1.0);
+  EXPECT_THROW(threePointSvdRansac(p1, p1.leftCols(9)), std::runtime_error);
+  RansacOptions options;
+  options.confidence = 1.0;
+  EXPECT_THROW(qMethodRansac(p1, p1, options), std::runtime_error);
+}
@@ -16,6 +16,10 @@ namespace sm {
         bool isNamedStreamEnabled( const std::string & name );
         void enableNamedStream( const std::string & name );
         void disableNamedStream( const std::string & name );
+        /// \brief Set the level of a stream such as "estimator" or of a hierarchy such as "estimator.*".
+        ///        Names without the "sm." prefix get it. See LoggingGlobals::setNamedStreamLevel().
+        void setNamedStreamLevel( const std::string & name, Level level );
+        void clearNamedStreamLevel( const std::string & name );
 
         
         
@@ -0,0 +1,125 @@
+#ifndef SM_LOGGING_ASYNC_LOGGER_HPP
+#define SM_LOGGING_ASYNC_LOGGER_HPP
+
+#include <sm/logging/Logger.hpp>
+#include <sm/logging/Levels.hpp>
+#include <sm/logging/LogField.hpp>
+#include <boost/shared_ptr.hpp>
+#include <boost/thread.hpp>
+#include <atomic>
+#include <vector>
+#include <string>
+
+namespace sm {
+    namespace logging {
+
+        /**
+         * \class AsyncLogger
+         *
+         * A logger that hands the events to a background thread, which passes
+         * them on to another logger. The calling thread only copies the event
+         * into a bounded lock-free queue, so slow sinks such as a terminal or a
+         * disk no longer block the threads that log. Deferred events (see
+         * SM_LOG_DEFERRED) are queued unformatted and formatted by the sink on
+         * the background thread.
+         *
+         * \code
+         * sm::logging::setLogger(boost::shared_ptr<sm::logging::Logger>(
+         *     new sm::logging::AsyncLogger(boost::shared_ptr<sm::logging::Logger>(new sm::logging::StdOutLogger()))));
+         * \endcode
+         */
+        class AsyncLogger : public Logger
+        {
+        public:
+            /// \brief What to do with an event when the queue is full.
+            enum OverflowPolicy
+            {
+                /// wait until the background thread made room
+                Block,
+                /// drop the event and count it, see droppedEvents()
+                Drop
+            };
+
+            /// \brief capacity is rounded up to a power of two.
+            AsyncLogger(boost::shared_ptr<Logger> sink, size_t capacity = 8192, OverflowPolicy policy = Block);
+            /// \brief passes the queued events on before returning.
+            ~AsyncLogger() override;
+
+            /// \brief wait until all events logged so far were passed on to the sink.
+            void flush();
+
+            /// \brief the number of events dropped because the queue was full.
+            size_t droppedEvents() const;
+
+            boost::shared_ptr<Logger> sink() const;
+            OverflowPolicy overflowPolicy() const;
+            size_t capacity() const;
+
+            /// \brief the producers only share the lock-free queue.
+            bool isThreadSafe() const override { return true; }
+        protected:
+            Time currentTimeImplementation() const override;
+            void logImplementation(const LoggingEvent & event) override;
+            void logDeferredImplementation(const DeferredLoggingEvent & event) override;
+        private:
+            // A queued event. The strings keep their capacity, so copying an
+            // event into a slot that was used before does not allocate.
+            struct Slot
+            {
+                std::atomic<size_t> sequence;
+                std::string streamName;
+                Level level;
+                std::string file;
+                int line;
+                std::string function;
+                std::string message;
+                size_t messageLength;
+                Time time;
+                std::vector<LogField> fields;
+                std::string fieldStrings;
+                // deferred events
+                bool deferred;
+                const char * format;
+                std::vector<char> args;
+            };
+
+            template<typename Event>
+            void push(const Event & event);
+            Slot * tryClaim();
+            void fill(Slot * slot, const LoggingEvent & event);
+            void fill(Slot * slot, const DeferredLoggingEvent & event);
+            void publish(Slot * slot);
+            bool tryPop(Slot *& slot);
+            void release(Slot * slot);
+            void run();
+
+            boost::shared_ptr<Logger> _sink;
+            OverflowPolicy _policy;
+            std::vector<Slot> _slots;
+            size_t _mask;
+
+            // The positions are padded apart, they are written by the producers and the consumer.
+            char _pad0[64];
+            std::atomic<size_t> _enqueuePos;
+            char _pad1[64];
+            std::atomic<size_t> _dequeuePos;
+            char _pad2[64];
+            std::atomic<size_t> _dropped;
+            // events passed on to the sink, for flush()
+            std::atomic<size_t> _processed;
+            std::atomic<bool> _consumerWaiting;
+            // producers blocked on a full queue and threads in flush()
+            std::atomic<size_t> _waiters;
+            std::atomic<bool> _stop;
+
+            boost::mutex _mutex;
+            boost::condition_variable _notEmpty;
+            boost::condition_variable _notFull;
+            boost::thread _thread;
+        };
+
+    } // namespace logging
+} // namespace sm
+
+
+#endif /* SM_LOGGING_ASYNC_LOGGER_HPP */
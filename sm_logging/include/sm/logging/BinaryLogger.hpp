@@ -0,0 +1,83 @@
+#ifndef SM_LOGGING_BINARY_LOGGER_HPP
+#define SM_LOGGING_BINARY_LOGGER_HPP
+
+#include <sm/logging/Logger.hpp>
+#include <boost/thread/mutex.hpp>
+#include <boost/cstdint.hpp>
+#include <fstream>
+#include <deque>
+#include <map>
+#include <string>
+#include <vector>
+
+namespace sm {
+    namespace logging {
+
+        /**
+         * \class BinaryLogger
+         *
+         * A logger that writes the events to a file without formatting them.
+         * Deferred events (see SM_LOG_DEFERRED) are stored as a reference to
+         * their call site plus the encoded arguments; the format string, file,
+         * function and stream name of a call site are only written the first
+         * time it logs. decodeBinaryLog() and the sm_logging_decode tool turn
+         * the file back into events.
+         *
+         * The file starts with the 8 bytes "SMLOG\2\0\0", followed by records
+         * in the byte order of the host. Strings are a u32 length and the bytes.
+         *   'L' call site: u32 id, u8 level, i32 line, streamName, file, function, format
+         *   'D' deferred event: u32 call site id, i64 ns since the epoch, u32 size, arguments
+         *   'M' formatted event: u8 level, i32 line, i64 ns since the epoch, streamName, file, function, message
+         */
+        class BinaryLogger : public Logger
+        {
+        public:
+            /// \brief throws std::runtime_error if the file can't be opened.
+            BinaryLogger(const std::string & path);
+            ~BinaryLogger() override;
+
+            void flush();
+            bool isThreadSafe() const override { return true; }
+        protected:
+            void logImplementation(const LoggingEvent & event) override;
+            void logDeferredImplementation(const DeferredLoggingEvent & event) override;
+        private:
+            // A call site, ordered by the format pointer first so lookups
+            // rarely compare strings.
+            struct CallSite
+            {
+                const char * format;
+                int line;
+                int level;
+                const char * file;
+                const char * streamName;
+                bool operator<(const CallSite & other) const;
+            };
+            struct CallSiteStrings
+            {
+                std::string file;
+                std::string streamName;
+            };
+
+            boost::uint32_t callSiteId(const DeferredLoggingEvent & event);
+            void write(const void * data, size_t size);
+            void writeString(const char * str);
+
+            boost::mutex _mutex;
+            // declared before the stream, which uses it until it is closed
+            std::vector<char> _streamBuffer;
+            std::ofstream _stream;
+            std::map<CallSite, boost::uint32_t> _callSites;
+            // owns the strings the keys of _callSites point to
+            std::deque<CallSiteStrings> _callSiteStrings;
+        };
+
+        /// \brief Read a file written by a BinaryLogger and pass the events to logger.
+        ///        Throws std::runtime_error if the file is not a binary log or corrupt.
+        void decodeBinaryLog(const std::string & path, Logger & logger);
+
+    } // namespace logging
+} // namespace sm
+
+
+#endif /* SM_LOGGING_BINARY_LOGGER_HPP */
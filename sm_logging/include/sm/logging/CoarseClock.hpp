@@ -0,0 +1,36 @@
+#ifndef SM_LOGGING_COARSE_CLOCK_HPP
+#define SM_LOGGING_COARSE_CLOCK_HPP
+
+#include <chrono>
+#if defined(__linux__)
+#include <time.h>
+#endif
+
+namespace sm {
+    namespace logging {
+
+        /**
+         * \brief Seconds of a monotonic clock with a resolution of a few milliseconds.
+         *
+         * The throttled log statements compare this against their rate. On
+         * Linux it reads CLOCK_MONOTONIC_COARSE, which the vDSO serves from
+         * the last timer tick and is several times cheaper than the precise
+         * clocks; elsewhere it falls back to std::chrono::steady_clock.
+         */
+        inline double coarseMonotonicSeconds()
+        {
+#if defined(__linux__) && defined(CLOCK_MONOTONIC_COARSE)
+            timespec ts;
+            if(clock_gettime(CLOCK_MONOTONIC_COARSE, &ts) == 0)
+            {
+                return ts.tv_sec + ts.tv_nsec * 1e-9;
+            }
+#endif
+            return std::chrono::duration<double>(std::chrono::steady_clock::now().time_since_epoch()).count();
+        }
+
+    } // namespace logging
+} // namespace sm
+
+
+#endif /* SM_LOGGING_COARSE_CLOCK_HPP */
@@ -0,0 +1,134 @@
+#ifndef SM_LOGGING_DEFERRED_ARGUMENTS_HPP
+#define SM_LOGGING_DEFERRED_ARGUMENTS_HPP
+
+#include <boost/cstdint.hpp>
+#include <boost/type_traits.hpp>
+#include <boost/utility/enable_if.hpp>
+#include <cstring>
+#include <string>
+#include <vector>
+
+#include <sm/logging/macros.h>
+
+namespace sm {
+    namespace logging {
+
+        /**
+         * The arguments of a printf-style log statement in binary form, so they
+         * can be formatted later, on another thread or by another process.
+         *
+         * Every argument is stored as a one byte type tag followed by its value:
+         * integers as 64 bit, floating point values as double, C strings as a
+         * 32 bit length and the characters (they may not outlive the call) and
+         * other pointers as their address. The byte order is the one of the host.
+         */
+        namespace deferred {
+
+            enum ArgumentType
+            {
+                SignedInteger = 1,
+                UnsignedInteger = 2,
+                Double = 3,
+                String = 4,
+                Pointer = 5
+            };
+
+            inline void appendBytes(std::vector<char> & buffer, const void * data, size_t size)
+            {
+                const char * p = static_cast<const char *>(data);
+                buffer.insert(buffer.end(), p, p + size);
+            }
+
+            template<typename T>
+            inline void appendTagged(std::vector<char> & buffer, ArgumentType type, T value)
+            {
+                buffer.push_back(static_cast<char>(type));
+                appendBytes(buffer, &value, sizeof(value));
+            }
+
+            inline void appendString(std::vector<char> & buffer, const char * value)
+            {
+                if(!value)
+                {
+                    value = "(null)";
+                }
+                const boost::uint32_t size = static_cast<boost::uint32_t>(strlen(value));
+                appendTagged(buffer, String, size);
+                appendBytes(buffer, value, size);
+            }
+
+            // One overload per kind of argument. The enable_if keeps the integer
+            // overloads from swallowing floating point values and vice versa.
+            template<typename T>
+            inline typename boost::enable_if_c<boost::is_integral<T>::value && boost::is_signed<T>::value>::type
+            appendArgument(std::vector<char> & buffer, T value)
+            {
+                appendTagged(buffer, SignedInteger, static_cast<boost::int64_t>(value));
+            }
+
+            template<typename T>
+            inline typename boost::enable_if_c<boost::is_integral<T>::value && !boost::is_signed<T>::value>::type
+            appendArgument(std::vector<char> & buffer, T value)
+            {
+                appendTagged(buffer, UnsignedInteger, static_cast<boost::uint64_t>(value));
+            }
+
+            template<typename T>
+            inline typename boost::enable_if_c<boost::is_enum<T>::value>::type
+            appendArgument(std::vector<char> & buffer, T value)
+            {
+                appendTagged(buffer, SignedInteger, static_cast<boost::int64_t>(value));
+            }
+
+            template<typename T>
+            inline typename boost::enable_if_c<boost::is_floating_point<T>::value>::type
+            appendArgument(std::vector<char> & buffer, T value)
+            {
+                appendTagged(buffer, Double, static_cast<double>(value));
+            }
+
+            inline void appendArgument(std::vector<char> & buffer, const char * value)
+            {
+                appendString(buffer, value);
+            }
+
+            inline void appendArgument(std::vector<char> & buffer, char * value)
+            {
+                appendString(buffer, value);
+            }
+
+            template<typename T>
+            inline void appendArgument(std::vector<char> & buffer, T * value)
+            {
+                appendTagged(buffer, Pointer, static_cast<boost::uint64_t>(reinterpret_cast<boost::uintptr_t>(value)));
+            }
+
+            inline void appendArguments(std::vector<char> &)
+            {
+            }
+
+            template<typename T, typename... Args>
+            inline void appendArguments(std::vector<char> & buffer, const T & value, const Args &... args)
+            {
+                appendArgument(buffer, value);
+                appendArguments(buffer, args...);
+            }
+
+            /// \brief Format the encoded arguments with the printf format fmt and append the result to out.
+            ///
+            /// Arguments are converted to the type the conversion asks for, so a
+            /// mismatch changes the printed value but never reads out of bounds.
+            /// Missing arguments are printed as "<missing>".
+            void format(const char * fmt, const char * args, size_t argsSize, std::string & out);
+
+            /// \brief A function with printf semantics that does nothing. The deferred
+            ///        log macros call it in dead code, so the compiler checks the format.
+            void checkFormat(const char * fmt, ...) SMCONSOLE_PRINTF_ATTRIBUTE(1, 2);
+
+        } // namespace deferred
+
+    } // namespace logging
+} // namespace sm
+
+
+#endif /* SM_LOGGING_DEFERRED_ARGUMENTS_HPP */
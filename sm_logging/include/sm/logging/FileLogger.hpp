@@ -0,0 +1,113 @@
+#ifndef SM_LOGGING_FILE_LOGGER_HPP
+#define SM_LOGGING_FILE_LOGGER_HPP
+
+#include <sm/logging/Logger.hpp>
+#include <sm/logging/Formatter.hpp>
+#include <sm/logging/Levels.hpp>
+#include <boost/thread/mutex.hpp>
+#include <boost/cstdint.hpp>
+#include <string>
+
+namespace sm {
+    namespace logging {
+
+        /**
+         * \class FileLogger
+         *
+         * A logger that formats the events into a large buffer and writes the
+         * buffer to a file when it is full, so that most events cost no system
+         * call. Events at flushLevel or above and events arriving flushInterval
+         * after the last write flush the buffer right away.
+         *
+         * The file can be rotated when it grows beyond maxFileSize or every
+         * rotationInterval. Rotation renames path to path.1, path.1 to
+         * path.2 and so on, deleting the files beyond maxBackups, and then
+         * starts a new path.
+         *
+         * Write errors are reported on stderr and the events are dropped,
+         * logging never throws after the file was opened.
+         */
+        class FileLogger : public Logger
+        {
+        public:
+            enum SyncPolicy
+            {
+                /// leave the data in the page cache
+                NoSync,
+                /// fdatasync() after every write of the buffer
+                DataSync,
+                /// open the file with O_DIRECT, which bypasses the page cache.
+                /// Falls back to NoSync on file systems without O_DIRECT.
+                Direct
+            };
+
+            struct Options
+            {
+                Options();
+
+                /// \brief the size of the write buffer in bytes. Rounded up to 4 kB.
+                size_t bufferSize;
+                /// \brief rotate when the file would grow beyond this many bytes. 0 disables it.
+                boost::uint64_t maxFileSize;
+                /// \brief rotate after this time. 0 disables it.
+                Duration rotationInterval;
+                /// \brief the number of rotated files kept.
+                int maxBackups;
+                /// \brief events at this level or above are written right away.
+                Level flushLevel;
+                /// \brief write the buffer when an event arrives this long after the last write. 0 disables it.
+                Duration flushInterval;
+                SyncPolicy syncPolicy;
+                /// \brief append to an existing file instead of truncating it.
+                bool append;
+            };
+
+            /// \brief throws std::runtime_error if the file can't be opened.
+            FileLogger(const std::string & path, const Options & options = Options());
+            ~FileLogger() override;
+
+            /// \brief write the buffered events to the file.
+            void flush();
+            /// \brief rotate the file now.
+            void rotate();
+
+            const std::string & path() const { return _path; }
+            const Options & options() const { return _options; }
+            /// \brief true if the file was opened with O_DIRECT.
+            bool isDirect() const { return _direct; }
+            bool isThreadSafe() const override { return true; }
+
+            Formatter formatter;
+        protected:
+            void logImplementation(const LoggingEvent & event) override;
+        private:
+            void open(bool append);
+            void close();
+            void writeBuffer(bool all);
+            void writeFully(const char * data, size_t size, boost::uint64_t offset);
+            void rotateUnlocked();
+
+            std::string _path;
+            Options _options;
+            boost::mutex _mutex;
+            int _fd;
+            bool _direct;
+            // aligned to the block size for O_DIRECT
+            char * _buffer;
+            size_t _bufferCapacity;
+            size_t _bufferSize;
+            // The file offset of the buffer. With O_DIRECT the last partial
+            // block stays in the buffer and is written again together with
+            // the next events, so the offset stays aligned.
+            boost::uint64_t _bufferOffset;
+            Time _lastWrite;
+            Time _nextRotation;
+            // the event being formatted
+            std::string _line;
+        };
+
+    } // namespace logging
+} // namespace sm
+
+
+#endif /* SM_LOGGING_FILE_LOGGER_HPP */
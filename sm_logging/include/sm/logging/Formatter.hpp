@@ -3,11 +3,21 @@
 
 #include "Tokens.hpp"
 #include "LoggingEvent.hpp"
+#include <map>
+#include <ostream>
+#include <string>
+#include <vector>
 
 namespace sm {
     namespace logging {
-        
 
+
+        /**
+         * Formats events according to a format such as
+         * "[${severity}] [${time}]: ${message}". init() compiles the format
+         * into a list of fields and fixed text, which format() then appends to
+         * a string without allocating per event.
+         */
         struct Formatter
         {
 
@@ -15,19 +25,32 @@ namespace sm {
             virtual ~Formatter();
 
 
-            TokenPtr createTokenFromType(const std::string& type);
             void init(const char* fmt);
+            /// \brief write the formatted event and a newline to ss and flush it.
             void print(const ::sm::logging::LoggingEvent& event, std::ostream & ss);
-            
+            /// \brief append the formatted event and a newline to out.
+            void format(const ::sm::logging::LoggingEvent& event, std::string & out) const;
+
+            /// \brief set the text substituted for ${name}, for names that are not fields of the event.
+            void setFixedToken(const std::string & name, const std::string & value);
+
             std::string format_;
-            V_Token tokens_;
             bool doColor_;
             typedef std::map<std::string, std::string> M_string;
+            /// \brief the fixed tokens are substituted by init(), use setFixedToken() to change them.
             M_string extra_fixed_tokens_;
 
+        private:
+            struct Instruction
+            {
+                TokenType type;
+                // the text of fixed tokens
+                std::string text;
+            };
+            std::vector<Instruction> instructions_;
 
         };
-       
+
 
     } // namespace logging
 } // namespace sm
@@ -0,0 +1,55 @@
+#ifndef SM_LOGGING_JSON_LINES_LOGGER_HPP
+#define SM_LOGGING_JSON_LINES_LOGGER_HPP
+
+#include <sm/logging/Logger.hpp>
+#include <boost/thread/mutex.hpp>
+#include <fstream>
+#include <ostream>
+#include <string>
+#include <vector>
+
+namespace sm {
+    namespace logging {
+
+        /**
+         * \class JsonLinesLogger
+         *
+         * A logger that writes one JSON object per event and line, for log
+         * analysis tools:
+         *
+         *   {"time":1466426112.123456,"level":"info","stream":"sm.solver","file":"solver.cpp",
+         *    "line":42,"function":"solve","message":"solve","fields":{"iters":12,"cost":0.5}}
+         *
+         * The fields of SM_*_KV statements keep their types, "message" is the
+         * message without them. Events at levels::Error and above flush the
+         * stream.
+         */
+        class JsonLinesLogger : public Logger
+        {
+        public:
+            /// \brief write to stream, which has to outlive the logger.
+            JsonLinesLogger(std::ostream & stream);
+            /// \brief write to a new file, throws std::runtime_error if it can't be opened.
+            JsonLinesLogger(const std::string & path);
+            ~JsonLinesLogger() override;
+
+            void flush();
+            bool isThreadSafe() const override { return true; }
+
+            /// \brief append the JSON object of the event and a newline to out.
+            static void format(const LoggingEvent & event, std::string & out);
+        protected:
+            void logImplementation(const LoggingEvent & event) override;
+        private:
+            boost::mutex _mutex;
+            std::vector<char> _fileBuffer;
+            std::ofstream _file;
+            std::ostream & _stream;
+            std::string _line;
+        };
+
+    } // namespace logging
+} // namespace sm
+
+
+#endif /* SM_LOGGING_JSON_LINES_LOGGER_HPP */
@@ -0,0 +1,125 @@
+#ifndef SM_LOGGING_LOG_FIELD_HPP
+#define SM_LOGGING_LOG_FIELD_HPP
+
+#include <boost/cstdint.hpp>
+#include <cstring>
+#include <string>
+#include <type_traits>
+#include <vector>
+
+namespace sm {
+    namespace logging {
+
+        /**
+         * \brief A typed key-value pair attached to a log event by the SM_*_KV macros.
+         *
+         * The field only points to the key and to string values, like the
+         * strings of a LoggingEvent they are valid during the call of the
+         * logger. Use copyLogFields() to keep them.
+         */
+        struct LogField
+        {
+            enum Type { Int, UInt, Double, Bool, String };
+
+            const char * key;
+            Type type;
+            union
+            {
+                boost::int64_t i;
+                boost::uint64_t u;
+                double d;
+                bool b;
+            };
+            const char * str;
+            size_t length;
+        };
+
+        inline LogField makeLogField(const char * key, bool value)
+        {
+            LogField field;
+            field.key = key;
+            field.type = LogField::Bool;
+            field.b = value;
+            return field;
+        }
+
+        inline LogField makeLogField(const char * key, double value)
+        {
+            LogField field;
+            field.key = key;
+            field.type = LogField::Double;
+            field.d = value;
+            return field;
+        }
+
+        inline LogField makeLogField(const char * key, float value)
+        {
+            return makeLogField(key, static_cast<double>(value));
+        }
+
+        inline LogField makeLogField(const char * key, const char * value)
+        {
+            LogField field;
+            field.key = key;
+            field.type = LogField::String;
+            field.str = value ? value : "(null)";
+            field.length = strlen(field.str);
+            return field;
+        }
+
+        inline LogField makeLogField(const char * key, const std::string & value)
+        {
+            LogField field;
+            field.key = key;
+            field.type = LogField::String;
+            field.str = value.c_str();
+            field.length = value.size();
+            return field;
+        }
+
+        template<typename T>
+        typename std::enable_if<std::is_integral<T>::value && std::is_signed<T>::value, LogField>::type
+        makeLogField(const char * key, T value)
+        {
+            LogField field;
+            field.key = key;
+            field.type = LogField::Int;
+            field.i = value;
+            return field;
+        }
+
+        template<typename T>
+        typename std::enable_if<std::is_integral<T>::value && !std::is_signed<T>::value && !std::is_same<T, bool>::value, LogField>::type
+        makeLogField(const char * key, T value)
+        {
+            LogField field;
+            field.key = key;
+            field.type = LogField::UInt;
+            field.u = value;
+            return field;
+        }
+
+        inline void makeLogFields(LogField *) {}
+
+        /// \brief fill fields from alternating keys and values.
+        template<typename T, typename... Rest>
+        void makeLogFields(LogField * fields, const char * key, const T & value, const Rest &... rest)
+        {
+            *fields = makeLogField(key, value);
+            makeLogFields(fields + 1, rest...);
+        }
+
+        /// \brief append the value of the field, strings without quotes or escaping.
+        void appendLogFieldValue(const LogField & field, std::string & out);
+
+        /// \brief append " key=value" for every field, strings with spaces are quoted.
+        void appendLogFields(const LogField * fields, size_t numFields, std::string & out);
+
+        /// \brief copy the fields into out, with the keys and strings copied into strings.
+        void copyLogFields(const LogField * fields, size_t numFields, std::vector<LogField> & out, std::string & strings);
+
+    } // namespace logging
+} // namespace sm
+
+
+#endif /* SM_LOGGING_LOG_FIELD_HPP */
@@ -1,17 +1,53 @@
 #ifndef SM_LOGGING_LOG_LOCATION_HPP
 #define SM_LOGGING_LOG_LOCATION_HPP
 
+#include <sm/logging/Levels.hpp>
+#include <atomic>
+#include <boost/cstdint.hpp>
+
 namespace sm {
     namespace logging {
+
+        /**
+         * \brief The state of a log statement.
+         *
+         * Whether the statement is enabled and its level are packed into one
+         * atomic word, so a log statement costs one relaxed load. The word is
+         * 0 until the statement was first hit; afterwards kInitializedBit is
+         * always set. The LoggingGlobals rewrite it whenever the level or the
+         * named streams change, so a location is never stale.
+         *
+         * The location is constant initialised and trivially destructible, so
+         * the function local statics of the log macros need no guard.
+         */
         struct LogLocation
         {
-            LogLocation() : _initialized(false), _loggerEnabled(false),
-                            _level(::sm::logging::levels::Count) {}
+            typedef boost::uint32_t State;
+
+            constexpr LogLocation() : _state(0), _streamName(0) {}
+
+            static bool isEnabled(State state) { return (state & kEnabledBit) != 0; }
+            static Level levelOf(State state) { return static_cast<Level>((state >> kLevelShift) & kLevelMask); }
+            static State makeState(bool enabled, Level level)
+            {
+                return kInitializedBit | (enabled ? kEnabledBit : 0) | (static_cast<State>(level) << kLevelShift);
+            }
+
+            /// \brief the stream name, owned by the LoggingGlobals. Only valid after the state was loaded non-zero.
+            const char * streamName() const
+            {
+                // pairs with the release store that published the state
+                std::atomic_thread_fence(std::memory_order_acquire);
+                return _streamName.load(std::memory_order_relaxed);
+            }
+
+            static const State kEnabledBit = 1;
+            static const int kLevelShift = 1;
+            static const State kLevelMask = 0xf;
+            static const State kInitializedBit = 1 << 5;
 
-            bool _initialized;
-            bool _loggerEnabled;
-            ::sm::logging::Level _level;
-            std::string _streamName;
+            std::atomic<State> _state;
+            std::atomic<const char *> _streamName;
         };
 
     } // namespace logging
@@ -8,6 +8,7 @@ namespace sm {
     namespace logging {
         
         struct LoggingEvent;
+        struct DeferredLoggingEvent;
         
         class Logger
         {
@@ -23,11 +24,24 @@ namespace sm {
             double currentTimeSecondsUtc() const;
             std::string currentTimeString() const;
             Time currentTime() const;
+            /// \brief seconds since the epoch with microseconds, the format of currentTimeString().
+            static std::string timeString(Time time);
+            /// \brief append timeString(time) to out. The seconds are cached per thread,
+            ///        so usually only the microseconds are formatted.
+            static void appendTimeString(Time time, std::string & out);
 
             void log(const LoggingEvent & event);
+            void logDeferred(const DeferredLoggingEvent & event);
+
+            /// \brief true if log() and logDeferred() may be called from several threads
+            ///        at once. The other loggers are called one thread at a time.
+            virtual bool isThreadSafe() const;
         protected:
             virtual Time currentTimeImplementation() const;
             virtual void logImplementation(const LoggingEvent & event) = 0;
+            /// \brief the default formats the message and passes it to logImplementation().
+            ///        Override it to keep the formatting off the calling thread.
+            virtual void logDeferredImplementation(const DeferredLoggingEvent & event);
         };
 
     } // namespace logging
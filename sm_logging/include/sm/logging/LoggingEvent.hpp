@@ -2,6 +2,8 @@
 #define SM_LOGGING_EVENT_HPP
 
 #include <sm/logging/Levels.hpp>
+#include <sm/logging/Logger.hpp>
+#include <sm/logging/LogField.hpp>
 #include <vector>
 #include <string>
 
@@ -16,23 +18,76 @@ namespace sm {
                          const char* file, int line, 
                          const char* function,
                          const char * message,
-                         const std::string & timestring) :
+                         Logger::Time time,
+                         const LogField * fields = NULL,
+                         size_t numFields = 0,
+                         size_t messageLength = std::string::npos) :
                 streamName(streamName),
                 level(level),
                 file(file),
                 line(line),
                 function(function),
                 message(message),
-                timestring(timestring)
+                time(time),
+                fields(fields),
+                numFields(numFields),
+                messageLength(messageLength)
                 {}
 
+            /// \brief the time formatted by Logger::timeString(). Formatters should
+            ///        use Logger::appendTimeString(), which does not allocate.
+            std::string timeString() const { return Logger::timeString(time); }
+
             const char * streamName;
             Level level;         
             const char * file;
             int line;            
             const char * function;
             const char * message;
-            std::string timestring;
+            Logger::Time time;
+            /// \brief the fields of SM_*_KV statements. The message already ends with them
+            ///        as " key=value", for the sinks that only print text.
+            const LogField * fields;
+            size_t numFields;
+            /// \brief the length of the message without the text of the fields,
+            ///        std::string::npos if the whole message is text.
+            size_t messageLength;
+        };
+
+        /// \brief A log statement whose message was not formatted yet.
+        ///
+        /// The message is the printf format applied to the arguments encoded
+        /// with deferred::appendArguments(). The format has to be a string
+        /// literal, sinks may keep the pointer.
+        struct DeferredLoggingEvent
+        {
+            DeferredLoggingEvent(const char* streamName,
+                                 Level level,
+                                 const char* file, int line,
+                                 const char* function,
+                                 const char* format,
+                                 const char* args, size_t argsSize,
+                                 Logger::Time time) :
+                streamName(streamName),
+                level(level),
+                file(file),
+                line(line),
+                function(function),
+                format(format),
+                args(args),
+                argsSize(argsSize),
+                time(time)
+                {}
+
+            const char * streamName;
+            Level level;
+            const char * file;
+            int line;
+            const char * function;
+            const char * format;
+            const char * args;
+            size_t argsSize;
+            Logger::Time time;
         };
         
         
@@ -7,6 +7,8 @@
 #include <stdarg.h>
 #include <vector>
 #include <set>
+#include <map>
+#include <atomic>
 
 #include <sm/logging/macros.h>
 #include <sm/logging/Levels.hpp>
@@ -15,6 +17,7 @@
 #include <boost/interprocess/streams/vectorstream.hpp>
 #include <boost/thread.hpp>
 #include <sm/logging/Logger.hpp>
+#include <sm/logging/DeferredArguments.hpp>
 
 
 
@@ -47,9 +50,13 @@ namespace sm {
 
             void checkLogLocationEnabledNoLock(LogLocation* loc);
 
-            void initializeLogLocation(LogLocation* loc, const std::string& name, Level level);
+            /// \brief Set the stream name and level of a location the first time it is hit.
+            /// \return the state of the location
+            LogLocation::State initializeLogLocation(LogLocation* loc, const std::string& name, Level level);
 
-            void setLogLocationLevel(LogLocation* loc, Level level);
+            /// \brief Change the level of a location, for statements with a level that is not constant.
+            /// \return the state of the location
+            LogLocation::State setLogLocationLevel(LogLocation* loc, Level level);
 
             void checkLogLocationEnabled(LogLocation* loc);
 
@@ -58,28 +65,42 @@ namespace sm {
             /**
              * \brief Tells the system that a logger's level has changed
              *
-             * This must be called if a log4cxx::Logger's level has been changed in the middle of an application run.
-             * Because of the way the static guard for enablement works, if a logger's level is changed and this
-             * function is not called, only logging statements which are first hit *after* the change will be correct wrt
-             * that logger.
+             * Recomputes the state of all logging locations. setLevel() and
+             * the named stream functions call it.
              */
             void notifyLoggerLevelsChanged();
 
         
+            /// \brief true if the stream was enabled or has a level other than levels::Count, directly or through a parent.
             bool isNamedStreamEnabled( const std::string & name );
 
             void enableNamedStream( const std::string & name );
 
             void disableNamedStream( const std::string & name );
 
+            /**
+             * \brief Set the level of a named stream, which replaces the global level for it.
+             *
+             * name is either a stream like "sm.estimator" or a hierarchy
+             * like "sm.estimator.*", which applies to all streams below
+             * sm.estimator that have no level of their own; the longest
+             * matching hierarchy wins. A stream with a level is enabled,
+             * levels::Count turns it off.
+             */
+            void setNamedStreamLevel( const std::string & name, Level level );
+
+            /// \brief Remove the level set with setNamedStreamLevel().
+            void clearNamedStreamLevel( const std::string & name );
+
             sm::logging::levels::Level getLevel();
             void setLevel( sm::logging::levels::Level level );        
             void setLogger( boost::shared_ptr<Logger> logger );
             boost::shared_ptr<Logger> getLogger();
 
 
-            void vformatToBuffer(const char* fmt, va_list args);
-            void formatToBuffer(const char* fmt, ...);
+            /// \brief Format into a buffer of the calling thread, which stays valid until its next call.
+            const char* vformatToBuffer(const char* fmt, va_list args);
+            const char* formatToBuffer(const char* fmt, ...) SMCONSOLE_PRINTF_ATTRIBUTE(2, 3);
 
 
             
@@ -87,7 +108,22 @@ namespace sm {
             void print(const char * streamName,  Level level, 
                        vectorstream & ss, const char* file, int line, const char* function);
 
-            Level _level;
+            /// \brief Log the format and the arguments without formatting them.
+            ///        fmt must be a string literal.
+            template<typename... Args>
+            void printDeferred(const char * streamName, Level level, const char* file, int line, const char* function,
+                               const char* fmt, const Args &... args);
+            void printDeferred(const char * streamName, Level level, const char* file, int line, const char* function,
+                               const char* fmt, const std::vector<char> & args);
+
+            /// \brief Log the message with fields made from alternating keys and values.
+            template<typename... KeysAndValues>
+            void printFields(const char * streamName, Level level, const char* file, int line, const char* function,
+                             const char* message, const KeysAndValues &... keysAndValues);
+            void printFieldArray(const char * streamName, Level level, const char* file, int line, const char* function,
+                                 const char* message, const LogField * fields, size_t numFields);
+
+            std::atomic<Level> _level;
             
             boost::shared_ptr<Logger> _logger;
 
@@ -96,21 +132,56 @@ namespace sm {
             boost::mutex _init_mutex;
 
 
+            // guards the locations and the named stream settings
             boost::mutex _locations_mutex;
             V_LogLocation _log_locations;
 
-            boost::recursive_mutex _named_stream_mutex;
             std::set< std::string > _namedStreamsEnabled;
+            std::map< std::string, Level > _namedStreamLevels;
+            // owns the stream names of the locations
+            std::set< std::string > _streamNames;
             
-            std::vector<char> _globalCharBuffer;
+            // serialises the calls of loggers that are not thread safe
             boost::mutex _print_mutex;
-            boost::thread::id _printing_thread_id;
 
+        private:
+            // locks _print_mutex unless the logger is thread safe
+            boost::mutex::scoped_lock printLock();
+            void notifyLoggerLevelsChangedNoLock();
+            LogLocation::State logLocationStateNoLock(const char* streamName, Level level);
+            // false if the stream is disabled, otherwise sets the level that applies to it
+            bool namedStreamLevelNoLock(const std::string & name, Level & level);
 
         };
 
         extern LoggingGlobals g_logging_globals;
 
+        /// \brief prefix + "." + name, the stream name of the _NAMED log statements.
+        std::string namedStreamName(const char * prefix, const char * name);
+        std::string namedStreamName(const char * prefix, const std::string & name);
+
+        template<typename... KeysAndValues>
+        void LoggingGlobals::printFields(const char * streamName, Level level, const char* file, int line, const char* function,
+                                         const char* message, const KeysAndValues &... keysAndValues)
+        {
+            static_assert(sizeof...(KeysAndValues) % 2 == 0, "The fields have to be pairs of a key and a value");
+            // one more, so the array is never empty
+            LogField fields[sizeof...(KeysAndValues) / 2 + 1];
+            makeLogFields(fields, keysAndValues...);
+            printFieldArray(streamName, level, file, line, function, message, fields, sizeof...(KeysAndValues) / 2);
+        }
+
+        template<typename... Args>
+        void LoggingGlobals::printDeferred(const char * streamName, Level level, const char* file, int line, const char* function,
+                                           const char* fmt, const Args &... args)
+        {
+            // Reused by the following statements of this thread, so encoding does not allocate.
+            static thread_local std::vector<char> buffer;
+            buffer.clear();
+            deferred::appendArguments(buffer, args...);
+            printDeferred(streamName, level, file, line, function, fmt, buffer);
+        }
+
     } // namespace logging
 } // namespace sm
 
@@ -0,0 +1,53 @@
+#ifndef SM_LOGGING_MULTI_LOGGER_HPP
+#define SM_LOGGING_MULTI_LOGGER_HPP
+
+#include <sm/logging/Logger.hpp>
+#include <sm/logging/Levels.hpp>
+#include <boost/shared_ptr.hpp>
+#include <boost/thread/mutex.hpp>
+#include <vector>
+
+namespace sm {
+    namespace logging {
+
+        /**
+         * \class MultiLogger
+         *
+         * Passes each event on to several loggers, e.g. the console and a
+         * file. Every logger has its own level, events below it are not
+         * passed to that logger. The global level still applies first.
+         */
+        class MultiLogger : public Logger
+        {
+        public:
+            MultiLogger();
+            ~MultiLogger() override;
+
+            /// \brief add a logger receiving the events at level or above.
+            void addLogger(const boost::shared_ptr<Logger> & logger, Level level = levels::All);
+            /// \brief change the level of a logger that was added.
+            void setLevel(const boost::shared_ptr<Logger> & logger, Level level);
+            void removeLogger(const boost::shared_ptr<Logger> & logger);
+            size_t numLoggers() const;
+
+            /// \brief the loggers are called one thread at a time.
+            bool isThreadSafe() const override { return true; }
+        protected:
+            void logImplementation(const LoggingEvent & event) override;
+            void logDeferredImplementation(const DeferredLoggingEvent & event) override;
+        private:
+            struct Sink
+            {
+                boost::shared_ptr<Logger> logger;
+                Level level;
+            };
+
+            mutable boost::mutex _mutex;
+            std::vector<Sink> _sinks;
+        };
+
+    } // namespace logging
+} // namespace sm
+
+
+#endif /* SM_LOGGING_MULTI_LOGGER_HPP */
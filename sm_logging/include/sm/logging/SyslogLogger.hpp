@@ -0,0 +1,46 @@
+#ifndef SM_LOGGING_SYSLOG_LOGGER_HPP
+#define SM_LOGGING_SYSLOG_LOGGER_HPP
+
+#include <sm/logging/Logger.hpp>
+#include <sm/logging/Formatter.hpp>
+#include <boost/thread/mutex.hpp>
+#include <string>
+
+namespace sm {
+    namespace logging {
+
+        /**
+         * \class SyslogLogger
+         *
+         * A logger that sends the events to syslog(3), which journald also
+         * collects. The levels are mapped to syslog priorities, and syslog
+         * adds the time, so the default format is "[${streamname}] ${message}".
+         *
+         * openlog() configures the whole process; only use one SyslogLogger.
+         */
+        class SyslogLogger : public Logger
+        {
+        public:
+            /// \brief facility is one of the LOG_* facilities of <syslog.h>, LOG_USER by default.
+            SyslogLogger(const std::string & ident, int facility = -1);
+            ~SyslogLogger() override;
+
+            /// \brief the syslog priority of a level.
+            static int priority(Level level);
+            bool isThreadSafe() const override { return true; }
+
+            Formatter formatter;
+        protected:
+            void logImplementation(const LoggingEvent & event) override;
+        private:
+            // openlog() keeps the pointer
+            std::string _ident;
+            boost::mutex _mutex;
+            std::string _line;
+        };
+
+    } // namespace logging
+} // namespace sm
+
+
+#endif /* SM_LOGGING_SYSLOG_LOGGER_HPP */
@@ -36,8 +36,10 @@
 #include <sstream>
 
 #include <cstdarg>
+#include <cmath>
 #include <sm/logging/macros.h>
 #include <sm/logging/Levels.hpp>
+#include <sm/logging/CoarseClock.hpp>
 #include <sm/logging/LoggingGlobals.hpp>
 #include <boost/interprocess/streams/vectorstream.hpp>
 
@@ -64,21 +66,40 @@ namespace sm
 
 
 
+// name is only evaluated the first time the statement is hit, the location
+// keeps the stream name. Afterwards checking the statement is one relaxed
+// load of the location state.
 #define SMCONSOLE_DEFINE_LOCATION(cond, level, name)                    \
     static ::sm::logging::LogLocation loc;                              \
-    if (SM_UNLIKELY(!loc._initialized))                                 \
+    ::sm::logging::LogLocation::State state___ = loc._state.load(std::memory_order_relaxed); \
+    if (SM_UNLIKELY(state___ == 0))                                     \
     {                                                                   \
-        ::sm::logging::g_logging_globals.initializeLogLocation(&loc, name, level); \
+        state___ = ::sm::logging::g_logging_globals.initializeLogLocation(&loc, name, level); \
     }                                                                   \
-    if (SM_UNLIKELY(loc._level != level))                               \
+    if (SM_UNLIKELY(::sm::logging::LogLocation::levelOf(state___) != (level))) \
     {                                                                   \
-        ::sm::logging::g_logging_globals.setLogLocationLevel(&loc, level);             \
-        ::sm::logging::g_logging_globals.checkLogLocationEnabled(&loc);                \
+        state___ = ::sm::logging::g_logging_globals.setLogLocationLevel(&loc, level); \
     }                                                                   \
-    bool enabled = loc._loggerEnabled && (cond);
+    bool enabled = ::sm::logging::LogLocation::isEnabled(state___) && (cond);
+
+// The stream name of the _NAMED statements, built out of line so the call
+// sites stay small.
+#define SMCONSOLE_NAMED_STREAM_NAME(name)                               \
+    ::sm::logging::namedStreamName(SMCONSOLE_NAME_PREFIX, name)
 
 #define SMCONSOLE_PRINT_AT_LOCATION(...)                      \
-    ::sm::logging::g_logging_globals.print(loc._streamName.c_str(), loc._level, __FILE__, __LINE__, __SMCONSOLE_FUNCTION__, __VA_ARGS__)
+    ::sm::logging::g_logging_globals.print(loc.streamName(), ::sm::logging::LogLocation::levelOf(state___), __FILE__, __LINE__, __SMCONSOLE_FUNCTION__, __VA_ARGS__)
+
+
+#define SMCONSOLE_PRINT_DEFERRED_AT_LOCATION(...)                       \
+    do                                                                  \
+    {                                                                   \
+        if (false)                                                      \
+        {                                                               \
+            ::sm::logging::deferred::checkFormat(__VA_ARGS__);          \
+        }                                                               \
+        ::sm::logging::g_logging_globals.printDeferred(loc.streamName(), ::sm::logging::LogLocation::levelOf(state___), __FILE__, __LINE__, __SMCONSOLE_FUNCTION__, __VA_ARGS__); \
+    } while (0)
 
 
 #define SMCONSOLE_PRINT_STREAM_AT_LOCATION(args)                        \
@@ -86,7 +107,7 @@ namespace sm
     {                                                                   \
         ::sm::logging::vectorstream ss___;                              \
          ss___ << args;                                                 \
-        ::sm::logging::g_logging_globals.print(loc._streamName.c_str(), loc._level, ss___, __FILE__, __LINE__, __SMCONSOLE_FUNCTION__); \
+        ::sm::logging::g_logging_globals.print(loc.streamName(), ::sm::logging::LogLocation::levelOf(state___), ss___, __FILE__, __LINE__, __SMCONSOLE_FUNCTION__); \
     } while (0)
 
 
@@ -176,12 +197,15 @@ namespace sm
     do                                                                  \
     {                                                                   \
         SMCONSOLE_DEFINE_LOCATION(true, level, name);                   \
-        static double last_hit = 0.0;                                   \
-        double now = ::sm::logging::g_logging_globals._logger->currentTimeSecondsUtc(); \
-        if (SM_UNLIKELY(enabled) && SM_UNLIKELY(last_hit + rate <= now)) \
+        static double last_hit = -HUGE_VAL;                             \
+        if (SM_UNLIKELY(enabled))                                       \
         {                                                               \
-            last_hit = now;                                             \
-            SMCONSOLE_PRINT_AT_LOCATION(__VA_ARGS__);                   \
+            double now = ::sm::logging::coarseMonotonicSeconds();       \
+            if (last_hit + rate <= now)                                 \
+            {                                                           \
+                last_hit = now;                                         \
+                SMCONSOLE_PRINT_AT_LOCATION(__VA_ARGS__);               \
+            }                                                           \
         }                                                               \
     } while(0)
 
@@ -196,12 +220,15 @@ namespace sm
     do                                                                  \
     {                                                                   \
         SMCONSOLE_DEFINE_LOCATION(true, level, name);                   \
-        static double last_hit = 0.0;                                   \
-        double now = ::sm::logging::g_logging_globals._logger->currentTimeSecondsUtc(); \
-        if (SM_UNLIKELY(enabled) && SM_UNLIKELY(last_hit + rate <= now)) \
+        static double last_hit = -HUGE_VAL;                             \
+        if (SM_UNLIKELY(enabled))                                       \
         {                                                               \
-            last_hit = now;                                             \
-            SMCONSOLE_PRINT_STREAM_AT_LOCATION(args);                   \
+            double now = ::sm::logging::coarseMonotonicSeconds();       \
+            if (last_hit + rate <= now)                                 \
+            {                                                           \
+                last_hit = now;                                         \
+                SMCONSOLE_PRINT_STREAM_AT_LOCATION(args);               \
+            }                                                           \
         }                                                               \
     } while(0)
 
@@ -238,6 +265,52 @@ namespace sm
  */
 #define SM_LOG_STREAM(level, name, args) SM_LOG_STREAM_COND(true, level, name, args)
 
+/**
+ * \brief Log to a given named logger at a given verbosity level, with printf-style formatting deferred to the logger
+ *
+ * Only the format, which must be a string literal, and the arguments are passed
+ * to the logger. An AsyncLogger formats the message on its own thread, other
+ * loggers format it right away. The arguments may be numbers, enums, C strings
+ * and pointers.
+ *
+ * \param level One of the levels specified in ::sm::logging::levels::Level
+ * \param name Name of the logger.  Note that this is the fully qualified name, and does NOT include "sm.<package_name>".  Use SMCONSOLE_DEFAULT_NAME if you would like to use the default name.
+ */
+#define SM_LOG_DEFERRED(level, name, ...)                               \
+    do                                                                  \
+    {                                                                   \
+        SMCONSOLE_DEFINE_LOCATION(true, level, name);                   \
+        if (SM_UNLIKELY(enabled))                                       \
+        {                                                               \
+            SMCONSOLE_PRINT_DEFERRED_AT_LOCATION(__VA_ARGS__);          \
+        }                                                               \
+    } while(0)
+
+/**
+ * \brief Log a message with typed fields to a given named logger at a given verbosity level
+ *
+ * The arguments after the message alternate between a key, which has to be a
+ * string literal, and a value, which is an integer, a floating point number,
+ * a bool or a string:
+ *
+ *   SM_INFO_KV("solve", "iters", n, "cost", c);
+ *
+ * Text sinks print the message followed by " iters=12 cost=0.5", structured
+ * sinks like the JsonLinesLogger keep the fields typed.
+ *
+ * \param level One of the levels specified in ::sm::logging::levels::Level
+ * \param name Name of the logger.  Note that this is the fully qualified name, and does NOT include "sm.<package_name>".  Use SMCONSOLE_DEFAULT_NAME if you would like to use the default name.
+ */
+#define SM_LOG_KV(level, name, ...)                                     \
+    do                                                                  \
+    {                                                                   \
+        SMCONSOLE_DEFINE_LOCATION(true, level, name);                   \
+        if (SM_UNLIKELY(enabled))                                       \
+        {                                                               \
+            ::sm::logging::g_logging_globals.printFields(loc.streamName(), ::sm::logging::LogLocation::levelOf(state___), __FILE__, __LINE__, __SMCONSOLE_FUNCTION__, __VA_ARGS__); \
+        }                                                               \
+    } while(0)
+
 #include "macros_generated.hpp"
 
 #endif // SMCONSOLE_SMCONSOLE_H
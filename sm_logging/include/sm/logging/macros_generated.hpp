@@ -46,23 +46,29 @@
 #define SM_ALL_STREAM_THROTTLE(rate, args)
 #define SM_ALL_THROTTLE_NAMED(rate, name, ...)
 #define SM_ALL_STREAM_THROTTLE_NAMED(rate, name, args)
+#define SM_ALL_DEFERRED(...)
+#define SM_ALL_KV(...)
+#define SM_ALL_KV_NAMED(name, ...)
 #else
-#define SM_ALL(...) SM_LOG(::sm::logging::levels::All, SMCONSOLE_NAME_PREFIX, __VA_ARGS__)
-#define SM_ALL_STREAM(args) SM_LOG_STREAM(::sm::logging::levels::All, SMCONSOLE_NAME_PREFIX, args)
-#define SM_ALL_NAMED(name, ...) SM_LOG(::sm::logging::levels::All, std::string(SMCONSOLE_NAME_PREFIX) + "." + name, __VA_ARGS__)
-#define SM_ALL_STREAM_NAMED(name, args) SM_LOG_STREAM(::sm::logging::levels::All, std::string(SMCONSOLE_NAME_PREFIX) + "." + name, args)
-#define SM_ALL_COND(cond, ...) SM_LOG_COND(cond, ::sm::logging::levels::All, SMCONSOLE_NAME_PREFIX, __VA_ARGS__)
-#define SM_ALL_STREAM_COND(cond, args) SM_LOG_STREAM_COND(cond, ::sm::logging::levels::All, SMCONSOLE_NAME_PREFIX, args)
-#define SM_ALL_COND_NAMED(cond, name, ...) SM_LOG_COND(cond, ::sm::logging::levels::All, std::string(SMCONSOLE_NAME_PREFIX) + "." + name, __VA_ARGS__)
-#define SM_ALL_STREAM_COND_NAMED(cond, name, args) SM_LOG_STREAM_COND(cond, ::sm::logging::levels::All, std::string(SMCONSOLE_NAME_PREFIX) + "." + name, args)
-#define SM_ALL_ONCE(...) SM_LOG_ONCE(::sm::logging::levels::All, SMCONSOLE_NAME_PREFIX, __VA_ARGS__)
-#define SM_ALL_STREAM_ONCE(args) SM_LOG_STREAM_ONCE(::sm::logging::levels::All, SMCONSOLE_NAME_PREFIX, args)
-#define SM_ALL_ONCE_NAMED(name, ...) SM_LOG_ONCE(::sm::logging::levels::All, std::string(SMCONSOLE_NAME_PREFIX) + "." + name, __VA_ARGS__)
-#define SM_ALL_STREAM_ONCE_NAMED(name, args) SM_LOG_STREAM_ONCE(::sm::logging::levels::All, std::string(SMCONSOLE_NAME_PREFIX) + "." + name, args)
-#define SM_ALL_THROTTLE(rate, ...) SM_LOG_THROTTLE(rate, ::sm::logging::levels::All, SMCONSOLE_NAME_PREFIX, __VA_ARGS__)
-#define SM_ALL_STREAM_THROTTLE(rate, args) SM_LOG_STREAM_THROTTLE(rate, ::sm::logging::levels::All, SMCONSOLE_NAME_PREFIX, args)
-#define SM_ALL_THROTTLE_NAMED(rate, name, ...) SM_LOG_THROTTLE(rate, ::sm::logging::levels::All, std::string(SMCONSOLE_NAME_PREFIX) + "." + name, __VA_ARGS__)
-#define SM_ALL_STREAM_THROTTLE_NAMED(rate, name, args) SM_LOG_STREAM_THROTTLE(rate, ::sm::logging::levels::All, std::string(SMCONSOLE_NAME_PREFIX) + "." + name, args)
+#define SM_ALL(...) SM_LOG(::sm::logging::levels::All, SMCONSOLE_DEFAULT_NAME, __VA_ARGS__)
+#define SM_ALL_STREAM(args) SM_LOG_STREAM(::sm::logging::levels::All, SMCONSOLE_DEFAULT_NAME, args)
+#define SM_ALL_NAMED(name, ...) SM_LOG(::sm::logging::levels::All, SMCONSOLE_NAMED_STREAM_NAME(name), __VA_ARGS__)
+#define SM_ALL_STREAM_NAMED(name, args) SM_LOG_STREAM(::sm::logging::levels::All, SMCONSOLE_NAMED_STREAM_NAME(name), args)
+#define SM_ALL_COND(cond, ...) SM_LOG_COND(cond, ::sm::logging::levels::All, SMCONSOLE_DEFAULT_NAME, __VA_ARGS__)
+#define SM_ALL_STREAM_COND(cond, args) SM_LOG_STREAM_COND(cond, ::sm::logging::levels::All, SMCONSOLE_DEFAULT_NAME, args)
+#define SM_ALL_COND_NAMED(cond, name, ...) SM_LOG_COND(cond, ::sm::logging::levels::All, SMCONSOLE_NAMED_STREAM_NAME(name), __VA_ARGS__)
+#define SM_ALL_STREAM_COND_NAMED(cond, name, args) SM_LOG_STREAM_COND(cond, ::sm::logging::levels::All, SMCONSOLE_NAMED_STREAM_NAME(name), args)
+#define SM_ALL_ONCE(...) SM_LOG_ONCE(::sm::logging::levels::All, SMCONSOLE_DEFAULT_NAME, __VA_ARGS__)
+#define SM_ALL_STREAM_ONCE(args) SM_LOG_STREAM_ONCE(::sm::logging::levels::All, SMCONSOLE_DEFAULT_NAME, args)
+#define SM_ALL_ONCE_NAMED(name, ...) SM_LOG_ONCE(::sm::logging::levels::All, SMCONSOLE_NAMED_STREAM_NAME(name), __VA_ARGS__)
+#define SM_ALL_STREAM_ONCE_NAMED(name, args) SM_LOG_STREAM_ONCE(::sm::logging::levels::All, SMCONSOLE_NAMED_STREAM_NAME(name), args)
+#define SM_ALL_THROTTLE(rate, ...) SM_LOG_THROTTLE(rate, ::sm::logging::levels::All, SMCONSOLE_DEFAULT_NAME, __VA_ARGS__)
+#define SM_ALL_STREAM_THROTTLE(rate, args) SM_LOG_STREAM_THROTTLE(rate, ::sm::logging::levels::All, SMCONSOLE_DEFAULT_NAME, args)
+#define SM_ALL_THROTTLE_NAMED(rate, name, ...) SM_LOG_THROTTLE(rate, ::sm::logging::levels::All, SMCONSOLE_NAMED_STREAM_NAME(name), __VA_ARGS__)
+#define SM_ALL_STREAM_THROTTLE_NAMED(rate, name, args) SM_LOG_STREAM_THROTTLE(rate, ::sm::logging::levels::All, SMCONSOLE_NAMED_STREAM_NAME(name), args)
+#define SM_ALL_DEFERRED(...) SM_LOG_DEFERRED(::sm::logging::levels::All, SMCONSOLE_DEFAULT_NAME, __VA_ARGS__)
+#define SM_ALL_KV(...) SM_LOG_KV(::sm::logging::levels::All, SMCONSOLE_DEFAULT_NAME, __VA_ARGS__)
+#define SM_ALL_KV_NAMED(name, ...) SM_LOG_KV(::sm::logging::levels::All, SMCONSOLE_NAMED_STREAM_NAME(name), __VA_ARGS__)
 #endif
 
 #if (SMCONSOLE_MIN_SEVERITY > SMCONSOLE_SEVERITY_FINEST)
@@ -82,23 +88,29 @@
 #define SM_FINEST_STREAM_THROTTLE(rate, args)
 #define SM_FINEST_THROTTLE_NAMED(rate, name, ...)
 #define SM_FINEST_STREAM_THROTTLE_NAMED(rate, name, args)
+#define SM_FINEST_DEFERRED(...)
+#define SM_FINEST_KV(...)
+#define SM_FINEST_KV_NAMED(name, ...)
 #else
-#define SM_FINEST(...) SM_LOG(::sm::logging::levels::Finest, SMCONSOLE_NAME_PREFIX, __VA_ARGS__)
-#define SM_FINEST_STREAM(args) SM_LOG_STREAM(::sm::logging::levels::Finest, SMCONSOLE_NAME_PREFIX, args)
-#define SM_FINEST_NAMED(name, ...) SM_LOG(::sm::logging::levels::Finest, std::string(SMCONSOLE_NAME_PREFIX) + "." + name, __VA_ARGS__)
-#define SM_FINEST_STREAM_NAMED(name, args) SM_LOG_STREAM(::sm::logging::levels::Finest, std::string(SMCONSOLE_NAME_PREFIX) + "." + name, args)
-#define SM_FINEST_COND(cond, ...) SM_LOG_COND(cond, ::sm::logging::levels::Finest, SMCONSOLE_NAME_PREFIX, __VA_ARGS__)
-#define SM_FINEST_STREAM_COND(cond, args) SM_LOG_STREAM_COND(cond, ::sm::logging::levels::Finest, SMCONSOLE_NAME_PREFIX, args)
-#define SM_FINEST_COND_NAMED(cond, name, ...) SM_LOG_COND(cond, ::sm::logging::levels::Finest, std::string(SMCONSOLE_NAME_PREFIX) + "." + name, __VA_ARGS__)
-#define SM_FINEST_STREAM_COND_NAMED(cond, name, args) SM_LOG_STREAM_COND(cond, ::sm::logging::levels::Finest, std::string(SMCONSOLE_NAME_PREFIX) + "." + name, args)
-#define SM_FINEST_ONCE(...) SM_LOG_ONCE(::sm::logging::levels::Finest, SMCONSOLE_NAME_PREFIX, __VA_ARGS__)
-#define SM_FINEST_STREAM_ONCE(args) SM_LOG_STREAM_ONCE(::sm::logging::levels::Finest, SMCONSOLE_NAME_PREFIX, args)
-#define SM_FINEST_ONCE_NAMED(name, ...) SM_LOG_ONCE(::sm::logging::levels::Finest, std::string(SMCONSOLE_NAME_PREFIX) + "." + name, __VA_ARGS__)
-#define SM_FINEST_STREAM_ONCE_NAMED(name, args) SM_LOG_STREAM_ONCE(::sm::logging::levels::Finest, std::string(SMCONSOLE_NAME_PREFIX) + "." + name, args)
-#define SM_FINEST_THROTTLE(rate, ...) SM_LOG_THROTTLE(rate, ::sm::logging::levels::Finest, SMCONSOLE_NAME_PREFIX, __VA_ARGS__)
-#define SM_FINEST_STREAM_THROTTLE(rate, args) SM_LOG_STREAM_THROTTLE(rate, ::sm::logging::levels::Finest, SMCONSOLE_NAME_PREFIX, args)
-#define SM_FINEST_THROTTLE_NAMED(rate, name, ...) SM_LOG_THROTTLE(rate, ::sm::logging::levels::Finest, std::string(SMCONSOLE_NAME_PREFIX) + "." + name, __VA_ARGS__)
-#define SM_FINEST_STREAM_THROTTLE_NAMED(rate, name, args) SM_LOG_STREAM_THROTTLE(rate, ::sm::logging::levels::Finest, std::string(SMCONSOLE_NAME_PREFIX) + "." + name, args)
+#define SM_FINEST(...) SM_LOG(::sm::logging::levels::Finest, SMCONSOLE_DEFAULT_NAME, __VA_ARGS__)
+#define SM_FINEST_STREAM(args) SM_LOG_STREAM(::sm::logging::levels::Finest, SMCONSOLE_DEFAULT_NAME, args)
+#define SM_FINEST_NAMED(name, ...) SM_LOG(::sm::logging::levels::Finest, SMCONSOLE_NAMED_STREAM_NAME(name), __VA_ARGS__)
+#define SM_FINEST_STREAM_NAMED(name, args) SM_LOG_STREAM(::sm::logging::levels::Finest, SMCONSOLE_NAMED_STREAM_NAME(name), args)
+#define SM_FINEST_COND(cond, ...) SM_LOG_COND(cond, ::sm::logging::levels::Finest, SMCONSOLE_DEFAULT_NAME, __VA_ARGS__)
+#define SM_FINEST_STREAM_COND(cond, args) SM_LOG_STREAM_COND(cond, ::sm::logging::levels::Finest, SMCONSOLE_DEFAULT_NAME, args)
+#define SM_FINEST_COND_NAMED(cond, name, ...) SM_LOG_COND(cond, ::sm::logging::levels::Finest, SMCONSOLE_NAMED_STREAM_NAME(name), __VA_ARGS__)
+#define SM_FINEST_STREAM_COND_NAMED(cond, name, args) SM_LOG_STREAM_COND(cond, ::sm::logging::levels::Finest, SMCONSOLE_NAMED_STREAM_NAME(name), args)
+#define SM_FINEST_ONCE(...) SM_LOG_ONCE(::sm::logging::levels::Finest, SMCONSOLE_DEFAULT_NAME, __VA_ARGS__)
+#define SM_FINEST_STREAM_ONCE(args) SM_LOG_STREAM_ONCE(::sm::logging::levels::Finest, SMCONSOLE_DEFAULT_NAME, args)
+#define SM_FINEST_ONCE_NAMED(name, ...) SM_LOG_ONCE(::sm::logging::levels::Finest, SMCONSOLE_NAMED_STREAM_NAME(name), __VA_ARGS__)
+#define SM_FINEST_STREAM_ONCE_NAMED(name, args) SM_LOG_STREAM_ONCE(::sm::logging::levels::Finest, SMCONSOLE_NAMED_STREAM_NAME(name), args)
+#define SM_FINEST_THROTTLE(rate, ...) SM_LOG_THROTTLE(rate, ::sm::logging::levels::Finest, SMCONSOLE_DEFAULT_NAME, __VA_ARGS__)
+#define SM_FINEST_STREAM_THROTTLE(rate, args) SM_LOG_STREAM_THROTTLE(rate, ::sm::logging::levels::Finest, SMCONSOLE_DEFAULT_NAME, args)
+#define SM_FINEST_THROTTLE_NAMED(rate, name, ...) SM_LOG_THROTTLE(rate, ::sm::logging::levels::Finest, SMCONSOLE_NAMED_STREAM_NAME(name), __VA_ARGS__)
+#define SM_FINEST_STREAM_THROTTLE_NAMED(rate, name, args) SM_LOG_STREAM_THROTTLE(rate, ::sm::logging::levels::Finest, SMCONSOLE_NAMED_STREAM_NAME(name), args)
+#define SM_FINEST_DEFERRED(...) SM_LOG_DEFERRED(::sm::logging::levels::Finest, SMCONSOLE_DEFAULT_NAME, __VA_ARGS__)
+#define SM_FINEST_KV(...) SM_LOG_KV(::sm::logging::levels::Finest, SMCONSOLE_DEFAULT_NAME, __VA_ARGS__)
+#define SM_FINEST_KV_NAMED(name, ...) SM_LOG_KV(::sm::logging::levels::Finest, SMCONSOLE_NAMED_STREAM_NAME(name), __VA_ARGS__)
 #endif
 
 #if (SMCONSOLE_MIN_SEVERITY > SMCONSOLE_SEVERITY_VERBOSE)
@@ -118,23 +130,29 @@
 #define SM_VERBOSE_STREAM_THROTTLE(rate, args)
 #define SM_VERBOSE_THROTTLE_NAMED(rate, name, ...)
 #define SM_VERBOSE_STREAM_THROTTLE_NAMED(rate, name, args)
+#define SM_VERBOSE_DEFERRED(...)
+#define SM_VERBOSE_KV(...)
+#define SM_VERBOSE_KV_NAMED(name, ...)
 #else
-#define SM_VERBOSE(...) SM_LOG(::sm::logging::levels::Verbose, SMCONSOLE_NAME_PREFIX, __VA_ARGS__)
-#define SM_VERBOSE_STREAM(args) SM_LOG_STREAM(::sm::logging::levels::Verbose, SMCONSOLE_NAME_PREFIX, args)
-#define SM_VERBOSE_NAMED(name, ...) SM_LOG(::sm::logging::levels::Verbose, std::string(SMCONSOLE_NAME_PREFIX) + "." + name, __VA_ARGS__)
-#define SM_VERBOSE_STREAM_NAMED(name, args) SM_LOG_STREAM(::sm::logging::levels::Verbose, std::string(SMCONSOLE_NAME_PREFIX) + "." + name, args)
-#define SM_VERBOSE_COND(cond, ...) SM_LOG_COND(cond, ::sm::logging::levels::Verbose, SMCONSOLE_NAME_PREFIX, __VA_ARGS__)
-#define SM_VERBOSE_STREAM_COND(cond, args) SM_LOG_STREAM_COND(cond, ::sm::logging::levels::Verbose, SMCONSOLE_NAME_PREFIX, args)
-#define SM_VERBOSE_COND_NAMED(cond, name, ...) SM_LOG_COND(cond, ::sm::logging::levels::Verbose, std::string(SMCONSOLE_NAME_PREFIX) + "." + name, __VA_ARGS__)
-#define SM_VERBOSE_STREAM_COND_NAMED(cond, name, args) SM_LOG_STREAM_COND(cond, ::sm::logging::levels::Verbose, std::string(SMCONSOLE_NAME_PREFIX) + "." + name, args)
-#define SM_VERBOSE_ONCE(...) SM_LOG_ONCE(::sm::logging::levels::Verbose, SMCONSOLE_NAME_PREFIX, __VA_ARGS__)
-#define SM_VERBOSE_STREAM_ONCE(args) SM_LOG_STREAM_ONCE(::sm::logging::levels::Verbose, SMCONSOLE_NAME_PREFIX, args)
-#define SM_VERBOSE_ONCE_NAMED(name, ...) SM_LOG_ONCE(::sm::logging::levels::Verbose, std::string(SMCONSOLE_NAME_PREFIX) + "." + name, __VA_ARGS__)
-#define SM_VERBOSE_STREAM_ONCE_NAMED(name, args) SM_LOG_STREAM_ONCE(::sm::logging::levels::Verbose, std::string(SMCONSOLE_NAME_PREFIX) + "." + name, args)
-#define SM_VERBOSE_THROTTLE(rate, ...) SM_LOG_THROTTLE(rate, ::sm::logging::levels::Verbose, SMCONSOLE_NAME_PREFIX, __VA_ARGS__)
-#define SM_VERBOSE_STREAM_THROTTLE(rate, args) SM_LOG_STREAM_THROTTLE(rate, ::sm::logging::levels::Verbose, SMCONSOLE_NAME_PREFIX, args)
-#define SM_VERBOSE_THROTTLE_NAMED(rate, name, ...) SM_LOG_THROTTLE(rate, ::sm::logging::levels::Verbose, std::string(SMCONSOLE_NAME_PREFIX) + "." + name, __VA_ARGS__)
-#define SM_VERBOSE_STREAM_THROTTLE_NAMED(rate, name, args) SM_LOG_STREAM_THROTTLE(rate, ::sm::logging::levels::Verbose, std::string(SMCONSOLE_NAME_PREFIX) + "." + name, args)
+#define SM_VERBOSE(...) SM_LOG(::sm::logging::levels::Verbose, SMCONSOLE_DEFAULT_NAME, __VA_ARGS__)
+#define SM_VERBOSE_STREAM(args) SM_LOG_STREAM(::sm::logging::levels::Verbose, SMCONSOLE_DEFAULT_NAME, args)
+#define SM_VERBOSE_NAMED(name, ...) SM_LOG(::sm::logging::levels::Verbose, SMCONSOLE_NAMED_STREAM_NAME(name), __VA_ARGS__)
+#define SM_VERBOSE_STREAM_NAMED(name, args) SM_LOG_STREAM(::sm::logging::levels::Verbose, SMCONSOLE_NAMED_STREAM_NAME(name), args)
+#define SM_VERBOSE_COND(cond, ...) SM_LOG_COND(cond, ::sm::logging::levels::Verbose, SMCONSOLE_DEFAULT_NAME, __VA_ARGS__)
+#define SM_VERBOSE_STREAM_COND(cond, args) SM_LOG_STREAM_COND(cond, ::sm::logging::levels::Verbose, SMCONSOLE_DEFAULT_NAME, args)
+#define SM_VERBOSE_COND_NAMED(cond, name, ...) SM_LOG_COND(cond, ::sm::logging::levels::Verbose, SMCONSOLE_NAMED_STREAM_NAME(name), __VA_ARGS__)
+#define SM_VERBOSE_STREAM_COND_NAMED(cond, name, args) SM_LOG_STREAM_COND(cond, ::sm::logging::levels::Verbose, SMCONSOLE_NAMED_STREAM_NAME(name), args)
+#define SM_VERBOSE_ONCE(...) SM_LOG_ONCE(::sm::logging::levels::Verbose, SMCONSOLE_DEFAULT_NAME, __VA_ARGS__)
+#define SM_VERBOSE_STREAM_ONCE(args) SM_LOG_STREAM_ONCE(::sm::logging::levels::Verbose, SMCONSOLE_DEFAULT_NAME, args)
+#define SM_VERBOSE_ONCE_NAMED(name, ...) SM_LOG_ONCE(::sm::logging::levels::Verbose, SMCONSOLE_NAMED_STREAM_NAME(name), __VA_ARGS__)
+#define SM_VERBOSE_STREAM_ONCE_NAMED(name, args) SM_LOG_STREAM_ONCE(::sm::logging::levels::Verbose, SMCONSOLE_NAMED_STREAM_NAME(name), args)
+#define SM_VERBOSE_THROTTLE(rate, ...) SM_LOG_THROTTLE(rate, ::sm::logging::levels::Verbose, SMCONSOLE_DEFAULT_NAME, __VA_ARGS__)
+#define SM_VERBOSE_STREAM_THROTTLE(rate, args) SM_LOG_STREAM_THROTTLE(rate, ::sm::logging::levels::Verbose, SMCONSOLE_DEFAULT_NAME, args)
+#define SM_VERBOSE_THROTTLE_NAMED(rate, name, ...) SM_LOG_THROTTLE(rate, ::sm::logging::levels::Verbose, SMCONSOLE_NAMED_STREAM_NAME(name), __VA_ARGS__)
+#define SM_VERBOSE_STREAM_THROTTLE_NAMED(rate, name, args) SM_LOG_STREAM_THROTTLE(rate, ::sm::logging::levels::Verbose, SMCONSOLE_NAMED_STREAM_NAME(name), args)
+#define SM_VERBOSE_DEFERRED(...) SM_LOG_DEFERRED(::sm::logging::levels::Verbose, SMCONSOLE_DEFAULT_NAME, __VA_ARGS__)
+#define SM_VERBOSE_KV(...) SM_LOG_KV(::sm::logging::levels::Verbose, SMCONSOLE_DEFAULT_NAME, __VA_ARGS__)
+#define SM_VERBOSE_KV_NAMED(name, ...) SM_LOG_KV(::sm::logging::levels::Verbose, SMCONSOLE_NAMED_STREAM_NAME(name), __VA_ARGS__)
 #endif
 
 #if (SMCONSOLE_MIN_SEVERITY > SMCONSOLE_SEVERITY_FINER)
@@ -154,23 +172,29 @@
 #define SM_FINER_STREAM_THROTTLE(rate, args)
 #define SM_FINER_THROTTLE_NAMED(rate, name, ...)
 #define SM_FINER_STREAM_THROTTLE_NAMED(rate, name, args)
+#define SM_FINER_DEFERRED(...)
+#define SM_FINER_KV(...)
+#define SM_FINER_KV_NAMED(name, ...)
 #else
-#define SM_FINER(...) SM_LOG(::sm::logging::levels::Finer, SMCONSOLE_NAME_PREFIX, __VA_ARGS__)
-#define SM_FINER_STREAM(args) SM_LOG_STREAM(::sm::logging::levels::Finer, SMCONSOLE_NAME_PREFIX, args)
-#define SM_FINER_NAMED(name, ...) SM_LOG(::sm::logging::levels::Finer, std::string(SMCONSOLE_NAME_PREFIX) + "." + name, __VA_ARGS__)
-#define SM_FINER_STREAM_NAMED(name, args) SM_LOG_STREAM(::sm::logging::levels::Finer, std::string(SMCONSOLE_NAME_PREFIX) + "." + name, args)
-#define SM_FINER_COND(cond, ...) SM_LOG_COND(cond, ::sm::logging::levels::Finer, SMCONSOLE_NAME_PREFIX, __VA_ARGS__)
-#define SM_FINER_STREAM_COND(cond, args) SM_LOG_STREAM_COND(cond, ::sm::logging::levels::Finer, SMCONSOLE_NAME_PREFIX, args)
-#define SM_FINER_COND_NAMED(cond, name, ...) SM_LOG_COND(cond, ::sm::logging::levels::Finer, std::string(SMCONSOLE_NAME_PREFIX) + "." + name, __VA_ARGS__)
-#define SM_FINER_STREAM_COND_NAMED(cond, name, args) SM_LOG_STREAM_COND(cond, ::sm::logging::levels::Finer, std::string(SMCONSOLE_NAME_PREFIX) + "." + name, args)
-#define SM_FINER_ONCE(...) SM_LOG_ONCE(::sm::logging::levels::Finer, SMCONSOLE_NAME_PREFIX, __VA_ARGS__)
-#define SM_FINER_STREAM_ONCE(args) SM_LOG_STREAM_ONCE(::sm::logging::levels::Finer, SMCONSOLE_NAME_PREFIX, args)
-#define SM_FINER_ONCE_NAMED(name, ...) SM_LOG_ONCE(::sm::logging::levels::Finer, std::string(SMCONSOLE_NAME_PREFIX) + "." + name, __VA_ARGS__)
-#define SM_FINER_STREAM_ONCE_NAMED(name, args) SM_LOG_STREAM_ONCE(::sm::logging::levels::Finer, std::string(SMCONSOLE_NAME_PREFIX) + "." + name, args)
-#define SM_FINER_THROTTLE(rate, ...) SM_LOG_THROTTLE(rate, ::sm::logging::levels::Finer, SMCONSOLE_NAME_PREFIX, __VA_ARGS__)
-#define SM_FINER_STREAM_THROTTLE(rate, args) SM_LOG_STREAM_THROTTLE(rate, ::sm::logging::levels::Finer, SMCONSOLE_NAME_PREFIX, args)
-#define SM_FINER_THROTTLE_NAMED(rate, name, ...) SM_LOG_THROTTLE(rate, ::sm::logging::levels::Finer, std::string(SMCONSOLE_NAME_PREFIX) + "." + name, __VA_ARGS__)
-#define SM_FINER_STREAM_THROTTLE_NAMED(rate, name, args) SM_LOG_STREAM_THROTTLE(rate, ::sm::logging::levels::Finer, std::string(SMCONSOLE_NAME_PREFIX) + "." + name, args)
+#define SM_FINER(...) SM_LOG(::sm::logging::levels::Finer, SMCONSOLE_DEFAULT_NAME, __VA_ARGS__)
+#define SM_FINER_STREAM(args) SM_LOG_STREAM(::sm::logging::levels::Finer, SMCONSOLE_DEFAULT_NAME, args)
+#define SM_FINER_NAMED(name, ...) SM_LOG(::sm::logging::levels::Finer, SMCONSOLE_NAMED_STREAM_NAME(name), __VA_ARGS__)
+#define SM_FINER_STREAM_NAMED(name, args) SM_LOG_STREAM(::sm::logging::levels::Finer, SMCONSOLE_NAMED_STREAM_NAME(name), args)
+#define SM_FINER_COND(cond, ...) SM_LOG_COND(cond, ::sm::logging::levels::Finer, SMCONSOLE_DEFAULT_NAME, __VA_ARGS__)
+#define SM_FINER_STREAM_COND(cond, args) SM_LOG_STREAM_COND(cond, ::sm::logging::levels::Finer, SMCONSOLE_DEFAULT_NAME, args)
+#define SM_FINER_COND_NAMED(cond, name, ...) SM_LOG_COND(cond, ::sm::logging::levels::Finer, SMCONSOLE_NAMED_STREAM_NAME(name), __VA_ARGS__)
+#define SM_FINER_STREAM_COND_NAMED(cond, name, args) SM_LOG_STREAM_COND(cond, ::sm::logging::levels::Finer, SMCONSOLE_NAMED_STREAM_NAME(name), args)
+#define SM_FINER_ONCE(...) SM_LOG_ONCE(::sm::logging::levels::Finer, SMCONSOLE_DEFAULT_NAME, __VA_ARGS__)
+#define SM_FINER_STREAM_ONCE(args) SM_LOG_STREAM_ONCE(::sm::logging::levels::Finer, SMCONSOLE_DEFAULT_NAME, args)
+#define SM_FINER_ONCE_NAMED(name, ...) SM_LOG_ONCE(::sm::logging::levels::Finer, SMCONSOLE_NAMED_STREAM_NAME(name), __VA_ARGS__)
+#define SM_FINER_STREAM_ONCE_NAMED(name, args) SM_LOG_STREAM_ONCE(::sm::logging::levels::Finer, SMCONSOLE_NAMED_STREAM_NAME(name), args)
+#define SM_FINER_THROTTLE(rate, ...) SM_LOG_THROTTLE(rate, ::sm::logging::levels::Finer, SMCONSOLE_DEFAULT_NAME, __VA_ARGS__)
+#define SM_FINER_STREAM_THROTTLE(rate, args) SM_LOG_STREAM_THROTTLE(rate, ::sm::logging::levels::Finer, SMCONSOLE_DEFAULT_NAME, args)
+#define SM_FINER_THROTTLE_NAMED(rate, name, ...) SM_LOG_THROTTLE(rate, ::sm::logging::levels::Finer, SMCONSOLE_NAMED_STREAM_NAME(name), __VA_ARGS__)
+#define SM_FINER_STREAM_THROTTLE_NAMED(rate, name, args) SM_LOG_STREAM_THROTTLE(rate, ::sm::logging::levels::Finer, SMCONSOLE_NAMED_STREAM_NAME(name), args)
+#define SM_FINER_DEFERRED(...) SM_LOG_DEFERRED(::sm::logging::levels::Finer, SMCONSOLE_DEFAULT_NAME, __VA_ARGS__)
+#define SM_FINER_KV(...) SM_LOG_KV(::sm::logging::levels::Finer, SMCONSOLE_DEFAULT_NAME, __VA_ARGS__)
+#define SM_FINER_KV_NAMED(name, ...) SM_LOG_KV(::sm::logging::levels::Finer, SMCONSOLE_NAMED_STREAM_NAME(name), __VA_ARGS__)
 #endif
 
 #if (SMCONSOLE_MIN_SEVERITY > SMCONSOLE_SEVERITY_TRACE)
@@ -190,23 +214,29 @@
 #define SM_TRACE_STREAM_THROTTLE(rate, args)
 #define SM_TRACE_THROTTLE_NAMED(rate, name, ...)
 #define SM_TRACE_STREAM_THROTTLE_NAMED(rate, name, args)
+#define SM_TRACE_DEFERRED(...)
+#define SM_TRACE_KV(...)
+#define SM_TRACE_KV_NAMED(name, ...)
 #else
-#define SM_TRACE(...) SM_LOG(::sm::logging::levels::Trace, SMCONSOLE_NAME_PREFIX, __VA_ARGS__)
-#define SM_TRACE_STREAM(args) SM_LOG_STREAM(::sm::logging::levels::Trace, SMCONSOLE_NAME_PREFIX, args)
-#define SM_TRACE_NAMED(name, ...) SM_LOG(::sm::logging::levels::Trace, std::string(SMCONSOLE_NAME_PREFIX) + "." + name, __VA_ARGS__)
-#define SM_TRACE_STREAM_NAMED(name, args) SM_LOG_STREAM(::sm::logging::levels::Trace, std::string(SMCONSOLE_NAME_PREFIX) + "." + name, args)
-#define SM_TRACE_COND(cond, ...) SM_LOG_COND(cond, ::sm::logging::levels::Trace, SMCONSOLE_NAME_PREFIX, __VA_ARGS__)
-#define SM_TRACE_STREAM_COND(cond, args) SM_LOG_STREAM_COND(cond, ::sm::logging::levels::Trace, SMCONSOLE_NAME_PREFIX, args)
-#define SM_TRACE_COND_NAMED(cond, name, ...) SM_LOG_COND(cond, ::sm::logging::levels::Trace, std::string(SMCONSOLE_NAME_PREFIX) + "." + name, __VA_ARGS__)
-#define SM_TRACE_STREAM_COND_NAMED(cond, name, args) SM_LOG_STREAM_COND(cond, ::sm::logging::levels::Trace, std::string(SMCONSOLE_NAME_PREFIX) + "." + name, args)
-#define SM_TRACE_ONCE(...) SM_LOG_ONCE(::sm::logging::levels::Trace, SMCONSOLE_NAME_PREFIX, __VA_ARGS__)
-#define SM_TRACE_STREAM_ONCE(args) SM_LOG_STREAM_ONCE(::sm::logging::levels::Trace, SMCONSOLE_NAME_PREFIX, args)
-#define SM_TRACE_ONCE_NAMED(name, ...) SM_LOG_ONCE(::sm::logging::levels::Trace, std::string(SMCONSOLE_NAME_PREFIX) + "." + name, __VA_ARGS__)
-#define SM_TRACE_STREAM_ONCE_NAMED(name, args) SM_LOG_STREAM_ONCE(::sm::logging::levels::Trace, std::string(SMCONSOLE_NAME_PREFIX) + "." + name, args)
-#define SM_TRACE_THROTTLE(rate, ...) SM_LOG_THROTTLE(rate, ::sm::logging::levels::Trace, SMCONSOLE_NAME_PREFIX, __VA_ARGS__)
-#define SM_TRACE_STREAM_THROTTLE(rate, args) SM_LOG_STREAM_THROTTLE(rate, ::sm::logging::levels::Trace, SMCONSOLE_NAME_PREFIX, args)
-#define SM_TRACE_THROTTLE_NAMED(rate, name, ...) SM_LOG_THROTTLE(rate, ::sm::logging::levels::Trace, std::string(SMCONSOLE_NAME_PREFIX) + "." + name, __VA_ARGS__)
-#define SM_TRACE_STREAM_THROTTLE_NAMED(rate, name, args) SM_LOG_STREAM_THROTTLE(rate, ::sm::logging::levels::Trace, std::string(SMCONSOLE_NAME_PREFIX) + "." + name, args)
+#define SM_TRACE(...) SM_LOG(::sm::logging::levels::Trace, SMCONSOLE_DEFAULT_NAME, __VA_ARGS__)
+#define SM_TRACE_STREAM(args) SM_LOG_STREAM(::sm::logging::levels::Trace, SMCONSOLE_DEFAULT_NAME, args)
+#define SM_TRACE_NAMED(name, ...) SM_LOG(::sm::logging::levels::Trace, SMCONSOLE_NAMED_STREAM_NAME(name), __VA_ARGS__)
+#define SM_TRACE_STREAM_NAMED(name, args) SM_LOG_STREAM(::sm::logging::levels::Trace, SMCONSOLE_NAMED_STREAM_NAME(name), args)
+#define SM_TRACE_COND(cond, ...) SM_LOG_COND(cond, ::sm::logging::levels::Trace, SMCONSOLE_DEFAULT_NAME, __VA_ARGS__)
+#define SM_TRACE_STREAM_COND(cond, args) SM_LOG_STREAM_COND(cond, ::sm::logging::levels::Trace, SMCONSOLE_DEFAULT_NAME, args)
+#define SM_TRACE_COND_NAMED(cond, name, ...) SM_LOG_COND(cond, ::sm::logging::levels::Trace, SMCONSOLE_NAMED_STREAM_NAME(name), __VA_ARGS__)
+#define SM_TRACE_STREAM_COND_NAMED(cond, name, args) SM_LOG_STREAM_COND(cond, ::sm::logging::levels::Trace, SMCONSOLE_NAMED_STREAM_NAME(name), args)
+#define SM_TRACE_ONCE(...) SM_LOG_ONCE(::sm::logging::levels::Trace, SMCONSOLE_DEFAULT_NAME, __VA_ARGS__)
+#define SM_TRACE_STREAM_ONCE(args) SM_LOG_STREAM_ONCE(::sm::logging::levels::Trace, SMCONSOLE_DEFAULT_NAME, args)
+#define SM_TRACE_ONCE_NAMED(name, ...) SM_LOG_ONCE(::sm::logging::levels::Trace, SMCONSOLE_NAMED_STREAM_NAME(name), __VA_ARGS__)
+#define SM_TRACE_STREAM_ONCE_NAMED(name, args) SM_LOG_STREAM_ONCE(::sm::logging::levels::Trace, SMCONSOLE_NAMED_STREAM_NAME(name), args)
+#define SM_TRACE_THROTTLE(rate, ...) SM_LOG_THROTTLE(rate, ::sm::logging::levels::Trace, SMCONSOLE_DEFAULT_NAME, __VA_ARGS__)
+#define SM_TRACE_STREAM_THROTTLE(rate, args) SM_LOG_STREAM_THROTTLE(rate, ::sm::logging::levels::Trace, SMCONSOLE_DEFAULT_NAME, args)
+#define SM_TRACE_THROTTLE_NAMED(rate, name, ...) SM_LOG_THROTTLE(rate, ::sm::logging::levels::Trace, SMCONSOLE_NAMED_STREAM_NAME(name), __VA_ARGS__)
+#define SM_TRACE_STREAM_THROTTLE_NAMED(rate, name, args) SM_LOG_STREAM_THROTTLE(rate, ::sm::logging::levels::Trace, SMCONSOLE_NAMED_STREAM_NAME(name), args)
+#define SM_TRACE_DEFERRED(...) SM_LOG_DEFERRED(::sm::logging::levels::Trace, SMCONSOLE_DEFAULT_NAME, __VA_ARGS__)
+#define SM_TRACE_KV(...) SM_LOG_KV(::sm::logging::levels::Trace, SMCONSOLE_DEFAULT_NAME, __VA_ARGS__)
+#define SM_TRACE_KV_NAMED(name, ...) SM_LOG_KV(::sm::logging::levels::Trace, SMCONSOLE_NAMED_STREAM_NAME(name), __VA_ARGS__)
 #endif
 
 #if (SMCONSOLE_MIN_SEVERITY > SMCONSOLE_SEVERITY_FINE)
@@ -226,23 +256,29 @@
 #define SM_FINE_STREAM_THROTTLE(rate, args)
 #define SM_FINE_THROTTLE_NAMED(rate, name, ...)
 #define SM_FINE_STREAM_THROTTLE_NAMED(rate, name, args)
+#define SM_FINE_DEFERRED(...)
+#define SM_FINE_KV(...)
+#define SM_FINE_KV_NAMED(name, ...)
 #else
-#define SM_FINE(...) SM_LOG(::sm::logging::levels::Fine, SMCONSOLE_NAME_PREFIX, __VA_ARGS__)
-#define SM_FINE_STREAM(args) SM_LOG_STREAM(::sm::logging::levels::Fine, SMCONSOLE_NAME_PREFIX, args)
-#define SM_FINE_NAMED(name, ...) SM_LOG(::sm::logging::levels::Fine, std::string(SMCONSOLE_NAME_PREFIX) + "." + name, __VA_ARGS__)
-#define SM_FINE_STREAM_NAMED(name, args) SM_LOG_STREAM(::sm::logging::levels::Fine, std::string(SMCONSOLE_NAME_PREFIX) + "." + name, args)
-#define SM_FINE_COND(cond, ...) SM_LOG_COND(cond, ::sm::logging::levels::Fine, SMCONSOLE_NAME_PREFIX, __VA_ARGS__)
-#define SM_FINE_STREAM_COND(cond, args) SM_LOG_STREAM_COND(cond, ::sm::logging::levels::Fine, SMCONSOLE_NAME_PREFIX, args)
-#define SM_FINE_COND_NAMED(cond, name, ...) SM_LOG_COND(cond, ::sm::logging::levels::Fine, std::string(SMCONSOLE_NAME_PREFIX) + "." + name, __VA_ARGS__)
-#define SM_FINE_STREAM_COND_NAMED(cond, name, args) SM_LOG_STREAM_COND(cond, ::sm::logging::levels::Fine, std::string(SMCONSOLE_NAME_PREFIX) + "." + name, args)
-#define SM_FINE_ONCE(...) SM_LOG_ONCE(::sm::logging::levels::Fine, SMCONSOLE_NAME_PREFIX, __VA_ARGS__)
-#define SM_FINE_STREAM_ONCE(args) SM_LOG_STREAM_ONCE(::sm::logging::levels::Fine, SMCONSOLE_NAME_PREFIX, args)
-#define SM_FINE_ONCE_NAMED(name, ...) SM_LOG_ONCE(::sm::logging::levels::Fine, std::string(SMCONSOLE_NAME_PREFIX) + "." + name, __VA_ARGS__)
-#define SM_FINE_STREAM_ONCE_NAMED(name, args) SM_LOG_STREAM_ONCE(::sm::logging::levels::Fine, std::string(SMCONSOLE_NAME_PREFIX) + "." + name, args)
-#define SM_FINE_THROTTLE(rate, ...) SM_LOG_THROTTLE(rate, ::sm::logging::levels::Fine, SMCONSOLE_NAME_PREFIX, __VA_ARGS__)
-#define SM_FINE_STREAM_THROTTLE(rate, args) SM_LOG_STREAM_THROTTLE(rate, ::sm::logging::levels::Fine, SMCONSOLE_NAME_PREFIX, args)
-#define SM_FINE_THROTTLE_NAMED(rate, name, ...) SM_LOG_THROTTLE(rate, ::sm::logging::levels::Fine, std::string(SMCONSOLE_NAME_PREFIX) + "." + name, __VA_ARGS__)
-#define SM_FINE_STREAM_THROTTLE_NAMED(rate, name, args) SM_LOG_STREAM_THROTTLE(rate, ::sm::logging::levels::Fine, std::string(SMCONSOLE_NAME_PREFIX) + "." + name, args)
+#define SM_FINE(...) SM_LOG(::sm::logging::levels::Fine, SMCONSOLE_DEFAULT_NAME, __VA_ARGS__)
+#define SM_FINE_STREAM(args) SM_LOG_STREAM(::sm::logging::levels::Fine, SMCONSOLE_DEFAULT_NAME, args)
+#define SM_FINE_NAMED(name, ...) SM_LOG(::sm::logging::levels::Fine, SMCONSOLE_NAMED_STREAM_NAME(name), __VA_ARGS__)
+#define SM_FINE_STREAM_NAMED(name, args) SM_LOG_STREAM(::sm::logging::levels::Fine, SMCONSOLE_NAMED_STREAM_NAME(name), args)
+#define SM_FINE_COND(cond, ...) SM_LOG_COND(cond, ::sm::logging::levels::Fine, SMCONSOLE_DEFAULT_NAME, __VA_ARGS__)
+#define SM_FINE_STREAM_COND(cond, args) SM_LOG_STREAM_COND(cond, ::sm::logging::levels::Fine, SMCONSOLE_DEFAULT_NAME, args)
+#define SM_FINE_COND_NAMED(cond, name, ...) SM_LOG_COND(cond, ::sm::logging::levels::Fine, SMCONSOLE_NAMED_STREAM_NAME(name), __VA_ARGS__)
+#define SM_FINE_STREAM_COND_NAMED(cond, name, args) SM_LOG_STREAM_COND(cond, ::sm::logging::levels::Fine, SMCONSOLE_NAMED_STREAM_NAME(name), args)
+#define SM_FINE_ONCE(...) SM_LOG_ONCE(::sm::logging::levels::Fine, SMCONSOLE_DEFAULT_NAME, __VA_ARGS__)
+#define SM_FINE_STREAM_ONCE(args) SM_LOG_STREAM_ONCE(::sm::logging::levels::Fine, SMCONSOLE_DEFAULT_NAME, args)
+#define SM_FINE_ONCE_NAMED(name, ...) SM_LOG_ONCE(::sm::logging::levels::Fine, SMCONSOLE_NAMED_STREAM_NAME(name), __VA_ARGS__)
+#define SM_FINE_STREAM_ONCE_NAMED(name, args) SM_LOG_STREAM_ONCE(::sm::logging::levels::Fine, SMCONSOLE_NAMED_STREAM_NAME(name), args)
+#define SM_FINE_THROTTLE(rate, ...) SM_LOG_THROTTLE(rate, ::sm::logging::levels::Fine, SMCONSOLE_DEFAULT_NAME, __VA_ARGS__)
+#define SM_FINE_STREAM_THROTTLE(rate, args) SM_LOG_STREAM_THROTTLE(rate, ::sm::logging::levels::Fine, SMCONSOLE_DEFAULT_NAME, args)
+#define SM_FINE_THROTTLE_NAMED(rate, name, ...) SM_LOG_THROTTLE(rate, ::sm::logging::levels::Fine, SMCONSOLE_NAMED_STREAM_NAME(name), __VA_ARGS__)
+#define SM_FINE_STREAM_THROTTLE_NAMED(rate, name, args) SM_LOG_STREAM_THROTTLE(rate, ::sm::logging::levels::Fine, SMCONSOLE_NAMED_STREAM_NAME(name), args)
+#define SM_FINE_DEFERRED(...) SM_LOG_DEFERRED(::sm::logging::levels::Fine, SMCONSOLE_DEFAULT_NAME, __VA_ARGS__)
+#define SM_FINE_KV(...) SM_LOG_KV(::sm::logging::levels::Fine, SMCONSOLE_DEFAULT_NAME, __VA_ARGS__)
+#define SM_FINE_KV_NAMED(name, ...) SM_LOG_KV(::sm::logging::levels::Fine, SMCONSOLE_NAMED_STREAM_NAME(name), __VA_ARGS__)
 #endif
 
 #if (SMCONSOLE_MIN_SEVERITY > SMCONSOLE_SEVERITY_DEBUG)
@@ -262,23 +298,29 @@
 #define SM_DEBUG_STREAM_THROTTLE(rate, args)
 #define SM_DEBUG_THROTTLE_NAMED(rate, name, ...)
 #define SM_DEBUG_STREAM_THROTTLE_NAMED(rate, name, args)
+#define SM_DEBUG_DEFERRED(...)
+#define SM_DEBUG_KV(...)
+#define SM_DEBUG_KV_NAMED(name, ...)
 #else
-#define SM_DEBUG(...) SM_LOG(::sm::logging::levels::Debug, SMCONSOLE_NAME_PREFIX, __VA_ARGS__)
-#define SM_DEBUG_STREAM(args) SM_LOG_STREAM(::sm::logging::levels::Debug, SMCONSOLE_NAME_PREFIX, args)
-#define SM_DEBUG_NAMED(name, ...) SM_LOG(::sm::logging::levels::Debug, std::string(SMCONSOLE_NAME_PREFIX) + "." + name, __VA_ARGS__)
-#define SM_DEBUG_STREAM_NAMED(name, args) SM_LOG_STREAM(::sm::logging::levels::Debug, std::string(SMCONSOLE_NAME_PREFIX) + "." + name, args)
-#define SM_DEBUG_COND(cond, ...) SM_LOG_COND(cond, ::sm::logging::levels::Debug, SMCONSOLE_NAME_PREFIX, __VA_ARGS__)
-#define SM_DEBUG_STREAM_COND(cond, args) SM_LOG_STREAM_COND(cond, ::sm::logging::levels::Debug, SMCONSOLE_NAME_PREFIX, args)
-#define SM_DEBUG_COND_NAMED(cond, name, ...) SM_LOG_COND(cond, ::sm::logging::levels::Debug, std::string(SMCONSOLE_NAME_PREFIX) + "." + name, __VA_ARGS__)
-#define SM_DEBUG_STREAM_COND_NAMED(cond, name, args) SM_LOG_STREAM_COND(cond, ::sm::logging::levels::Debug, std::string(SMCONSOLE_NAME_PREFIX) + "." + name, args)
-#define SM_DEBUG_ONCE(...) SM_LOG_ONCE(::sm::logging::levels::Debug, SMCONSOLE_NAME_PREFIX, __VA_ARGS__)
-#define SM_DEBUG_STREAM_ONCE(args) SM_LOG_STREAM_ONCE(::sm::logging::levels::Debug, SMCONSOLE_NAME_PREFIX, args)
-#define SM_DEBUG_ONCE_NAMED(name, ...) SM_LOG_ONCE(::sm::logging::levels::Debug, std::string(SMCONSOLE_NAME_PREFIX) + "." + name, __VA_ARGS__)
-#define SM_DEBUG_STREAM_ONCE_NAMED(name, args) SM_LOG_STREAM_ONCE(::sm::logging::levels::Debug, std::string(SMCONSOLE_NAME_PREFIX) + "." + name, args)
-#define SM_DEBUG_THROTTLE(rate, ...) SM_LOG_THROTTLE(rate, ::sm::logging::levels::Debug, SMCONSOLE_NAME_PREFIX, __VA_ARGS__)
-#define SM_DEBUG_STREAM_THROTTLE(rate, args) SM_LOG_STREAM_THROTTLE(rate, ::sm::logging::levels::Debug, SMCONSOLE_NAME_PREFIX, args)
-#define SM_DEBUG_THROTTLE_NAMED(rate, name, ...) SM_LOG_THROTTLE(rate, ::sm::logging::levels::Debug, std::string(SMCONSOLE_NAME_PREFIX) + "." + name, __VA_ARGS__)
-#define SM_DEBUG_STREAM_THROTTLE_NAMED(rate, name, args) SM_LOG_STREAM_THROTTLE(rate, ::sm::logging::levels::Debug, std::string(SMCONSOLE_NAME_PREFIX) + "." + name, args)
+#define SM_DEBUG(...) SM_LOG(::sm::logging::levels::Debug, SMCONSOLE_DEFAULT_NAME, __VA_ARGS__)
+#define SM_DEBUG_STREAM(args) SM_LOG_STREAM(::sm::logging::levels::Debug, SMCONSOLE_DEFAULT_NAME, args)
+#define SM_DEBUG_NAMED(name, ...) SM_LOG(::sm::logging::levels::Debug, SMCONSOLE_NAMED_STREAM_NAME(name), __VA_ARGS__)
+#define SM_DEBUG_STREAM_NAMED(name, args) SM_LOG_STREAM(::sm::logging::levels::Debug, SMCONSOLE_NAMED_STREAM_NAME(name), args)
+#define SM_DEBUG_COND(cond, ...) SM_LOG_COND(cond, ::sm::logging::levels::Debug, SMCONSOLE_DEFAULT_NAME, __VA_ARGS__)
+#define SM_DEBUG_STREAM_COND(cond, args) SM_LOG_STREAM_COND(cond, ::sm::logging::levels::Debug, SMCONSOLE_DEFAULT_NAME, args)
+#define SM_DEBUG_COND_NAMED(cond, name, ...) SM_LOG_COND(cond, ::sm::logging::levels::Debug, SMCONSOLE_NAMED_STREAM_NAME(name), __VA_ARGS__)
+#define SM_DEBUG_STREAM_COND_NAMED(cond, name, args) SM_LOG_STREAM_COND(cond, ::sm::logging::levels::Debug, SMCONSOLE_NAMED_STREAM_NAME(name), args)
+#define SM_DEBUG_ONCE(...) SM_LOG_ONCE(::sm::logging::levels::Debug, SMCONSOLE_DEFAULT_NAME, __VA_ARGS__)
+#define SM_DEBUG_STREAM_ONCE(args) SM_LOG_STREAM_ONCE(::sm::logging::levels::Debug, SMCONSOLE_DEFAULT_NAME, args)
+#define SM_DEBUG_ONCE_NAMED(name, ...) SM_LOG_ONCE(::sm::logging::levels::Debug, SMCONSOLE_NAMED_STREAM_NAME(name), __VA_ARGS__)
+#define SM_DEBUG_STREAM_ONCE_NAMED(name, args) SM_LOG_STREAM_ONCE(::sm::logging::levels::Debug, SMCONSOLE_NAMED_STREAM_NAME(name), args)
+#define SM_DEBUG_THROTTLE(rate, ...) SM_LOG_THROTTLE(rate, ::sm::logging::levels::Debug, SMCONSOLE_DEFAULT_NAME, __VA_ARGS__)
+#define SM_DEBUG_STREAM_THROTTLE(rate, args) SM_LOG_STREAM_THROTTLE(rate, ::sm::logging::levels::Debug, SMCONSOLE_DEFAULT_NAME, args)
+#define SM_DEBUG_THROTTLE_NAMED(rate, name, ...) SM_LOG_THROTTLE(rate, ::sm::logging::levels::Debug, SMCONSOLE_NAMED_STREAM_NAME(name), __VA_ARGS__)
+#define SM_DEBUG_STREAM_THROTTLE_NAMED(rate, name, args) SM_LOG_STREAM_THROTTLE(rate, ::sm::logging::levels::Debug, SMCONSOLE_NAMED_STREAM_NAME(name), args)
+#define SM_DEBUG_DEFERRED(...) SM_LOG_DEFERRED(::sm::logging::levels::Debug, SMCONSOLE_DEFAULT_NAME, __VA_ARGS__)
+#define SM_DEBUG_KV(...) SM_LOG_KV(::sm::logging::levels::Debug, SMCONSOLE_DEFAULT_NAME, __VA_ARGS__)
+#define SM_DEBUG_KV_NAMED(name, ...) SM_LOG_KV(::sm::logging::levels::Debug, SMCONSOLE_NAMED_STREAM_NAME(name), __VA_ARGS__)
 #endif
 
 #if (SMCONSOLE_MIN_SEVERITY > SMCONSOLE_SEVERITY_INFO)
@@ -298,23 +340,29 @@
 #define SM_INFO_STREAM_THROTTLE(rate, args)
 #define SM_INFO_THROTTLE_NAMED(rate, name, ...)
 #define SM_INFO_STREAM_THROTTLE_NAMED(rate, name, args)
+#define SM_INFO_DEFERRED(...)
+#define SM_INFO_KV(...)
+#define SM_INFO_KV_NAMED(name, ...)
 #else
-#define SM_INFO(...) SM_LOG(::sm::logging::levels::Info, SMCONSOLE_NAME_PREFIX, __VA_ARGS__)
-#define SM_INFO_STREAM(args) SM_LOG_STREAM(::sm::logging::levels::Info, SMCONSOLE_NAME_PREFIX, args)
-#define SM_INFO_NAMED(name, ...) SM_LOG(::sm::logging::levels::Info, std::string(SMCONSOLE_NAME_PREFIX) + "." + name, __VA_ARGS__)
-#define SM_INFO_STREAM_NAMED(name, args) SM_LOG_STREAM(::sm::logging::levels::Info, std::string(SMCONSOLE_NAME_PREFIX) + "." + name, args)
-#define SM_INFO_COND(cond, ...) SM_LOG_COND(cond, ::sm::logging::levels::Info, SMCONSOLE_NAME_PREFIX, __VA_ARGS__)
-#define SM_INFO_STREAM_COND(cond, args) SM_LOG_STREAM_COND(cond, ::sm::logging::levels::Info, SMCONSOLE_NAME_PREFIX, args)
-#define SM_INFO_COND_NAMED(cond, name, ...) SM_LOG_COND(cond, ::sm::logging::levels::Info, std::string(SMCONSOLE_NAME_PREFIX) + "." + name, __VA_ARGS__)
-#define SM_INFO_STREAM_COND_NAMED(cond, name, args) SM_LOG_STREAM_COND(cond, ::sm::logging::levels::Info, std::string(SMCONSOLE_NAME_PREFIX) + "." + name, args)
-#define SM_INFO_ONCE(...) SM_LOG_ONCE(::sm::logging::levels::Info, SMCONSOLE_NAME_PREFIX, __VA_ARGS__)
-#define SM_INFO_STREAM_ONCE(args) SM_LOG_STREAM_ONCE(::sm::logging::levels::Info, SMCONSOLE_NAME_PREFIX, args)
-#define SM_INFO_ONCE_NAMED(name, ...) SM_LOG_ONCE(::sm::logging::levels::Info, std::string(SMCONSOLE_NAME_PREFIX) + "." + name, __VA_ARGS__)
-#define SM_INFO_STREAM_ONCE_NAMED(name, args) SM_LOG_STREAM_ONCE(::sm::logging::levels::Info, std::string(SMCONSOLE_NAME_PREFIX) + "." + name, args)
-#define SM_INFO_THROTTLE(rate, ...) SM_LOG_THROTTLE(rate, ::sm::logging::levels::Info, SMCONSOLE_NAME_PREFIX, __VA_ARGS__)
-#define SM_INFO_STREAM_THROTTLE(rate, args) SM_LOG_STREAM_THROTTLE(rate, ::sm::logging::levels::Info, SMCONSOLE_NAME_PREFIX, args)
-#define SM_INFO_THROTTLE_NAMED(rate, name, ...) SM_LOG_THROTTLE(rate, ::sm::logging::levels::Info, std::string(SMCONSOLE_NAME_PREFIX) + "." + name, __VA_ARGS__)
-#define SM_INFO_STREAM_THROTTLE_NAMED(rate, name, args) SM_LOG_STREAM_THROTTLE(rate, ::sm::logging::levels::Info, std::string(SMCONSOLE_NAME_PREFIX) + "." + name, args)
+#define SM_INFO(...) SM_LOG(::sm::logging::levels::Info, SMCONSOLE_DEFAULT_NAME, __VA_ARGS__)
+#define SM_INFO_STREAM(args) SM_LOG_STREAM(::sm::logging::levels::Info, SMCONSOLE_DEFAULT_NAME, args)
+#define SM_INFO_NAMED(name, ...) SM_LOG(::sm::logging::levels::Info, SMCONSOLE_NAMED_STREAM_NAME(name), __VA_ARGS__)
+#define SM_INFO_STREAM_NAMED(name, args) SM_LOG_STREAM(::sm::logging::levels::Info, SMCONSOLE_NAMED_STREAM_NAME(name), args)
+#define SM_INFO_COND(cond, ...) SM_LOG_COND(cond, ::sm::logging::levels::Info, SMCONSOLE_DEFAULT_NAME, __VA_ARGS__)
+#define SM_INFO_STREAM_COND(cond, args) SM_LOG_STREAM_COND(cond, ::sm::logging::levels::Info, SMCONSOLE_DEFAULT_NAME, args)
+#define SM_INFO_COND_NAMED(cond, name, ...) SM_LOG_COND(cond, ::sm::logging::levels::Info, SMCONSOLE_NAMED_STREAM_NAME(name), __VA_ARGS__)
+#define SM_INFO_STREAM_COND_NAMED(cond, name, args) SM_LOG_STREAM_COND(cond, ::sm::logging::levels::Info, SMCONSOLE_NAMED_STREAM_NAME(name), args)
+#define SM_INFO_ONCE(...) SM_LOG_ONCE(::sm::logging::levels::Info, SMCONSOLE_DEFAULT_NAME, __VA_ARGS__)
+#define SM_INFO_STREAM_ONCE(args) SM_LOG_STREAM_ONCE(::sm::logging::levels::Info, SMCONSOLE_DEFAULT_NAME, args)
+#define SM_INFO_ONCE_NAMED(name, ...) SM_LOG_ONCE(::sm::logging::levels::Info, SMCONSOLE_NAMED_STREAM_NAME(name), __VA_ARGS__)
+#define SM_INFO_STREAM_ONCE_NAMED(name, args) SM_LOG_STREAM_ONCE(::sm::logging::levels::Info, SMCONSOLE_NAMED_STREAM_NAME(name), args)
+#define SM_INFO_THROTTLE(rate, ...) SM_LOG_THROTTLE(rate, ::sm::logging::levels::Info, SMCONSOLE_DEFAULT_NAME, __VA_ARGS__)
+#define SM_INFO_STREAM_THROTTLE(rate, args) SM_LOG_STREAM_THROTTLE(rate, ::sm::logging::levels::Info, SMCONSOLE_DEFAULT_NAME, args)
+#define SM_INFO_THROTTLE_NAMED(rate, name, ...) SM_LOG_THROTTLE(rate, ::sm::logging::levels::Info, SMCONSOLE_NAMED_STREAM_NAME(name), __VA_ARGS__)
+#define SM_INFO_STREAM_THROTTLE_NAMED(rate, name, args) SM_LOG_STREAM_THROTTLE(rate, ::sm::logging::levels::Info, SMCONSOLE_NAMED_STREAM_NAME(name), args)
+#define SM_INFO_DEFERRED(...) SM_LOG_DEFERRED(::sm::logging::levels::Info, SMCONSOLE_DEFAULT_NAME, __VA_ARGS__)
+#define SM_INFO_KV(...) SM_LOG_KV(::sm::logging::levels::Info, SMCONSOLE_DEFAULT_NAME, __VA_ARGS__)
+#define SM_INFO_KV_NAMED(name, ...) SM_LOG_KV(::sm::logging::levels::Info, SMCONSOLE_NAMED_STREAM_NAME(name), __VA_ARGS__)
 #endif
 
 #if (SMCONSOLE_MIN_SEVERITY > SMCONSOLE_SEVERITY_WARN)
@@ -334,23 +382,29 @@
 #define SM_WARN_STREAM_THROTTLE(rate, args)
 #define SM_WARN_THROTTLE_NAMED(rate, name, ...)
 #define SM_WARN_STREAM_THROTTLE_NAMED(rate, name, args)
+#define SM_WARN_DEFERRED(...)
+#define SM_WARN_KV(...)
+#define SM_WARN_KV_NAMED(name, ...)
 #else
-#define SM_WARN(...) SM_LOG(::sm::logging::levels::Warn, SMCONSOLE_NAME_PREFIX, __VA_ARGS__)
-#define SM_WARN_STREAM(args) SM_LOG_STREAM(::sm::logging::levels::Warn, SMCONSOLE_NAME_PREFIX, args)
-#define SM_WARN_NAMED(name, ...) SM_LOG(::sm::logging::levels::Warn, std::string(SMCONSOLE_NAME_PREFIX) + "." + name, __VA_ARGS__)
-#define SM_WARN_STREAM_NAMED(name, args) SM_LOG_STREAM(::sm::logging::levels::Warn, std::string(SMCONSOLE_NAME_PREFIX) + "." + name, args)
-#define SM_WARN_COND(cond, ...) SM_LOG_COND(cond, ::sm::logging::levels::Warn, SMCONSOLE_NAME_PREFIX, __VA_ARGS__)
-#define SM_WARN_STREAM_COND(cond, args) SM_LOG_STREAM_COND(cond, ::sm::logging::levels::Warn, SMCONSOLE_NAME_PREFIX, args)
-#define SM_WARN_COND_NAMED(cond, name, ...) SM_LOG_COND(cond, ::sm::logging::levels::Warn, std::string(SMCONSOLE_NAME_PREFIX) + "." + name, __VA_ARGS__)
-#define SM_WARN_STREAM_COND_NAMED(cond, name, args) SM_LOG_STREAM_COND(cond, ::sm::logging::levels::Warn, std::string(SMCONSOLE_NAME_PREFIX) + "." + name, args)
-#define SM_WARN_ONCE(...) SM_LOG_ONCE(::sm::logging::levels::Warn, SMCONSOLE_NAME_PREFIX, __VA_ARGS__)
-#define SM_WARN_STREAM_ONCE(args) SM_LOG_STREAM_ONCE(::sm::logging::levels::Warn, SMCONSOLE_NAME_PREFIX, args)
-#define SM_WARN_ONCE_NAMED(name, ...) SM_LOG_ONCE(::sm::logging::levels::Warn, std::string(SMCONSOLE_NAME_PREFIX) + "." + name, __VA_ARGS__)
-#define SM_WARN_STREAM_ONCE_NAMED(name, args) SM_LOG_STREAM_ONCE(::sm::logging::levels::Warn, std::string(SMCONSOLE_NAME_PREFIX) + "." + name, args)
-#define SM_WARN_THROTTLE(rate, ...) SM_LOG_THROTTLE(rate, ::sm::logging::levels::Warn, SMCONSOLE_NAME_PREFIX, __VA_ARGS__)
-#define SM_WARN_STREAM_THROTTLE(rate, args) SM_LOG_STREAM_THROTTLE(rate, ::sm::logging::levels::Warn, SMCONSOLE_NAME_PREFIX, args)
-#define SM_WARN_THROTTLE_NAMED(rate, name, ...) SM_LOG_THROTTLE(rate, ::sm::logging::levels::Warn, std::string(SMCONSOLE_NAME_PREFIX) + "." + name, __VA_ARGS__)
-#define SM_WARN_STREAM_THROTTLE_NAMED(rate, name, args) SM_LOG_STREAM_THROTTLE(rate, ::sm::logging::levels::Warn, std::string(SMCONSOLE_NAME_PREFIX) + "." + name, args)
+#define SM_WARN(...) SM_LOG(::sm::logging::levels::Warn, SMCONSOLE_DEFAULT_NAME, __VA_ARGS__)
+#define SM_WARN_STREAM(args) SM_LOG_STREAM(::sm::logging::levels::Warn, SMCONSOLE_DEFAULT_NAME, args)
+#define SM_WARN_NAMED(name, ...) SM_LOG(::sm::logging::levels::Warn, SMCONSOLE_NAMED_STREAM_NAME(name), __VA_ARGS__)
+#define SM_WARN_STREAM_NAMED(name, args) SM_LOG_STREAM(::sm::logging::levels::Warn, SMCONSOLE_NAMED_STREAM_NAME(name), args)
+#define SM_WARN_COND(cond, ...) SM_LOG_COND(cond, ::sm::logging::levels::Warn, SMCONSOLE_DEFAULT_NAME, __VA_ARGS__)
+#define SM_WARN_STREAM_COND(cond, args) SM_LOG_STREAM_COND(cond, ::sm::logging::levels::Warn, SMCONSOLE_DEFAULT_NAME, args)
+#define SM_WARN_COND_NAMED(cond, name, ...) SM_LOG_COND(cond, ::sm::logging::levels::Warn, SMCONSOLE_NAMED_STREAM_NAME(name), __VA_ARGS__)
+#define SM_WARN_STREAM_COND_NAMED(cond, name, args) SM_LOG_STREAM_COND(cond, ::sm::logging::levels::Warn, SMCONSOLE_NAMED_STREAM_NAME(name), args)
+#define SM_WARN_ONCE(...) SM_LOG_ONCE(::sm::logging::levels::Warn, SMCONSOLE_DEFAULT_NAME, __VA_ARGS__)
+#define SM_WARN_STREAM_ONCE(args) SM_LOG_STREAM_ONCE(::sm::logging::levels::Warn, SMCONSOLE_DEFAULT_NAME, args)
+#define SM_WARN_ONCE_NAMED(name, ...) SM_LOG_ONCE(::sm::logging::levels::Warn, SMCONSOLE_NAMED_STREAM_NAME(name), __VA_ARGS__)
+#define SM_WARN_STREAM_ONCE_NAMED(name, args) SM_LOG_STREAM_ONCE(::sm::logging::levels::Warn, SMCONSOLE_NAMED_STREAM_NAME(name), args)
+#define SM_WARN_THROTTLE(rate, ...) SM_LOG_THROTTLE(rate, ::sm::logging::levels::Warn, SMCONSOLE_DEFAULT_NAME, __VA_ARGS__)
+#define SM_WARN_STREAM_THROTTLE(rate, args) SM_LOG_STREAM_THROTTLE(rate, ::sm::logging::levels::Warn, SMCONSOLE_DEFAULT_NAME, args)
+#define SM_WARN_THROTTLE_NAMED(rate, name, ...) SM_LOG_THROTTLE(rate, ::sm::logging::levels::Warn, SMCONSOLE_NAMED_STREAM_NAME(name), __VA_ARGS__)
+#define SM_WARN_STREAM_THROTTLE_NAMED(rate, name, args) SM_LOG_STREAM_THROTTLE(rate, ::sm::logging::levels::Warn, SMCONSOLE_NAMED_STREAM_NAME(name), args)
+#define SM_WARN_DEFERRED(...) SM_LOG_DEFERRED(::sm::logging::levels::Warn, SMCONSOLE_DEFAULT_NAME, __VA_ARGS__)
+#define SM_WARN_KV(...) SM_LOG_KV(::sm::logging::levels::Warn, SMCONSOLE_DEFAULT_NAME, __VA_ARGS__)
+#define SM_WARN_KV_NAMED(name, ...) SM_LOG_KV(::sm::logging::levels::Warn, SMCONSOLE_NAMED_STREAM_NAME(name), __VA_ARGS__)
 #endif
 
 #if (SMCONSOLE_MIN_SEVERITY > SMCONSOLE_SEVERITY_ERROR)
@@ -370,23 +424,29 @@
 #define SM_ERROR_STREAM_THROTTLE(rate, args)
 #define SM_ERROR_THROTTLE_NAMED(rate, name, ...)
 #define SM_ERROR_STREAM_THROTTLE_NAMED(rate, name, args)
+#define SM_ERROR_DEFERRED(...)
+#define SM_ERROR_KV(...)
+#define SM_ERROR_KV_NAMED(name, ...)
 #else
-#define SM_ERROR(...) SM_LOG(::sm::logging::levels::Error, SMCONSOLE_NAME_PREFIX, __VA_ARGS__)
-#define SM_ERROR_STREAM(args) SM_LOG_STREAM(::sm::logging::levels::Error, SMCONSOLE_NAME_PREFIX, args)
-#define SM_ERROR_NAMED(name, ...) SM_LOG(::sm::logging::levels::Error, std::string(SMCONSOLE_NAME_PREFIX) + "." + name, __VA_ARGS__)
-#define SM_ERROR_STREAM_NAMED(name, args) SM_LOG_STREAM(::sm::logging::levels::Error, std::string(SMCONSOLE_NAME_PREFIX) + "." + name, args)
-#define SM_ERROR_COND(cond, ...) SM_LOG_COND(cond, ::sm::logging::levels::Error, SMCONSOLE_NAME_PREFIX, __VA_ARGS__)
-#define SM_ERROR_STREAM_COND(cond, args) SM_LOG_STREAM_COND(cond, ::sm::logging::levels::Error, SMCONSOLE_NAME_PREFIX, args)
-#define SM_ERROR_COND_NAMED(cond, name, ...) SM_LOG_COND(cond, ::sm::logging::levels::Error, std::string(SMCONSOLE_NAME_PREFIX) + "." + name, __VA_ARGS__)
-#define SM_ERROR_STREAM_COND_NAMED(cond, name, args) SM_LOG_STREAM_COND(cond, ::sm::logging::levels::Error, std::string(SMCONSOLE_NAME_PREFIX) + "." + name, args)
-#define SM_ERROR_ONCE(...) SM_LOG_ONCE(::sm::logging::levels::Error, SMCONSOLE_NAME_PREFIX, __VA_ARGS__)
-#define SM_ERROR_STREAM_ONCE(args) SM_LOG_STREAM_ONCE(::sm::logging::levels::Error, SMCONSOLE_NAME_PREFIX, args)
-#define SM_ERROR_ONCE_NAMED(name, ...) SM_LOG_ONCE(::sm::logging::levels::Error, std::string(SMCONSOLE_NAME_PREFIX) + "." + name, __VA_ARGS__)
-#define SM_ERROR_STREAM_ONCE_NAMED(name, args) SM_LOG_STREAM_ONCE(::sm::logging::levels::Error, std::string(SMCONSOLE_NAME_PREFIX) + "." + name, args)
-#define SM_ERROR_THROTTLE(rate, ...) SM_LOG_THROTTLE(rate, ::sm::logging::levels::Error, SMCONSOLE_NAME_PREFIX, __VA_ARGS__)
-#define SM_ERROR_STREAM_THROTTLE(rate, args) SM_LOG_STREAM_THROTTLE(rate, ::sm::logging::levels::Error, SMCONSOLE_NAME_PREFIX, args)
-#define SM_ERROR_THROTTLE_NAMED(rate, name, ...) SM_LOG_THROTTLE(rate, ::sm::logging::levels::Error, std::string(SMCONSOLE_NAME_PREFIX) + "." + name, __VA_ARGS__)
-#define SM_ERROR_STREAM_THROTTLE_NAMED(rate, name, args) SM_LOG_STREAM_THROTTLE(rate, ::sm::logging::levels::Error, std::string(SMCONSOLE_NAME_PREFIX) + "." + name, args)
+#define SM_ERROR(...) SM_LOG(::sm::logging::levels::Error, SMCONSOLE_DEFAULT_NAME, __VA_ARGS__)
+#define SM_ERROR_STREAM(args) SM_LOG_STREAM(::sm::logging::levels::Error, SMCONSOLE_DEFAULT_NAME, args)
+#define SM_ERROR_NAMED(name, ...) SM_LOG(::sm::logging::levels::Error, SMCONSOLE_NAMED_STREAM_NAME(name), __VA_ARGS__)
+#define SM_ERROR_STREAM_NAMED(name, args) SM_LOG_STREAM(::sm::logging::levels::Error, SMCONSOLE_NAMED_STREAM_NAME(name), args)
+#define SM_ERROR_COND(cond, ...) SM_LOG_COND(cond, ::sm::logging::levels::Error, SMCONSOLE_DEFAULT_NAME, __VA_ARGS__)
+#define SM_ERROR_STREAM_COND(cond, args) SM_LOG_STREAM_COND(cond, ::sm::logging::levels::Error, SMCONSOLE_DEFAULT_NAME, args)
+#define SM_ERROR_COND_NAMED(cond, name, ...) SM_LOG_COND(cond, ::sm::logging::levels::Error, SMCONSOLE_NAMED_STREAM_NAME(name), __VA_ARGS__)
+#define SM_ERROR_STREAM_COND_NAMED(cond, name, args) SM_LOG_STREAM_COND(cond, ::sm::logging::levels::Error, SMCONSOLE_NAMED_STREAM_NAME(name), args)
+#define SM_ERROR_ONCE(...) SM_LOG_ONCE(::sm::logging::levels::Error, SMCONSOLE_DEFAULT_NAME, __VA_ARGS__)
+#define SM_ERROR_STREAM_ONCE(args) SM_LOG_STREAM_ONCE(::sm::logging::levels::Error, SMCONSOLE_DEFAULT_NAME, args)
+#define SM_ERROR_ONCE_NAMED(name, ...) SM_LOG_ONCE(::sm::logging::levels::Error, SMCONSOLE_NAMED_STREAM_NAME(name), __VA_ARGS__)
+#define SM_ERROR_STREAM_ONCE_NAMED(name, args) SM_LOG_STREAM_ONCE(::sm::logging::levels::Error, SMCONSOLE_NAMED_STREAM_NAME(name), args)
+#define SM_ERROR_THROTTLE(rate, ...) SM_LOG_THROTTLE(rate, ::sm::logging::levels::Error, SMCONSOLE_DEFAULT_NAME, __VA_ARGS__)
+#define SM_ERROR_STREAM_THROTTLE(rate, args) SM_LOG_STREAM_THROTTLE(rate, ::sm::logging::levels::Error, SMCONSOLE_DEFAULT_NAME, args)
+#define SM_ERROR_THROTTLE_NAMED(rate, name, ...) SM_LOG_THROTTLE(rate, ::sm::logging::levels::Error, SMCONSOLE_NAMED_STREAM_NAME(name), __VA_ARGS__)
+#define SM_ERROR_STREAM_THROTTLE_NAMED(rate, name, args) SM_LOG_STREAM_THROTTLE(rate, ::sm::logging::levels::Error, SMCONSOLE_NAMED_STREAM_NAME(name), args)
+#define SM_ERROR_DEFERRED(...) SM_LOG_DEFERRED(::sm::logging::levels::Error, SMCONSOLE_DEFAULT_NAME, __VA_ARGS__)
+#define SM_ERROR_KV(...) SM_LOG_KV(::sm::logging::levels::Error, SMCONSOLE_DEFAULT_NAME, __VA_ARGS__)
+#define SM_ERROR_KV_NAMED(name, ...) SM_LOG_KV(::sm::logging::levels::Error, SMCONSOLE_NAMED_STREAM_NAME(name), __VA_ARGS__)
 #endif
 
 #if (SMCONSOLE_MIN_SEVERITY > SMCONSOLE_SEVERITY_FATAL)
@@ -406,22 +466,28 @@
 #define SM_FATAL_STREAM_THROTTLE(rate, args)
 #define SM_FATAL_THROTTLE_NAMED(rate, name, ...)
 #define SM_FATAL_STREAM_THROTTLE_NAMED(rate, name, args)
+#define SM_FATAL_DEFERRED(...)
+#define SM_FATAL_KV(...)
+#define SM_FATAL_KV_NAMED(name, ...)
 #else
-#define SM_FATAL(...) SM_LOG(::sm::logging::levels::Fatal, SMCONSOLE_NAME_PREFIX, __VA_ARGS__)
-#define SM_FATAL_STREAM(args) SM_LOG_STREAM(::sm::logging::levels::Fatal, SMCONSOLE_NAME_PREFIX, args)
-#define SM_FATAL_NAMED(name, ...) SM_LOG(::sm::logging::levels::Fatal, std::string(SMCONSOLE_NAME_PREFIX) + "." + name, __VA_ARGS__)
-#define SM_FATAL_STREAM_NAMED(name, args) SM_LOG_STREAM(::sm::logging::levels::Fatal, std::string(SMCONSOLE_NAME_PREFIX) + "." + name, args)
-#define SM_FATAL_COND(cond, ...) SM_LOG_COND(cond, ::sm::logging::levels::Fatal, SMCONSOLE_NAME_PREFIX, __VA_ARGS__)
-#define SM_FATAL_STREAM_COND(cond, args) SM_LOG_STREAM_COND(cond, ::sm::logging::levels::Fatal, SMCONSOLE_NAME_PREFIX, args)
-#define SM_FATAL_COND_NAMED(cond, name, ...) SM_LOG_COND(cond, ::sm::logging::levels::Fatal, std::string(SMCONSOLE_NAME_PREFIX) + "." + name, __VA_ARGS__)
-#define SM_FATAL_STREAM_COND_NAMED(cond, name, args) SM_LOG_STREAM_COND(cond, ::sm::logging::levels::Fatal, std::string(SMCONSOLE_NAME_PREFIX) + "." + name, args)
-#define SM_FATAL_ONCE(...) SM_LOG_ONCE(::sm::logging::levels::Fatal, SMCONSOLE_NAME_PREFIX, __VA_ARGS__)
-#define SM_FATAL_STREAM_ONCE(args) SM_LOG_STREAM_ONCE(::sm::logging::levels::Fatal, SMCONSOLE_NAME_PREFIX, args)
-#define SM_FATAL_ONCE_NAMED(name, ...) SM_LOG_ONCE(::sm::logging::levels::Fatal, std::string(SMCONSOLE_NAME_PREFIX) + "." + name, __VA_ARGS__)
-#define SM_FATAL_STREAM_ONCE_NAMED(name, args) SM_LOG_STREAM_ONCE(::sm::logging::levels::Fatal, std::string(SMCONSOLE_NAME_PREFIX) + "." + name, args)
-#define SM_FATAL_THROTTLE(rate, ...) SM_LOG_THROTTLE(rate, ::sm::logging::levels::Fatal, SMCONSOLE_NAME_PREFIX, __VA_ARGS__)
-#define SM_FATAL_STREAM_THROTTLE(rate, args) SM_LOG_STREAM_THROTTLE(rate, ::sm::logging::levels::Fatal, SMCONSOLE_NAME_PREFIX, args)
-#define SM_FATAL_THROTTLE_NAMED(rate, name, ...) SM_LOG_THROTTLE(rate, ::sm::logging::levels::Fatal, std::string(SMCONSOLE_NAME_PREFIX) + "." + name, __VA_ARGS__)
-#define SM_FATAL_STREAM_THROTTLE_NAMED(rate, name, args) SM_LOG_STREAM_THROTTLE(rate, ::sm::logging::levels::Fatal, std::string(SMCONSOLE_NAME_PREFIX) + "." + name, args)
+#define SM_FATAL(...) SM_LOG(::sm::logging::levels::Fatal, SMCONSOLE_DEFAULT_NAME, __VA_ARGS__)
+#define SM_FATAL_STREAM(args) SM_LOG_STREAM(::sm::logging::levels::Fatal, SMCONSOLE_DEFAULT_NAME, args)
+#define SM_FATAL_NAMED(name, ...) SM_LOG(::sm::logging::levels::Fatal, SMCONSOLE_NAMED_STREAM_NAME(name), __VA_ARGS__)
+#define SM_FATAL_STREAM_NAMED(name, args) SM_LOG_STREAM(::sm::logging::levels::Fatal, SMCONSOLE_NAMED_STREAM_NAME(name), args)
+#define SM_FATAL_COND(cond, ...) SM_LOG_COND(cond, ::sm::logging::levels::Fatal, SMCONSOLE_DEFAULT_NAME, __VA_ARGS__)
+#define SM_FATAL_STREAM_COND(cond, args) SM_LOG_STREAM_COND(cond, ::sm::logging::levels::Fatal, SMCONSOLE_DEFAULT_NAME, args)
+#define SM_FATAL_COND_NAMED(cond, name, ...) SM_LOG_COND(cond, ::sm::logging::levels::Fatal, SMCONSOLE_NAMED_STREAM_NAME(name), __VA_ARGS__)
+#define SM_FATAL_STREAM_COND_NAMED(cond, name, args) SM_LOG_STREAM_COND(cond, ::sm::logging::levels::Fatal, SMCONSOLE_NAMED_STREAM_NAME(name), args)
+#define SM_FATAL_ONCE(...) SM_LOG_ONCE(::sm::logging::levels::Fatal, SMCONSOLE_DEFAULT_NAME, __VA_ARGS__)
+#define SM_FATAL_STREAM_ONCE(args) SM_LOG_STREAM_ONCE(::sm::logging::levels::Fatal, SMCONSOLE_DEFAULT_NAME, args)
+#define SM_FATAL_ONCE_NAMED(name, ...) SM_LOG_ONCE(::sm::logging::levels::Fatal, SMCONSOLE_NAMED_STREAM_NAME(name), __VA_ARGS__)
+#define SM_FATAL_STREAM_ONCE_NAMED(name, args) SM_LOG_STREAM_ONCE(::sm::logging::levels::Fatal, SMCONSOLE_NAMED_STREAM_NAME(name), args)
+#define SM_FATAL_THROTTLE(rate, ...) SM_LOG_THROTTLE(rate, ::sm::logging::levels::Fatal, SMCONSOLE_DEFAULT_NAME, __VA_ARGS__)
+#define SM_FATAL_STREAM_THROTTLE(rate, args) SM_LOG_STREAM_THROTTLE(rate, ::sm::logging::levels::Fatal, SMCONSOLE_DEFAULT_NAME, args)
+#define SM_FATAL_THROTTLE_NAMED(rate, name, ...) SM_LOG_THROTTLE(rate, ::sm::logging::levels::Fatal, SMCONSOLE_NAMED_STREAM_NAME(name), __VA_ARGS__)
+#define SM_FATAL_STREAM_THROTTLE_NAMED(rate, name, args) SM_LOG_STREAM_THROTTLE(rate, ::sm::logging::levels::Fatal, SMCONSOLE_NAMED_STREAM_NAME(name), args)
+#define SM_FATAL_DEFERRED(...) SM_LOG_DEFERRED(::sm::logging::levels::Fatal, SMCONSOLE_DEFAULT_NAME, __VA_ARGS__)
+#define SM_FATAL_KV(...) SM_LOG_KV(::sm::logging::levels::Fatal, SMCONSOLE_DEFAULT_NAME, __VA_ARGS__)
+#define SM_FATAL_KV_NAMED(name, ...) SM_LOG_KV(::sm::logging::levels::Fatal, SMCONSOLE_NAMED_STREAM_NAME(name), __VA_ARGS__)
 #endif
 
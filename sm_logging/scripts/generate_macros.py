@@ -56,6 +56,9 @@ def add_macro(f, caps_name, enum_name):
     f.write('#define SM_%s_STREAM_THROTTLE(rate, args)\n' %(caps_name))
     f.write('#define SM_%s_THROTTLE_NAMED(rate, name, ...)\n' %(caps_name))
     f.write('#define SM_%s_STREAM_THROTTLE_NAMED(rate, name, args)\n' %(caps_name))
+    f.write('#define SM_%s_DEFERRED(...)\n' %(caps_name))
+    f.write('#define SM_%s_KV(...)\n' %(caps_name))
+    f.write('#define SM_%s_KV_NAMED(name, ...)\n' %(caps_name))
     
     # f.write('#define SM_%s_FILTER(filter, ...)\n' %(caps_name))
     # f.write('#define SM_%s_STREAM_FILTER(filter, args)\n' %(caps_name))
@@ -64,27 +67,30 @@ def add_macro(f, caps_name, enum_name):
     f.write('#else\n')
     f.write('#define SM_%s(...) SM_LOG(::sm::logging::levels::%s, SMCONSOLE_DEFAULT_NAME, __VA_ARGS__)\n' %(caps_name, enum_name))
     f.write('#define SM_%s_STREAM(args) SM_LOG_STREAM(::sm::logging::levels::%s, SMCONSOLE_DEFAULT_NAME, args)\n' %(caps_name, enum_name))
-    f.write('#define SM_%s_NAMED(name, ...) SM_LOG(::sm::logging::levels::%s, std::string(SMCONSOLE_NAME_PREFIX) + "." + name, __VA_ARGS__)\n' %(caps_name, enum_name))
-    f.write('#define SM_%s_STREAM_NAMED(name, args) SM_LOG_STREAM(::sm::logging::levels::%s, std::string(SMCONSOLE_NAME_PREFIX) + "." + name, args)\n' %(caps_name, enum_name))
+    f.write('#define SM_%s_NAMED(name, ...) SM_LOG(::sm::logging::levels::%s, SMCONSOLE_NAMED_STREAM_NAME(name), __VA_ARGS__)\n' %(caps_name, enum_name))
+    f.write('#define SM_%s_STREAM_NAMED(name, args) SM_LOG_STREAM(::sm::logging::levels::%s, SMCONSOLE_NAMED_STREAM_NAME(name), args)\n' %(caps_name, enum_name))
     f.write('#define SM_%s_COND(cond, ...) SM_LOG_COND(cond, ::sm::logging::levels::%s, SMCONSOLE_DEFAULT_NAME, __VA_ARGS__)\n' %(caps_name, enum_name))
     f.write('#define SM_%s_STREAM_COND(cond, args) SM_LOG_STREAM_COND(cond, ::sm::logging::levels::%s, SMCONSOLE_DEFAULT_NAME, args)\n' %(caps_name, enum_name))
-    f.write('#define SM_%s_COND_NAMED(cond, name, ...) SM_LOG_COND(cond, ::sm::logging::levels::%s, std::string(SMCONSOLE_NAME_PREFIX) + "." + name, __VA_ARGS__)\n' %(caps_name, enum_name))
-    f.write('#define SM_%s_STREAM_COND_NAMED(cond, name, args) SM_LOG_STREAM_COND(cond, ::sm::logging::levels::%s, std::string(SMCONSOLE_NAME_PREFIX) + "." + name, args)\n' %(caps_name, enum_name))
+    f.write('#define SM_%s_COND_NAMED(cond, name, ...) SM_LOG_COND(cond, ::sm::logging::levels::%s, SMCONSOLE_NAMED_STREAM_NAME(name), __VA_ARGS__)\n' %(caps_name, enum_name))
+    f.write('#define SM_%s_STREAM_COND_NAMED(cond, name, args) SM_LOG_STREAM_COND(cond, ::sm::logging::levels::%s, SMCONSOLE_NAMED_STREAM_NAME(name), args)\n' %(caps_name, enum_name))
     
     f.write('#define SM_%s_ONCE(...) SM_LOG_ONCE(::sm::logging::levels::%s, SMCONSOLE_DEFAULT_NAME, __VA_ARGS__)\n' %(caps_name, enum_name))
     f.write('#define SM_%s_STREAM_ONCE(args) SM_LOG_STREAM_ONCE(::sm::logging::levels::%s, SMCONSOLE_DEFAULT_NAME, args)\n' %(caps_name, enum_name))
-    f.write('#define SM_%s_ONCE_NAMED(name, ...) SM_LOG_ONCE(::sm::logging::levels::%s, std::string(SMCONSOLE_NAME_PREFIX) + "." + name, __VA_ARGS__)\n' %(caps_name, enum_name))
-    f.write('#define SM_%s_STREAM_ONCE_NAMED(name, args) SM_LOG_STREAM_ONCE(::sm::logging::levels::%s, std::string(SMCONSOLE_NAME_PREFIX) + "." + name, args)\n' %(caps_name, enum_name))
+    f.write('#define SM_%s_ONCE_NAMED(name, ...) SM_LOG_ONCE(::sm::logging::levels::%s, SMCONSOLE_NAMED_STREAM_NAME(name), __VA_ARGS__)\n' %(caps_name, enum_name))
+    f.write('#define SM_%s_STREAM_ONCE_NAMED(name, args) SM_LOG_STREAM_ONCE(::sm::logging::levels::%s, SMCONSOLE_NAMED_STREAM_NAME(name), args)\n' %(caps_name, enum_name))
     
     f.write('#define SM_%s_THROTTLE(rate, ...) SM_LOG_THROTTLE(rate, ::sm::logging::levels::%s, SMCONSOLE_DEFAULT_NAME, __VA_ARGS__)\n' %(caps_name, enum_name))
     f.write('#define SM_%s_STREAM_THROTTLE(rate, args) SM_LOG_STREAM_THROTTLE(rate, ::sm::logging::levels::%s, SMCONSOLE_DEFAULT_NAME, args)\n' %(caps_name, enum_name))
-    f.write('#define SM_%s_THROTTLE_NAMED(rate, name, ...) SM_LOG_THROTTLE(rate, ::sm::logging::levels::%s, std::string(SMCONSOLE_NAME_PREFIX) + "." + name, __VA_ARGS__)\n' %(caps_name, enum_name))
-    f.write('#define SM_%s_STREAM_THROTTLE_NAMED(rate, name, args) SM_LOG_STREAM_THROTTLE(rate, ::sm::logging::levels::%s, std::string(SMCONSOLE_NAME_PREFIX) + "." + name, args)\n' %(caps_name, enum_name))
+    f.write('#define SM_%s_THROTTLE_NAMED(rate, name, ...) SM_LOG_THROTTLE(rate, ::sm::logging::levels::%s, SMCONSOLE_NAMED_STREAM_NAME(name), __VA_ARGS__)\n' %(caps_name, enum_name))
+    f.write('#define SM_%s_STREAM_THROTTLE_NAMED(rate, name, args) SM_LOG_STREAM_THROTTLE(rate, ::sm::logging::levels::%s, SMCONSOLE_NAMED_STREAM_NAME(name), args)\n' %(caps_name, enum_name))
+    f.write('#define SM_%s_DEFERRED(...) SM_LOG_DEFERRED(::sm::logging::levels::%s, SMCONSOLE_DEFAULT_NAME, __VA_ARGS__)\n' %(caps_name, enum_name))
+    f.write('#define SM_%s_KV(...) SM_LOG_KV(::sm::logging::levels::%s, SMCONSOLE_DEFAULT_NAME, __VA_ARGS__)\n' %(caps_name, enum_name))
+    f.write('#define SM_%s_KV_NAMED(name, ...) SM_LOG_KV(::sm::logging::levels::%s, SMCONSOLE_NAMED_STREAM_NAME(name), __VA_ARGS__)\n' %(caps_name, enum_name))
     
     # f.write('#define SM_%s_FILTER(filter, ...) SM_LOG_FILTER(filter, ::sm::logging::levels::%s, SMCONSOLE_DEFAULT_NAME, __VA_ARGS__)\n' %(caps_name, enum_name))
     # f.write('#define SM_%s_STREAM_FILTER(filter, args) SM_LOG_STREAM_FILTER(filter, ::sm::logging::levels::%s, SMCONSOLE_DEFAULT_NAME, args)\n' %(caps_name, enum_name))
-    # f.write('#define SM_%s_FILTER_NAMED(filter, name, ...) SM_LOG_FILTER(filter, ::sm::logging::levels::%s, std::string(SMCONSOLE_NAME_PREFIX) + "." + name, __VA_ARGS__)\n' %(caps_name, enum_name))
-    # f.write('#define SM_%s_STREAM_FILTER_NAMED(filter, name, args) SM_LOG_STREAM_FILTER(filter, ::sm::logging::levels::%s, std::string(SMCONSOLE_NAME_PREFIX) + "." + name, args)\n' %(caps_name, enum_name))
+    # f.write('#define SM_%s_FILTER_NAMED(filter, name, ...) SM_LOG_FILTER(filter, ::sm::logging::levels::%s, SMCONSOLE_NAMED_STREAM_NAME(name), __VA_ARGS__)\n' %(caps_name, enum_name))
+    # f.write('#define SM_%s_STREAM_FILTER_NAMED(filter, name, args) SM_LOG_STREAM_FILTER(filter, ::sm::logging::levels::%s, SMCONSOLE_NAMED_STREAM_NAME(name), args)\n' %(caps_name, enum_name))
     f.write('#endif\n\n')
 
 f = open('%s/include/sm/logging/macros_generated.hpp' %(base_path), 'w')
@@ -120,6 +126,12 @@ f.write(' * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED
 f.write(' * POSSIBILITY OF SUCH DAMAGE.\n')
 f.write(' */\n\n')
 
+add_macro(f, "ALL", "All")
+add_macro(f, "FINEST", "Finest")
+add_macro(f, "VERBOSE", "Verbose")
+add_macro(f, "FINER", "Finer")
+add_macro(f, "TRACE", "Trace")
+add_macro(f, "FINE", "Fine")
 add_macro(f, "DEBUG", "Debug")
 add_macro(f, "INFO", "Info")
 add_macro(f, "WARN", "Warn")
@@ -0,0 +1,263 @@
+#include <sm/logging/AsyncLogger.hpp>
+#include <sm/logging/LoggingEvent.hpp>
+#include <cstdio>
+
+namespace sm {
+    namespace logging {
+
+        // The queue is the bounded multi-producer queue by Dmitry Vyukov
+        // (http://www.1024cores.net/home/lock-free-algorithms/queues/bounded-mpmc-queue)
+        // with a single consumer. Every slot carries a sequence number that tells
+        // the producers whether it is free and the consumer whether it is filled.
+
+        AsyncLogger::AsyncLogger(boost::shared_ptr<Logger> sink, size_t capacity, OverflowPolicy policy) :
+            _sink(sink), _policy(policy), _enqueuePos(0), _dequeuePos(0), _dropped(0), _processed(0),
+            _consumerWaiting(false), _waiters(0), _stop(false)
+        {
+            size_t size = 2;
+            while(size < capacity)
+            {
+                size *= 2;
+            }
+            std::vector<Slot>(size).swap(_slots);
+            _mask = size - 1;
+            for(size_t i = 0; i < size; ++i)
+            {
+                _slots[i].sequence.store(i, std::memory_order_relaxed);
+            }
+            _thread = boost::thread(&AsyncLogger::run, this);
+        }
+
+        AsyncLogger::~AsyncLogger()
+        {
+            {
+                boost::mutex::scoped_lock lock(_mutex);
+                _stop = true;
+                _notEmpty.notify_one();
+            }
+            _thread.join();
+        }
+
+        void AsyncLogger::flush()
+        {
+            const size_t target = _enqueuePos.load();
+            if(_processed.load() >= target)
+            {
+                return;
+            }
+            ++_waiters;
+            {
+                boost::mutex::scoped_lock lock(_mutex);
+                while(_processed.load() < target)
+                {
+                    _notFull.wait(lock);
+                }
+            }
+            --_waiters;
+        }
+
+        size_t AsyncLogger::droppedEvents() const
+        {
+            return _dropped.load(std::memory_order_relaxed);
+        }
+
+        boost::shared_ptr<Logger> AsyncLogger::sink() const
+        {
+            return _sink;
+        }
+
+        AsyncLogger::OverflowPolicy AsyncLogger::overflowPolicy() const
+        {
+            return _policy;
+        }
+
+        size_t AsyncLogger::capacity() const
+        {
+            return _slots.size();
+        }
+
+        Logger::Time AsyncLogger::currentTimeImplementation() const
+        {
+            return _sink->currentTime();
+        }
+
+        void AsyncLogger::logImplementation(const LoggingEvent & event)
+        {
+            push(event);
+        }
+
+        void AsyncLogger::logDeferredImplementation(const DeferredLoggingEvent & event)
+        {
+            push(event);
+        }
+
+        template<typename Event>
+        void AsyncLogger::push(const Event & event)
+        {
+            Slot * slot = tryClaim();
+            if(!slot)
+            {
+                if(_policy == Drop)
+                {
+                    _dropped.fetch_add(1, std::memory_order_relaxed);
+                    return;
+                }
+                // Wait for the consumer, which wakes us after freeing slots.
+                _waiters.fetch_add(1);
+                std::atomic_thread_fence(std::memory_order_seq_cst);
+                {
+                    boost::mutex::scoped_lock lock(_mutex);
+                    while(!(slot = tryClaim()))
+                    {
+                        _notFull.wait(lock);
+                    }
+                }
+                _waiters.fetch_sub(1);
+            }
+            fill(slot, event);
+            publish(slot);
+
+            // Wake the consumer if it went to sleep on an empty queue.
+            std::atomic_thread_fence(std::memory_order_seq_cst);
+            if(_consumerWaiting.load(std::memory_order_relaxed))
+            {
+                boost::mutex::scoped_lock lock(_mutex);
+                _notEmpty.notify_one();
+            }
+        }
+
+        AsyncLogger::Slot * AsyncLogger::tryClaim()
+        {
+            size_t pos = _enqueuePos.load(std::memory_order_relaxed);
+            for(;;)
+            {
+                Slot * slot = &_slots[pos & _mask];
+                const size_t sequence = slot->sequence.load(std::memory_order_acquire);
+                const std::ptrdiff_t diff = static_cast<std::ptrdiff_t>(sequence) - static_cast<std::ptrdiff_t>(pos);
+                if(diff == 0)
+                {
+                    if(_enqueuePos.compare_exchange_weak(pos, pos + 1, std::memory_order_relaxed))
+                    {
+                        return slot;
+                    }
+                }
+                else if(diff < 0)
+                {
+                    // full
+                    return NULL;
+                }
+                else
+                {
+                    pos = _enqueuePos.load(std::memory_order_relaxed);
+                }
+            }
+        }
+
+        void AsyncLogger::fill(Slot * slot, const LoggingEvent & event)
+        {
+            // The pointers in the event may not outlive the call, so copy the strings.
+            slot->deferred = false;
+            slot->streamName.assign(event.streamName);
+            slot->level = event.level;
+            slot->file.assign(event.file);
+            slot->line = event.line;
+            slot->function.assign(event.function);
+            slot->message.assign(event.message);
+            slot->messageLength = event.messageLength;
+            slot->time = event.time;
+            copyLogFields(event.fields, event.numFields, slot->fields, slot->fieldStrings);
+        }
+
+        void AsyncLogger::fill(Slot * slot, const DeferredLoggingEvent & event)
+        {
+            slot->deferred = true;
+            slot->streamName.assign(event.streamName);
+            slot->level = event.level;
+            slot->file.assign(event.file);
+            slot->line = event.line;
+            slot->function.assign(event.function);
+            slot->format = event.format;
+            slot->args.assign(event.args, event.args + event.argsSize);
+            slot->time = event.time;
+        }
+
+        void AsyncLogger::publish(Slot * slot)
+        {
+            // A claimed slot holds the position it was claimed at.
+            slot->sequence.store(slot->sequence.load(std::memory_order_relaxed) + 1, std::memory_order_release);
+        }
+
+        bool AsyncLogger::tryPop(Slot *& slot)
+        {
+            const size_t pos = _dequeuePos.load(std::memory_order_relaxed);
+            slot = &_slots[pos & _mask];
+            return slot->sequence.load(std::memory_order_acquire) == pos + 1;
+        }
+
+        void AsyncLogger::release(Slot * slot)
+        {
+            const size_t pos = _dequeuePos.load(std::memory_order_relaxed);
+            slot->sequence.store(pos + _mask + 1, std::memory_order_release);
+            _dequeuePos.store(pos + 1, std::memory_order_relaxed);
+            _processed.fetch_add(1);
+
+            // Wake blocked producers and flush().
+            std::atomic_thread_fence(std::memory_order_seq_cst);
+            if(_waiters.load(std::memory_order_relaxed) > 0)
+            {
+                boost::mutex::scoped_lock lock(_mutex);
+                _notFull.notify_all();
+            }
+        }
+
+        void AsyncLogger::run()
+        {
+            Slot * slot;
+            for(;;)
+            {
+                if(tryPop(slot))
+                {
+                    try
+                    {
+                        if(slot->deferred)
+                        {
+                            _sink->logDeferred( DeferredLoggingEvent( slot->streamName.c_str(), slot->level, slot->file.c_str(), slot->line,
+                                                                      slot->function.c_str(), slot->format,
+                                                                      slot->args.empty() ? NULL : &slot->args[0], slot->args.size(), slot->time ) );
+                        }
+                        else
+                        {
+                            _sink->log( LoggingEvent( slot->streamName.c_str(), slot->level, slot->file.c_str(), slot->line,
+                                                      slot->function.c_str(), slot->message.c_str(), slot->time,
+                                                      slot->fields.empty() ? NULL : &slot->fields[0], slot->fields.size(),
+                                                      slot->messageLength ) );
+                        }
+                    }
+                    catch (std::exception& e)
+                    {
+                        fprintf(stderr, "Caught exception while logging: [%s]\n", e.what());
+                    }
+                    release(slot);
+                    continue;
+                }
+
+                // The queue is empty. Sleep until a producer wakes us, unless we should stop.
+                _consumerWaiting.store(true);
+                std::atomic_thread_fence(std::memory_order_seq_cst);
+                {
+                    boost::mutex::scoped_lock lock(_mutex);
+                    while(!tryPop(slot) && !_stop)
+                    {
+                        _notEmpty.wait(lock);
+                    }
+                }
+                _consumerWaiting.store(false, std::memory_order_relaxed);
+                if(!tryPop(slot) && _stop)
+                {
+                    return;
+                }
+            }
+        }
+
+    } // namespace logging
+} // namespace sm
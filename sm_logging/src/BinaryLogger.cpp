@@ -0,0 +1,267 @@
+#include <sm/logging/BinaryLogger.hpp>
+#include <sm/logging/LoggingEvent.hpp>
+#include <cstring>
+#include <stdexcept>
+
+namespace sm {
+    namespace logging {
+
+        namespace {
+            const char kMagic[8] = { 'S', 'M', 'L', 'O', 'G', 2, 0, 0 };
+            const char kCallSiteRecord = 'L';
+            const char kDeferredRecord = 'D';
+            const char kMessageRecord = 'M';
+            const size_t kStreamBufferSize = 1 << 16;
+
+            int compareStrings(const char * a, const char * b)
+            {
+                return a == b ? 0 : strcmp(a, b);
+            }
+        } // namespace
+
+        bool BinaryLogger::CallSite::operator<(const CallSite & other) const
+        {
+            if(format != other.format) return format < other.format;
+            if(line != other.line) return line < other.line;
+            if(level != other.level) return level < other.level;
+            const int c = compareStrings(file, other.file);
+            if(c != 0) return c < 0;
+            return compareStrings(streamName, other.streamName) < 0;
+        }
+
+        BinaryLogger::BinaryLogger(const std::string & path) : _streamBuffer(kStreamBufferSize)
+        {
+            _stream.rdbuf()->pubsetbuf(&_streamBuffer[0], _streamBuffer.size());
+            _stream.open(path.c_str(), std::ios::binary | std::ios::trunc);
+            if(!_stream.good())
+            {
+                throw std::runtime_error("Unable to open the binary log " + path + " for writing");
+            }
+            write(kMagic, sizeof(kMagic));
+        }
+
+        BinaryLogger::~BinaryLogger()
+        {
+            _stream.close();
+        }
+
+        void BinaryLogger::flush()
+        {
+            boost::mutex::scoped_lock lock(_mutex);
+            _stream.flush();
+        }
+
+        void BinaryLogger::write(const void * data, size_t size)
+        {
+            _stream.write(static_cast<const char *>(data), size);
+        }
+
+        void BinaryLogger::writeString(const char * str)
+        {
+            const boost::uint32_t size = static_cast<boost::uint32_t>(strlen(str));
+            write(&size, sizeof(size));
+            write(str, size);
+        }
+
+        boost::uint32_t BinaryLogger::callSiteId(const DeferredLoggingEvent & event)
+        {
+            CallSite key = { event.format, event.line, event.level, event.file, event.streamName };
+            std::map<CallSite, boost::uint32_t>::const_iterator it = _callSites.find(key);
+            if(it != _callSites.end())
+            {
+                return it->second;
+            }
+
+            // A new call site. Keep copies of the strings, the event's may be temporary.
+            _callSiteStrings.push_back(CallSiteStrings());
+            _callSiteStrings.back().file = event.file;
+            _callSiteStrings.back().streamName = event.streamName;
+            key.file = _callSiteStrings.back().file.c_str();
+            key.streamName = _callSiteStrings.back().streamName.c_str();
+            const boost::uint32_t id = static_cast<boost::uint32_t>(_callSites.size());
+            _callSites[key] = id;
+
+            const boost::uint8_t level = static_cast<boost::uint8_t>(event.level);
+            const boost::int32_t line = event.line;
+            write(&kCallSiteRecord, 1);
+            write(&id, sizeof(id));
+            write(&level, sizeof(level));
+            write(&line, sizeof(line));
+            writeString(event.streamName);
+            writeString(event.file);
+            writeString(event.function);
+            writeString(event.format);
+            return id;
+        }
+
+        void BinaryLogger::logDeferredImplementation(const DeferredLoggingEvent & event)
+        {
+            boost::mutex::scoped_lock lock(_mutex);
+            const boost::uint32_t id = callSiteId(event);
+            const boost::int64_t time = std::chrono::duration_cast<std::chrono::nanoseconds>( event.time.time_since_epoch() ).count();
+            const boost::uint32_t size = static_cast<boost::uint32_t>(event.argsSize);
+            write(&kDeferredRecord, 1);
+            write(&id, sizeof(id));
+            write(&time, sizeof(time));
+            write(&size, sizeof(size));
+            write(event.args, size);
+        }
+
+        void BinaryLogger::logImplementation(const LoggingEvent & event)
+        {
+            boost::mutex::scoped_lock lock(_mutex);
+            const boost::uint8_t level = static_cast<boost::uint8_t>(event.level);
+            const boost::int32_t line = event.line;
+            const boost::int64_t time = std::chrono::duration_cast<std::chrono::nanoseconds>( event.time.time_since_epoch() ).count();
+            write(&kMessageRecord, 1);
+            write(&level, sizeof(level));
+            write(&line, sizeof(line));
+            write(&time, sizeof(time));
+            writeString(event.streamName);
+            writeString(event.file);
+            writeString(event.function);
+            writeString(event.message);
+        }
+
+        namespace {
+
+            class BinaryLogReader
+            {
+            public:
+                BinaryLogReader(const std::string & path) : _path(path), _stream(path.c_str(), std::ios::binary)
+                {
+                    if(!_stream.good())
+                    {
+                        throw std::runtime_error("Unable to open the binary log " + path + " for reading");
+                    }
+                    char magic[sizeof(kMagic)];
+                    read(magic, sizeof(magic));
+                    if(memcmp(magic, kMagic, sizeof(kMagic)) != 0)
+                    {
+                        throw std::runtime_error(path + " is not a binary log");
+                    }
+                }
+
+                // false at the end of the file
+                bool readType(char & type)
+                {
+                    _stream.read(&type, 1);
+                    return _stream.gcount() == 1;
+                }
+
+                template<typename T>
+                T readValue()
+                {
+                    T value;
+                    read(&value, sizeof(value));
+                    return value;
+                }
+
+                void readBytes(std::vector<char> & bytes)
+                {
+                    bytes.resize(readValue<boost::uint32_t>());
+                    if(!bytes.empty())
+                    {
+                        read(&bytes[0], bytes.size());
+                    }
+                }
+
+                std::string readString()
+                {
+                    std::vector<char> bytes;
+                    readBytes(bytes);
+                    return std::string(bytes.begin(), bytes.end());
+                }
+
+                void corrupt(const std::string & what)
+                {
+                    throw std::runtime_error("The binary log " + _path + " is corrupt: " + what);
+                }
+
+            private:
+                void read(void * data, size_t size)
+                {
+                    _stream.read(static_cast<char *>(data), size);
+                    if(static_cast<size_t>(_stream.gcount()) != size)
+                    {
+                        corrupt("unexpected end of file");
+                    }
+                }
+
+                std::string _path;
+                std::ifstream _stream;
+            };
+
+            struct DecodedCallSite
+            {
+                Level level;
+                int line;
+                std::string streamName;
+                std::string file;
+                std::string function;
+                std::string format;
+            };
+
+        } // namespace
+
+        void decodeBinaryLog(const std::string & path, Logger & logger)
+        {
+            BinaryLogReader reader(path);
+            // a deque keeps the format strings in place, sinks may keep pointers to them
+            std::deque<DecodedCallSite> callSites;
+            std::vector<char> args;
+            char type;
+            while(reader.readType(type))
+            {
+                if(type == kCallSiteRecord)
+                {
+                    const boost::uint32_t id = reader.readValue<boost::uint32_t>();
+                    if(id != callSites.size())
+                    {
+                        reader.corrupt("call sites out of order");
+                    }
+                    DecodedCallSite site;
+                    site.level = static_cast<Level>(reader.readValue<boost::uint8_t>());
+                    site.line = reader.readValue<boost::int32_t>();
+                    site.streamName = reader.readString();
+                    site.file = reader.readString();
+                    site.function = reader.readString();
+                    site.format = reader.readString();
+                    callSites.push_back(site);
+                }
+                else if(type == kDeferredRecord)
+                {
+                    const boost::uint32_t id = reader.readValue<boost::uint32_t>();
+                    if(id >= callSites.size())
+                    {
+                        reader.corrupt("unknown call site");
+                    }
+                    const boost::int64_t ns = reader.readValue<boost::int64_t>();
+                    reader.readBytes(args);
+                    const DecodedCallSite & site = callSites[id];
+                    const Logger::Time time(std::chrono::duration_cast<Logger::Duration>(std::chrono::nanoseconds(ns)));
+                    logger.logDeferred( DeferredLoggingEvent( site.streamName.c_str(), site.level, site.file.c_str(), site.line,
+                                                              site.function.c_str(), site.format.c_str(),
+                                                              args.empty() ? NULL : &args[0], args.size(), time ) );
+                }
+                else if(type == kMessageRecord)
+                {
+                    const Level level = static_cast<Level>(reader.readValue<boost::uint8_t>());
+                    const int line = reader.readValue<boost::int32_t>();
+                    const boost::int64_t ns = reader.readValue<boost::int64_t>();
+                    const std::string streamName = reader.readString();
+                    const std::string file = reader.readString();
+                    const std::string function = reader.readString();
+                    const std::string message = reader.readString();
+                    const Logger::Time time(std::chrono::duration_cast<Logger::Duration>(std::chrono::nanoseconds(ns)));
+                    logger.log( LoggingEvent( streamName.c_str(), level, file.c_str(), line, function.c_str(), message.c_str(), time ) );
+                }
+                else
+                {
+                    reader.corrupt("unknown record type");
+                }
+            }
+        }
+
+    } // namespace logging
+} // namespace sm
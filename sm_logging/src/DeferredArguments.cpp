@@ -0,0 +1,312 @@
+#include <sm/logging/DeferredArguments.hpp>
+#include <cstdio>
+
+namespace sm {
+    namespace logging {
+        namespace deferred {
+
+            namespace {
+
+                // The value of an argument, converted on demand.
+                struct Argument
+                {
+                    Argument() : type(SignedInteger), i(0), u(0), d(0.0), s(NULL), sSize(0) {}
+
+                    ArgumentType type;
+                    boost::int64_t i;
+                    boost::uint64_t u;
+                    double d;
+                    const char * s;
+                    boost::uint32_t sSize;
+
+                    boost::int64_t asSigned() const
+                    {
+                        switch(type)
+                        {
+                            case SignedInteger: return i;
+                            case Double: return static_cast<boost::int64_t>(d);
+                            case String: return 0;
+                            default: return static_cast<boost::int64_t>(u);
+                        }
+                    }
+
+                    boost::uint64_t asUnsigned() const
+                    {
+                        switch(type)
+                        {
+                            case SignedInteger: return static_cast<boost::uint64_t>(i);
+                            case Double: return static_cast<boost::uint64_t>(d);
+                            case String: return 0;
+                            default: return u;
+                        }
+                    }
+
+                    double asDouble() const
+                    {
+                        switch(type)
+                        {
+                            case SignedInteger: return static_cast<double>(i);
+                            case Double: return d;
+                            case String: return 0.0;
+                            default: return static_cast<double>(u);
+                        }
+                    }
+                };
+
+                // Reads the encoded arguments one at a time.
+                class ArgumentReader
+                {
+                public:
+                    ArgumentReader(const char * args, size_t size) : _p(args), _end(args + size) {}
+
+                    // false if there are no more arguments or they are truncated
+                    bool next(Argument & arg)
+                    {
+                        if(_p >= _end)
+                        {
+                            return false;
+                        }
+                        arg.type = static_cast<ArgumentType>(*_p++);
+                        switch(arg.type)
+                        {
+                            case SignedInteger:
+                                return read(&arg.i, sizeof(arg.i));
+                            case UnsignedInteger:
+                            case Pointer:
+                                return read(&arg.u, sizeof(arg.u));
+                            case Double:
+                                return read(&arg.d, sizeof(arg.d));
+                            case String:
+                                if(!read(&arg.sSize, sizeof(arg.sSize)) || static_cast<size_t>(_end - _p) < arg.sSize)
+                                {
+                                    _p = _end;
+                                    return false;
+                                }
+                                arg.s = _p;
+                                _p += arg.sSize;
+                                return true;
+                        }
+                        _p = _end;
+                        return false;
+                    }
+
+                private:
+                    bool read(void * value, size_t size)
+                    {
+                        if(static_cast<size_t>(_end - _p) < size)
+                        {
+                            _p = _end;
+                            return false;
+                        }
+                        memcpy(value, _p, size);
+                        _p += size;
+                        return true;
+                    }
+
+                    const char * _p;
+                    const char * _end;
+                };
+
+                template<typename T>
+                void appendFormatted(std::string & out, const std::string & spec, T value)
+                {
+                    char buffer[128];
+                    const int n = snprintf(buffer, sizeof(buffer), spec.c_str(), value);
+                    if(n < 0)
+                    {
+                        return;
+                    }
+                    if(static_cast<size_t>(n) < sizeof(buffer))
+                    {
+                        out.append(buffer, n);
+                        return;
+                    }
+                    // very wide fields
+                    std::vector<char> large(n + 1);
+                    snprintf(&large[0], large.size(), spec.c_str(), value);
+                    out.append(&large[0], n);
+                }
+
+                bool isFlag(char c)
+                {
+                    return c == '-' || c == '+' || c == ' ' || c == '#' || c == '0' || c == '\'';
+                }
+
+                bool isDigit(char c)
+                {
+                    return c >= '0' && c <= '9';
+                }
+
+            } // namespace
+
+            void format(const char * fmt, const char * args, size_t argsSize, std::string & out)
+            {
+                ArgumentReader reader(args, argsSize);
+                Argument arg;
+                std::string spec, str;
+                const char * p = fmt;
+                while(*p)
+                {
+                    const char * percent = strchr(p, '%');
+                    if(!percent)
+                    {
+                        out.append(p);
+                        break;
+                    }
+                    out.append(p, percent - p);
+                    p = percent + 1;
+                    if(*p == '%')
+                    {
+                        out.push_back('%');
+                        ++p;
+                        continue;
+                    }
+
+                    // %[flags][width][.precision][length]conversion, with * taken from the arguments
+                    spec.assign(1, '%');
+                    while(isFlag(*p))
+                    {
+                        spec.push_back(*p++);
+                    }
+                    for(int field = 0; field < 2; ++field)
+                    {
+                        if(field == 1)
+                        {
+                            if(*p != '.')
+                            {
+                                break;
+                            }
+                            spec.push_back(*p++);
+                        }
+                        if(*p == '*')
+                        {
+                            ++p;
+                            const bool ok = reader.next(arg);
+                            char number[32];
+                            snprintf(number, sizeof(number), "%d", ok ? static_cast<int>(arg.asSigned()) : 0);
+                            spec.append(number);
+                        }
+                        while(isDigit(*p))
+                        {
+                            spec.push_back(*p++);
+                        }
+                    }
+
+                    // The length modifier tells how many bits of an integer are significant.
+                    int bits = 32;
+                    if(*p == 'h')
+                    {
+                        ++p;
+                        bits = 16;
+                        if(*p == 'h')
+                        {
+                            ++p;
+                            bits = 8;
+                        }
+                    }
+                    else if(*p == 'l' || *p == 'j' || *p == 'z' || *p == 't' || *p == 'q' || *p == 'L')
+                    {
+                        bits = (*p == 'l' && sizeof(long) == 4) ? 32 : 64;
+                        if(*p == 'l' && p[1] == 'l')
+                        {
+                            bits = 64;
+                            ++p;
+                        }
+                        ++p;
+                    }
+
+                    const char conversion = *p;
+                    if(!conversion)
+                    {
+                        out.append(spec);
+                        break;
+                    }
+                    ++p;
+                    if(conversion == 'n')
+                    {
+                        // never write through a pointer from the log
+                        reader.next(arg);
+                        continue;
+                    }
+                    if(!reader.next(arg))
+                    {
+                        out.append("<missing>");
+                        continue;
+                    }
+
+                    switch(conversion)
+                    {
+                        case 'd':
+                        case 'i':
+                        {
+                            boost::int64_t v = arg.asSigned();
+                            if(bits == 8) v = static_cast<signed char>(v);
+                            else if(bits == 16) v = static_cast<short>(v);
+                            else if(bits == 32) v = static_cast<int>(v);
+                            spec.append("lld");
+                            appendFormatted(out, spec, static_cast<long long>(v));
+                            break;
+                        }
+                        case 'u':
+                        case 'o':
+                        case 'x':
+                        case 'X':
+                        {
+                            boost::uint64_t v = arg.asUnsigned();
+                            if(bits < 64)
+                            {
+                                v &= (boost::uint64_t(1) << bits) - 1;
+                            }
+                            spec.append("ll");
+                            spec.push_back(conversion);
+                            appendFormatted(out, spec, static_cast<unsigned long long>(v));
+                            break;
+                        }
+                        case 'c':
+                            spec.push_back('c');
+                            appendFormatted(out, spec, static_cast<int>(static_cast<unsigned char>(arg.asSigned())));
+                            break;
+                        case 'f':
+                        case 'F':
+                        case 'e':
+                        case 'E':
+                        case 'g':
+                        case 'G':
+                        case 'a':
+                        case 'A':
+                            spec.push_back(conversion);
+                            appendFormatted(out, spec, arg.asDouble());
+                            break;
+                        case 's':
+                            if(arg.type == String)
+                            {
+                                // The encoded string is not null terminated.
+                                str.assign(arg.s, arg.sSize);
+                                spec.push_back('s');
+                                appendFormatted(out, spec, str.c_str());
+                            }
+                            else
+                            {
+                                out.append("<not a string>");
+                            }
+                            break;
+                        case 'p':
+                            spec.push_back('p');
+                            appendFormatted(out, spec, reinterpret_cast<void *>(static_cast<boost::uintptr_t>(arg.asUnsigned())));
+                            break;
+                        default:
+                            // unknown conversion, print it as it is
+                            out.append(spec);
+                            out.push_back(conversion);
+                            break;
+                    }
+                }
+            }
+
+            void checkFormat(const char *, ...)
+            {
+            }
+
+        } // namespace deferred
+    } // namespace logging
+} // namespace sm
@@ -0,0 +1,258 @@
+#include <sm/logging/FileLogger.hpp>
+#include <sm/logging/LoggingEvent.hpp>
+#include <boost/lexical_cast.hpp>
+#include <algorithm>
+#include <cerrno>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <iostream>
+#include <stdexcept>
+#include <fcntl.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+namespace sm {
+    namespace logging {
+
+        namespace {
+            // the alignment O_DIRECT needs for buffers, sizes and offsets
+            const size_t kBlockSize = 4096;
+        } // namespace
+
+        FileLogger::Options::Options() :
+            bufferSize(1 << 20),
+            maxFileSize(0),
+            rotationInterval(Duration::zero()),
+            maxBackups(5),
+            flushLevel(levels::Error),
+            flushInterval(std::chrono::duration_cast<Duration>(std::chrono::seconds(1))),
+            syncPolicy(NoSync),
+            append(false)
+        {
+        }
+
+        FileLogger::FileLogger(const std::string & path, const Options & options) :
+            _path(path), _options(options), _fd(-1), _direct(false), _buffer(NULL),
+            _bufferCapacity(std::max(kBlockSize, (options.bufferSize + kBlockSize - 1) / kBlockSize * kBlockSize)),
+            _bufferSize(0), _bufferOffset(0)
+        {
+            formatter.doColor_ = false;
+            void * buffer = NULL;
+            if(posix_memalign(&buffer, kBlockSize, _bufferCapacity) != 0)
+            {
+                throw std::bad_alloc();
+            }
+            _buffer = static_cast<char *>(buffer);
+            try
+            {
+                open(_options.append);
+            }
+            catch(...)
+            {
+                free(_buffer);
+                throw;
+            }
+        }
+
+        FileLogger::~FileLogger()
+        {
+            close();
+            free(_buffer);
+        }
+
+        void FileLogger::open(bool append)
+        {
+            int flags = O_CREAT | (append ? 0 : O_TRUNC);
+            _direct = false;
+            _fd = -1;
+#ifdef O_DIRECT
+            if(_options.syncPolicy == Direct)
+            {
+                // read access for the partial block at the end of an appended file
+                _fd = ::open(_path.c_str(), flags | O_RDWR | O_DIRECT, 0644);
+                _direct = _fd >= 0;
+            }
+#endif
+            if(_fd < 0)
+            {
+                _fd = ::open(_path.c_str(), flags | O_WRONLY, 0644);
+            }
+            if(_fd < 0)
+            {
+                throw std::runtime_error("Unable to open the log file " + _path + " for writing: " + strerror(errno));
+            }
+
+            _bufferSize = 0;
+            _bufferOffset = 0;
+            struct stat st;
+            if(append && fstat(_fd, &st) == 0)
+            {
+                _bufferOffset = st.st_size;
+                if(_direct)
+                {
+                    // Start at the beginning of the last block and rewrite it.
+                    _bufferOffset -= _bufferOffset % kBlockSize;
+                    const ssize_t tail = pread(_fd, _buffer, kBlockSize, _bufferOffset);
+                    _bufferSize = tail > 0 ? static_cast<size_t>(tail) : 0;
+                }
+            }
+            _lastWrite = Clock::now();
+            _nextRotation = _lastWrite + _options.rotationInterval;
+        }
+
+        void FileLogger::close()
+        {
+            if(_fd >= 0)
+            {
+                writeBuffer(true);
+                ::close(_fd);
+                _fd = -1;
+            }
+        }
+
+        void FileLogger::writeFully(const char * data, size_t size, boost::uint64_t offset)
+        {
+            while(size > 0)
+            {
+                const ssize_t written = pwrite(_fd, data, size, offset);
+                if(written < 0)
+                {
+                    if(errno == EINTR)
+                    {
+                        continue;
+                    }
+                    // Logging must not fail the caller, report it and drop the data.
+                    std::cerr << "sm::logging::FileLogger: unable to write to " << _path << ": " << strerror(errno) << std::endl;
+                    return;
+                }
+                data += written;
+                size -= written;
+                offset += written;
+            }
+        }
+
+        void FileLogger::writeBuffer(bool all)
+        {
+            _lastWrite = Clock::now();
+            if(_bufferSize == 0)
+            {
+                return;
+            }
+            if(!_direct)
+            {
+                writeFully(_buffer, _bufferSize, _bufferOffset);
+                _bufferOffset += _bufferSize;
+                _bufferSize = 0;
+            }
+            else
+            {
+                const size_t blocks = _bufferSize - _bufferSize % kBlockSize;
+                const size_t tail = _bufferSize - blocks;
+                if(blocks > 0)
+                {
+                    writeFully(_buffer, blocks, _bufferOffset);
+                }
+#ifdef O_DIRECT
+                if(all && tail > 0)
+                {
+                    // O_DIRECT only writes whole blocks. Write the rest through
+                    // the page cache, it is written again with the next events.
+                    const int flags = fcntl(_fd, F_GETFL);
+                    fcntl(_fd, F_SETFL, flags & ~O_DIRECT);
+                    writeFully(_buffer + blocks, tail, _bufferOffset + blocks);
+                    fcntl(_fd, F_SETFL, flags);
+                }
+#endif
+                if(blocks > 0)
+                {
+                    memmove(_buffer, _buffer + blocks, tail);
+                    _bufferOffset += blocks;
+                    _bufferSize = tail;
+                }
+            }
+            if(_options.syncPolicy == DataSync)
+            {
+                fdatasync(_fd);
+            }
+        }
+
+        void FileLogger::flush()
+        {
+            boost::mutex::scoped_lock lock(_mutex);
+            writeBuffer(true);
+        }
+
+        void FileLogger::rotate()
+        {
+            boost::mutex::scoped_lock lock(_mutex);
+            rotateUnlocked();
+        }
+
+        void FileLogger::rotateUnlocked()
+        {
+            close();
+            if(_options.maxBackups > 0)
+            {
+                for(int i = _options.maxBackups - 1; i > 0; --i)
+                {
+                    const std::string from = _path + "." + boost::lexical_cast<std::string>(i);
+                    const std::string to = _path + "." + boost::lexical_cast<std::string>(i + 1);
+                    ::rename(from.c_str(), to.c_str());
+                }
+                ::rename(_path.c_str(), (_path + ".1").c_str());
+            }
+            open(false);
+        }
+
+        void FileLogger::logImplementation(const LoggingEvent & event)
+        {
+            boost::mutex::scoped_lock lock(_mutex);
+            if(_fd < 0)
+            {
+                // a failed rotation
+                return;
+            }
+            _line.clear();
+            formatter.format(event, _line);
+
+            const Time now = Clock::now();
+            const boost::uint64_t fileSize = _bufferOffset + _bufferSize;
+            if( (_options.rotationInterval > Duration::zero() && now >= _nextRotation) ||
+                (_options.maxFileSize > 0 && fileSize > 0 && fileSize + _line.size() > _options.maxFileSize) )
+            {
+                try
+                {
+                    rotateUnlocked();
+                }
+                catch(const std::exception & e)
+                {
+                    std::cerr << "sm::logging::FileLogger: " << e.what() << std::endl;
+                    return;
+                }
+            }
+
+            const char * data = _line.data();
+            size_t size = _line.size();
+            while(size > 0)
+            {
+                const size_t n = std::min(size, _bufferCapacity - _bufferSize);
+                memcpy(_buffer + _bufferSize, data, n);
+                _bufferSize += n;
+                data += n;
+                size -= n;
+                if(_bufferSize == _bufferCapacity)
+                {
+                    writeBuffer(false);
+                }
+            }
+
+            if(event.level >= _options.flushLevel ||
+               (_options.flushInterval > Duration::zero() && now - _lastWrite >= _options.flushInterval))
+            {
+                writeBuffer(true);
+            }
+        }
+
+    } // namespace logging
+} // namespace sm
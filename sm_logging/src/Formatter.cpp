@@ -1,174 +1,179 @@
 #include <sm/logging/Formatter.hpp>
-
-#if ! defined __GLIBCXX__  || __GLIBCXX__ > 20150426
-#include <regex>
-#else
-#include <boost/regex.hpp>
-#define USE_BOOST_REGEX
-#endif
+#include <boost/thread/thread.hpp>
+#include <cstdlib>
+#include <cstring>
+#include <sstream>
 
 namespace sm {
     namespace logging {
-        
-        Formatter::~Formatter(){}
 
-            TokenPtr Formatter::createTokenFromType(const std::string& type)
+        namespace {
+            // indexed by the level
+            const char * const kSeverityStrings[levels::Count] = {
+                "  ALL", "FINES", "VERBO", "FINER", "TRACE", " FINE", "DEBUG", " INFO", " WARN", "ERROR", "FATAL"
+            };
+            const char * const kSeverityColors[levels::Count] = {
+                COLOR_LIGHT_GREEN, COLOR_LIGHT_GREEN, COLOR_LIGHT_GREEN, COLOR_LIGHT_GREEN, COLOR_LIGHT_GREEN,
+                COLOR_LIGHT_GREEN, COLOR_GREEN, COLOR_NORMAL, COLOR_YELLOW, COLOR_RED, COLOR_LIGHT_RED
+            };
+
+            bool isKnownLevel(Level level)
+            {
+                return level >= levels::All && level < levels::Count;
+            }
+
+            void appendInt(std::string & out, int value)
+            {
+                char buffer[16];
+                char * end = buffer + sizeof(buffer);
+                char * p = end;
+                unsigned int v = value < 0 ? 0u - static_cast<unsigned int>(value) : static_cast<unsigned int>(value);
+                do
                 {
-                    if (type == "severity")
-                    {
-                        return TokenPtr(new SeverityToken());
-                    }
-                    else if (type == "message")
-                    {
-                        return TokenPtr(new MessageToken());
-                    }
-                    else if (type == "time")
-                    {
-                        return TokenPtr(new TimeToken());
-                    }
-                    else if (type == "thread")
-                    {
-                        return TokenPtr(new ThreadToken());
-                    }
-                    else if (type == "file")
-                    {
-                        return TokenPtr(new FileToken());
-                    }
-                    else if (type == "line")
-                    {
-                        return TokenPtr(new LineToken());
-                    }
-                    else if (type == "function")
-                    {
-                        return TokenPtr(new FunctionToken());
-                    }
-                    else if (type == "streamname")
-                    {
-                        return TokenPtr(new StreamNameToken());
-                    }
+                    *--p = static_cast<char>('0' + v % 10);
+                    v /= 10;
+                } while(v != 0);
+                if(value < 0)
+                {
+                    *--p = '-';
+                }
+                out.append(p, end - p);
+            }
 
-                    return TokenPtr(new FixedMapToken(type, extra_fixed_tokens_));
+            const std::string & currentThreadString()
+            {
+                static thread_local std::string thread;
+                if(thread.empty())
+                {
+                    std::stringstream ss;
+                    ss << boost::this_thread::get_id();
+                    thread = ss.str();
                 }
+                return thread;
+            }
 
+            bool isTokenChar(char c)
+            {
+                return (c >= 'a' && c <= 'z') || (c >= 'A' && c <= 'Z');
+            }
+        } // namespace
+
+        Formatter::~Formatter(){}
 
             void Formatter::init(const char* fmt)
                 {
                     format_ = fmt;
+                    instructions_.clear();
 
-#ifndef USE_BOOST_REGEX
-                    std::regex FormatterFormatGroupPattern("\\$\\{([a-zA-Z]+)[}]", std::regex::egrep); // The [}] is a workaround for a bug in at least libstdc++ 5.4 that throws on "\\}" (BUT not on "\\{").
-                    using std::match_results;
-                    using std::regex_search;
-#else
-                    boost::regex FormatterFormatGroupPattern("\\$\\{([a-z|A-Z]+)\\}");
-                    using boost::match_results;
-                    using boost::regex_search;
-#endif
-
-
-                    match_results<std::string::const_iterator> results;
-                    std::string::const_iterator start, end;
-                    start = format_.begin();
-                    end = format_.end();
-                    bool matched_once = false;
-                    std::string last_suffix;
-                    tokens_.clear();
-                    while (regex_search(start, end, results, FormatterFormatGroupPattern))
+                    // Split the format into ${name} tokens and the fixed text between them.
+                    // Neighbouring fixed text is merged into one instruction.
+                    std::string text;
+                    const char * p = format_.c_str();
+                    while(*p != '\0')
                     {
-#if 0
-                        for (size_t i = 0; i < results.size(); ++i)
+                        if(p[0] == '$' && p[1] == '{')
                         {
-                            std::cout << i << "|" << results.prefix() << "|" <<  results[i] << "|" << results.suffix() << std::endl;
+                            const char * name = p + 2;
+                            const char * nameEnd = name;
+                            while(isTokenChar(*nameEnd))
+                            {
+                                ++nameEnd;
+                            }
+                            if(nameEnd != name && *nameEnd == '}')
+                            {
+                                const TokenType type = tokenTypeFromName(name, nameEnd - name);
+                                if(type == FixedToken)
+                                {
+                                    const std::string key(name, nameEnd);
+                                    M_string::const_iterator it = extra_fixed_tokens_.find(key);
+                                    text += it == extra_fixed_tokens_.end() ? std::string(p, nameEnd + 1) : it->second;
+                                }
+                                else
+                                {
+                                    if(!text.empty())
+                                    {
+                                        Instruction fixed = { FixedToken, text };
+                                        instructions_.push_back(fixed);
+                                        text.clear();
+                                    }
+                                    Instruction token = { type, std::string() };
+                                    instructions_.push_back(token);
+                                }
+                                p = nameEnd + 1;
+                                continue;
+                            }
                         }
-#endif
-
-                        std::string token = results[1];
-                        last_suffix = results.suffix();
-                        tokens_.push_back(TokenPtr(new FixedToken(results.prefix())));
-                        tokens_.push_back(createTokenFromType(token));
-
-                        start = results[0].second;
-                        matched_once = true;
+                        text += *p;
+                        ++p;
                     }
-
-                    if (matched_once)
+                    if(!text.empty())
                     {
-                        tokens_.push_back(TokenPtr(new FixedToken(last_suffix)));
-                    }
-                    else
-                    {
-                        tokens_.push_back(TokenPtr(new FixedToken(format_)));
+                        Instruction fixed = { FixedToken, text };
+                        instructions_.push_back(fixed);
                     }
                 }
 
-            void Formatter::print(const ::sm::logging::LoggingEvent& event, std::ostream & ss)
+            void Formatter::setFixedToken(const std::string & name, const std::string & value)
                 {
-                    const char* color = COLOR_NORMAL;
-                    //FILE * f = stdout;
-
-                    if (event.level == SMCONSOLE_SEVERITY_FATAL)
-                    {
-                        color = COLOR_LIGHT_RED;
-                        //f = stderr;
-                    }
-                    else if (event.level == SMCONSOLE_SEVERITY_ERROR)
-                    {
-                        color = COLOR_RED;
-                        //f = stderr;
-                    }
-                    else if (event.level == SMCONSOLE_SEVERITY_WARN)
-                    {
-                        color = COLOR_YELLOW;
-                    }
-                    else if (event.level == SMCONSOLE_SEVERITY_INFO)
-                    {
-                        color = COLOR_NORMAL;
-                    }
-                    else if (event.level == SMCONSOLE_SEVERITY_DEBUG)
-                    {
-                        color = COLOR_GREEN;
-                    }
-                    else if (event.level == SMCONSOLE_SEVERITY_FINE)
-                    {
-                        color = COLOR_LIGHT_GREEN;
-                    }
-                    else if (event.level == SMCONSOLE_SEVERITY_TRACE)
-                    {
-                        color = COLOR_LIGHT_GREEN;
-                    }
-                    else if (event.level == SMCONSOLE_SEVERITY_FINER)
-                    {
-                        color = COLOR_LIGHT_GREEN;
-                    }
-                    else if (event.level == SMCONSOLE_SEVERITY_VERBOSE)
-                    {
-                        color = COLOR_LIGHT_GREEN;
-                    }
-                    else if (event.level == SMCONSOLE_SEVERITY_FINEST)
-                    {
-                        color = COLOR_LIGHT_GREEN;
-                    }
-                    else if (event.level == SMCONSOLE_SEVERITY_ALL)
-                    {
-                        color = COLOR_LIGHT_GREEN;
-                    }
+                    extra_fixed_tokens_[name] = value;
+                    init(format_.c_str());
+                }
 
+            void Formatter::format(const ::sm::logging::LoggingEvent& event, std::string & out) const
+                {
+                    const bool knownLevel = isKnownLevel(event.level);
                     if(doColor_)
                     {
-                        ss << color;
+                        out += knownLevel ? kSeverityColors[event.level] : COLOR_NORMAL;
                     }
-                    V_Token::iterator it = tokens_.begin();
-                    V_Token::iterator end = tokens_.end();
-                    for (; it != end; ++it)
+                    for(std::vector<Instruction>::const_iterator it = instructions_.begin(); it != instructions_.end(); ++it)
                     {
-                        ss << (*it)->getString(event);
+                        switch(it->type)
+                        {
+                        case FixedToken:
+                            out += it->text;
+                            break;
+                        case SeverityToken:
+                            out += knownLevel ? kSeverityStrings[event.level] : "UNKNO";
+                            break;
+                        case MessageToken:
+                            out += event.message;
+                            break;
+                        case TimeToken:
+                            Logger::appendTimeString(event.time, out);
+                            break;
+                        case ThreadToken:
+                            out += currentThreadString();
+                            break;
+                        case FileToken:
+                            out += event.file;
+                            break;
+                        case LineToken:
+                            appendInt(out, event.line);
+                            break;
+                        case FunctionToken:
+                            out += event.function;
+                            break;
+                        case StreamNameToken:
+                            out += event.streamName;
+                            break;
+                        }
                     }
                     if(doColor_)
                     {
-                        ss << COLOR_NORMAL;
+                        out += COLOR_NORMAL;
                     }
-                    ss << std::endl;
+                    out += '\n';
+                }
 
+            void Formatter::print(const ::sm::logging::LoggingEvent& event, std::ostream & ss)
+                {
+                    // reused so that printing does not allocate once the buffer has grown
+                    static thread_local std::string buffer;
+                    buffer.clear();
+                    format(event, buffer);
+                    ss.write(buffer.data(), buffer.size());
+                    ss.flush();
                 }
 
         Formatter::Formatter() : doColor_(true){
@@ -187,7 +192,7 @@ namespace sm {
                 {
                     init(format_string);
                 }
-                
+
             }
 
 
@@ -0,0 +1,150 @@
+#include <sm/logging/JsonLinesLogger.hpp>
+#include <sm/logging/LoggingEvent.hpp>
+#include <cmath>
+#include <cstring>
+#include <stdexcept>
+
+namespace sm {
+    namespace logging {
+
+        namespace {
+            const size_t kFileBufferSize = 1 << 16;
+
+            // the names of levels::fromString(), indexed by the level
+            const char * const kLevelNames[levels::Count] = {
+                "all", "finest", "verbose", "finer", "trace", "fine", "debug", "info", "warn", "error", "fatal"
+            };
+
+            void appendJsonString(std::string & out, const char * str, size_t length)
+            {
+                static const char kHex[] = "0123456789abcdef";
+                out += '"';
+                const char * begin = str;
+                const char * end = str + length;
+                for(const char * p = str; p != end; ++p)
+                {
+                    const unsigned char c = static_cast<unsigned char>(*p);
+                    if(c >= 0x20 && c != '"' && c != '\\')
+                    {
+                        continue;
+                    }
+                    out.append(begin, p - begin);
+                    begin = p + 1;
+                    switch(c)
+                    {
+                    case '"': out += "\\\""; break;
+                    case '\\': out += "\\\\"; break;
+                    case '\n': out += "\\n"; break;
+                    case '\r': out += "\\r"; break;
+                    case '\t': out += "\\t"; break;
+                    default:
+                        out += "\\u00";
+                        out += kHex[c >> 4];
+                        out += kHex[c & 0xf];
+                    }
+                }
+                out.append(begin, end - begin);
+                out += '"';
+            }
+
+            void appendJsonString(std::string & out, const char * str)
+            {
+                appendJsonString(out, str, strlen(str));
+            }
+        } // namespace
+
+        JsonLinesLogger::JsonLinesLogger(std::ostream & stream) : _stream(stream) {}
+
+        JsonLinesLogger::JsonLinesLogger(const std::string & path) : _fileBuffer(kFileBufferSize), _stream(_file)
+        {
+            _file.rdbuf()->pubsetbuf(&_fileBuffer[0], _fileBuffer.size());
+            _file.open(path.c_str(), std::ios::binary | std::ios::trunc);
+            if(!_file.good())
+            {
+                throw std::runtime_error("Unable to open the log file " + path + " for writing");
+            }
+        }
+
+        JsonLinesLogger::~JsonLinesLogger()
+        {
+            _stream.flush();
+        }
+
+        void JsonLinesLogger::flush()
+        {
+            boost::mutex::scoped_lock lock(_mutex);
+            _stream.flush();
+        }
+
+        void JsonLinesLogger::format(const LoggingEvent & event, std::string & out)
+        {
+            out += "{\"time\":";
+            Logger::appendTimeString(event.time, out);
+            out += ",\"level\":";
+            if(event.level >= levels::All && event.level < levels::Count)
+            {
+                appendJsonString(out, kLevelNames[event.level]);
+            }
+            else
+            {
+                out += "null";
+            }
+            out += ",\"stream\":";
+            appendJsonString(out, event.streamName);
+            out += ",\"file\":";
+            appendJsonString(out, event.file);
+            out += ",\"line\":";
+            appendLogFieldValue(makeLogField("line", event.line), out);
+            out += ",\"function\":";
+            appendJsonString(out, event.function);
+
+            // The message ends with the text of the fields, leave it out.
+            out += ",\"message\":";
+            appendJsonString(out, event.message,
+                             event.messageLength != std::string::npos ? event.messageLength : strlen(event.message));
+
+            if(event.numFields > 0)
+            {
+                out += ",\"fields\":{";
+                for(size_t i = 0; i < event.numFields; ++i)
+                {
+                    const LogField & field = event.fields[i];
+                    if(i > 0)
+                    {
+                        out += ',';
+                    }
+                    appendJsonString(out, field.key);
+                    out += ':';
+                    if(field.type == LogField::String)
+                    {
+                        appendJsonString(out, field.str, field.length);
+                    }
+                    else if(field.type == LogField::Double && !std::isfinite(field.d))
+                    {
+                        // JSON has no NaN or infinity
+                        out += "null";
+                    }
+                    else
+                    {
+                        appendLogFieldValue(field, out);
+                    }
+                }
+                out += '}';
+            }
+            out += "}\n";
+        }
+
+        void JsonLinesLogger::logImplementation(const LoggingEvent & event)
+        {
+            boost::mutex::scoped_lock lock(_mutex);
+            _line.clear();
+            format(event, _line);
+            _stream.write(_line.data(), _line.size());
+            if(event.level >= levels::Error)
+            {
+                _stream.flush();
+            }
+        }
+
+    } // namespace logging
+} // namespace sm
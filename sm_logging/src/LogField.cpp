@@ -0,0 +1,139 @@
+#include <sm/logging/LogField.hpp>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+
+namespace sm {
+    namespace logging {
+
+        namespace {
+            void appendUnsigned(std::string & out, boost::uint64_t value, bool negative)
+            {
+                char buffer[24];
+                char * end = buffer + sizeof(buffer);
+                char * p = end;
+                do
+                {
+                    *--p = static_cast<char>('0' + value % 10);
+                    value /= 10;
+                } while(value != 0);
+                if(negative)
+                {
+                    *--p = '-';
+                }
+                out.append(p, end - p);
+            }
+        } // namespace
+
+        void appendLogFieldValue(const LogField & field, std::string & out)
+        {
+            switch(field.type)
+            {
+            case LogField::Int:
+                appendUnsigned(out, field.i < 0 ? 0u - static_cast<boost::uint64_t>(field.i) : static_cast<boost::uint64_t>(field.i), field.i < 0);
+                break;
+            case LogField::UInt:
+                appendUnsigned(out, field.u, false);
+                break;
+            case LogField::Bool:
+                out += field.b ? "true" : "false";
+                break;
+            case LogField::Double:
+            {
+                // Most values have few decimals. If one with at most six reads back
+                // exactly, print it without going through snprintf.
+                if(std::fabs(field.d) < 1e12)
+                {
+                    const boost::int64_t scaled = static_cast<boost::int64_t>(std::llround(field.d * 1e6));
+                    if(static_cast<double>(scaled) / 1e6 == field.d)
+                    {
+                        const boost::uint64_t magnitude = scaled < 0 ? 0u - static_cast<boost::uint64_t>(scaled) : static_cast<boost::uint64_t>(scaled);
+                        appendUnsigned(out, magnitude / 1000000, std::signbit(field.d));
+                        boost::uint64_t fraction = magnitude % 1000000;
+                        if(fraction != 0)
+                        {
+                            char digits[7] = { '.' };
+                            int size = 7;
+                            for(int i = 6; i > 0; --i)
+                            {
+                                digits[i] = static_cast<char>('0' + fraction % 10);
+                                fraction /= 10;
+                            }
+                            while(digits[size - 1] == '0')
+                            {
+                                --size;
+                            }
+                            out.append(digits, size);
+                        }
+                        break;
+                    }
+                }
+                // the shortest of 15 and 17 digits that reads back the same value
+                char buffer[32];
+                int size = snprintf(buffer, sizeof(buffer), "%.15g", field.d);
+                if(std::isfinite(field.d) && strtod(buffer, NULL) != field.d)
+                {
+                    size = snprintf(buffer, sizeof(buffer), "%.17g", field.d);
+                }
+                out.append(buffer, size);
+                break;
+            }
+            case LogField::String:
+                out.append(field.str, field.length);
+                break;
+            }
+        }
+
+        void appendLogFields(const LogField * fields, size_t numFields, std::string & out)
+        {
+            for(size_t i = 0; i < numFields; ++i)
+            {
+                const LogField & field = fields[i];
+                out += ' ';
+                out += field.key;
+                out += '=';
+                if(field.type == LogField::String &&
+                   (field.length == 0 || memchr(field.str, ' ', field.length) != NULL))
+                {
+                    out += '"';
+                    out.append(field.str, field.length);
+                    out += '"';
+                }
+                else
+                {
+                    appendLogFieldValue(field, out);
+                }
+            }
+        }
+
+        void copyLogFields(const LogField * fields, size_t numFields, std::vector<LogField> & out, std::string & strings)
+        {
+            out.assign(fields, fields + numFields);
+            // Reserve everything up front, so the pointers into strings stay valid.
+            size_t size = 0;
+            for(size_t i = 0; i < numFields; ++i)
+            {
+                size += strlen(fields[i].key) + 1;
+                if(fields[i].type == LogField::String)
+                {
+                    size += fields[i].length + 1;
+                }
+            }
+            strings.clear();
+            strings.reserve(size);
+            for(size_t i = 0; i < numFields; ++i)
+            {
+                out[i].key = strings.data() + strings.size();
+                strings.append(fields[i].key);
+                strings += '\0';
+                if(fields[i].type == LogField::String)
+                {
+                    out[i].str = strings.data() + strings.size();
+                    strings.append(fields[i].str, fields[i].length);
+                    strings += '\0';
+                }
+            }
+        }
+
+    } // namespace logging
+} // namespace sm
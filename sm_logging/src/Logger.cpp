@@ -1,5 +1,8 @@
 #include <sm/logging/Logger.hpp>
+#include <sm/logging/LoggingEvent.hpp>
+#include <sm/logging/DeferredArguments.hpp>
 #include <boost/date_time/posix_time/posix_time_types.hpp>
+#include <cstdio>
 
 namespace sm {
     namespace logging {
@@ -17,15 +20,47 @@ namespace sm {
 
         std::string Logger::currentTimeString() const
         {
-            double cts = currentTimeSecondsUtc();
-            std::stringstream ss;
-            ss.fill(' ');
-            ss.setf(std::ios::fixed,std::ios::floatfield);   // floatfield set to fixed
-            ss.precision(6);
+            return timeString(currentTimeImplementation());
+        }
+
+        std::string Logger::timeString(Time time)
+        {
+            std::string str;
+            appendTimeString(time, str);
+            return str;
+        }
 
-            ss << cts;
-            return ss.str();
+        void Logger::appendTimeString(Time time, std::string & out)
+        {
+            const boost::int64_t us = std::chrono::duration_cast<std::chrono::microseconds>( time.time_since_epoch() ).count();
+            if(us < 0)
+            {
+                char buffer[32];
+                const int size = snprintf(buffer, sizeof(buffer), "%.6f", (double)us/1000000.0);
+                out.append(buffer, size);
+                return;
+            }
+
+            // The events of a thread mostly fall into the same second.
+            static thread_local boost::int64_t cachedSeconds = -1;
+            static thread_local char cachedPrefix[24];
+            static thread_local int cachedPrefixSize = 0;
+            const boost::int64_t seconds = us / 1000000;
+            if(seconds != cachedSeconds)
+            {
+                cachedPrefixSize = snprintf(cachedPrefix, sizeof(cachedPrefix), "%lld.", static_cast<long long>(seconds));
+                cachedSeconds = seconds;
+            }
+            out.append(cachedPrefix, cachedPrefixSize);
 
+            char micros[6];
+            boost::int64_t fraction = us % 1000000;
+            for(int i = 5; i >= 0; --i)
+            {
+                micros[i] = static_cast<char>('0' + fraction % 10);
+                fraction /= 10;
+            }
+            out.append(micros, sizeof(micros));
         }
 
         Logger::Time Logger::currentTime() const {
@@ -38,6 +73,26 @@ namespace sm {
             logImplementation(event);
         }
 
+        void Logger::logDeferred(const DeferredLoggingEvent & event)
+        {
+            logDeferredImplementation(event);
+        }
+
+        bool Logger::isThreadSafe() const
+        {
+            return false;
+        }
+
+        void Logger::logDeferredImplementation(const DeferredLoggingEvent & event)
+        {
+            // Reused by the following events of this thread.
+            static thread_local std::string message;
+            message.clear();
+            deferred::format(event.format, event.args, event.argsSize, message);
+            logImplementation( LoggingEvent( event.streamName, event.level, event.file, event.line, event.function,
+                                             message.c_str(), event.time ) );
+        }
+
         
         Logger::Time Logger::currentTimeImplementation() const
         {
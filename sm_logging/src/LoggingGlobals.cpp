@@ -1,5 +1,6 @@
 #include <sm/logging/LoggingGlobals.hpp>
 #include <sm/logging/StdOutLogger.hpp>
+#include <cstring>
 
 namespace sm {
     namespace logging {
@@ -14,7 +15,6 @@ namespace sm {
             _logger.reset( new StdOutLogger() );
             _level = levels::Info;
             enableNamedStream(SMCONSOLE_DEFAULT_NAME);
-            _globalCharBuffer.resize(4096);
         }
 
         LoggingGlobals::~LoggingGlobals()
@@ -37,34 +37,75 @@ namespace sm {
         void LoggingGlobals::registerLogLocation(LogLocation* loc) {
             boost::mutex::scoped_lock lock(_locations_mutex);
             _log_locations.push_back(loc);
+            checkLogLocationEnabledNoLock(loc);
+        }
+
+        bool LoggingGlobals::namedStreamLevelNoLock(const std::string & name, Level & level) {
+            std::map< std::string, Level >::const_iterator it = _namedStreamLevels.find(name);
+            if(it != _namedStreamLevels.end())
+            {
+                level = it->second;
+                return level != levels::Count;
+            }
+            // the longest matching hierarchy, "sm.estimator.*" before "sm.*"
+            if(!_namedStreamLevels.empty())
+            {
+                for(size_t dot = name.rfind('.'); dot != std::string::npos && dot > 0; dot = name.rfind('.', dot - 1))
+                {
+                    it = _namedStreamLevels.find(name.substr(0, dot) + ".*");
+                    if(it != _namedStreamLevels.end())
+                    {
+                        level = it->second;
+                        return level != levels::Count;
+                    }
+                }
+            }
+            if(name.empty() || _namedStreamsEnabled.count(name) > 0)
+            {
+                level = _level.load(std::memory_order_relaxed);
+                return true;
+            }
+            return false;
+        }
+
+        LogLocation::State LoggingGlobals::logLocationStateNoLock(const char* streamName, Level level) {
+            Level streamLevel = levels::Count;
+            const bool enabled = namedStreamLevelNoLock(streamName, streamLevel) && level >= streamLevel;
+            return LogLocation::makeState(enabled, level);
         }
 
         void LoggingGlobals::checkLogLocationEnabledNoLock(LogLocation* loc) {
-            loc->_loggerEnabled = loc->_level >= _level && (loc->_streamName.size() == 0 || isNamedStreamEnabled(loc->_streamName));
+            const Level level = LogLocation::levelOf(loc->_state.load(std::memory_order_relaxed));
+            const char * streamName = loc->_streamName.load(std::memory_order_relaxed);
+            loc->_state.store(logLocationStateNoLock(streamName ? streamName : "", level), std::memory_order_release);
         }
 
-        void LoggingGlobals::initializeLogLocation(LogLocation* loc, const std::string& name, Level level){
+        LogLocation::State LoggingGlobals::initializeLogLocation(LogLocation* loc, const std::string& name, Level level){
             boost::mutex::scoped_lock lock(_locations_mutex);
-                
-            if (loc->_initialized)
+
+            LogLocation::State state = loc->_state.load(std::memory_order_relaxed);
+            if (state != 0)
             {
-                return;
+                // initialized by another thread
+                return state;
             }
 
-            loc->_streamName = name;
-            loc->_level = level;
-                
+            const char * streamName = _streamNames.insert(name).first->c_str();
+            loc->_streamName.store(streamName, std::memory_order_relaxed);
             _log_locations.push_back(loc);
-                
-            checkLogLocationEnabledNoLock(loc);
-            
-            loc->_initialized = true;
+
+            // publishes the stream name together with the state
+            state = logLocationStateNoLock(streamName, level);
+            loc->_state.store(state, std::memory_order_release);
+            return state;
         }
 
-        void LoggingGlobals::setLogLocationLevel(LogLocation* loc, Level level)
+        LogLocation::State LoggingGlobals::setLogLocationLevel(LogLocation* loc, Level level)
         {
             boost::mutex::scoped_lock lock(_locations_mutex);
-            loc->_level = level;
+            const LogLocation::State state = logLocationStateNoLock(loc->_streamName.load(std::memory_order_relaxed), level);
+            loc->_state.store(state, std::memory_order_release);
+            return state;
         }
 
         void LoggingGlobals::checkLogLocationEnabled(LogLocation* loc)
@@ -78,15 +119,17 @@ namespace sm {
         /**
          * \brief Tells the system that a logger's level has changed
          *
-         * This must be called if a log4cxx::Logger's level has been changed in the middle of an application run.
-         * Because of the way the static guard for enablement works, if a logger's level is changed and this
-         * function is not called, only logging statements which are first hit *after* the change will be correct wrt
-         * that logger.
+         * Recomputes the state of all logging locations. setLevel() and
+         * the named stream functions call it.
          */
         void LoggingGlobals::notifyLoggerLevelsChanged()
         {
             boost::mutex::scoped_lock lock(_locations_mutex);
-                    
+            notifyLoggerLevelsChangedNoLock();
+        }
+
+        void LoggingGlobals::notifyLoggerLevelsChangedNoLock()
+        {
             V_LogLocation::iterator it = _log_locations.begin();
             V_LogLocation::iterator end = _log_locations.end();
             for ( ; it != end; ++it )
@@ -98,67 +141,123 @@ namespace sm {
 
         
         bool LoggingGlobals::isNamedStreamEnabled( const std::string & name ){
-            boost::recursive_mutex::scoped_lock lock(_named_stream_mutex);
-            std::set< std::string >::iterator it = _namedStreamsEnabled.find(name);
-            return it != _namedStreamsEnabled.end();
-                
+            boost::mutex::scoped_lock lock(_locations_mutex);
+            Level level;
+            return namedStreamLevelNoLock(name, level);
         }
 
         void LoggingGlobals::enableNamedStream( const std::string & name ) {
-            boost::recursive_mutex::scoped_lock lock(_named_stream_mutex);
-            _namedStreamsEnabled.insert(name);
-            notifyLoggerLevelsChanged();
+            boost::mutex::scoped_lock lock(_locations_mutex);
+            if(_namedStreamsEnabled.insert(name).second)
+            {
+                notifyLoggerLevelsChangedNoLock();
+            }
         }
 
         void LoggingGlobals::disableNamedStream( const std::string & name ) {
-            boost::recursive_mutex::scoped_lock lock(_named_stream_mutex);
-            std::set< std::string >::iterator it = _namedStreamsEnabled.find(name);
-            if(it != _namedStreamsEnabled.end())
+            boost::mutex::scoped_lock lock(_locations_mutex);
+            if(_namedStreamsEnabled.erase(name) > 0)
             {
-                _namedStreamsEnabled.erase(it);
-                notifyLoggerLevelsChanged();
+                notifyLoggerLevelsChangedNoLock();
             }
         }
 
+        void LoggingGlobals::setNamedStreamLevel( const std::string & name, Level level ) {
+            boost::mutex::scoped_lock lock(_locations_mutex);
+            _namedStreamLevels[name] = level;
+            notifyLoggerLevelsChangedNoLock();
+        }
+
+        void LoggingGlobals::clearNamedStreamLevel( const std::string & name ) {
+            boost::mutex::scoped_lock lock(_locations_mutex);
+            if(_namedStreamLevels.erase(name) > 0)
+            {
+                notifyLoggerLevelsChangedNoLock();
+            }
+        }
 
 
 
-        void LoggingGlobals::vformatToBuffer(const char* fmt, va_list args)
+
+        namespace {
+            // Messages up to this size are formatted without allocating.
+            const size_t kInlineBufferSize = 512;
+            // Longer messages use a heap buffer, which is released again if it grew beyond this.
+            const size_t kMaxRetainedBufferSize = 1 << 16;
+
+            struct FormatBuffer
+            {
+                char inlineBuffer[kInlineBufferSize];
+                std::vector<char> heapBuffer;
+            };
+
+            FormatBuffer & threadFormatBuffer()
+            {
+                static thread_local FormatBuffer buffer;
+                return buffer;
+            }
+
+            // Set while this thread passes an event to the logger, to throw out log
+            // statements of the logger itself.
+            thread_local bool t_printing = false;
+
+            class PrintingGuard
+            {
+            public:
+                PrintingGuard() : _recursive(t_printing)
+                {
+                    if(_recursive)
+                    {
+                        fprintf(stderr, "Warning: recursive print statement has occurred.  Throwing out recursive print.\n");
+                    }
+                    t_printing = true;
+                }
+                ~PrintingGuard()
+                {
+                    t_printing = _recursive;
+                }
+                bool recursive() const { return _recursive; }
+            private:
+                bool _recursive;
+            };
+        } // namespace
+
+        const char* LoggingGlobals::vformatToBuffer(const char* fmt, va_list args)
         {
+            FormatBuffer & buffer = threadFormatBuffer();
+            if(buffer.heapBuffer.capacity() > kMaxRetainedBufferSize)
+            {
+                std::vector<char>().swap(buffer.heapBuffer);
+            }
 #ifdef _MSC_VER
             va_list arg_copy = args; // dangerous?
 #else
             va_list arg_copy;
             va_copy(arg_copy, args);
 #endif
-            
-#ifdef _MSC_VER
-            size_t total = vsnprintf_s(&_globalCharBuffer[0], _globalCharBuffer.size(), _globalCharBuffer.size(), fmt, args);
-#else
-            size_t total = vsnprintf(&_globalCharBuffer[0], _globalCharBuffer.size(), fmt, args);
-#endif
-            if (total >= _globalCharBuffer.size())
+
+            // C99 vsnprintf, which returns the size of the whole message (also in MSVC 2015 and later)
+            size_t total = vsnprintf(buffer.inlineBuffer, kInlineBufferSize, fmt, args);
+            const char* str = buffer.inlineBuffer;
+            if (total >= kInlineBufferSize)
             {
-                _globalCharBuffer.resize(total + 2);
-#ifdef _MSC_VER
-                total = vsnprintf_s(&_globalCharBuffer[0], _globalCharBuffer.size(), _globalCharBuffer.size(), fmt, arg_copy);
-#else
-                total = vsnprintf(&_globalCharBuffer[0], _globalCharBuffer.size(), fmt, arg_copy);
-#endif
-               
+                buffer.heapBuffer.resize(total + 1);
+                vsnprintf(&buffer.heapBuffer[0], buffer.heapBuffer.size(), fmt, arg_copy);
+                str = &buffer.heapBuffer[0];
             }
             va_end(arg_copy);
-
+            return str;
         }
 
-        void LoggingGlobals::formatToBuffer(const char* fmt, ...)
+        const char* LoggingGlobals::formatToBuffer(const char* fmt, ...)
         {
             va_list args;
             va_start(args, fmt);
 
-            vformatToBuffer(fmt, args);
+            const char* str = vformatToBuffer(fmt, args);
 
             va_end(args);
+            return str;
         }
 
 
@@ -167,34 +266,27 @@ namespace sm {
             if (_shutting_down)
                 return;
 
-            if (_printing_thread_id == boost::this_thread::get_id())
-            {
-                fprintf(stderr, "Warning: recursive print statement has occurred.  Throwing out recursive print.\n");
+            PrintingGuard guard;
+            if (guard.recursive())
                 return;
-            }
-
-            boost::mutex::scoped_lock lock(_print_mutex);
-
-            _printing_thread_id = boost::this_thread::get_id();
 
+            // formatted by this thread outside of the lock
             va_list args;
             va_start(args, fmt);
 
-            vformatToBuffer(fmt, args);
+            const char* message = vformatToBuffer(fmt, args);
 
             va_end(args);
 
+            boost::mutex::scoped_lock lock = printLock();
             try
             {
-                _logger->log( LoggingEvent( streamName, level, file, line, function, &_globalCharBuffer[0], _logger->currentTimeString() ) );
+                _logger->log( LoggingEvent( streamName, level, file, line, function, message, _logger->currentTime() ) );
             }
             catch (std::exception& e)
             {
                 fprintf(stderr, "Caught exception while logging: [%s]\n", e.what());
             }
-                    
-
-            _printing_thread_id = boost::thread::id();
         }
 
         void LoggingGlobals::print(const char * streamName,  Level level, 
@@ -203,46 +295,99 @@ namespace sm {
             if (_shutting_down)
                 return;
 
-            if (_printing_thread_id == boost::this_thread::get_id())
-            {
-                fprintf(stderr, "Warning: recursive print statement has occurred.  Throwing out recursive print.\n");
+            PrintingGuard guard;
+            if (guard.recursive())
                 return;
-            }
 
             std::vector<char> str;
             ss.swap_vector(str);
             // make sure the string is null terminated.
             str.push_back('\0');
             
-            boost::mutex::scoped_lock lock(_print_mutex);
+            boost::mutex::scoped_lock lock = printLock();
+            try
+            {
+                _logger->log( LoggingEvent( streamName, level, file, line, function, &str[0], _logger->currentTime() ) );
+            }
+            catch (std::exception& e)
+            {
+                fprintf(stderr, "Caught exception while logging: [%s]\n", e.what());
+            }
+        }
+
+
+        void LoggingGlobals::printFieldArray(const char * streamName, Level level, const char* file, int line, const char* function,
+                                             const char* message, const LogField * fields, size_t numFields)
+        {
+            if (_shutting_down)
+                return;
+
+            PrintingGuard guard;
+            if (guard.recursive())
+                return;
+
+            // The text for the sinks that don't look at the fields.
+            static thread_local std::string text;
+            const size_t messageLength = strlen(message);
+            text.assign(message, messageLength);
+            appendLogFields(fields, numFields, text);
+
+            boost::mutex::scoped_lock lock = printLock();
+            try
+            {
+                _logger->log( LoggingEvent( streamName, level, file, line, function, text.c_str(), _logger->currentTime(),
+                                            fields, numFields, messageLength ) );
+            }
+            catch (std::exception& e)
+            {
+                fprintf(stderr, "Caught exception while logging: [%s]\n", e.what());
+            }
+        }
 
-            _printing_thread_id = boost::this_thread::get_id();
+        void LoggingGlobals::printDeferred(const char * streamName, Level level, const char* file, int line, const char* function,
+                                           const char* fmt, const std::vector<char> & args)
+        {
+            if (_shutting_down)
+                return;
+
+            PrintingGuard guard;
+            if (guard.recursive())
+                return;
+
+            boost::mutex::scoped_lock lock = printLock();
             try
             {
-                _logger->log( LoggingEvent( streamName, level, file, line, function, &str[0], _logger->currentTimeString() ) );
+                _logger->logDeferred( DeferredLoggingEvent( streamName, level, file, line, function, fmt,
+                                                            args.empty() ? NULL : &args[0], args.size(), _logger->currentTime() ) );
             }
             catch (std::exception& e)
             {
                 fprintf(stderr, "Caught exception while logging: [%s]\n", e.what());
             }
-                    
-            _printing_thread_id = boost::thread::id();
         }
 
 
+        boost::mutex::scoped_lock LoggingGlobals::printLock()
+        {
+            if(_logger->isThreadSafe())
+            {
+                return boost::mutex::scoped_lock(_print_mutex, boost::defer_lock);
+            }
+            return boost::mutex::scoped_lock(_print_mutex);
+        }
+
         sm::logging::levels::Level LoggingGlobals::getLevel()
         {
-            // \todo is this thread safe?
-            return _level;
+            return _level.load(std::memory_order_relaxed);
         }
 
         void LoggingGlobals::setLevel( sm::logging::levels::Level level )
         {
-            // \todo is this thread safe?
-            if(level != _level)
+            boost::mutex::scoped_lock lock(_locations_mutex);
+            if(level != _level.load(std::memory_order_relaxed))
             {
-                _level = level;
-                notifyLoggerLevelsChanged();
+                _level.store(level, std::memory_order_relaxed);
+                notifyLoggerLevelsChangedNoLock();
             }
         }
 
@@ -275,6 +420,23 @@ namespace sm {
             return g_logging_globals.getLogger();
         }
         
+        std::string namedStreamName(const char * prefix, const char * name)
+        {
+            const size_t prefixSize = strlen(prefix);
+            const size_t nameSize = strlen(name);
+            std::string streamName;
+            streamName.reserve(prefixSize + 1 + nameSize);
+            streamName.append(prefix, prefixSize);
+            streamName += '.';
+            streamName.append(name, nameSize);
+            return streamName;
+        }
+
+        std::string namedStreamName(const char * prefix, const std::string & name)
+        {
+            return namedStreamName(prefix, name.c_str());
+        }
+
         std::string addDefaultPrefixIfMissing(const std::string & name) {
             if(name.substr(0, 3) == SMCONSOLE_DEFAULT_NAME ".") { // starts with "sm."
               return name;
@@ -296,6 +458,14 @@ namespace sm {
         {
             g_logging_globals.disableNamedStream(addDefaultPrefixIfMissing(name));
         }
+        void setNamedStreamLevel( const std::string & name, Level level )
+        {
+            g_logging_globals.setNamedStreamLevel(addDefaultPrefixIfMissing(name), level);
+        }
+        void clearNamedStreamLevel( const std::string & name )
+        {
+            g_logging_globals.clearNamedStreamLevel(addDefaultPrefixIfMissing(name));
+        }
 
         
     } // namespace logging
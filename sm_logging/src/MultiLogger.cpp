@@ -0,0 +1,77 @@
+#include <sm/logging/MultiLogger.hpp>
+#include <sm/logging/LoggingEvent.hpp>
+
+namespace sm {
+    namespace logging {
+
+        MultiLogger::MultiLogger(){}
+        MultiLogger::~MultiLogger(){}
+
+        void MultiLogger::addLogger(const boost::shared_ptr<Logger> & logger, Level level)
+        {
+            boost::mutex::scoped_lock lock(_mutex);
+            Sink sink = { logger, level };
+            _sinks.push_back(sink);
+        }
+
+        void MultiLogger::setLevel(const boost::shared_ptr<Logger> & logger, Level level)
+        {
+            boost::mutex::scoped_lock lock(_mutex);
+            for(size_t i = 0; i < _sinks.size(); ++i)
+            {
+                if(_sinks[i].logger == logger)
+                {
+                    _sinks[i].level = level;
+                }
+            }
+        }
+
+        void MultiLogger::removeLogger(const boost::shared_ptr<Logger> & logger)
+        {
+            boost::mutex::scoped_lock lock(_mutex);
+            for(std::vector<Sink>::iterator it = _sinks.begin(); it != _sinks.end(); )
+            {
+                if(it->logger == logger)
+                {
+                    it = _sinks.erase(it);
+                }
+                else
+                {
+                    ++it;
+                }
+            }
+        }
+
+        size_t MultiLogger::numLoggers() const
+        {
+            boost::mutex::scoped_lock lock(_mutex);
+            return _sinks.size();
+        }
+
+        void MultiLogger::logImplementation(const LoggingEvent & event)
+        {
+            boost::mutex::scoped_lock lock(_mutex);
+            for(size_t i = 0; i < _sinks.size(); ++i)
+            {
+                if(event.level >= _sinks[i].level)
+                {
+                    _sinks[i].logger->log(event);
+                }
+            }
+        }
+
+        void MultiLogger::logDeferredImplementation(const DeferredLoggingEvent & event)
+        {
+            // Each logger decides whether to format the event.
+            boost::mutex::scoped_lock lock(_mutex);
+            for(size_t i = 0; i < _sinks.size(); ++i)
+            {
+                if(event.level >= _sinks[i].level)
+                {
+                    _sinks[i].logger->logDeferred(event);
+                }
+            }
+        }
+
+    } // namespace logging
+} // namespace sm
@@ -0,0 +1,48 @@
+#include <sm/logging/SyslogLogger.hpp>
+#include <sm/logging/LoggingEvent.hpp>
+#include <syslog.h>
+
+namespace sm {
+    namespace logging {
+
+        SyslogLogger::SyslogLogger(const std::string & ident, int facility) : _ident(ident)
+        {
+            formatter.doColor_ = false;
+            formatter.init("[${streamname}] ${message}");
+            openlog(_ident.c_str(), LOG_PID, facility < 0 ? LOG_USER : facility);
+        }
+
+        SyslogLogger::~SyslogLogger()
+        {
+            closelog();
+        }
+
+        int SyslogLogger::priority(Level level)
+        {
+            switch(level)
+            {
+            case levels::Fatal:
+                return LOG_CRIT;
+            case levels::Error:
+                return LOG_ERR;
+            case levels::Warn:
+                return LOG_WARNING;
+            case levels::Info:
+                return LOG_INFO;
+            default:
+                return LOG_DEBUG;
+            }
+        }
+
+        void SyslogLogger::logImplementation(const LoggingEvent & event)
+        {
+            boost::mutex::scoped_lock lock(_mutex);
+            _line.clear();
+            formatter.format(event, _line);
+            // without the newline of the formatter
+            _line.resize(_line.size() - 1);
+            syslog(priority(event.level), "%s", _line.c_str());
+        }
+
+    } // namespace logging
+} // namespace sm
@@ -1,9 +1,30 @@
 #include <sm/logging/Tokens.hpp>
+#include <cstring>
 
 namespace sm {
     namespace logging {
-        
-        
+
+        TokenType tokenTypeFromName(const char * name, size_t size)
+        {
+            static const struct { const char * name; TokenType type; } kTokens[] = {
+                { "severity", SeverityToken },
+                { "message", MessageToken },
+                { "time", TimeToken },
+                { "thread", ThreadToken },
+                { "file", FileToken },
+                { "line", LineToken },
+                { "function", FunctionToken },
+                { "streamname", StreamNameToken }
+            };
+            for(size_t i = 0; i < sizeof(kTokens) / sizeof(kTokens[0]); ++i)
+            {
+                if(strlen(kTokens[i].name) == size && strncmp(kTokens[i].name, name, size) == 0)
+                {
+                    return kTokens[i].type;
+                }
+            }
+            return FixedToken;
+        }
 
     } // namespace logging
 } // namespace sm
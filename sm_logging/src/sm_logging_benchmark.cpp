@@ -0,0 +1,206 @@
+// Measures the cost of log statements and the throughput of the sinks.
+//
+//   sm_logging_benchmark [iterations] [directory of the log files]
+//
+// Every case prints the time per statement or event and the resulting
+// messages per second. The statements log into a sink that drops the
+// events, so they measure the front end: the level check, formatting and
+// locking. The sinks are measured on their own with a prepared event.
+// The SyslogLogger is left out, it would flood the system log.
+#include <sm/logging.hpp>
+#include <sm/logging/Formatter.hpp>
+#include <sm/logging/LoggingEvent.hpp>
+#include <sm/logging/StdOutLogger.hpp>
+#include <sm/logging/FileLogger.hpp>
+#include <sm/logging/BinaryLogger.hpp>
+#include <sm/logging/JsonLinesLogger.hpp>
+#include <sm/logging/AsyncLogger.hpp>
+#include <sm/logging/MultiLogger.hpp>
+#include <boost/thread.hpp>
+#include <boost/thread/barrier.hpp>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <iostream>
+#include <ostream>
+#include <streambuf>
+#include <string>
+#include <unistd.h>
+
+namespace {
+
+    // Discards everything written to it.
+    class NullBuffer : public std::streambuf
+    {
+    protected:
+        std::streamsize xsputn(const char *, std::streamsize n) override { return n; }
+        int overflow(int c) override { return c; }
+    };
+
+    // Drops the events, deferred ones without formatting them.
+    class NullLogger : public sm::logging::Logger
+    {
+    protected:
+        void logImplementation(const sm::logging::LoggingEvent &) override {}
+        void logDeferredImplementation(const sm::logging::DeferredLoggingEvent &) override {}
+    };
+
+    void report(const char * name, size_t iterations, double seconds)
+    {
+        printf("%-44s %10.1f ns/op %12.0f msgs/s\n", name, seconds * 1e9 / iterations, iterations / seconds);
+    }
+
+    // finish() is part of the measurement, for sinks that buffer.
+    template<typename F, typename Finish>
+    void run(const char * name, size_t iterations, F f, Finish finish)
+    {
+        // warm up
+        for(size_t i = 0; i < iterations / 10; ++i)
+        {
+            f();
+        }
+        finish();
+        const std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+        for(size_t i = 0; i < iterations; ++i)
+        {
+            f();
+        }
+        finish();
+        report(name, iterations, std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count());
+    }
+
+    template<typename F>
+    void run(const char * name, size_t iterations, F f)
+    {
+        run(name, iterations, f, []() {});
+    }
+
+    // Splits the iterations over the threads, which start together.
+    template<typename F, typename Finish>
+    void runThreads(const char * name, size_t iterations, int numThreads, F f, Finish finish)
+    {
+        const size_t perThread = iterations / numThreads;
+        boost::barrier barrier(numThreads + 1);
+        boost::thread_group threads;
+        for(int t = 0; t < numThreads; ++t)
+        {
+            threads.create_thread([&]() {
+                barrier.wait();
+                for(size_t i = 0; i < perThread; ++i)
+                {
+                    f();
+                }
+            });
+        }
+        barrier.wait();
+        const std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+        threads.join_all();
+        finish();
+        const double seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+
+        char label[128];
+        snprintf(label, sizeof(label), "%s, %d threads", name, numThreads);
+        report(label, perThread * numThreads, seconds);
+    }
+
+} // namespace
+
+int main(int argc, char ** argv)
+{
+    const size_t iterations = argc > 1 ? strtoul(argv[1], NULL, 10) : 1000000;
+    const std::string directory = argc > 2 ? argv[2] : "/tmp";
+    const std::string logPath = directory + "/sm_logging_benchmark.log";
+    const std::string binaryPath = directory + "/sm_logging_benchmark.smlog";
+
+    const boost::shared_ptr<sm::logging::Logger> previous = sm::logging::getLogger();
+    const boost::shared_ptr<sm::logging::Logger> null(new NullLogger());
+    sm::logging::setLogger(null);
+    sm::logging::setLevel(sm::logging::levels::Info);
+    sm::logging::enableNamedStream("estimator");
+
+    printf("-- statements\n");
+    run("disabled", iterations, [&]() { SM_DEBUG("disabled %d", 1); });
+    run("disabled, stream", iterations, [&]() { SM_DEBUG_STREAM("disabled " << 1); });
+    run("disabled, named", iterations, [&]() { SM_DEBUG_NAMED("estimator", "disabled %d", 1); });
+    run("printf", iterations, [&]() { SM_INFO("The estimator converged after %d iterations, cost %f", 12, 0.5); });
+    run("stream", iterations, [&]() { SM_INFO_STREAM("The estimator converged after " << 12 << " iterations, cost " << 0.5); });
+    run("printf, named", iterations, [&]() { SM_INFO_NAMED("estimator", "The estimator converged after %d iterations, cost %f", 12, 0.5); });
+    run("stream, named", iterations, [&]() { SM_INFO_STREAM_NAMED("estimator", "The estimator converged after " << 12 << " iterations, cost " << 0.5); });
+    run("deferred", iterations, [&]() { SM_INFO_DEFERRED("The estimator converged after %d iterations, cost %f", 12, 0.5); });
+    run("key-value", iterations, [&]() { SM_INFO_KV("converged", "iterations", 12, "cost", 0.5); });
+    // enabled, but almost all hits are dropped by the rate
+    run("throttled", iterations, [&]() { SM_INFO_THROTTLE(1000.0, "throttled %d", 1); });
+
+    printf("-- formatter\n");
+    const sm::logging::LogField fields[] = { sm::logging::makeLogField("iterations", 12), sm::logging::makeLogField("cost", 0.5) };
+    const sm::logging::LoggingEvent event("sm", sm::logging::levels::Info, __FILE__, __LINE__, "main",
+                                          "The estimator converged after 12 iterations iterations=12 cost=0.5",
+                                          sm::logging::Logger::Time(std::chrono::microseconds(1466426112123456ll)), fields, 2);
+    NullBuffer nullBuffer;
+    std::ostream nullStream(&nullBuffer);
+    std::string out;
+
+    sm::logging::Formatter formatter;
+    formatter.doColor_ = false;
+    formatter.init("[${severity}] [${time}]: ${message}");
+    run("format, default format", iterations, [&]() { out.clear(); formatter.format(event, out); });
+    formatter.doColor_ = true;
+    formatter.init("[${severity}] [${time}] [${thread}] ${file}:${line} ${function} ${streamname} ${host}: ${message}");
+    formatter.setFixedToken("host", "localhost");
+    run("format, all tokens and color", iterations, [&]() { out.clear(); formatter.format(event, out); });
+    run("format, JSON", iterations, [&]() { out.clear(); sm::logging::JsonLinesLogger::format(event, out); });
+
+    printf("-- sinks\n");
+    {
+        std::streambuf * cout = std::cout.rdbuf(&nullBuffer);
+        sm::logging::StdOutLogger logger;
+        run("StdOutLogger", iterations, [&]() { logger.log(event); });
+        std::cout.rdbuf(cout);
+    }
+    sm::logging::FileLogger::Options options;
+    {
+        sm::logging::FileLogger logger(logPath, options);
+        run("FileLogger", iterations, [&]() { logger.log(event); }, [&]() { logger.flush(); });
+    }
+    options.syncPolicy = sm::logging::FileLogger::Direct;
+    {
+        sm::logging::FileLogger logger(logPath, options);
+        run(logger.isDirect() ? "FileLogger, O_DIRECT" : "FileLogger, O_DIRECT unsupported", iterations,
+            [&]() { logger.log(event); }, [&]() { logger.flush(); });
+    }
+    unlink(logPath.c_str());
+    {
+        sm::logging::BinaryLogger logger(binaryPath);
+        run("BinaryLogger", iterations, [&]() { logger.log(event); }, [&]() { logger.flush(); });
+    }
+    unlink(binaryPath.c_str());
+    {
+        sm::logging::JsonLinesLogger logger(nullStream);
+        run("JsonLinesLogger", iterations, [&]() { logger.log(event); });
+    }
+    {
+        sm::logging::MultiLogger logger;
+        logger.addLogger(null);
+        logger.addLogger(null, sm::logging::levels::Warn);
+        run("MultiLogger, 2 sinks", iterations, [&]() { logger.log(event); });
+    }
+    {
+        sm::logging::AsyncLogger logger(null);
+        run("AsyncLogger", iterations, [&]() { logger.log(event); }, [&]() { logger.flush(); });
+    }
+
+    printf("-- contention\n");
+    const boost::shared_ptr<sm::logging::AsyncLogger> async(new sm::logging::AsyncLogger(null));
+    for(int numThreads = 1; numThreads <= 32; numThreads *= 2)
+    {
+        sm::logging::setLogger(null);
+        runThreads("printf", iterations, numThreads,
+                   [&]() { SM_INFO("The estimator converged after %d iterations, cost %f", 12, 0.5); }, []() {});
+        sm::logging::setLogger(async);
+        runThreads("printf, AsyncLogger", iterations, numThreads,
+                   [&]() { SM_INFO("The estimator converged after %d iterations, cost %f", 12, 0.5); }, [&]() { async->flush(); });
+    }
+
+    sm::logging::setLogger(previous);
+    return 0;
+}
@@ -0,0 +1,38 @@
+#include <sm/logging/BinaryLogger.hpp>
+#include <sm/logging/StdOutLogger.hpp>
+#include <iostream>
+#include <exception>
+
+// Prints the events of binary logs written by sm::logging::BinaryLogger.
+// The output uses the format in the SMCONSOLE_FORMAT environment variable,
+// like the StdOutLogger.
+int main(int argc, char ** argv)
+{
+  if(argc < 2)
+  {
+    std::cout << "Usage: " << argv[0] << " [--no-color] <binary log>...\n";
+    return 1;
+  }
+
+  sm::logging::StdOutLogger logger;
+  int status = 0;
+  for(int i = 1; i < argc; ++i)
+  {
+    const std::string arg = argv[i];
+    if(arg == "--no-color")
+    {
+      logger.formatter.doColor_ = false;
+      continue;
+    }
+    try
+    {
+      sm::logging::decodeBinaryLog(arg, logger);
+    }
+    catch(const std::exception & e)
+    {
+      std::cerr << e.what() << std::endl;
+      status = 1;
+    }
+  }
+  return status;
+}
@@ -2,7 +2,14 @@
 #include <gtest/gtest.h>
 #include <sm/logging.hpp>
 #include <sm/logging/StdOutLogger.hpp>
+#include <sm/logging/AsyncLogger.hpp>
+#include <sm/logging/BinaryLogger.hpp>
+#include <sm/logging/FileLogger.hpp>
+#include <sm/logging/MultiLogger.hpp>
+#include <sm/logging/JsonLinesLogger.hpp>
 #include <boost/date_time/posix_time/posix_time.hpp>
+#include <atomic>
+#include <limits>
 
 /// \brief Helper logger to catch console output
 class TestLogger : public sm::logging::StdOutLogger {
@@ -186,3 +193,509 @@ TEST(LoggingTestSuite, testLevel) {
     EXPECT_EQ(sm::logging::Level::Info, level);
   }
 }
+
+/// \brief Helper logger that records the messages and can hold up the caller
+class RecordingLogger : public sm::logging::Logger {
+ public:
+  RecordingLogger() : _blocked(false) { }
+  ~RecordingLogger() override { }
+  std::vector<std::string> messages() { boost::mutex::scoped_lock lock(_mutex); return _messages; }
+  void block() { boost::mutex::scoped_lock lock(_mutex); _blocked = true; }
+  void unblock() { boost::mutex::scoped_lock lock(_mutex); _blocked = false; _unblocked.notify_all(); }
+ protected:
+  void logImplementation(const sm::logging::LoggingEvent & event) override {
+    boost::mutex::scoped_lock lock(_mutex);
+    while (_blocked) {
+      _unblocked.wait(lock);
+    }
+    _messages.push_back(event.message);
+  }
+ private:
+  boost::mutex _mutex;
+  boost::condition_variable _unblocked;
+  bool _blocked;
+  std::vector<std::string> _messages;
+};
+
+namespace {
+int g_streamNameEvaluations = 0;
+std::string countedStreamName() {
+  ++g_streamNameEvaluations;
+  return "counted";
+}
+}
+
+TEST(LoggingTestSuite, testNamedStreamName) {
+  EXPECT_EQ("sm.test", sm::logging::namedStreamName("sm", "test"));
+  EXPECT_EQ("sm.test", sm::logging::namedStreamName("sm", std::string("test")));
+
+  // The name of a statement is only built the first time it is hit.
+  const sm::logging::Level level = sm::logging::getLevel();
+  sm::logging::setLevel(sm::logging::Level::Info);
+  for (int i = 0; i < 3; ++i) {
+    SM_DEBUG_NAMED(countedStreamName(), "disabled %d", i);
+  }
+  EXPECT_EQ(1, g_streamNameEvaluations);
+  sm::logging::setLevel(level);
+}
+
+TEST(LoggingTestSuite, testNamedStreamLevels) {
+  const sm::logging::Level level = sm::logging::getLevel();
+  const boost::shared_ptr<sm::logging::Logger> previous = sm::logging::getLogger();
+  boost::shared_ptr<TestLogger> logger(new TestLogger());
+  sm::logging::setLogger(logger);
+  sm::logging::setLevel(sm::logging::Level::Info);
+
+  // A hierarchy enables the streams below it at its level.
+  EXPECT_FALSE(sm::logging::isNamedStreamEnabled("estimator.solver"));
+  sm::logging::setNamedStreamLevel("estimator.*", sm::logging::Level::Debug);
+  EXPECT_TRUE(sm::logging::isNamedStreamEnabled("estimator.solver"));
+  EXPECT_TRUE(sm::logging::isNamedStreamEnabled("sm.estimator.solver.inner"));
+  EXPECT_FALSE(sm::logging::isNamedStreamEnabled("estimator"));
+  SM_DEBUG_NAMED("estimator.solver", "debug");
+  EXPECT_NE("", logger->string());
+  SM_FINE_NAMED("estimator.solver", "fine");
+  EXPECT_EQ("", logger->string());
+
+  // The longest hierarchy and the stream's own level win.
+  sm::logging::setNamedStreamLevel("estimator.solver.*", sm::logging::Level::Error);
+  sm::logging::setNamedStreamLevel("estimator.solver.inner", sm::logging::Level::All);
+  SM_INFO_NAMED("estimator.solver.outer", "info");
+  EXPECT_EQ("", logger->string());
+  SM_FINE_NAMED("estimator.solver.inner", "fine");
+  EXPECT_NE("", logger->string());
+  SM_DEBUG_NAMED("estimator.solver", "debug");
+  EXPECT_NE("", logger->string());
+
+  // levels::Count turns a stream off, clearing the level falls back to the hierarchy.
+  sm::logging::setNamedStreamLevel("estimator.solver.inner", sm::logging::levels::Count);
+  EXPECT_FALSE(sm::logging::isNamedStreamEnabled("estimator.solver.inner"));
+  EXPECT_TRUE(sm::logging::isNamedStreamEnabled("estimator.solver.outer"));
+  SM_FATAL_NAMED("estimator.solver.inner", "fatal");
+  EXPECT_EQ("", logger->string());
+  sm::logging::clearNamedStreamLevel("estimator.solver.inner");
+  EXPECT_TRUE(sm::logging::isNamedStreamEnabled("estimator.solver.inner"));
+  SM_ERROR_NAMED("estimator.solver.inner", "error");
+  EXPECT_NE("", logger->string());
+
+  // The same holds for a hierarchy.
+  sm::logging::setNamedStreamLevel("estimator.solver.*", sm::logging::levels::Count);
+  EXPECT_FALSE(sm::logging::isNamedStreamEnabled("estimator.solver.outer"));
+  EXPECT_TRUE(sm::logging::isNamedStreamEnabled("estimator.solver"));
+  SM_FATAL_NAMED("estimator.solver.outer", "fatal");
+  EXPECT_EQ("", logger->string());
+
+  sm::logging::clearNamedStreamLevel("estimator.*");
+  sm::logging::clearNamedStreamLevel("estimator.solver.*");
+  SM_DEBUG_NAMED("estimator.solver", "debug");
+  EXPECT_EQ("", logger->string());
+
+  // Statements see level changes made by other threads.
+  boost::thread thread([]() { sm::logging::setLevel(sm::logging::Level::Debug); });
+  thread.join();
+  SM_DEBUG("debug");
+  EXPECT_NE("", logger->string());
+
+  sm::logging::setLogger(previous);
+  sm::logging::setLevel(level);
+}
+
+/// \brief Helper logger that logs while logging
+class RecursiveLogger : public RecordingLogger {
+ protected:
+  void logImplementation(const sm::logging::LoggingEvent & event) override {
+    RecordingLogger::logImplementation(event);
+    SM_INFO("recursive %d", 1);
+  }
+};
+
+TEST(LoggingTestSuite, testPrintBuffers) {
+  const sm::logging::Level level = sm::logging::getLevel();
+  const boost::shared_ptr<sm::logging::Logger> previous = sm::logging::getLogger();
+  sm::logging::setLevel(sm::logging::Level::Info);
+  boost::shared_ptr<RecordingLogger> logger(new RecursiveLogger());
+  sm::logging::setLogger(logger);
+
+  // Short and long messages from several threads, the recursive ones are thrown out.
+  const std::string longText(100000, 'x');
+  std::vector<boost::shared_ptr<boost::thread> > threads;
+  for (int t = 0; t < 4; ++t) {
+    threads.push_back(boost::shared_ptr<boost::thread>(new boost::thread([&longText, t]() {
+      for (int i = 0; i < 100; ++i) {
+        SM_INFO("%d %s", t, i % 10 == 0 ? longText.c_str() : "short");
+      }
+    })));
+  }
+  for (size_t t = 0; t < threads.size(); ++t) {
+    threads[t]->join();
+  }
+  const std::vector<std::string> messages = logger->messages();
+  ASSERT_EQ(400u, messages.size());
+  size_t longMessages = 0;
+  for (size_t i = 0; i < messages.size(); ++i) {
+    const std::string suffix = messages[i].substr(2);
+    EXPECT_TRUE(suffix == "short" || suffix == longText);
+    longMessages += suffix == longText;
+  }
+  EXPECT_EQ(40u, longMessages);
+
+  sm::logging::setLogger(previous);
+  sm::logging::setLevel(level);
+}
+
+TEST(LoggingTestSuite, testFormatter) {
+  sm::logging::Formatter formatter;
+  formatter.doColor_ = false;
+  const sm::logging::LoggingEvent event("sm.test", sm::logging::levels::Warn, "file.cpp", -42, "function", "message",
+                                        sm::logging::Logger::Time(std::chrono::milliseconds(1500)));
+
+  std::string out;
+  formatter.init("${severity}|${time}|${file}:${line}|${function}|${streamname}|${message}");
+  formatter.format(event, out);
+  EXPECT_EQ(" WARN|1.500000|file.cpp:-42|function|sm.test|message\n", out);
+
+  // Unknown tokens and incomplete ones are kept as they are until they get a value.
+  out.clear();
+  formatter.init("${host} ${} ${line ${message}$");
+  formatter.format(event, out);
+  EXPECT_EQ("${host} ${} ${line message$\n", out);
+  out.clear();
+  formatter.setFixedToken("host", "localhost");
+  formatter.format(event, out);
+  EXPECT_EQ("localhost ${} ${line message$\n", out);
+
+  out.clear();
+  formatter.doColor_ = true;
+  formatter.init("${severity}");
+  formatter.format(sm::logging::LoggingEvent("", static_cast<sm::logging::Level>(42), "", 0, "", "", sm::logging::Logger::Time()), out);
+  EXPECT_EQ(COLOR_NORMAL "UNKNO" COLOR_NORMAL "\n", out);
+
+  std::ostringstream os;
+  formatter.doColor_ = false;
+  formatter.print(event, os);
+  EXPECT_EQ(" WARN\n", os.str());
+}
+
+TEST(LoggingTestSuite, testTimeString) {
+  typedef sm::logging::Logger::Time Time;
+  EXPECT_EQ("0.000000", sm::logging::Logger::timeString(Time()));
+  EXPECT_EQ("1466426112.000042", sm::logging::Logger::timeString(Time(std::chrono::microseconds(1466426112000042ll))));
+  // the cached seconds must not leak into the next second
+  EXPECT_EQ("1466426112.999999", sm::logging::Logger::timeString(Time(std::chrono::microseconds(1466426112999999ll))));
+  EXPECT_EQ("1466426113.000000", sm::logging::Logger::timeString(Time(std::chrono::microseconds(1466426113000000ll))));
+  EXPECT_EQ("-1.500000", sm::logging::Logger::timeString(Time(std::chrono::milliseconds(-1500))));
+
+  std::string out = "t=";
+  sm::logging::Logger::appendTimeString(Time(std::chrono::milliseconds(2250)), out);
+  EXPECT_EQ("t=2.250000", out);
+}
+
+namespace {
+std::string readFile(const std::string & path) {
+  std::ifstream file(path.c_str());
+  std::stringstream ss;
+  ss << file.rdbuf();
+  return ss.str();
+}
+}
+
+TEST(LoggingTestSuite, testFileLogger) {
+  try {
+    const std::string path = "/tmp/testFileLogger.log";
+    const sm::logging::LoggingEvent info("sm", sm::logging::levels::Info, "", 0, "", "0123456789", sm::logging::Logger::Time(std::chrono::seconds(1)));
+    const sm::logging::LoggingEvent error("sm", sm::logging::levels::Error, "", 0, "", "error", sm::logging::Logger::Time(std::chrono::seconds(1)));
+    const std::string infoLine = "[ INFO] [1.000000]: 0123456789\n";
+    const std::string threeLines = infoLine + infoLine + infoLine;
+
+    for (int direct = 0; direct < 2; ++direct) {
+      sm::logging::FileLogger::Options options;
+      options.maxFileSize = 3 * infoLine.size();
+      options.maxBackups = 2;
+      options.flushInterval = sm::logging::Logger::Duration::zero();
+      options.syncPolicy = direct ? sm::logging::FileLogger::Direct : sm::logging::FileLogger::NoSync;
+      {
+        sm::logging::FileLogger logger(path, options);
+        logger.log(info);
+        EXPECT_EQ("", readFile(path)); // buffered
+        logger.log(error);
+        EXPECT_EQ(infoLine + "[ERROR] [1.000000]: error\n", readFile(path)); // errors are written right away
+        logger.log(info);
+        logger.flush();
+        EXPECT_EQ(3 * infoLine.size() - 5, readFile(path).size());
+
+        // Rotate by size, keeping two backups.
+        for (int i = 0; i < 9; ++i) {
+          logger.log(info);
+        }
+      }
+      EXPECT_EQ(threeLines, readFile(path));
+      EXPECT_EQ(threeLines, readFile(path + ".1"));
+      EXPECT_EQ(threeLines, readFile(path + ".2"));
+      EXPECT_EQ("", readFile(path + ".3"));
+
+      // Appending continues the file.
+      options.append = true;
+      options.maxFileSize = 0;
+      {
+        sm::logging::FileLogger logger(path, options);
+        logger.log(info);
+      }
+      EXPECT_EQ(threeLines + infoLine, readFile(path));
+
+      unlink(path.c_str());
+      unlink((path + ".1").c_str());
+      unlink((path + ".2").c_str());
+    }
+  }
+  catch( const std::exception & e )
+  {
+    FAIL() << e.what();
+  }
+}
+
+TEST(LoggingTestSuite, testMultiLogger) {
+  boost::shared_ptr<RecordingLogger> all(new RecordingLogger());
+  boost::shared_ptr<RecordingLogger> warnings(new RecordingLogger());
+  sm::logging::MultiLogger logger;
+  logger.addLogger(all);
+  logger.addLogger(warnings, sm::logging::levels::Warn);
+  EXPECT_EQ(2u, logger.numLoggers());
+
+  logger.log(sm::logging::LoggingEvent("sm", sm::logging::levels::Info, "", 0, "", "info", sm::logging::Logger::Time()));
+  logger.log(sm::logging::LoggingEvent("sm", sm::logging::levels::Error, "", 0, "", "error", sm::logging::Logger::Time()));
+  EXPECT_EQ(2u, all->messages().size());
+  ASSERT_EQ(1u, warnings->messages().size());
+  EXPECT_EQ("error", warnings->messages()[0]);
+
+  logger.setLevel(warnings, sm::logging::levels::Info);
+  logger.removeLogger(all);
+  logger.log(sm::logging::LoggingEvent("sm", sm::logging::levels::Info, "", 0, "", "info", sm::logging::Logger::Time()));
+  EXPECT_EQ(2u, all->messages().size());
+  EXPECT_EQ(2u, warnings->messages().size());
+}
+
+TEST(LoggingTestSuite, testAsyncLogger) {
+  try {
+    const sm::logging::Level level = sm::logging::getLevel();
+    const boost::shared_ptr<sm::logging::Logger> previous = sm::logging::getLogger();
+    sm::logging::setLevel(sm::logging::Level::Info);
+
+    // All events arrive in order, also when the producers have to wait for room.
+    boost::shared_ptr<RecordingLogger> sink(new RecordingLogger());
+    boost::shared_ptr<sm::logging::AsyncLogger> async(new sm::logging::AsyncLogger(sink, 16));
+    EXPECT_EQ(16u, async->capacity());
+    sm::logging::setLogger(async);
+    const int numThreads = 4, numMessages = 500;
+    boost::thread_group threads;
+    for (int t = 0; t < numThreads; ++t) {
+      threads.create_thread([t, numMessages]() {
+        for (int i = 0; i < numMessages; ++i) {
+          SM_INFO("%d %d", t, i);
+        }
+      });
+    }
+    threads.join_all();
+    async->flush();
+    std::vector<std::string> messages = sink->messages();
+    ASSERT_EQ(size_t(numThreads * numMessages), messages.size());
+    std::vector<int> next(numThreads, 0);
+    for (const std::string & message : messages) {
+      int t, i;
+      ASSERT_EQ(2, sscanf(message.c_str(), "%d %d", &t, &i));
+      EXPECT_EQ(next[t]++, i);
+    }
+    EXPECT_EQ(0u, async->droppedEvents());
+
+    // With the drop policy a stalled sink loses events instead of blocking.
+    boost::shared_ptr<RecordingLogger> stalled(new RecordingLogger());
+    stalled->block();
+    boost::shared_ptr<sm::logging::AsyncLogger> dropping(new sm::logging::AsyncLogger(stalled, 4, sm::logging::AsyncLogger::Drop));
+    sm::logging::setLogger(dropping);
+    for (int i = 0; i < 20; ++i) {
+      SM_INFO("%d", i);
+    }
+    EXPECT_GE(dropping->droppedEvents(), 15u);
+    stalled->unblock();
+    dropping->flush();
+    EXPECT_EQ(20u, stalled->messages().size() + dropping->droppedEvents());
+    EXPECT_EQ("0", stalled->messages().front());
+
+    sm::logging::setLogger(previous);
+    sm::logging::setLevel(level);
+  }
+  catch( const std::exception & e )
+  {
+    FAIL() << e.what();
+  }
+}
+
+TEST(LoggingTestSuite, testAsyncLoggerBlockingProducers) {
+  try {
+    const sm::logging::Level level = sm::logging::getLevel();
+    const boost::shared_ptr<sm::logging::Logger> previous = sm::logging::getLogger();
+    sm::logging::setLevel(sm::logging::Level::Info);
+
+    EXPECT_FALSE(sm::logging::StdOutLogger().isThreadSafe());
+    boost::shared_ptr<RecordingLogger> sink(new RecordingLogger());
+    boost::shared_ptr<sm::logging::AsyncLogger> async(new sm::logging::AsyncLogger(sink, 4));
+    EXPECT_TRUE(async->isThreadSafe());
+    sm::logging::setLogger(async);
+
+    // The stalled sink fills the queue, so all producers wait in the logger
+    // at the same time until it drains.
+    sink->block();
+    const int numThreads = 4, numMessages = 50;
+    std::atomic<int> finished(0);
+    boost::thread_group threads;
+    for (int t = 0; t < numThreads; ++t) {
+      threads.create_thread([t, numMessages, &finished]() {
+        for (int i = 0; i < numMessages; ++i) {
+          SM_INFO("%d %d", t, i);
+        }
+        ++finished;
+      });
+    }
+    boost::this_thread::sleep(boost::posix_time::milliseconds(50));
+    EXPECT_EQ(0, finished.load());
+    EXPECT_TRUE(sink->messages().empty());
+    sink->unblock();
+    threads.join_all();
+    async->flush();
+
+    std::vector<std::string> messages = sink->messages();
+    ASSERT_EQ(size_t(numThreads * numMessages), messages.size());
+    std::vector<int> next(numThreads, 0);
+    for (const std::string & message : messages) {
+      int t, i;
+      ASSERT_EQ(2, sscanf(message.c_str(), "%d %d", &t, &i));
+      EXPECT_EQ(next[t]++, i);
+    }
+    EXPECT_EQ(0u, async->droppedEvents());
+
+    sm::logging::setLogger(previous);
+    sm::logging::setLevel(level);
+  }
+  catch( const std::exception & e )
+  {
+    FAIL() << e.what();
+  }
+}
+
+TEST(LoggingTestSuite, testDeferredFormat) {
+  std::vector<char> args;
+  std::string out;
+  char expected[256];
+
+  sm::logging::deferred::appendArguments(args, 42, -7, 3.25, "text", 'x', 255u, static_cast<short>(-1));
+  sm::logging::deferred::format("%d|%5i|%.3f|%-6s|%c|%#x|%hu", &args[0], args.size(), out);
+  snprintf(expected, sizeof(expected), "%d|%5i|%.3f|%-6s|%c|%#x|%hu", 42, -7, 3.25, "text", 'x', 255u, static_cast<unsigned short>(-1));
+  EXPECT_EQ(expected, out);
+
+  args.clear();
+  out.clear();
+  std::string temporary("gone");
+  sm::logging::deferred::appendArguments(args, 8, 3, 1.0 / 3.0, temporary.c_str(), -1, 1ll << 40);
+  temporary = "changed";
+  sm::logging::deferred::format("%*.*f %s %x %lld 100%%", &args[0], args.size(), out);
+  snprintf(expected, sizeof(expected), "%*.*f %s %x %lld 100%%", 8, 3, 1.0 / 3.0, "gone", -1, 1ll << 40);
+  EXPECT_EQ(expected, out);
+
+  // Too few arguments are reported instead of read.
+  out.clear();
+  sm::logging::deferred::format("%d %s", &args[0], 9, out);
+  EXPECT_EQ("8 <missing>", out);
+}
+
+TEST(LoggingTestSuite, testDeferredLogging) {
+  try {
+    const sm::logging::Level level = sm::logging::getLevel();
+    const boost::shared_ptr<sm::logging::Logger> previous = sm::logging::getLogger();
+    sm::logging::setLevel(sm::logging::Level::Info);
+
+    // Loggers without support for deferred events format them right away.
+    boost::shared_ptr<TestLogger> logger(new TestLogger());
+    sm::logging::setLogger(logger);
+    SM_INFO("Deferred: %d %s %.2f", 1, "one", 1.0);
+    const std::string formatted = logger->string();
+    SM_INFO_DEFERRED("Deferred: %d %s %.2f", 1, "one", 1.0);
+    EXPECT_EQ(formatted, logger->string());
+    SM_DEBUG_DEFERRED("Disabled: %d", 1);
+    EXPECT_EQ("", logger->string());
+
+    // Through the async logger into a binary log and back.
+    const std::string path = "/tmp/testDeferredLogging.smlog";
+    {
+      boost::shared_ptr<sm::logging::BinaryLogger> binary(new sm::logging::BinaryLogger(path));
+      sm::logging::setLogger(boost::shared_ptr<sm::logging::Logger>(new sm::logging::AsyncLogger(binary)));
+      for (int i = 0; i < 3; ++i) {
+        std::string name = "name" + std::to_string(i);
+        SM_INFO_DEFERRED("Deferred %d: %s", i, name.c_str());
+      }
+      SM_WARN("Formatted: %d", 3);
+      sm::logging::setLogger(previous);
+    }
+    boost::shared_ptr<RecordingLogger> decoded(new RecordingLogger());
+    sm::logging::decodeBinaryLog(path, *decoded);
+    std::vector<std::string> messages = decoded->messages();
+    ASSERT_EQ(4u, messages.size());
+    EXPECT_EQ("Deferred 0: name0", messages[0]);
+    EXPECT_EQ("Deferred 2: name2", messages[2]);
+    EXPECT_EQ("Formatted: 3", messages[3]);
+    unlink(path.c_str());
+
+    sm::logging::setLevel(level);
+  }
+  catch( const std::exception & e )
+  {
+    FAIL() << e.what();
+  }
+}
+
+TEST(LoggingTestSuite, testKeyValueLogging) {
+  try {
+    const sm::logging::Level level = sm::logging::getLevel();
+    const boost::shared_ptr<sm::logging::Logger> previous = sm::logging::getLogger();
+    sm::logging::setLevel(sm::logging::Level::Info);
+
+    // Text sinks print the fields after the message.
+    boost::shared_ptr<TestLogger> logger(new TestLogger());
+    sm::logging::setLogger(logger);
+    const std::string name = "gauss newton";
+    SM_INFO_KV("solve", "iters", 12, "cost", 0.1, "solver", name, "converged", true, "size", size_t(3));
+    EXPECT_EQ("[ INFO] [0.000000]: solve iters=12 cost=0.1 solver=\"gauss newton\" converged=true size=3\n", logger->string());
+    SM_DEBUG_KV("disabled", "iters", 12);
+    EXPECT_EQ("", logger->string());
+
+    // The JSON sink keeps them typed, also behind the async logger.
+    std::ostringstream json;
+    boost::shared_ptr<sm::logging::AsyncLogger> async(
+        new sm::logging::AsyncLogger(boost::shared_ptr<sm::logging::Logger>(new sm::logging::JsonLinesLogger(json))));
+    sm::logging::setLogger(async);
+    {
+      std::string temporary = "a \"quoted\"\nvalue";
+      SM_WARN_KV("solve", "iters", -3, "cost", std::numeric_limits<double>::quiet_NaN(), "text", temporary);
+    }
+    async->flush();
+    const std::string line = json.str();
+    ASSERT_FALSE(line.empty());
+    EXPECT_EQ('\n', line[line.size() - 1]);
+    EXPECT_NE(std::string::npos, line.find("\"level\":\"warn\""));
+    EXPECT_NE(std::string::npos, line.find("\"message\":\"solve\","));
+    EXPECT_NE(std::string::npos, line.find("\"fields\":{\"iters\":-3,\"cost\":null,\"text\":\"a \\\"quoted\\\"\\nvalue\"}}"));
+
+    sm::logging::setLogger(previous);
+    sm::logging::setLevel(level);
+  }
+  catch( const std::exception & e )
+  {
+    FAIL() << e.what();
+  }
+
+  const sm::logging::LogField fields[] = { sm::logging::makeLogField("x", 1.5f), sm::logging::makeLogField("big", 1ull << 63) };
+  const sm::logging::LoggingEvent event("sm", sm::logging::levels::Info, "file.cpp", 7, "f", "pose x=1.5 big=9223372036854775808",
+                                        sm::logging::Logger::Time(std::chrono::milliseconds(1500)), fields, 2, 4);
+  std::string out;
+  sm::logging::JsonLinesLogger::format(event, out);
+  EXPECT_EQ("{\"time\":1.500000,\"level\":\"info\",\"stream\":\"sm\",\"file\":\"file.cpp\",\"line\":7,\"function\":\"f\","
+            "\"message\":\"pose\",\"fields\":{\"x\":1.5,\"big\":9223372036854775808}}\n", out);
+}
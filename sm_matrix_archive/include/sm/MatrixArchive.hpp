@@ -2,11 +2,15 @@
 #define SM_AMA_MATRIX_IO_HPP
 
 #include <string>
+#include <vector>
 #include <map>
 #include <set>
 #include <boost/static_assert.hpp>
 #include <boost/filesystem.hpp>
 #include <sm/assert_macros.hpp>
+#include <sm/matrix_archive/compression.hpp>
+#include <sm/matrix_archive/byte_swap.hpp>
+#include <sm/matrix_archive/FlatNameIndex.hpp>
 #include <Eigen/Core>
 
 
@@ -17,6 +21,8 @@ BOOST_STATIC_ASSERT(sizeof(std::string::value_type) == 1);
 
 namespace sm { 
 
+    class JobQueue;
+
     SM_DEFINE_EXCEPTION(MatrixArchiveException,std::runtime_error);
     
     class MatrixArchive{
@@ -25,7 +31,10 @@ namespace sm {
       typedef std::map< std::string, std::string > string_map_t;
 
       MatrixArchive();
+      MatrixArchive(MatrixArchive const & other);
       ~MatrixArchive();
+
+      MatrixArchive & operator=(MatrixArchive const & other);
     
       // clears the matrix and strings archive.
       void clear();
@@ -46,11 +55,21 @@ namespace sm {
       void load(const std::string & amaFilePath);
       void load(boost::filesystem::path const & amaFilePath);
       void load(boost::filesystem::path const & amaFilePath, std::set<std::string> const & validNames);
+      // Loads matrices, reading and decoding the blocks on numThreads threads.
+      // With 0 threads, large archives use one thread per core.
+      void load(boost::filesystem::path const & amaFilePath, std::set<std::string> const & validNames, size_t numThreads);
+      // Loads matrices, reading and decoding the blocks on a running job queue.
+      void load(boost::filesystem::path const & amaFilePath, std::set<std::string> const & validNames, JobQueue & jobQueue);
 
       // Saves matrices from a file into the archive.
       void save(const std::string & amaFilePath) const;
       void save(boost::filesystem::path const & amaFilePath) const;
       void save(boost::filesystem::path const & amaFilePath, std::set<std::string> const & validNames) const;
+      // Saves matrices, encoding and writing the blocks on numThreads threads.
+      // With 0 threads, large archives use one thread per core.
+      void save(boost::filesystem::path const & amaFilePath, std::set<std::string> const & validNames, size_t numThreads) const;
+      // Saves matrices, encoding and writing the blocks on a running job queue.
+      void save(boost::filesystem::path const & amaFilePath, std::set<std::string> const & validNames, JobQueue & jobQueue) const;
       void save(std::ostream & fout, std::set<std::string> const & validNames) const;
 
       // Appends matrices to a file.
@@ -83,6 +102,32 @@ namespace sm {
 
       const string_map_t & getStrings() const;
 
+      // sets the codec used for the matrix blocks written by save(). Blocks that
+      // would not get smaller are still written uncompressed. With byteShuffle the
+      // bytes of the doubles are transposed before compression.
+      void setCompression(matrix_archive::Codec codec, bool byteShuffle = true);
+      matrix_archive::Codec getCompression() const;
+
+      enum ByteOrder {
+        LITTLE_ENDIAN_ARCHIVE,
+        BIG_ENDIAN_ARCHIVE
+      };
+      // sets the byte order of the archives written by save(). Archives are little
+      // endian unless they contain a byte order marker, which is only written for
+      // big endian archives. load() reads both byte orders.
+      void setByteOrder(ByteOrder byteOrder);
+      ByteOrder getByteOrder() const;
+
+      // enables CRC-32C checksums of every block written by save(). Archives with
+      // checksums start with a format version block, which older readers reject.
+      // load() verifies the checksums of the blocks it reads.
+      void setChecksums(bool checksums);
+      bool getChecksums() const;
+
+      // checks the structure and the checksums of an archive without loading it.
+      // Throws a MatrixArchiveException describing the first problem found.
+      void verify(boost::filesystem::path const & amaFilePath) const;
+
       bool isSystemLittleEndian() const;
 
       size_t maxNameSize();
@@ -90,42 +135,121 @@ namespace sm {
       static const size_t s_fixedNameSize;
       static const char s_magicCharStartAMatrixBlock;
       static const char s_magicCharStartAStringBlock;
+      static const char s_magicCharStartACompressedMatrixBlock;
+      static const char s_magicCharStartAByteOrderBlock;
+      static const boost::uint32_t s_byteOrderMarker;
+      static const char s_magicCharStartAVersionBlock;
+      static const boost::uint32_t s_formatVersion;
+      static const boost::uint32_t s_formatFlagBlockChecksums;
       static const char s_magicCharEnd;
-
-
-      void writeMatrixBlock(std::ostream & fout, std::string const & name, Eigen::MatrixXd const & matrix) const;
-      void writeMatrixBlockSwapBytes(std::ostream & fout, std::string const & name, Eigen::MatrixXd const & matrix) const;
-      void writeStringBlock(std::ostream & fout, std::string const & name, std::string const & stringValue) const;
-
-      void readMatrix(std::istream & fin, Eigen::MatrixXd & matrix) const;
-      void readMatrixSwapBytes(std::istream & fin, std::string & name, Eigen::MatrixXd & matrix) const;
-      void readString(std::istream & fin, std::string & stringValue) const;
+      static const boost::uint8_t s_filterByteShuffle;
 
       enum BlockType {
         MATRIX,
-        STRING
+        STRING,
+        COMPRESSED_MATRIX,
+        BYTE_ORDER_MARKER,
+        FORMAT_VERSION
+      };
+
+      // The header of a block and the position of its data in the file.
+      struct BlockLocation {
+        BlockType type;
+        boost::uint32_t rows;
+        boost::uint32_t cols;
+        boost::uint8_t codec;
+        boost::uint8_t filter;
+        boost::uint64_t blockOffset;
+        boost::uint64_t dataOffset;
+        boost::uint64_t dataSize;
+        // the block was written with the other byte order
+        bool swapBytes;
+        // the CRC-32C stored after the end character
+        bool hasChecksum;
+        boost::uint32_t checksum;
+        // the contents of a format version block
+        boost::uint32_t formatVersion;
+        boost::uint32_t formatFlags;
       };
-      BlockType readBlock(std::istream & fin, std::string & name, Eigen::MatrixXd & matrix, std::string & stringValue) const;
+
+      // A block ready to be written: header bytes, data and the end character.
+      struct EncodedBlock {
+        std::vector<char> header;
+        const char * data;
+        size_t dataSize;
+        // owns the data of compressed or byte swapped blocks
+        std::vector<char> buffer;
+        // the end character and the optional checksum
+        std::vector<char> trailer;
+        boost::uint64_t offset;
+      };
+
+      void encodeMatrixBlock(std::string const & name, Eigen::MatrixXd const & matrix, matrix_archive::Codec codec, bool swapBytes, EncodedBlock & block) const;
+      void encodeStringBlock(std::string const & name, std::string const & stringValue, bool swapBytes, EncodedBlock & block) const;
+      void encodeByteOrderBlock(bool swapBytes, EncodedBlock & block) const;
+      void encodeVersionBlock(bool swapBytes, EncodedBlock & block) const;
+      void encodeTrailer(bool checksum, bool swapBytes, EncodedBlock & block) const;
+      void writeFileHeader(std::ostream & fout) const;
+      bool swapBytesOnSave() const;
+      void writeBlock(std::ostream & fout, EncodedBlock const & block) const;
+
+      void writeMatrixBlock(std::ostream & fout, std::string const & name, Eigen::MatrixXd const & matrix, matrix_archive::Codec codec = matrix_archive::CODEC_NONE) const;
+      void writeMatrixBlockSwapBytes(std::ostream & fout, std::string const & name, Eigen::MatrixXd const & matrix, matrix_archive::Codec codec = matrix_archive::CODEC_NONE) const;
+      void writeStringBlock(std::ostream & fout, std::string const & name, std::string const & stringValue) const;
+
+      void readBlockHeader(std::istream & fin, bool swapBytes, std::string & name, BlockLocation & block) const;
+      void readBlockData(int fd, BlockLocation const & block, Eigen::MatrixXd & matrix) const;
+      void readBlockData(int fd, BlockLocation const & block, std::string & stringValue) const;
+      void readBlockTrailer(std::istream & fin, bool checksums, std::string const & name, BlockLocation & block) const;
+      void checkBlockChecksum(int fd, BlockLocation const & block, const char * data) const;
 
       void validateName(std::string const & name, sm::source_file_pos const & sfp) const;
-      void writeName(std::ostream & fout, std::string const & name) const;
+      void appendName(std::vector<char> & buffer, std::string const & name) const;
 
       void saveMatrices(std::ostream & fout, std::set<std::string> const & validNames) const;
       void saveStrings(std::ostream & fout, std::set<std::string> const & validNames) const;
-    
+
+      void saveBlocks(boost::filesystem::path const & amaFilePath, std::set<std::string> const & validNames, JobQueue * jobQueue, size_t numThreads) const;
+      void loadBlocks(boost::filesystem::path const & amaFilePath, std::set<std::string> const & validNames, JobQueue * jobQueue, size_t numThreads);
+
+      // Where a name is stored in m_values and m_strings.
+      struct IndexEntry {
+        IndexEntry() : matrix(), string(), hasMatrix(false), hasString(false) {}
+        matrix_map_t::iterator matrix;
+        string_map_t::iterator string;
+        bool hasMatrix;
+        bool hasString;
+      };
+
+      // The map entries for a name, creating them if necessary.
+      Eigen::MatrixXd & insertMatrix(std::string const & name);
+      std::string & insertString(std::string const & name);
+      // NULL if there is no entry for the name.
+      const Eigen::MatrixXd * findMatrix(std::string const & name) const;
+      const std::string * findString(std::string const & name) const;
+      void eraseMatrix(std::string const & name);
+      void eraseString(std::string const & name);
+      void rebuildIndex();
+
+      // The maps keep the names sorted for save() and iteration,
+      // lookups by name go through the hash index.
       matrix_map_t m_values;
       string_map_t m_strings;
+      matrix_archive::FlatNameIndex<IndexEntry> m_index;
+
+      matrix_archive::Codec m_codec;
+      bool m_byteShuffle;
+      ByteOrder m_byteOrder;
+      bool m_checksums;
 
     }; // end class MatrixArchive
 
     template<typename Derived>
     void MatrixArchive::setMatrix(std::string const & matrixName, Eigen::MatrixBase<Derived> const & matrix)
     {
-      if(m_strings.count(matrixName) > 0){
-        m_strings.erase(matrixName);
-      }
       validateName(matrixName, SM_SOURCE_FILE_POS);
-      m_values[matrixName] = matrix;
+      eraseString(matrixName);
+      insertMatrix(matrixName) = matrix;
     }
   
     template<typename Derived>
@@ -133,7 +257,7 @@ namespace sm {
     {
       SM_ASSERT_EQ(MatrixArchiveException, vector.cols(),1, "The input must be a column vector");
       validateName(vectorName, SM_SOURCE_FILE_POS);
-      m_values[vectorName] = vector;
+      insertMatrix(vectorName) = vector;
     }
 
   } // end namespace sm
@@ -0,0 +1,98 @@
+/**
+ * @file   FlatNameIndex.hpp
+ *
+ * @brief  An open addressing hash table keyed by short names.
+ */
+
+#ifndef SM_MATRIX_ARCHIVE_FLAT_NAME_INDEX_HPP
+#define SM_MATRIX_ARCHIVE_FLAT_NAME_INDEX_HPP
+
+#include <cstring>
+#include <string>
+#include <vector>
+#include <stdexcept>
+#include <boost/cstdint.hpp>
+#include <sm/assert_macros.hpp>
+
+namespace sm {
+  namespace matrix_archive {
+
+    /**
+     * \class FixedName
+     *
+     * A name of at most kSize characters stored inline and padded with zeros,
+     * so that hashing and comparison work on whole words.
+     */
+    class FixedName {
+    public:
+      enum { kSize = 32 };
+
+      FixedName();
+      /// \brief the name must not be longer than kSize characters.
+      explicit FixedName(std::string const & name);
+
+      bool operator==(FixedName const & other) const;
+
+      boost::uint64_t hash() const;
+
+    private:
+      boost::uint64_t m_words[kSize / sizeof(boost::uint64_t)];
+    };
+
+    /**
+     * \class FlatNameIndex
+     *
+     * A hash table from names of up to FixedName::kSize characters to values.
+     * The keys are stored inline in a single array of slots and collisions are
+     * resolved by linear probing, so a lookup usually touches a single cache
+     * line. The iteration order is unspecified; keep an ordered container
+     * next to the index where the order matters.
+     */
+    template<typename T>
+    class FlatNameIndex {
+    public:
+      FlatNameIndex();
+
+      /// \brief the value stored for name or NULL.
+      T * find(std::string const & name);
+      const T * find(std::string const & name) const;
+
+      /// \brief the value stored for name, inserting a default constructed value if there is none.
+      T & operator[](std::string const & name);
+
+      /// \brief remove the name. Returns false if it was not in the index.
+      bool erase(std::string const & name);
+
+      void clear();
+      size_t size() const;
+      bool empty() const;
+
+    private:
+      enum SlotState {
+        EMPTY = 0,
+        FULL,
+        DELETED
+      };
+
+      struct Slot {
+        Slot() : state(EMPTY), value() {}
+        FixedName key;
+        boost::uint8_t state;
+        T value;
+      };
+
+      /// \brief the slot holding key, or the slot where it should be inserted.
+      size_t probe(FixedName const & key, boost::uint64_t hash) const;
+      void rehash(size_t capacity);
+
+      std::vector<Slot> m_slots;
+      size_t m_size;
+      size_t m_deleted;
+    };
+
+  } // namespace matrix_archive
+} // namespace sm
+
+#include "implementation/FlatNameIndex.hpp"
+
+#endif /* SM_MATRIX_ARCHIVE_FLAT_NAME_INDEX_HPP */
@@ -0,0 +1,42 @@
+/**
+ * @file   byte_swap.hpp
+ *
+ * @brief  Byte order of the host and vectorised byte swapping used to
+ *         read and write archives of the other byte order.
+ */
+
+#ifndef SM_MATRIX_ARCHIVE_BYTE_SWAP_HPP
+#define SM_MATRIX_ARCHIVE_BYTE_SWAP_HPP
+
+#include <cstddef>
+#include <boost/predef/other/endian.h>
+#include <boost/endian/conversion.hpp>
+
+namespace sm {
+  namespace matrix_archive {
+
+#if BOOST_ENDIAN_LITTLE_BYTE
+    /// \brief Is the host little endian? Known at compile time.
+    const bool kHostIsLittleEndian = true;
+#elif BOOST_ENDIAN_BIG_BYTE
+    const bool kHostIsLittleEndian = false;
+#else
+#error "sm_matrix_archive only supports little and big endian hosts"
+#endif
+
+    /// \brief Reverse the bytes of a single value.
+    template<typename T>
+    inline T swapBytes(T value)
+    {
+      return boost::endian::endian_reverse(value);
+    }
+
+    /// \brief Reverse the bytes of count 8 byte values from src into dst.
+    ///        src and dst may be the same buffer. Uses AVX2/SSSE3 on x86
+    ///        (selected at runtime) and NEON on ARM.
+    void byteSwap64(const void * src, void * dst, size_t count);
+
+  } // namespace matrix_archive
+} // namespace sm
+
+#endif /* SM_MATRIX_ARCHIVE_BYTE_SWAP_HPP */
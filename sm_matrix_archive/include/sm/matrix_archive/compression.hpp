@@ -0,0 +1,59 @@
+/**
+ * @file   compression.hpp
+ *
+ * @brief  Block codecs and filters used for compressed matrix archive blocks.
+ *
+ * The LZ4 codec is always available. If liblz4 was found at build time
+ * it is used, otherwise a vendored implementation of the LZ4 block format
+ * is used, so files written by either can be read by both. Zstandard is
+ * only available if libzstd was found at build time.
+ */
+
+#ifndef SM_MATRIX_ARCHIVE_COMPRESSION_HPP
+#define SM_MATRIX_ARCHIVE_COMPRESSION_HPP
+
+#include <cstddef>
+#include <boost/cstdint.hpp>
+
+namespace sm {
+  namespace matrix_archive {
+
+    /// \brief The codecs that can be used for a compressed block.
+    ///        The values are stored in the file and must not change.
+    enum Codec {
+      CODEC_NONE = 0,
+      CODEC_LZ4 = 1,
+      CODEC_ZSTD = 2
+    };
+
+    /// \brief Is the codec compiled into this build?
+    bool isCodecAvailable(Codec codec);
+
+    /// \brief A human readable name of the codec.
+    const char * codecName(Codec codec);
+
+    /// \brief The maximum size of the compressed output of srcSize bytes.
+    size_t compressBound(Codec codec, size_t srcSize);
+
+    /// \brief Compress srcSize bytes from src into dst.
+    ///
+    /// dst must hold at least compressBound(codec, srcSize) bytes.
+    /// @return the number of bytes written to dst.
+    size_t compress(Codec codec, const char * src, size_t srcSize, char * dst);
+
+    /// \brief Decompress srcSize bytes from src into exactly dstSize bytes at dst.
+    ///        Throws a MatrixArchiveException if the data is corrupt.
+    void decompress(Codec codec, const char * src, size_t srcSize, char * dst, size_t dstSize);
+
+    /// \brief Transpose the bytes of numElements elements of size elementSize so
+    ///        that byte k of every element is stored contiguously. Smooth data
+    ///        then produces long runs of similar bytes that compress well.
+    void byteShuffle(const char * src, size_t numElements, size_t elementSize, char * dst);
+
+    /// \brief Invert byteShuffle().
+    void byteUnshuffle(const char * src, size_t numElements, size_t elementSize, char * dst);
+
+  } // namespace matrix_archive
+} // namespace sm
+
+#endif /* SM_MATRIX_ARCHIVE_COMPRESSION_HPP */
@@ -0,0 +1,25 @@
+/**
+ * @file   crc32c.hpp
+ *
+ * @brief  CRC-32C (Castagnoli) checksums of archive blocks.
+ */
+
+#ifndef SM_MATRIX_ARCHIVE_CRC32C_HPP
+#define SM_MATRIX_ARCHIVE_CRC32C_HPP
+
+#include <cstddef>
+#include <boost/cstdint.hpp>
+
+namespace sm {
+  namespace matrix_archive {
+
+    /// \brief Extend the CRC-32C checksum crc by size bytes of data.
+    ///        Start with crc = 0. Uses the SSE4.2 crc32 instruction on x86
+    ///        (selected at runtime) and the ARMv8 CRC extension where it is
+    ///        enabled at compile time.
+    boost::uint32_t crc32c(boost::uint32_t crc, const void * data, size_t size);
+
+  } // namespace matrix_archive
+} // namespace sm
+
+#endif /* SM_MATRIX_ARCHIVE_CRC32C_HPP */
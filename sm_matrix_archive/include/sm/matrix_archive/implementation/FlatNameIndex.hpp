@@ -0,0 +1,167 @@
+namespace sm {
+  namespace matrix_archive {
+
+    inline FixedName::FixedName()
+    {
+      memset(m_words, 0, sizeof(m_words));
+    }
+
+    inline FixedName::FixedName(std::string const & name)
+    {
+      memset(m_words, 0, sizeof(m_words));
+      memcpy(m_words, name.data(), name.size() < size_t(kSize) ? name.size() : size_t(kSize));
+    }
+
+    inline bool FixedName::operator==(FixedName const & other) const
+    {
+      return ((m_words[0] ^ other.m_words[0]) | (m_words[1] ^ other.m_words[1]) |
+              (m_words[2] ^ other.m_words[2]) | (m_words[3] ^ other.m_words[3])) == 0;
+    }
+
+    inline boost::uint64_t FixedName::hash() const
+    {
+      // Multiply-xorshift mixing of the four words.
+      boost::uint64_t h = 0x9e3779b97f4a7c15ull;
+      for(size_t i = 0; i < sizeof(m_words) / sizeof(m_words[0]); ++i)
+      {
+        h = (h ^ m_words[i]) * 0xff51afd7ed558ccdull;
+        h ^= h >> 32;
+      }
+      return h;
+    }
+
+    template<typename T>
+    FlatNameIndex<T>::FlatNameIndex() : m_size(0), m_deleted(0)
+    {
+    }
+
+    template<typename T>
+    size_t FlatNameIndex<T>::probe(FixedName const & key, boost::uint64_t hash) const
+    {
+      const size_t mask = m_slots.size() - 1;
+      size_t i = hash & mask;
+      size_t firstDeleted = m_slots.size();
+      for(;;)
+      {
+        Slot const & slot = m_slots[i];
+        if(slot.state == EMPTY)
+        {
+          return firstDeleted < m_slots.size() ? firstDeleted : i;
+        }
+        if(slot.state == FULL && slot.key == key)
+        {
+          return i;
+        }
+        if(slot.state == DELETED && firstDeleted == m_slots.size())
+        {
+          firstDeleted = i;
+        }
+        i = (i + 1) & mask;
+      }
+    }
+
+    template<typename T>
+    const T * FlatNameIndex<T>::find(std::string const & name) const
+    {
+      if(m_size == 0 || name.size() > size_t(FixedName::kSize))
+      {
+        return NULL;
+      }
+      const FixedName key(name);
+      Slot const & slot = m_slots[probe(key, key.hash())];
+      return slot.state == FULL && slot.key == key ? &slot.value : NULL;
+    }
+
+    template<typename T>
+    T * FlatNameIndex<T>::find(std::string const & name)
+    {
+      return const_cast<T *>(static_cast<const FlatNameIndex<T> &>(*this).find(name));
+    }
+
+    template<typename T>
+    T & FlatNameIndex<T>::operator[](std::string const & name)
+    {
+      // A longer name would be cut off and could collide with another one.
+      SM_ASSERT_LE(std::runtime_error, name.size(), size_t(FixedName::kSize), "The name \"" << name << "\" is too long for the index");
+      // Keep at least half of the slots empty so probe sequences stay short.
+      if(2 * (m_size + m_deleted + 1) > m_slots.size())
+      {
+        // Grow if the table is getting full, otherwise only clean up deleted slots.
+        rehash(m_slots.empty() ? 16 : (4 * (m_size + 1) > m_slots.size() ? 2 * m_slots.size() : m_slots.size()));
+      }
+      const FixedName key(name);
+      Slot & slot = m_slots[probe(key, key.hash())];
+      if(slot.state != FULL)
+      {
+        if(slot.state == DELETED)
+        {
+          --m_deleted;
+        }
+        slot.key = key;
+        slot.state = FULL;
+        slot.value = T();
+        ++m_size;
+      }
+      return slot.value;
+    }
+
+    template<typename T>
+    bool FlatNameIndex<T>::erase(std::string const & name)
+    {
+      if(m_size == 0 || name.size() > size_t(FixedName::kSize))
+      {
+        return false;
+      }
+      const FixedName key(name);
+      Slot & slot = m_slots[probe(key, key.hash())];
+      if(slot.state != FULL || !(slot.key == key))
+      {
+        return false;
+      }
+      slot.state = DELETED;
+      slot.value = T();
+      --m_size;
+      ++m_deleted;
+      return true;
+    }
+
+    template<typename T>
+    void FlatNameIndex<T>::rehash(size_t capacity)
+    {
+      std::vector<Slot> old(capacity);
+      old.swap(m_slots);
+      m_deleted = 0;
+      for(size_t i = 0; i < old.size(); ++i)
+      {
+        if(old[i].state == FULL)
+        {
+          Slot & slot = m_slots[probe(old[i].key, old[i].key.hash())];
+          slot.key = old[i].key;
+          slot.state = FULL;
+          slot.value = old[i].value;
+        }
+      }
+    }
+
+    template<typename T>
+    void FlatNameIndex<T>::clear()
+    {
+      m_slots.clear();
+      m_size = 0;
+      m_deleted = 0;
+    }
+
+    template<typename T>
+    size_t FlatNameIndex<T>::size() const
+    {
+      return m_size;
+    }
+
+    template<typename T>
+    bool FlatNameIndex<T>::empty() const
+    {
+      return m_size == 0;
+    }
+
+  } // namespace matrix_archive
+} // namespace sm
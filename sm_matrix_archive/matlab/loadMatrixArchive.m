@@ -11,6 +11,9 @@ function [ ama ] = loadMatrixArchive( filename )
 
 startMagicMatrix = 'A';
 startMagicString = 'S';
+startMagicCompressedMatrix = 'C';
+startMagicByteOrder = 'E';
+startMagicVersion = 'V';
 endMagic   = 'B';
 nameFixedSize = 32;
 
@@ -26,7 +29,47 @@ try
 
     % Read the start magic character
     start = fread(fid,1,'uint8=>char');
+
+    % Big endian archives start with a byte order marker
+    if start == startMagicByteOrder
+        marker = fread(fid,1,'uint32');
+        if marker ~= hex2dec('01020304')
+            fclose(fid);
+            [fid, message] = fopen(filename,'r','ieee-be');
+            if fid < 0
+                error('unable to open file %s for reading: %s',filename, message);
+            end
+            fread(fid,5,'uint8');
+        end
+        endchar = fread(fid,1,'uint8=>char');
+        if endchar ~= endMagic
+            error('The byte order marker did not end with the expected character. Wanted %s, got %s', endMagic, endchar);
+        end
+        start = fread(fid,1,'uint8=>char');
+    end
+
+    % Archives with block checksums start with a format version block.
+    % The checksums are skipped, not verified.
+    checksumSize = 0;
+    if start == startMagicVersion
+        version = fread(fid,2,'uint32');
+        if version(1) ~= 2
+            error('Unsupported archive format version %d', version(1));
+        end
+        if bitand(version(2), 1)
+            checksumSize = 4;
+        end
+        endchar = fread(fid,1,'uint8=>char');
+        if endchar ~= endMagic
+            error('The format version block did not end with the expected character. Wanted %s, got %s', endMagic, endchar);
+        end
+        start = fread(fid,1,'uint8=>char');
+    end
+
     while ~feof(fid)
+        if start == startMagicCompressedMatrix
+            error('The archive contains compressed matrix blocks, which are not supported by this loader. Save it without compression.');
+        end
         if start ~= startMagicString && start ~= startMagicMatrix
             error('The start of a matrix block did not have the expected character. Wanted %s or %s, got %s', startMagicMatrix, startMagicString, start);
         end
@@ -57,6 +100,7 @@ try
         if endchar ~= endMagic
             error('The end of a matrix block for matrix named %s did not have the expected character. Wanted %s, got %s', name, endMagic, endchar);
         end
+        fread(fid,checksumSize,'uint8');
     
         % Set the field on the return struct
         ama.(name) = M;
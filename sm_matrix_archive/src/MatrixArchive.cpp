@@ -1,44 +1,328 @@
 #include <fstream>
 #include <cstdio>
+#include <cerrno>
+#include <cstring>
+#include <exception>
+#include <algorithm>
+#include <fcntl.h>
+#include <unistd.h>
 #include <boost/algorithm/string/trim.hpp>
+#include <boost/function.hpp>
+#include <boost/thread.hpp>
+#include <boost/atomic.hpp>
+#include <sm/boost/JobQueue.hpp>
 #include <sm/MatrixArchive.hpp>
+#include <sm/matrix_archive/crc32c.hpp>
 
 namespace sm 
 {
 
   const size_t MatrixArchive::s_fixedNameSize = 32;
+  // The hash index stores the names inline.
+  BOOST_STATIC_ASSERT(matrix_archive::FixedName::kSize == 32);
   const char MatrixArchive::s_magicCharStartAMatrixBlock = 'A';
   const char MatrixArchive::s_magicCharStartAStringBlock = 'S';
+  const char MatrixArchive::s_magicCharStartACompressedMatrixBlock = 'C';
+  const char MatrixArchive::s_magicCharStartAByteOrderBlock = 'E';
+  const boost::uint32_t MatrixArchive::s_byteOrderMarker = 0x01020304;
+  const char MatrixArchive::s_magicCharStartAVersionBlock = 'V';
+  // Archives without a version block are version 1.
+  const boost::uint32_t MatrixArchive::s_formatVersion = 2;
+  const boost::uint32_t MatrixArchive::s_formatFlagBlockChecksums = 0x1;
   const char MatrixArchive::s_magicCharEnd = 'B';
+  const boost::uint8_t MatrixArchive::s_filterByteShuffle = 0x1;
+
+  namespace {
+    // Matrices smaller than this are not worth compressing.
+    const size_t kMinCompressedDataSize = 64;
+    // Archives smaller than this are not worth spawning threads for by default.
+    const size_t kMinParallelDataSize = 1 << 20;
+    // verify() streams the block data through a buffer of this size.
+    const size_t kVerifyChunkSize = 1 << 20;
+
+    // Character classes for validating names without the locale dependent isalnum.
+    enum NameCharClass {
+      INVALID_CHAR = 0,
+      FIRST_CHAR = 1,
+      OTHER_CHAR = 2
+    };
+
+    struct NameCharTable {
+      NameCharTable()
+      {
+        memset(classes, INVALID_CHAR, sizeof(classes));
+        for(int c = 'a'; c <= 'z'; ++c)
+        {
+          classes[c] = FIRST_CHAR | OTHER_CHAR;
+          classes[c - 'a' + 'A'] = FIRST_CHAR | OTHER_CHAR;
+        }
+        for(int c = '0'; c <= '9'; ++c)
+        {
+          classes[c] = OTHER_CHAR;
+        }
+        classes[static_cast<unsigned char>('_')] = OTHER_CHAR;
+      }
+      unsigned char classes[256];
+    };
+    const NameCharTable kNameCharTable;
+
+    template<typename T>
+    void appendValue(std::vector<char> & buffer, T value, bool swapBytes)
+    {
+      if(swapBytes)
+      {
+        value = matrix_archive::swapBytes(value);
+      }
+      const char * bytes = reinterpret_cast<const char *>(&value);
+      buffer.insert(buffer.end(), bytes, bytes + sizeof(T));
+    }
+
+    void preadAll(int fd, char * data, size_t size, boost::uint64_t offset)
+    {
+      while(size > 0)
+      {
+        const ssize_t n = ::pread(fd, data, size, offset);
+        if(n < 0 && errno == EINTR)
+        {
+          continue;
+        }
+        SM_ASSERT_GT(MatrixArchiveException, n, 0, "Error while reading " << size << " bytes at offset " << offset << ": " << (n < 0 ? strerror(errno) : "unexpected end of file"));
+        data += n;
+        size -= n;
+        offset += n;
+      }
+    }
+
+    void pwriteAll(int fd, const char * data, size_t size, boost::uint64_t offset)
+    {
+      while(size > 0)
+      {
+        const ssize_t n = ::pwrite(fd, data, size, offset);
+        if(n < 0 && errno == EINTR)
+        {
+          continue;
+        }
+        SM_ASSERT_GT(MatrixArchiveException, n, 0, "Error while writing " << size << " bytes at offset " << offset << ": " << strerror(errno));
+        data += n;
+        size -= n;
+        offset += n;
+      }
+    }
+
+    // 0 threads picks one thread per core for large archives and a single thread otherwise.
+    size_t numJobThreads(size_t numThreads, size_t totalDataSize)
+    {
+      if(numThreads == 0)
+      {
+        numThreads = totalDataSize >= kMinParallelDataSize ? std::max(1u, boost::thread::hardware_concurrency()) : 1;
+      }
+      return numThreads;
+    }
+
+    // Runs the jobs on the job queue if one is given, or on numThreads threads otherwise.
+    // Blocks until all jobs are done and rethrows the first exception.
+    void runJobs(std::vector< boost::function<void()> > const & jobs, JobQueue * jobQueue, size_t numThreads)
+    {
+      std::vector<std::exception_ptr> errors(jobs.size());
+      if(jobQueue)
+      {
+        boost::mutex mutex;
+        boost::condition_variable done;
+        size_t remaining = jobs.size();
+        for(size_t i = 0; i < jobs.size(); ++i)
+        {
+          jobQueue->scheduleWork([i, &jobs, &errors, &mutex, &done, &remaining]() {
+            try
+            {
+              jobs[i]();
+            }
+            catch(...)
+            {
+              errors[i] = std::current_exception();
+            }
+            boost::mutex::scoped_lock lock(mutex);
+            if(--remaining == 0)
+            {
+              done.notify_all();
+            }
+          });
+        }
+        boost::mutex::scoped_lock lock(mutex);
+        while(remaining > 0)
+        {
+          done.wait(lock);
+        }
+      }
+      else if(numThreads <= 1 || jobs.size() <= 1)
+      {
+        for(size_t i = 0; i < jobs.size(); ++i)
+        {
+          jobs[i]();
+        }
+      }
+      else
+      {
+        boost::atomic<size_t> next(0);
+        boost::thread_group threads;
+        for(size_t t = 0; t < std::min(numThreads, jobs.size()); ++t)
+        {
+          threads.create_thread([&jobs, &errors, &next]() {
+            for(size_t i = next++; i < jobs.size(); i = next++)
+            {
+              try
+              {
+                jobs[i]();
+              }
+              catch(...)
+              {
+                errors[i] = std::current_exception();
+              }
+            }
+          });
+        }
+        threads.join_all();
+      }
 
-  MatrixArchive::MatrixArchive()
+      for(size_t i = 0; i < errors.size(); ++i)
+      {
+        if(errors[i])
+        {
+          std::rethrow_exception(errors[i]);
+        }
+      }
+    }
+  } // namespace
+
+  MatrixArchive::MatrixArchive() : m_codec(matrix_archive::CODEC_NONE), m_byteShuffle(true), m_byteOrder(LITTLE_ENDIAN_ARCHIVE), m_checksums(false)
   {
     // 0
   }
 
+  MatrixArchive::MatrixArchive(MatrixArchive const & other) :
+    m_values(other.m_values), m_strings(other.m_strings),
+    m_codec(other.m_codec), m_byteShuffle(other.m_byteShuffle), m_byteOrder(other.m_byteOrder), m_checksums(other.m_checksums)
+  {
+    rebuildIndex();
+  }
+
   MatrixArchive::~MatrixArchive()
   {
     // 0
   }
+
+  MatrixArchive & MatrixArchive::operator=(MatrixArchive const & other)
+  {
+    if(this != &other)
+    {
+      m_values = other.m_values;
+      m_strings = other.m_strings;
+      m_codec = other.m_codec;
+      m_byteShuffle = other.m_byteShuffle;
+      m_byteOrder = other.m_byteOrder;
+      m_checksums = other.m_checksums;
+      rebuildIndex();
+    }
+    return *this;
+  }
     
   // clears the matrix archive.
   void MatrixArchive::clear()
   {
     m_values.clear();
     m_strings.clear();
+    m_index.clear();
   }
 
   // clears a specific value from the archive.
   void MatrixArchive::clear(std::string const & entryName)
   {
-    m_values.erase(entryName);
-    m_values.erase(entryName);
+    eraseMatrix(entryName);
+    eraseString(entryName);
+  }
+
+  Eigen::MatrixXd & MatrixArchive::insertMatrix(std::string const & name)
+  {
+    IndexEntry & entry = m_index[name];
+    if(!entry.hasMatrix)
+    {
+      entry.matrix = m_values.insert(std::make_pair(name, Eigen::MatrixXd())).first;
+      entry.hasMatrix = true;
+    }
+    return entry.matrix->second;
+  }
+
+  std::string & MatrixArchive::insertString(std::string const & name)
+  {
+    IndexEntry & entry = m_index[name];
+    if(!entry.hasString)
+    {
+      entry.string = m_strings.insert(std::make_pair(name, std::string())).first;
+      entry.hasString = true;
+    }
+    return entry.string->second;
+  }
+
+  const Eigen::MatrixXd * MatrixArchive::findMatrix(std::string const & name) const
+  {
+    const IndexEntry * entry = m_index.find(name);
+    return entry && entry->hasMatrix ? &entry->matrix->second : NULL;
+  }
+
+  const std::string * MatrixArchive::findString(std::string const & name) const
+  {
+    const IndexEntry * entry = m_index.find(name);
+    return entry && entry->hasString ? &entry->string->second : NULL;
+  }
+
+  void MatrixArchive::eraseMatrix(std::string const & name)
+  {
+    IndexEntry * entry = m_index.find(name);
+    if(entry && entry->hasMatrix)
+    {
+      m_values.erase(entry->matrix);
+      entry->hasMatrix = false;
+      if(!entry->hasString)
+      {
+        m_index.erase(name);
+      }
+    }
+  }
+
+  void MatrixArchive::eraseString(std::string const & name)
+  {
+    IndexEntry * entry = m_index.find(name);
+    if(entry && entry->hasString)
+    {
+      m_strings.erase(entry->string);
+      entry->hasString = false;
+      if(!entry->hasMatrix)
+      {
+        m_index.erase(name);
+      }
+    }
+  }
+
+  void MatrixArchive::rebuildIndex()
+  {
+    m_index.clear();
+    for(matrix_map_t::iterator it = m_values.begin(); it != m_values.end(); ++it)
+    {
+      IndexEntry & entry = m_index[it->first];
+      entry.matrix = it;
+      entry.hasMatrix = true;
+    }
+    for(string_map_t::iterator it = m_strings.begin(); it != m_strings.end(); ++it)
+    {
+      IndexEntry & entry = m_index[it->first];
+      entry.string = it;
+      entry.hasString = true;
+    }
   }
 
   void MatrixArchive::setScalar(std::string const & scalarName, double scalar)
   {
     validateName(scalarName,SM_SOURCE_FILE_POS);
-    Eigen::MatrixXd & M = m_values[scalarName];
+    Eigen::MatrixXd & M = insertMatrix(scalarName);
     M.resize(1,1);
     M(0,0) = scalar;
   }
@@ -46,10 +330,8 @@ namespace sm
   void MatrixArchive::setString(std::string const & stringName, std::string const & value)
   {
     validateName(stringName, SM_SOURCE_FILE_POS);
-    if(m_values.count(stringName) > 0){
-      m_values.erase(stringName);
-    }
-    m_strings[stringName] = value;
+    eraseMatrix(stringName);
+    insertString(stringName) = value;
   }
 
   const MatrixArchive::string_map_t & MatrixArchive::getStrings() const
@@ -57,6 +339,43 @@ namespace sm
     return m_strings;
   }
 
+  void MatrixArchive::setCompression(matrix_archive::Codec codec, bool byteShuffle)
+  {
+    SM_ASSERT_TRUE(MatrixArchiveException, matrix_archive::isCodecAvailable(codec), "The codec " << matrix_archive::codecName(codec) << " is not available in this build");
+    m_codec = codec;
+    m_byteShuffle = byteShuffle;
+  }
+
+  matrix_archive::Codec MatrixArchive::getCompression() const
+  {
+    return m_codec;
+  }
+
+  void MatrixArchive::setByteOrder(ByteOrder byteOrder)
+  {
+    m_byteOrder = byteOrder;
+  }
+
+  MatrixArchive::ByteOrder MatrixArchive::getByteOrder() const
+  {
+    return m_byteOrder;
+  }
+
+  void MatrixArchive::setChecksums(bool checksums)
+  {
+    m_checksums = checksums;
+  }
+
+  bool MatrixArchive::getChecksums() const
+  {
+    return m_checksums;
+  }
+
+  bool MatrixArchive::swapBytesOnSave() const
+  {
+    return (m_byteOrder == LITTLE_ENDIAN_ARCHIVE) != isSystemLittleEndian();
+  }
+
 
   void MatrixArchive::getMatrix(std::string const & matrixName, Eigen::MatrixXd & outMatrix) const
   {
@@ -65,28 +384,28 @@ namespace sm
 
   Eigen::MatrixXd & MatrixArchive::createMatrix(std::string const & matrixName, int rows, int cols, bool overwriteExisting)
   {
+    validateName(matrixName, SM_SOURCE_FILE_POS);
     if(!overwriteExisting){
-      matrix_map_t::const_iterator it = m_values.find(matrixName);
-      if(it != m_values.end())
+      if(findMatrix(matrixName) != NULL)
       {
         SM_THROW(MatrixArchiveException,"There is already a matrix of name \"" << matrixName << "\" in the archive");
       }
     }
 
-    Eigen::MatrixXd & val = m_values[matrixName];
+    Eigen::MatrixXd & val = insertMatrix(matrixName);
     val.resize(rows, cols);
     return val;
   }
 
   const Eigen::MatrixXd & MatrixArchive::getMatrix(std::string const & matrixName) const
   {
-    matrix_map_t::const_iterator it = m_values.find(matrixName);
-    if(it == m_values.end())
+    const Eigen::MatrixXd * M = findMatrix(matrixName);
+    if(M == NULL)
     {
       SM_THROW(MatrixArchiveException,"There is no matrix named \"" << matrixName << "\" in the archive");
     }
 
-    return it->second;
+    return *M;
   }
   Eigen::MatrixXd & MatrixArchive::getMatrix(std::string const & matrixName)
   {
@@ -95,12 +414,12 @@ namespace sm
 
   void MatrixArchive::getVector(std::string const & vectorName, Eigen::VectorXd & outVector) const
   {
-    matrix_map_t::const_iterator it = m_values.find(vectorName);
-    if(it == m_values.end())
+    const Eigen::MatrixXd * found = findMatrix(vectorName);
+    if(found == NULL)
     {
       SM_THROW(MatrixArchiveException, "There is no vector named \"" << vectorName << "\" in the archive");
     }
-    Eigen::MatrixXd const & M = it->second;
+    Eigen::MatrixXd const & M = *found;
     SM_ASSERT_EQ(MatrixArchiveException, M.cols(), 1, "The stored value is not a vector");
 
     outVector = M.col(0);
@@ -112,13 +431,13 @@ namespace sm
   }
   double MatrixArchive::getScalar(std::string const & scalarName) const
   {
-    matrix_map_t::const_iterator it = m_values.find(scalarName);
-    if(it == m_values.end())
+    const Eigen::MatrixXd * found = findMatrix(scalarName);
+    if(found == NULL)
     {
       SM_THROW(MatrixArchiveException, "There is no scalar named \"" << scalarName << "\" in the archive");
     }
 
-    Eigen::MatrixXd const & M = it->second;
+    Eigen::MatrixXd const & M = *found;
     SM_ASSERT_EQ(MatrixArchiveException, M.rows(), 1, "The stored value is not a scalar");
     SM_ASSERT_EQ(MatrixArchiveException, M.cols(), 1, "The stored value is not a scalar");
 
@@ -134,12 +453,12 @@ namespace sm
   }
 
   std::string & MatrixArchive::getString(std::string const & stringName) {
-    string_map_t::iterator it = m_strings.find(stringName);
-    if(it == m_strings.end())
+    const std::string * value = findString(stringName);
+    if(value == NULL)
     {
       SM_THROW(MatrixArchiveException, "There is no string named \"" << stringName << "\" in the archive");
     }
-    return it->second;
+    return const_cast<std::string &>(*value);
   }
 
   void MatrixArchive::validateName(std::string const & name, sm::source_file_pos const & /* sfp */) const
@@ -149,20 +468,28 @@ namespace sm
       SM_THROW(MatrixArchiveException, "The name \"" << name << "\" is an incorrect size. Names length must be between 1 and " << s_fixedNameSize);
     }
 
-    SM_ASSERT_TRUE(MatrixArchiveException, isalpha(name[0]), "The name \"" << name << "\" is invalid. The first character of the name must be a letter");
+    const unsigned char * chars = reinterpret_cast<const unsigned char *>(name.data());
+    SM_ASSERT_TRUE(MatrixArchiveException, kNameCharTable.classes[chars[0]] & FIRST_CHAR, "The name \"" << name << "\" is invalid. The first character of the name must be a letter");
 
+    // Check all characters at once and only look for the culprit on failure.
+    unsigned char valid = OTHER_CHAR;
     for(unsigned i = 1; i < name.size(); i++)
     {
-      SM_ASSERT_TRUE(MatrixArchiveException, isalnum(name[i]) || name[i] == '_', "The name \"" << name << "\" is invalid. The characters of the name must be alphanumeric or an underscore. (failed at character " << i << ")");
+      valid &= kNameCharTable.classes[chars[i]];
+    }
+    if(!valid)
+    {
+      for(unsigned i = 1; i < name.size(); i++)
+      {
+        SM_ASSERT_TRUE(MatrixArchiveException, kNameCharTable.classes[chars[i]] & OTHER_CHAR, "The name \"" << name << "\" is invalid. The characters of the name must be alphanumeric or an underscore. (failed at character " << i << ")");
+      }
     }
   }
 
 
   bool MatrixArchive::isSystemLittleEndian() const
   {
-    short int word = 0x0001;
-    char *byte = (char *) &word;
-    return byte[0] != 0;
+    return matrix_archive::kHostIsLittleEndian;
   }
 
   size_t MatrixArchive::size() const
@@ -190,132 +517,376 @@ namespace sm
 
   MatrixArchive::matrix_map_t::const_iterator MatrixArchive::find(std::string const & name) const
   {
-    return m_values.find(name);
+    const IndexEntry * entry = m_index.find(name);
+    return entry && entry->hasMatrix ? matrix_map_t::const_iterator(entry->matrix) : m_values.end();
   }
 
-  void MatrixArchive::writeName(std::ostream & fout, std::string const & name) const
+  void MatrixArchive::encodeMatrixBlock(std::string const & name, Eigen::MatrixXd const & matrix, matrix_archive::Codec codec, bool swapBytes, EncodedBlock & block) const
   {
-    // fixed size character name
-    validateName(name, SM_SOURCE_FILE_POS);
-    fout.fill(' ');
-    fout.width(s_fixedNameSize);
-    fout << name;
-  }
+    block.data = reinterpret_cast<const char *>(matrix.data());
+    block.dataSize = matrix.size() * sizeof(double);
+    block.buffer.clear();
 
-  void MatrixArchive::writeMatrixBlock(std::ostream & fout, std::string const & name, Eigen::MatrixXd const & matrix) const
-  {
-    // start character
-    fout.write(&s_magicCharStartAMatrixBlock,1);
+    std::vector<char> swapped;
+    if(swapBytes && block.dataSize > 0)
+    {
+      swapped.resize(block.dataSize);
+      matrix_archive::byteSwap64(block.data, &swapped[0], matrix.size());
+      block.data = &swapped[0];
+    }
 
-    writeName(fout, name);
+    bool compressed = false;
+    if(codec != matrix_archive::CODEC_NONE && block.dataSize >= kMinCompressedDataSize)
+    {
+      std::vector<char> shuffled;
+      const char * raw = block.data;
+      if(m_byteShuffle)
+      {
+        shuffled.resize(block.dataSize);
+        matrix_archive::byteShuffle(raw, matrix.size(), sizeof(double), &shuffled[0]);
+        raw = &shuffled[0];
+      }
+      block.buffer.resize(matrix_archive::compressBound(codec, block.dataSize));
+      const size_t payloadSize = matrix_archive::compress(codec, raw, block.dataSize, &block.buffer[0]);
 
-    // 4 byte rows
-    boost::uint32_t rows = matrix.rows();
-    fout.write(reinterpret_cast<const char *>(&rows), 4);
+      // Only keep the compressed version if it pays for its extra header.
+      compressed = payloadSize + 6 < block.dataSize;
+      if(compressed)
+      {
+        block.buffer.resize(payloadSize);
+        block.data = &block.buffer[0];
+        block.dataSize = payloadSize;
+      }
+      else
+      {
+        std::vector<char>().swap(block.buffer);
+      }
+    }
+    if(!compressed && swapBytes)
+    {
+      block.buffer.swap(swapped);
+      block.data = block.buffer.empty() ? NULL : &block.buffer[0];
+    }
 
-    // 4 byte columns
-    boost::uint32_t cols = matrix.cols();
-    fout.write(reinterpret_cast<const char *>(&cols), 4);
+    // start character and fixed size name
+    block.header.clear();
+    block.header.push_back(compressed ? s_magicCharStartACompressedMatrixBlock : s_magicCharStartAMatrixBlock);
+    appendName(block.header, name);
 
-    // data
-    boost::uint32_t dataSize = rows * cols * sizeof(double);
-    fout.write(reinterpret_cast<const char *>(matrix.data()),dataSize);
+    // 4 byte rows, 4 byte columns
+    appendValue(block.header, static_cast<boost::uint32_t>(matrix.rows()), swapBytes);
+    appendValue(block.header, static_cast<boost::uint32_t>(matrix.cols()), swapBytes);
 
-    // std::cout << "Writing matrix " << name << ", size: " << rows << "x" << cols << ", dataSize: " << dataSize << std::endl;
-    // end character
-    fout.write(&s_magicCharEnd,1);
+    if(compressed)
+    {
+      // 1 byte codec, 1 byte filter, 4 byte compressed size
+      appendValue(block.header, static_cast<boost::uint8_t>(codec), swapBytes);
+      appendValue(block.header, static_cast<boost::uint8_t>(m_byteShuffle ? s_filterByteShuffle : 0), swapBytes);
+      appendValue(block.header, static_cast<boost::uint32_t>(block.dataSize), swapBytes);
+    }
+    encodeTrailer(m_checksums, swapBytes, block);
   }
 
+  void MatrixArchive::encodeStringBlock(std::string const & name, std::string const & stringValue, bool swapBytes, EncodedBlock & block) const
+  {
+    block.header.clear();
+    block.header.push_back(s_magicCharStartAStringBlock);
+    appendName(block.header, name);
+
+    // 4 byte size
+    appendValue(block.header, static_cast<boost::uint32_t>(stringValue.size()), swapBytes);
 
-  void MatrixArchive::writeMatrixBlockSwapBytes(std::ostream & /* fout */, std::string const & /* name */, Eigen::MatrixXd const & /* matrix */) const
+    block.data = stringValue.data();
+    block.dataSize = stringValue.size();
+    block.buffer.clear();
+    encodeTrailer(m_checksums, swapBytes, block);
+  }
+
+  void MatrixArchive::encodeByteOrderBlock(bool swapBytes, EncodedBlock & block) const
   {
-    SM_THROW(MatrixArchiveException, "Not Implemented");
+    // start character and the 4 byte marker in the byte order of the archive
+    block.header.clear();
+    block.header.push_back(s_magicCharStartAByteOrderBlock);
+    appendValue(block.header, s_byteOrderMarker, swapBytes);
+
+    block.data = NULL;
+    block.dataSize = 0;
+    block.buffer.clear();
+    encodeTrailer(false, swapBytes, block);
   }
-  
-  void MatrixArchive::readMatrix(std::istream & fin, Eigen::MatrixXd & matrix) const
-  {
-    // 4 byte rows
-    boost::uint32_t rows;
-    fin.read(reinterpret_cast<char *>(&rows),4);
-    // 4 byte columns
-    boost::uint32_t cols;
-    fin.read(reinterpret_cast<char *>(&cols),4);
-    
-    // data
 
-    matrix.resize(rows,cols);
-    std::streamsize dataSize = rows * cols * sizeof(double);
-    //std::cout << "Reading matrix \"" << name << "\", size: " << rows << "x" << cols << ", dataSize: " << dataSize << std::endl; 
-    fin.read(reinterpret_cast<char *>(matrix.data()),dataSize);
+  void MatrixArchive::encodeVersionBlock(bool swapBytes, EncodedBlock & block) const
+  {
+    // start character, 4 byte version and 4 byte flags
+    block.header.clear();
+    block.header.push_back(s_magicCharStartAVersionBlock);
+    appendValue(block.header, s_formatVersion, swapBytes);
+    appendValue(block.header, m_checksums ? s_formatFlagBlockChecksums : 0, swapBytes);
+
+    block.data = NULL;
+    block.dataSize = 0;
+    block.buffer.clear();
+    encodeTrailer(false, swapBytes, block);
   }
 
-  void MatrixArchive::writeStringBlock(std::ostream & fout, std::string const & name, std::string const & stringValue) const
+  void MatrixArchive::encodeTrailer(bool checksum, bool swapBytes, EncodedBlock & block) const
   {
-    // start character
-    fout.write(&s_magicCharStartAStringBlock,1);
+    // end character
+    block.trailer.assign(1, s_magicCharEnd);
+    if(checksum)
+    {
+      // 4 byte CRC-32C of the block from the start to the end character
+      boost::uint32_t crc = matrix_archive::crc32c(0, &block.header[0], block.header.size());
+      crc = matrix_archive::crc32c(crc, block.data, block.dataSize);
+      crc = matrix_archive::crc32c(crc, &block.trailer[0], 1);
+      appendValue(block.trailer, crc, swapBytes);
+    }
+  }
 
-    writeName(fout, name);
+  void MatrixArchive::writeBlock(std::ostream & fout, EncodedBlock const & block) const
+  {
+    fout.write(&block.header[0], block.header.size());
+    fout.write(block.data, block.dataSize);
+    fout.write(&block.trailer[0], block.trailer.size());
+  }
 
-    // 4 byte rows
-    boost::uint32_t stringSize = stringValue.size();
-    fout.write(reinterpret_cast<const char *>(&stringSize), 4);
+  void MatrixArchive::writeFileHeader(std::ostream & fout) const
+  {
+    EncodedBlock block;
+    if(m_byteOrder == BIG_ENDIAN_ARCHIVE)
+    {
+      encodeByteOrderBlock(swapBytesOnSave(), block);
+      writeBlock(fout, block);
+    }
+    if(m_checksums)
+    {
+      encodeVersionBlock(swapBytesOnSave(), block);
+      writeBlock(fout, block);
+    }
+  }
 
-    fout.write(&stringValue[0], stringSize);
+  void MatrixArchive::appendName(std::vector<char> & buffer, std::string const & name) const
+  {
+    // fixed size character name, right aligned and padded with spaces
+    validateName(name, SM_SOURCE_FILE_POS);
+    buffer.insert(buffer.end(), s_fixedNameSize - name.size(), ' ');
+    buffer.insert(buffer.end(), name.begin(), name.end());
+  }
 
-    // end character
-    fout.write(&s_magicCharEnd,1);
+  void MatrixArchive::writeMatrixBlock(std::ostream & fout, std::string const & name, Eigen::MatrixXd const & matrix, matrix_archive::Codec codec) const
+  {
+    EncodedBlock block;
+    encodeMatrixBlock(name, matrix, codec, false, block);
+    writeBlock(fout, block);
   }
 
-  void MatrixArchive::readString(std::istream & fin, std::string & stringValue) const
+
+  void MatrixArchive::writeMatrixBlockSwapBytes(std::ostream & fout, std::string const & name, Eigen::MatrixXd const & matrix, matrix_archive::Codec codec) const
   {
-    // 4 byte rows
-    boost::uint32_t stringSize;
-    fin.read(reinterpret_cast<char *>(&stringSize),4);
+    EncodedBlock block;
+    encodeMatrixBlock(name, matrix, codec, true, block);
+    writeBlock(fout, block);
+  }
 
-    // data
-    stringValue.resize(stringSize);
-    fin.read(&stringValue[0], stringSize);
+  void MatrixArchive::writeStringBlock(std::ostream & fout, std::string const & name, std::string const & stringValue) const
+  {
+    EncodedBlock block;
+    encodeStringBlock(name, stringValue, swapBytesOnSave(), block);
+    writeBlock(fout, block);
   }
 
-  MatrixArchive::BlockType MatrixArchive::readBlock(std::istream & fin, std::string & name, Eigen::MatrixXd & matrix, std::string & stringValue) const
+  void MatrixArchive::readBlockHeader(std::istream & fin, bool swapBytes, std::string & name, BlockLocation & block) const
   {
-    char start, end;
+    char start;
+    block.blockOffset = fin.tellg();
     // start character
     fin.read(&start,1);
-    BlockType blockType;
-    if(start == s_magicCharStartAStringBlock){
-      blockType = STRING;
+    block.rows = block.cols = 0;
+    block.codec = matrix_archive::CODEC_NONE;
+    block.filter = 0;
+    block.dataSize = 0;
+    block.hasChecksum = false;
+    block.checksum = 0;
+    block.formatVersion = block.formatFlags = 0;
+    if(start == s_magicCharStartAVersionBlock){
+      // 4 byte version, 4 byte flags
+      fin.read(reinterpret_cast<char *>(&block.formatVersion),4);
+      fin.read(reinterpret_cast<char *>(&block.formatFlags),4);
+      SM_ASSERT_TRUE(MatrixArchiveException, fin.good(), "Unexpected end of file while reading the format version");
+      if(swapBytes){
+        block.formatVersion = matrix_archive::swapBytes(block.formatVersion);
+        block.formatFlags = matrix_archive::swapBytes(block.formatFlags);
+      }
+      SM_ASSERT_GE_LE(MatrixArchiveException, block.formatVersion, 2u, s_formatVersion, "Unsupported archive format version");
+      block.type = FORMAT_VERSION;
+      block.swapBytes = swapBytes;
+      block.dataOffset = fin.tellg();
+      name.clear();
+      return;
+    }
+    else if(start == s_magicCharStartAByteOrderBlock){
+      // 4 byte marker, which sets the byte order of the following blocks
+      boost::uint32_t marker;
+      fin.read(reinterpret_cast<char *>(&marker),4);
+      SM_ASSERT_TRUE(MatrixArchiveException, fin.good(), "Unexpected end of file while reading the byte order marker");
+      if(marker == s_byteOrderMarker){
+        block.swapBytes = false;
+      }
+      else{
+        SM_ASSERT_EQ(MatrixArchiveException, marker, matrix_archive::swapBytes(s_byteOrderMarker), "Invalid byte order marker");
+        block.swapBytes = true;
+      }
+      block.type = BYTE_ORDER_MARKER;
+      block.dataOffset = fin.tellg();
+      name.clear();
+      return;
+    }
+    else if(start == s_magicCharStartAStringBlock){
+      block.type = STRING;
+    }
+    else if(start == s_magicCharStartACompressedMatrixBlock){
+      block.type = COMPRESSED_MATRIX;
     }
     else{
       SM_ASSERT_EQ(MatrixArchiveException, start, s_magicCharStartAMatrixBlock, "The block didn't start with the expected character");
-      blockType = MATRIX;
+      block.type = MATRIX;
     }
 
-    // 64 character name
+    // fixed size name
     char nameBuffer[s_fixedNameSize + 1];
     nameBuffer[s_fixedNameSize] = '\0';
     fin.read(nameBuffer,(std::streamsize)s_fixedNameSize);
     name = nameBuffer;
     boost::trim(name);
 
-    switch(blockType){
+    block.swapBytes = swapBytes;
+    switch(block.type){
       case MATRIX:
-        readMatrix(fin, matrix);
+        // 4 byte rows, 4 byte columns
+        fin.read(reinterpret_cast<char *>(&block.rows),4);
+        fin.read(reinterpret_cast<char *>(&block.cols),4);
+        if(swapBytes){
+          block.rows = matrix_archive::swapBytes(block.rows);
+          block.cols = matrix_archive::swapBytes(block.cols);
+        }
+        block.dataSize = static_cast<boost::uint64_t>(block.rows) * block.cols * sizeof(double);
         break;
       case STRING:
-        readString(fin, stringValue);
+      {
+        // 4 byte size
+        boost::uint32_t stringSize;
+        fin.read(reinterpret_cast<char *>(&stringSize),4);
+        block.dataSize = swapBytes ? matrix_archive::swapBytes(stringSize) : stringSize;
+        break;
+      }
+      case COMPRESSED_MATRIX:
+      {
+        // 4 byte rows, 4 byte columns, 1 byte codec, 1 byte filter, 4 byte compressed size
+        fin.read(reinterpret_cast<char *>(&block.rows),4);
+        fin.read(reinterpret_cast<char *>(&block.cols),4);
+        fin.read(reinterpret_cast<char *>(&block.codec),1);
+        fin.read(reinterpret_cast<char *>(&block.filter),1);
+        boost::uint32_t compressedSize;
+        fin.read(reinterpret_cast<char *>(&compressedSize),4);
+        if(swapBytes){
+          block.rows = matrix_archive::swapBytes(block.rows);
+          block.cols = matrix_archive::swapBytes(block.cols);
+          compressedSize = matrix_archive::swapBytes(compressedSize);
+        }
+        // Empty matrices are never compressed, so this is a corrupt file.
+        SM_ASSERT_TRUE(MatrixArchiveException, !fin.good() || (compressedSize > 0 && block.rows > 0 && block.cols > 0),
+                       "The compressed block \"" << name << "\" is empty: " << block.rows << "x" << block.cols
+                       << " with " << compressedSize << " compressed bytes");
+        block.dataSize = compressedSize;
+        break;
+      }
+      case BYTE_ORDER_MARKER:
+      case FORMAT_VERSION:
         break;
     }
+    SM_ASSERT_TRUE(MatrixArchiveException, fin.good(), "Unexpected end of file while reading the header of block \"" << name << "\"");
+    block.dataOffset = fin.tellg();
+  }
 
+  void MatrixArchive::readBlockData(int fd, BlockLocation const & block, Eigen::MatrixXd & matrix) const
+  {
+    matrix.resize(block.rows, block.cols);
+    const size_t dataSize = matrix.size() * sizeof(double);
+    char * out = reinterpret_cast<char *>(matrix.data());
+    if(block.type == MATRIX)
+    {
+      preadAll(fd, out, dataSize, block.dataOffset);
+      checkBlockChecksum(fd, block, out);
+      if(block.swapBytes)
+      {
+        matrix_archive::byteSwap64(out, out, matrix.size());
+      }
+      return;
+    }
+
+    std::vector<char> compressed(block.dataSize);
+    preadAll(fd, &compressed[0], compressed.size(), block.dataOffset);
+    checkBlockChecksum(fd, block, &compressed[0]);
+    const matrix_archive::Codec codec = static_cast<matrix_archive::Codec>(block.codec);
+    if(block.filter & s_filterByteShuffle)
+    {
+      std::vector<char> shuffled(dataSize);
+      matrix_archive::decompress(codec, &compressed[0], compressed.size(), &shuffled[0], dataSize);
+      matrix_archive::byteUnshuffle(&shuffled[0], matrix.size(), sizeof(double), out);
+    }
+    else
+    {
+      matrix_archive::decompress(codec, &compressed[0], compressed.size(), out, dataSize);
+    }
+    if(block.swapBytes)
+    {
+      matrix_archive::byteSwap64(out, out, matrix.size());
+    }
+  }
+
+  void MatrixArchive::readBlockData(int fd, BlockLocation const & block, std::string & stringValue) const
+  {
+    stringValue.resize(block.dataSize);
+    if(block.dataSize > 0)
+    {
+      preadAll(fd, &stringValue[0], block.dataSize, block.dataOffset);
+    }
+    checkBlockChecksum(fd, block, stringValue.data());
+  }
+
+  void MatrixArchive::readBlockTrailer(std::istream & fin, bool checksums, std::string const & name, BlockLocation & block) const
+  {
     // end character
+    char end;
     fin.read(&end,1);
+    SM_ASSERT_TRUE(MatrixArchiveException, fin.good(), "Unexpected end of file while reading block \"" << name << "\"");
     SM_ASSERT_EQ(MatrixArchiveException, end, s_magicCharEnd, "The matrix block didn't end with the expected character");
-    return blockType;
+
+    // 4 byte checksum
+    block.hasChecksum = checksums && block.type != BYTE_ORDER_MARKER && block.type != FORMAT_VERSION;
+    if(block.hasChecksum)
+    {
+      fin.read(reinterpret_cast<char *>(&block.checksum),4);
+      SM_ASSERT_TRUE(MatrixArchiveException, fin.good(), "Unexpected end of file while reading the checksum of block \"" << name << "\"");
+      if(block.swapBytes)
+      {
+        block.checksum = matrix_archive::swapBytes(block.checksum);
+      }
+    }
   }
 
-  void MatrixArchive::readMatrixSwapBytes(std::istream & /* fin */, std::string & /* name */, Eigen::MatrixXd & /* matrix */) const
+  void MatrixArchive::checkBlockChecksum(int fd, BlockLocation const & block, const char * data) const
   {
-    SM_THROW(MatrixArchiveException, "Not Implemented");
+    if(!block.hasChecksum)
+    {
+      return;
+    }
+    std::vector<char> header(block.dataOffset - block.blockOffset);
+    preadAll(fd, &header[0], header.size(), block.blockOffset);
+    boost::uint32_t crc = matrix_archive::crc32c(0, &header[0], header.size());
+    crc = matrix_archive::crc32c(crc, data, block.dataSize);
+    crc = matrix_archive::crc32c(crc, &s_magicCharEnd, 1);
+    SM_ASSERT_EQ(MatrixArchiveException, crc, block.checksum, "Checksum mismatch in the block at offset " << block.blockOffset);
   }
 
   // Loads matrices from a file into the archive.
@@ -360,16 +931,22 @@ namespace sm
 
   void MatrixArchive::save(boost::filesystem::path const & amaFilePath, std::set<std::string> const & validNames) const
   {
-    std::ofstream fout(amaFilePath.string().c_str(), std::ios::binary);
-    SM_ASSERT_TRUE(MatrixArchiveException, fout.good(), "Unable to open file " << amaFilePath.string() << " for writing");
+    save(amaFilePath, validNames, 0);
+  }
 
-    save(fout, validNames);
+  void MatrixArchive::save(boost::filesystem::path const & amaFilePath, std::set<std::string> const & validNames, size_t numThreads) const
+  {
+    saveBlocks(amaFilePath, validNames, NULL, numThreads);
+  }
 
-    fout.close();
+  void MatrixArchive::save(boost::filesystem::path const & amaFilePath, std::set<std::string> const & validNames, JobQueue & jobQueue) const
+  {
+    saveBlocks(amaFilePath, validNames, &jobQueue, 0);
   }
 
   void MatrixArchive::save(std::ostream & fout, std::set<std::string> const & validNames) const
   {
+    writeFileHeader(fout);
     saveMatrices(fout, validNames);
     saveStrings(fout, validNames);
   }
@@ -381,13 +958,13 @@ namespace sm
     {
       if(validNames.empty() || validNames.count(it->first) > 0)
       {
-        if(isSystemLittleEndian())
+        if(swapBytesOnSave())
         {
-          writeMatrixBlock(fout, it->first, it->second);
+          writeMatrixBlockSwapBytes(fout, it->first, it->second, m_codec);
         }
         else
         {
-          writeMatrixBlockSwapBytes(fout, it->first, it->second);
+          writeMatrixBlock(fout, it->first, it->second, m_codec);
         }
         SM_ASSERT_TRUE(MatrixArchiveException, fout.good(), "Error while writing matrix " << it->first << " to file.");
       }
@@ -407,33 +984,256 @@ namespace sm
     }
   }
 
+  void MatrixArchive::saveBlocks(boost::filesystem::path const & amaFilePath, std::set<std::string> const & validNames, JobQueue * jobQueue, size_t numThreads) const
+  {
+    std::vector<matrix_map_t::const_iterator> matrices;
+    std::vector<string_map_t::const_iterator> strings;
+    size_t totalBytes = 0;
+    for(matrix_map_t::const_iterator it = m_values.begin(); it != m_values.end(); ++it)
+    {
+      if(validNames.empty() || validNames.count(it->first) > 0)
+      {
+        matrices.push_back(it);
+        totalBytes += it->second.size() * sizeof(double);
+      }
+    }
+    for(string_map_t::const_iterator it = m_strings.begin(); it != m_strings.end(); ++it)
+    {
+      if(validNames.empty() || validNames.count(it->first) > 0)
+      {
+        strings.push_back(it);
+        totalBytes += it->second.size();
+      }
+    }
+
+    // Encode (and compress) all blocks in parallel.
+    const bool swapBytes = swapBytesOnSave();
+    const size_t first = (m_byteOrder == BIG_ENDIAN_ARCHIVE ? 1 : 0) + (m_checksums ? 1 : 0);
+    std::vector<EncodedBlock> blocks(first + matrices.size() + strings.size());
+    if(m_byteOrder == BIG_ENDIAN_ARCHIVE)
+    {
+      encodeByteOrderBlock(swapBytes, blocks[0]);
+    }
+    if(m_checksums)
+    {
+      encodeVersionBlock(swapBytes, blocks[first - 1]);
+    }
+    std::vector< boost::function<void()> > jobs;
+    jobs.reserve(blocks.size());
+    for(size_t i = 0; i < matrices.size(); ++i)
+    {
+      const size_t b = first + i;
+      jobs.push_back([this, i, b, swapBytes, &matrices, &blocks]() {
+        encodeMatrixBlock(matrices[i]->first, matrices[i]->second, m_codec, swapBytes, blocks[b]);
+      });
+    }
+    for(size_t i = 0; i < strings.size(); ++i)
+    {
+      const size_t b = first + matrices.size() + i;
+      jobs.push_back([this, i, b, swapBytes, &strings, &blocks]() {
+        encodeStringBlock(strings[i]->first, strings[i]->second, swapBytes, blocks[b]);
+      });
+    }
+    const size_t threads = numJobThreads(numThreads, totalBytes);
+    runJobs(jobs, jobQueue, threads);
+
+    // Now that all sizes are known, lay the blocks out and write them concurrently.
+    boost::uint64_t offset = 0;
+    for(size_t i = 0; i < blocks.size(); ++i)
+    {
+      blocks[i].offset = offset;
+      offset += blocks[i].header.size() + blocks[i].dataSize + blocks[i].trailer.size();
+    }
+
+    const int fd = ::open(amaFilePath.string().c_str(), O_WRONLY | O_CREAT | O_TRUNC, 0666);
+    SM_ASSERT_TRUE(MatrixArchiveException, fd >= 0, "Unable to open file " << amaFilePath.string() << " for writing: " << strerror(errno));
+    jobs.clear();
+    for(size_t i = 0; i < blocks.size(); ++i)
+    {
+      jobs.push_back([i, fd, &blocks]() {
+        EncodedBlock const & block = blocks[i];
+        pwriteAll(fd, &block.header[0], block.header.size(), block.offset);
+        pwriteAll(fd, block.data, block.dataSize, block.offset + block.header.size());
+        pwriteAll(fd, &block.trailer[0], block.trailer.size(), block.offset + block.header.size() + block.dataSize);
+      });
+    }
+    try
+    {
+      runJobs(jobs, jobQueue, threads);
+    }
+    catch(...)
+    {
+      ::close(fd);
+      throw;
+    }
+    SM_ASSERT_EQ(MatrixArchiveException, ::close(fd), 0, "Error while closing file " << amaFilePath.string() << ": " << strerror(errno));
+  }
+
   void MatrixArchive::load(boost::filesystem::path const & amaFilePath, std::set<std::string> const & validNames)
+  {
+    load(amaFilePath, validNames, 0);
+  }
+
+  void MatrixArchive::load(boost::filesystem::path const & amaFilePath, std::set<std::string> const & validNames, size_t numThreads)
+  {
+    loadBlocks(amaFilePath, validNames, NULL, numThreads);
+  }
+
+  void MatrixArchive::load(boost::filesystem::path const & amaFilePath, std::set<std::string> const & validNames, JobQueue & jobQueue)
+  {
+    loadBlocks(amaFilePath, validNames, &jobQueue, 0);
+  }
+
+  void MatrixArchive::verify(boost::filesystem::path const & amaFilePath) const
   {
     std::ifstream fin(amaFilePath.string().c_str(), std::ios::binary);
     SM_ASSERT_TRUE(MatrixArchiveException, fin.good(), "Unable to open file " << amaFilePath << " for reading");
-
-    std::string name, valueString;
-    Eigen::MatrixXd matrix;
+    fin.seekg(0, std::ios::end);
+    const boost::uint64_t fileSize = fin.tellg();
+    fin.seekg(0, std::ios::beg);
+
+    std::vector<char> chunk;
+    std::string name;
+    BlockLocation block;
+    bool swapBytes = !isSystemLittleEndian();
+    bool checksums = false;
     fin.peek();
     while(!fin.eof())
     {
-      BlockType blockType = readBlock(fin, name, matrix, valueString);
+      readBlockHeader(fin, swapBytes, name, block);
+      SM_ASSERT_LE(MatrixArchiveException, block.dataSize, fileSize - block.dataOffset, "The data of block \"" << name << "\" at offset " << block.blockOffset << " extends past the end of the file");
+      if(block.type == COMPRESSED_MATRIX)
+      {
+        const matrix_archive::Codec codec = static_cast<matrix_archive::Codec>(block.codec);
+        SM_ASSERT_TRUE(MatrixArchiveException, matrix_archive::isCodecAvailable(codec), "Block \"" << name << "\" uses the codec " << static_cast<int>(block.codec) << " which is not available in this build");
+        SM_ASSERT_EQ(MatrixArchiveException, block.filter & ~s_filterByteShuffle, 0, "Block \"" << name << "\" uses an unknown filter");
+      }
+      else if(block.type == MATRIX || block.type == STRING)
+      {
+        validateName(name, SM_SOURCE_FILE_POS);
+      }
 
-      if(validNames.empty() || validNames.count(name) > 0)
+      // Stream the header and the data through the checksum without keeping them.
+      const bool checkData = checksums && block.type != BYTE_ORDER_MARKER && block.type != FORMAT_VERSION;
+      boost::uint32_t crc = 0;
+      if(checkData)
       {
-        validateName(name,SM_SOURCE_FILE_POS);
-        switch(blockType){
-          case MATRIX:
-            m_values[name] = matrix;
-            break;
-          case STRING:
-            m_strings[name] = valueString;
-            break;
+        chunk.resize(std::max<size_t>(chunk.size(), block.dataOffset - block.blockOffset));
+        fin.seekg(block.blockOffset, std::ios::beg);
+        fin.read(&chunk[0], block.dataOffset - block.blockOffset);
+        crc = matrix_archive::crc32c(crc, &chunk[0], block.dataOffset - block.blockOffset);
+        chunk.resize(std::max<size_t>(chunk.size(), std::min<boost::uint64_t>(block.dataSize, kVerifyChunkSize)));
+        for(boost::uint64_t remaining = block.dataSize; remaining > 0; )
+        {
+          const size_t n = std::min<boost::uint64_t>(remaining, kVerifyChunkSize);
+          fin.read(&chunk[0], n);
+          SM_ASSERT_TRUE(MatrixArchiveException, fin.good(), "Unexpected end of file while reading block \"" << name << "\"");
+          crc = matrix_archive::crc32c(crc, &chunk[0], n);
+          remaining -= n;
         }
       }
+      else
+      {
+        fin.seekg(block.dataSize, std::ios::cur);
+      }
+      readBlockTrailer(fin, checksums, name, block);
+      if(checkData)
+      {
+        crc = matrix_archive::crc32c(crc, &s_magicCharEnd, 1);
+        SM_ASSERT_EQ(MatrixArchiveException, crc, block.checksum, "Checksum mismatch in block \"" << name << "\" at offset " << block.blockOffset);
+      }
+
+      if(block.type == BYTE_ORDER_MARKER)
+      {
+        swapBytes = block.swapBytes;
+      }
+      else if(block.type == FORMAT_VERSION)
+      {
+        checksums = (block.formatFlags & s_formatFlagBlockChecksums) != 0;
+      }
       fin.peek();
     }
+  }
 
+  void MatrixArchive::loadBlocks(boost::filesystem::path const & amaFilePath, std::set<std::string> const & validNames, JobQueue * jobQueue, size_t numThreads)
+  {
+    // Scan the block headers first. Later blocks with the same name replace earlier ones.
+    typedef std::map<std::string, BlockLocation> location_map_t;
+    location_map_t matrixBlocks, stringBlocks;
+    size_t totalBytes = 0;
+    {
+      std::ifstream fin(amaFilePath.string().c_str(), std::ios::binary);
+      SM_ASSERT_TRUE(MatrixArchiveException, fin.good(), "Unable to open file " << amaFilePath << " for reading");
+
+      std::string name;
+      BlockLocation block;
+      // Archives are little endian until a byte order marker says otherwise.
+      bool swapBytes = !isSystemLittleEndian();
+      // Blocks carry checksums once a format version block says so.
+      bool checksums = false;
+      fin.peek();
+      while(!fin.eof())
+      {
+        readBlockHeader(fin, swapBytes, name, block);
+
+        // skip the data and read the end of the block
+        fin.seekg(block.dataSize, std::ios::cur);
+        readBlockTrailer(fin, checksums, name, block);
+
+        if(block.type == BYTE_ORDER_MARKER)
+        {
+          swapBytes = block.swapBytes;
+        }
+        else if(block.type == FORMAT_VERSION)
+        {
+          checksums = (block.formatFlags & s_formatFlagBlockChecksums) != 0;
+        }
+        else if(validNames.empty() || validNames.count(name) > 0)
+        {
+          validateName(name,SM_SOURCE_FILE_POS);
+          if(block.type == STRING)
+          {
+            stringBlocks[name] = block;
+          }
+          else
+          {
+            matrixBlocks[name] = block;
+          }
+          totalBytes += block.dataSize;
+        }
+        fin.peek();
+      }
+    }
+
+    const int fd = ::open(amaFilePath.string().c_str(), O_RDONLY);
+    SM_ASSERT_TRUE(MatrixArchiveException, fd >= 0, "Unable to open file " << amaFilePath << " for reading: " << strerror(errno));
+
+    // The destinations are created up front, the jobs only fill them.
+    std::vector< boost::function<void()> > jobs;
+    jobs.reserve(matrixBlocks.size() + stringBlocks.size());
+    for(location_map_t::const_iterator it = matrixBlocks.begin(); it != matrixBlocks.end(); ++it)
+    {
+      BlockLocation const * block = &it->second;
+      Eigen::MatrixXd * matrix = &insertMatrix(it->first);
+      jobs.push_back([this, fd, block, matrix]() { readBlockData(fd, *block, *matrix); });
+    }
+    for(location_map_t::const_iterator it = stringBlocks.begin(); it != stringBlocks.end(); ++it)
+    {
+      BlockLocation const * block = &it->second;
+      std::string * value = &insertString(it->first);
+      jobs.push_back([this, fd, block, value]() { readBlockData(fd, *block, *value); });
+    }
+
+    try
+    {
+      runJobs(jobs, jobQueue, numJobThreads(numThreads, totalBytes));
+    }
+    catch(...)
+    {
+      ::close(fd);
+      throw;
+    }
+    ::close(fd);
   }
 
   void MatrixArchive::append(boost::filesystem::path const & amaFilePath, std::set<std::string> const & /* validNames */) const
@@ -0,0 +1,111 @@
+#include <cstring>
+#include <boost/cstdint.hpp>
+#include <sm/matrix_archive/byte_swap.hpp>
+
+#if defined(__GNUC__) && (defined(__x86_64__) || defined(__i386__))
+#define SM_MATRIX_ARCHIVE_X86_DISPATCH
+#include <immintrin.h>
+#elif defined(__ARM_NEON) || defined(__ARM_NEON__)
+#define SM_MATRIX_ARCHIVE_NEON
+#include <arm_neon.h>
+#endif
+
+namespace sm {
+  namespace matrix_archive {
+
+    namespace {
+
+      void byteSwap64Scalar(const char * src, char * dst, size_t count)
+      {
+        for(size_t i = 0; i < count; ++i)
+        {
+          boost::uint64_t v;
+          memcpy(&v, src + 8 * i, 8);
+          v = swapBytes(v);
+          memcpy(dst + 8 * i, &v, 8);
+        }
+      }
+
+#ifdef SM_MATRIX_ARCHIVE_X86_DISPATCH
+      __attribute__((target("ssse3")))
+      void byteSwap64Ssse3(const char * src, char * dst, size_t count)
+      {
+        const __m128i mask = _mm_setr_epi8(7, 6, 5, 4, 3, 2, 1, 0, 15, 14, 13, 12, 11, 10, 9, 8);
+        size_t i = 0;
+        for(; i + 2 <= count; i += 2)
+        {
+          const __m128i v = _mm_loadu_si128(reinterpret_cast<const __m128i *>(src + 8 * i));
+          _mm_storeu_si128(reinterpret_cast<__m128i *>(dst + 8 * i), _mm_shuffle_epi8(v, mask));
+        }
+        byteSwap64Scalar(src + 8 * i, dst + 8 * i, count - i);
+      }
+
+      __attribute__((target("avx2")))
+      void byteSwap64Avx2(const char * src, char * dst, size_t count)
+      {
+        const __m256i mask = _mm256_setr_epi8(7, 6, 5, 4, 3, 2, 1, 0, 15, 14, 13, 12, 11, 10, 9, 8,
+                                              7, 6, 5, 4, 3, 2, 1, 0, 15, 14, 13, 12, 11, 10, 9, 8);
+        size_t i = 0;
+        for(; i + 8 <= count; i += 8)
+        {
+          const __m256i a = _mm256_loadu_si256(reinterpret_cast<const __m256i *>(src + 8 * i));
+          const __m256i b = _mm256_loadu_si256(reinterpret_cast<const __m256i *>(src + 8 * i + 32));
+          _mm256_storeu_si256(reinterpret_cast<__m256i *>(dst + 8 * i), _mm256_shuffle_epi8(a, mask));
+          _mm256_storeu_si256(reinterpret_cast<__m256i *>(dst + 8 * i + 32), _mm256_shuffle_epi8(b, mask));
+        }
+        for(; i + 4 <= count; i += 4)
+        {
+          const __m256i a = _mm256_loadu_si256(reinterpret_cast<const __m256i *>(src + 8 * i));
+          _mm256_storeu_si256(reinterpret_cast<__m256i *>(dst + 8 * i), _mm256_shuffle_epi8(a, mask));
+        }
+        byteSwap64Scalar(src + 8 * i, dst + 8 * i, count - i);
+      }
+
+      typedef void (*ByteSwapKernel)(const char *, char *, size_t);
+
+      ByteSwapKernel selectByteSwapKernel()
+      {
+        __builtin_cpu_init();
+        if(__builtin_cpu_supports("avx2"))
+        {
+          return &byteSwap64Avx2;
+        }
+        if(__builtin_cpu_supports("ssse3"))
+        {
+          return &byteSwap64Ssse3;
+        }
+        return &byteSwap64Scalar;
+      }
+#endif
+
+#ifdef SM_MATRIX_ARCHIVE_NEON
+      void byteSwap64Neon(const char * src, char * dst, size_t count)
+      {
+        size_t i = 0;
+        for(; i + 2 <= count; i += 2)
+        {
+          const uint8x16_t v = vld1q_u8(reinterpret_cast<const uint8_t *>(src + 8 * i));
+          vst1q_u8(reinterpret_cast<uint8_t *>(dst + 8 * i), vrev64q_u8(v));
+        }
+        byteSwap64Scalar(src + 8 * i, dst + 8 * i, count - i);
+      }
+#endif
+
+    } // namespace
+
+    void byteSwap64(const void * src, void * dst, size_t count)
+    {
+      const char * in = static_cast<const char *>(src);
+      char * out = static_cast<char *>(dst);
+#if defined(SM_MATRIX_ARCHIVE_X86_DISPATCH)
+      static const ByteSwapKernel kernel = selectByteSwapKernel();
+      kernel(in, out, count);
+#elif defined(SM_MATRIX_ARCHIVE_NEON)
+      byteSwap64Neon(in, out, count);
+#else
+      byteSwap64Scalar(in, out, count);
+#endif
+    }
+
+  } // namespace matrix_archive
+} // namespace sm
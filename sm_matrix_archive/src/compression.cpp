@@ -0,0 +1,357 @@
+#include <cstring>
+#include <vector>
+#include <sm/MatrixArchive.hpp>
+#include <sm/matrix_archive/compression.hpp>
+
+#ifdef SM_MATRIX_ARCHIVE_HAVE_LZ4
+#include <lz4.h>
+#endif
+#ifdef SM_MATRIX_ARCHIVE_HAVE_ZSTD
+#include <zstd.h>
+#endif
+
+namespace sm {
+  namespace matrix_archive {
+
+    namespace {
+
+#ifndef SM_MATRIX_ARCHIVE_HAVE_LZ4
+      // A small implementation of the LZ4 block format
+      // (https://github.com/lz4/lz4/blob/dev/doc/lz4_Block_format.md)
+      // used when liblz4 is not available.
+      const size_t kLz4MinMatch = 4;
+      const size_t kLz4LastLiterals = 5;
+      const size_t kLz4MatchFindLimit = 12;
+      const size_t kLz4MaxOffset = 65535;
+      const int kLz4HashLog = 12;
+
+      inline boost::uint32_t read32(const unsigned char * p)
+      {
+        boost::uint32_t v;
+        memcpy(&v, p, sizeof(v));
+        return v;
+      }
+
+      inline unsigned char * writeLength(unsigned char * op, size_t length)
+      {
+        while(length >= 255)
+        {
+          *op++ = 255;
+          length -= 255;
+        }
+        *op++ = static_cast<unsigned char>(length);
+        return op;
+      }
+
+      size_t lz4CompressBound(size_t srcSize)
+      {
+        return srcSize + srcSize / 255 + 16;
+      }
+
+      size_t lz4Compress(const char * source, size_t srcSize, char * dest)
+      {
+        const unsigned char * src = reinterpret_cast<const unsigned char *>(source);
+        const unsigned char * const srcEnd = src + srcSize;
+        const unsigned char * anchor = src;
+        unsigned char * op = reinterpret_cast<unsigned char *>(dest);
+
+        if(srcSize > kLz4MatchFindLimit)
+        {
+          std::vector<boost::uint32_t> table(1u << kLz4HashLog, 0);
+          const unsigned char * const mfLimit = srcEnd - kLz4MatchFindLimit;
+          const unsigned char * const matchLimit = srcEnd - kLz4LastLiterals;
+          const unsigned char * ip = src;
+          // Skip faster over incompressible data.
+          unsigned searchCount = 1u << 6;
+          while(ip < mfLimit)
+          {
+            const boost::uint32_t sequence = read32(ip);
+            const boost::uint32_t h = (sequence * 2654435761u) >> (32 - kLz4HashLog);
+            const unsigned char * ref = src + table[h];
+            table[h] = static_cast<boost::uint32_t>(ip - src);
+            if(ref >= ip || static_cast<size_t>(ip - ref) > kLz4MaxOffset || read32(ref) != sequence)
+            {
+              ip += searchCount++ >> 6;
+              continue;
+            }
+            searchCount = 1u << 6;
+
+            const unsigned char * matchEnd = ip + kLz4MinMatch;
+            const unsigned char * refEnd = ref + kLz4MinMatch;
+            while(matchEnd < matchLimit && *matchEnd == *refEnd)
+            {
+              ++matchEnd;
+              ++refEnd;
+            }
+            while(ip > anchor && ref > src && ip[-1] == ref[-1])
+            {
+              --ip;
+              --ref;
+            }
+
+            unsigned char * token = op++;
+            const size_t literalLength = ip - anchor;
+            if(literalLength >= 15)
+            {
+              *token = 15 << 4;
+              op = writeLength(op, literalLength - 15);
+            }
+            else
+            {
+              *token = static_cast<unsigned char>(literalLength << 4);
+            }
+            memcpy(op, anchor, literalLength);
+            op += literalLength;
+
+            const size_t offset = ip - ref;
+            *op++ = static_cast<unsigned char>(offset & 0xff);
+            *op++ = static_cast<unsigned char>(offset >> 8);
+
+            const size_t matchLength = (matchEnd - ip) - kLz4MinMatch;
+            if(matchLength >= 15)
+            {
+              *token |= 15;
+              op = writeLength(op, matchLength - 15);
+            }
+            else
+            {
+              *token |= static_cast<unsigned char>(matchLength);
+            }
+            ip = anchor = matchEnd;
+          }
+        }
+
+        // The last sequence only holds literals.
+        const size_t literalLength = srcEnd - anchor;
+        if(literalLength >= 15)
+        {
+          *op++ = 15 << 4;
+          op = writeLength(op, literalLength - 15);
+        }
+        else
+        {
+          *op++ = static_cast<unsigned char>(literalLength << 4);
+        }
+        memcpy(op, anchor, literalLength);
+        op += literalLength;
+        return op - reinterpret_cast<unsigned char *>(dest);
+      }
+
+      void lz4Decompress(const char * source, size_t srcSize, char * dest, size_t dstSize)
+      {
+        const unsigned char * ip = reinterpret_cast<const unsigned char *>(source);
+        const unsigned char * const srcEnd = ip + srcSize;
+        unsigned char * const dst = reinterpret_cast<unsigned char *>(dest);
+        unsigned char * op = dst;
+        unsigned char * const dstEnd = dst + dstSize;
+
+        for(;;)
+        {
+          SM_ASSERT_TRUE(MatrixArchiveException, ip < srcEnd, "Corrupt LZ4 block: unexpected end of input");
+          const unsigned token = *ip++;
+
+          size_t literalLength = token >> 4;
+          if(literalLength == 15)
+          {
+            unsigned char s;
+            do
+            {
+              SM_ASSERT_TRUE(MatrixArchiveException, ip < srcEnd, "Corrupt LZ4 block: unexpected end of input");
+              s = *ip++;
+              literalLength += s;
+            } while(s == 255);
+          }
+          SM_ASSERT_TRUE(MatrixArchiveException, literalLength <= static_cast<size_t>(srcEnd - ip) && literalLength <= static_cast<size_t>(dstEnd - op),
+                         "Corrupt LZ4 block: literal run out of bounds");
+          memcpy(op, ip, literalLength);
+          ip += literalLength;
+          op += literalLength;
+          if(ip == srcEnd)
+          {
+            break;
+          }
+
+          SM_ASSERT_TRUE(MatrixArchiveException, srcEnd - ip >= 2, "Corrupt LZ4 block: unexpected end of input");
+          const size_t offset = ip[0] | (static_cast<size_t>(ip[1]) << 8);
+          ip += 2;
+          SM_ASSERT_TRUE(MatrixArchiveException, offset > 0 && offset <= static_cast<size_t>(op - dst), "Corrupt LZ4 block: invalid match offset " << offset);
+
+          size_t matchLength = token & 15;
+          if(matchLength == 15)
+          {
+            unsigned char s;
+            do
+            {
+              SM_ASSERT_TRUE(MatrixArchiveException, ip < srcEnd, "Corrupt LZ4 block: unexpected end of input");
+              s = *ip++;
+              matchLength += s;
+            } while(s == 255);
+          }
+          matchLength += kLz4MinMatch;
+          SM_ASSERT_TRUE(MatrixArchiveException, matchLength <= static_cast<size_t>(dstEnd - op), "Corrupt LZ4 block: match out of bounds");
+
+          const unsigned char * match = op - offset;
+          if(offset >= matchLength)
+          {
+            memcpy(op, match, matchLength);
+            op += matchLength;
+          }
+          else
+          {
+            // Overlapping copy: repeats the last offset bytes.
+            for(size_t i = 0; i < matchLength; ++i)
+            {
+              *op++ = *match++;
+            }
+          }
+        }
+        SM_ASSERT_TRUE(MatrixArchiveException, op == dstEnd, "Corrupt LZ4 block: decoded " << (op - dst) << " bytes, expected " << dstSize);
+      }
+#endif
+
+    } // namespace
+
+    bool isCodecAvailable(Codec codec)
+    {
+      switch(codec)
+      {
+        case CODEC_NONE:
+        case CODEC_LZ4:
+          return true;
+        case CODEC_ZSTD:
+#ifdef SM_MATRIX_ARCHIVE_HAVE_ZSTD
+          return true;
+#else
+          return false;
+#endif
+      }
+      return false;
+    }
+
+    const char * codecName(Codec codec)
+    {
+      switch(codec)
+      {
+        case CODEC_NONE:
+          return "none";
+        case CODEC_LZ4:
+          return "lz4";
+        case CODEC_ZSTD:
+          return "zstd";
+      }
+      return "unknown";
+    }
+
+    size_t compressBound(Codec codec, size_t srcSize)
+    {
+      SM_ASSERT_TRUE(MatrixArchiveException, isCodecAvailable(codec), "The codec " << codecName(codec) << " (" << static_cast<int>(codec) << ") is not available in this build");
+      switch(codec)
+      {
+        case CODEC_NONE:
+          return srcSize;
+        case CODEC_LZ4:
+#ifdef SM_MATRIX_ARCHIVE_HAVE_LZ4
+          return LZ4_compressBound(static_cast<int>(srcSize));
+#else
+          return lz4CompressBound(srcSize);
+#endif
+        case CODEC_ZSTD:
+#ifdef SM_MATRIX_ARCHIVE_HAVE_ZSTD
+          return ZSTD_compressBound(srcSize);
+#endif
+          break;
+      }
+      return 0;
+    }
+
+    size_t compress(Codec codec, const char * src, size_t srcSize, char * dst)
+    {
+      SM_ASSERT_TRUE(MatrixArchiveException, isCodecAvailable(codec), "The codec " << codecName(codec) << " (" << static_cast<int>(codec) << ") is not available in this build");
+      switch(codec)
+      {
+        case CODEC_NONE:
+          memcpy(dst, src, srcSize);
+          return srcSize;
+        case CODEC_LZ4:
+        {
+#ifdef SM_MATRIX_ARCHIVE_HAVE_LZ4
+          const int bound = LZ4_compressBound(static_cast<int>(srcSize));
+          const int n = LZ4_compress_default(src, dst, static_cast<int>(srcSize), bound);
+          SM_ASSERT_GT(MatrixArchiveException, n, 0, "LZ4 compression failed");
+          return n;
+#else
+          return lz4Compress(src, srcSize, dst);
+#endif
+        }
+        case CODEC_ZSTD:
+        {
+#ifdef SM_MATRIX_ARCHIVE_HAVE_ZSTD
+          const size_t n = ZSTD_compress(dst, ZSTD_compressBound(srcSize), src, srcSize, 3);
+          SM_ASSERT_FALSE(MatrixArchiveException, ZSTD_isError(n), "Zstd compression failed: " << ZSTD_getErrorName(n));
+          return n;
+#endif
+          break;
+        }
+      }
+      return 0;
+    }
+
+    void decompress(Codec codec, const char * src, size_t srcSize, char * dst, size_t dstSize)
+    {
+      SM_ASSERT_TRUE(MatrixArchiveException, isCodecAvailable(codec), "The codec " << codecName(codec) << " (" << static_cast<int>(codec) << ") is not available in this build");
+      switch(codec)
+      {
+        case CODEC_NONE:
+          SM_ASSERT_EQ(MatrixArchiveException, srcSize, dstSize, "Uncompressed block has the wrong size");
+          memcpy(dst, src, srcSize);
+          break;
+        case CODEC_LZ4:
+        {
+#ifdef SM_MATRIX_ARCHIVE_HAVE_LZ4
+          const int n = LZ4_decompress_safe(src, dst, static_cast<int>(srcSize), static_cast<int>(dstSize));
+          SM_ASSERT_EQ(MatrixArchiveException, n, static_cast<int>(dstSize), "Corrupt LZ4 block");
+#else
+          lz4Decompress(src, srcSize, dst, dstSize);
+#endif
+          break;
+        }
+        case CODEC_ZSTD:
+        {
+#ifdef SM_MATRIX_ARCHIVE_HAVE_ZSTD
+          const size_t n = ZSTD_decompress(dst, dstSize, src, srcSize);
+          SM_ASSERT_FALSE(MatrixArchiveException, ZSTD_isError(n), "Corrupt zstd block: " << ZSTD_getErrorName(n));
+          SM_ASSERT_EQ(MatrixArchiveException, n, dstSize, "Corrupt zstd block");
+#endif
+          break;
+        }
+      }
+    }
+
+    void byteShuffle(const char * src, size_t numElements, size_t elementSize, char * dst)
+    {
+      for(size_t b = 0; b < elementSize; ++b)
+      {
+        char * out = dst + b * numElements;
+        const char * in = src + b;
+        for(size_t i = 0; i < numElements; ++i, in += elementSize)
+        {
+          out[i] = *in;
+        }
+      }
+    }
+
+    void byteUnshuffle(const char * src, size_t numElements, size_t elementSize, char * dst)
+    {
+      for(size_t b = 0; b < elementSize; ++b)
+      {
+        const char * in = src + b * numElements;
+        char * out = dst + b;
+        for(size_t i = 0; i < numElements; ++i, out += elementSize)
+        {
+          *out = in[i];
+        }
+      }
+    }
+
+  } // namespace matrix_archive
+} // namespace sm
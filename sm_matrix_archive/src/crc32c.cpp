@@ -0,0 +1,150 @@
+#include <cstring>
+#include <sm/matrix_archive/crc32c.hpp>
+
+#if defined(__GNUC__) && (defined(__x86_64__) || defined(__i386__))
+#define SM_MATRIX_ARCHIVE_X86_DISPATCH
+#include <immintrin.h>
+#elif defined(__ARM_FEATURE_CRC32)
+#define SM_MATRIX_ARCHIVE_ARM_CRC32
+#include <arm_acle.h>
+#endif
+
+namespace sm {
+  namespace matrix_archive {
+
+    namespace {
+
+      // Reflected Castagnoli polynomial.
+      const boost::uint32_t kPolynomial = 0x82f63b78;
+
+      // Tables for the slicing-by-8 software implementation.
+      struct Crc32cTables {
+        Crc32cTables()
+        {
+          for(boost::uint32_t i = 0; i < 256; ++i)
+          {
+            boost::uint32_t crc = i;
+            for(int k = 0; k < 8; ++k)
+            {
+              crc = (crc >> 1) ^ (kPolynomial & (0u - (crc & 1)));
+            }
+            table[0][i] = crc;
+          }
+          for(int t = 1; t < 8; ++t)
+          {
+            for(int i = 0; i < 256; ++i)
+            {
+              table[t][i] = (table[t - 1][i] >> 8) ^ table[0][table[t - 1][i] & 0xff];
+            }
+          }
+        }
+        boost::uint32_t table[8][256];
+      };
+
+      boost::uint32_t crc32cSoftware(boost::uint32_t crc, const unsigned char * p, size_t size)
+      {
+        static const Crc32cTables tables;
+        const boost::uint32_t (*t)[256] = tables.table;
+        // Slicing reads little endian words; big endian hosts use the byte loop.
+#if !defined(__BYTE_ORDER__) || __BYTE_ORDER__ == __ORDER_LITTLE_ENDIAN__
+        while(size >= 8)
+        {
+          boost::uint32_t lo, hi;
+          memcpy(&lo, p, 4);
+          memcpy(&hi, p + 4, 4);
+          lo ^= crc;
+          crc = t[7][lo & 0xff] ^ t[6][(lo >> 8) & 0xff] ^ t[5][(lo >> 16) & 0xff] ^ t[4][lo >> 24] ^
+                t[3][hi & 0xff] ^ t[2][(hi >> 8) & 0xff] ^ t[1][(hi >> 16) & 0xff] ^ t[0][hi >> 24];
+          p += 8;
+          size -= 8;
+        }
+#endif
+        while(size > 0)
+        {
+          crc = (crc >> 8) ^ t[0][(crc ^ *p) & 0xff];
+          ++p;
+          --size;
+        }
+        return crc;
+      }
+
+#ifdef SM_MATRIX_ARCHIVE_X86_DISPATCH
+      __attribute__((target("sse4.2")))
+      boost::uint32_t crc32cSse42(boost::uint32_t crc, const unsigned char * p, size_t size)
+      {
+#ifdef __x86_64__
+        boost::uint64_t crc64 = crc;
+        while(size >= 8)
+        {
+          boost::uint64_t v;
+          memcpy(&v, p, 8);
+          crc64 = _mm_crc32_u64(crc64, v);
+          p += 8;
+          size -= 8;
+        }
+        crc = static_cast<boost::uint32_t>(crc64);
+#endif
+        while(size >= 4)
+        {
+          boost::uint32_t v;
+          memcpy(&v, p, 4);
+          crc = _mm_crc32_u32(crc, v);
+          p += 4;
+          size -= 4;
+        }
+        while(size > 0)
+        {
+          crc = _mm_crc32_u8(crc, *p);
+          ++p;
+          --size;
+        }
+        return crc;
+      }
+
+      typedef boost::uint32_t (*Crc32cKernel)(boost::uint32_t, const unsigned char *, size_t);
+
+      Crc32cKernel selectCrc32cKernel()
+      {
+        __builtin_cpu_init();
+        return __builtin_cpu_supports("sse4.2") ? &crc32cSse42 : &crc32cSoftware;
+      }
+#endif
+
+#ifdef SM_MATRIX_ARCHIVE_ARM_CRC32
+      boost::uint32_t crc32cArm(boost::uint32_t crc, const unsigned char * p, size_t size)
+      {
+        while(size >= 8)
+        {
+          boost::uint64_t v;
+          memcpy(&v, p, 8);
+          crc = __crc32cd(crc, v);
+          p += 8;
+          size -= 8;
+        }
+        while(size > 0)
+        {
+          crc = __crc32cb(crc, *p);
+          ++p;
+          --size;
+        }
+        return crc;
+      }
+#endif
+
+    } // namespace
+
+    boost::uint32_t crc32c(boost::uint32_t crc, const void * data, size_t size)
+    {
+      const unsigned char * p = static_cast<const unsigned char *>(data);
+#if defined(SM_MATRIX_ARCHIVE_X86_DISPATCH)
+      static const Crc32cKernel kernel = selectCrc32cKernel();
+      return ~kernel(~crc, p, size);
+#elif defined(SM_MATRIX_ARCHIVE_ARM_CRC32)
+      return ~crc32cArm(~crc, p, size);
+#else
+      return ~crc32cSoftware(~crc, p, size);
+#endif
+    }
+
+  } // namespace matrix_archive
+} // namespace sm
@@ -6,8 +6,12 @@
  */
 #include <gtest/gtest.h>
 #include <unistd.h>
+#include <fstream>
+#include <cstring>
 
 #include <sm/MatrixArchive.hpp>
+#include <sm/boost/JobQueue.hpp>
+#include <sm/matrix_archive/crc32c.hpp>
 
 TEST(MatrixArchive, testMatrixLoadAndSaveWorkTogether) {
   try {
@@ -39,3 +43,365 @@ TEST(MatrixArchive, testMatrixLoadAndSaveWorkTogether) {
     FAIL()<< e.what();
   }
 }
+
+TEST(MatrixArchive, testCompressedMatricesRoundTrip) {
+  try {
+    const int N = 5000;
+    Eigen::MatrixXd smooth(3, N);
+    for (int i = 0; i < N; ++i) {
+      const double t = i * 1e-3;
+      smooth(0, i) = t;
+      smooth(1, i) = sin(t);
+      smooth(2, i) = 0.5;
+    }
+    Eigen::MatrixXd random = Eigen::MatrixXd::Random(20, 30);
+    std::string tempfile("/tmp/testMatrixArchiveCompressed.ama");
+    std::string plainfile("/tmp/testMatrixArchivePlain.ama");
+
+    sm::MatrixArchive archive;
+    archive.setMatrix("smooth", smooth);
+    archive.setMatrix("random", random);
+    archive.setScalar("scalar", 3.0);
+    archive.setString("s", "testString");
+    archive.save(plainfile);
+
+    archive.setCompression(sm::matrix_archive::CODEC_LZ4);
+    archive.save(tempfile);
+
+    EXPECT_LT(boost::filesystem::file_size(tempfile), boost::filesystem::file_size(plainfile));
+
+    sm::MatrixArchive loaded;
+    loaded.load(tempfile);
+    ASSERT_EQ(4u, loaded.size());
+    EXPECT_EQ("testString", loaded.getString("s"));
+    EXPECT_EQ(3.0, loaded.getScalar("scalar"));
+    ASSERT_EQ(smooth.rows(), loaded.getMatrix("smooth").rows());
+    ASSERT_EQ(smooth.cols(), loaded.getMatrix("smooth").cols());
+    EXPECT_TRUE(smooth == loaded.getMatrix("smooth"));
+    EXPECT_TRUE(random == loaded.getMatrix("random"));
+
+    unlink(tempfile.c_str());
+    unlink(plainfile.c_str());
+  } catch (const std::exception & e) {
+    FAIL()<< e.what();
+  }
+}
+
+TEST(MatrixArchive, testCodecsRoundTrip) {
+  using namespace sm::matrix_archive;
+  const Codec codecs[] = { CODEC_NONE, CODEC_LZ4, CODEC_ZSTD };
+  std::vector<char> input(100000);
+  for (size_t i = 0; i < input.size(); ++i) {
+    input[i] = static_cast<char>((i / 7) % 13 + (i % 1000 == 0 ? rand() : 0));
+  }
+  for (Codec codec : codecs) {
+    if (!isCodecAvailable(codec)) {
+      continue;
+    }
+    SCOPED_TRACE(codecName(codec));
+    std::vector<char> compressed(compressBound(codec, input.size()));
+    const size_t n = compress(codec, input.data(), input.size(), compressed.data());
+    std::vector<char> output(input.size());
+    decompress(codec, compressed.data(), n, output.data(), output.size());
+    EXPECT_TRUE(input == output);
+    if (codec != CODEC_NONE) {
+      EXPECT_LT(n, input.size() / 4);
+      // Corrupt data must be detected instead of overrunning the output.
+      EXPECT_THROW(decompress(codec, compressed.data(), n / 2, output.data(), output.size()), sm::MatrixArchiveException);
+    }
+  }
+}
+
+namespace {
+std::string readFile(std::string const & path) {
+  std::ifstream fin(path.c_str(), std::ios::binary);
+  return std::string((std::istreambuf_iterator<char>(fin)), std::istreambuf_iterator<char>());
+}
+}  // namespace
+
+TEST(MatrixArchive, testParallelSaveAndLoad) {
+  try {
+    sm::MatrixArchive archive;
+    for (int i = 0; i < 20; ++i) {
+      archive.setMatrix("m" + std::to_string(i), Eigen::MatrixXd::Random(i + 1, 50 * i + 1));
+      archive.setString("s" + std::to_string(i), std::string(i, 'x'));
+    }
+    archive.setCompression(sm::matrix_archive::CODEC_LZ4);
+    std::string streamfile("/tmp/testMatrixArchiveStream.ama");
+    std::string parallelfile("/tmp/testMatrixArchiveParallel.ama");
+    std::string queuefile("/tmp/testMatrixArchiveQueue.ama");
+    const std::set<std::string> all;
+
+    {
+      std::ofstream fout(streamfile.c_str(), std::ios::binary);
+      archive.save(fout, all);
+    }
+    archive.save(parallelfile, all, 4);
+
+    sm::JobQueue queue;
+    queue.start(3);
+    archive.save(queuefile, all, queue);
+
+    // The block layout does not depend on how the archive was written.
+    const std::string expected = readFile(streamfile);
+    EXPECT_EQ(expected, readFile(parallelfile));
+    EXPECT_EQ(expected, readFile(queuefile));
+
+    sm::MatrixArchive threaded, queued;
+    threaded.load(parallelfile, all, 4);
+    queued.load(queuefile, all, queue);
+    for (const sm::MatrixArchive * loaded : { &threaded, &queued }) {
+      ASSERT_EQ(archive.size(), loaded->size());
+      for (auto & m : archive) {
+        EXPECT_TRUE(m.second == loaded->getMatrix(m.first)) << m.first;
+      }
+      for (auto & s : archive.getStrings()) {
+        EXPECT_EQ(s.second, loaded->getString(s.first));
+      }
+    }
+
+    // Only the selected names are loaded.
+    sm::MatrixArchive subset;
+    std::set<std::string> names;
+    names.insert("m3");
+    names.insert("s4");
+    subset.load(parallelfile, names, 2);
+    EXPECT_EQ(2u, subset.size());
+    EXPECT_TRUE(archive.getMatrix("m3") == subset.getMatrix("m3"));
+
+    unlink(streamfile.c_str());
+    unlink(parallelfile.c_str());
+    unlink(queuefile.c_str());
+  } catch (const std::exception & e) {
+    FAIL()<< e.what();
+  }
+}
+
+TEST(MatrixArchive, testTruncatedFileThrows) {
+  sm::MatrixArchive archive;
+  archive.setMatrix("m", Eigen::MatrixXd::Random(10, 10));
+  std::string tempfile("/tmp/testMatrixArchiveTruncated.ama");
+  archive.save(tempfile);
+  boost::filesystem::resize_file(tempfile, boost::filesystem::file_size(tempfile) - 10);
+  sm::MatrixArchive loaded;
+  EXPECT_THROW(loaded.load(tempfile), sm::MatrixArchiveException);
+  unlink(tempfile.c_str());
+}
+
+TEST(MatrixArchive, testEmptyCompressedBlockThrows) {
+  sm::MatrixArchive archive;
+  archive.setCompression(sm::matrix_archive::CODEC_LZ4);
+  archive.setMatrix("m", Eigen::MatrixXd::Zero(10, 10));
+  std::string tempfile("/tmp/testMatrixArchiveEmptyCompressed.ama");
+  archive.save(tempfile);
+  const std::string contents = readFile(tempfile);
+  ASSERT_EQ('C', contents[0]);
+
+  // Zero the rows, then the compressed size, of the block header.
+  const size_t rowsOffset = 1 + archive.maxNameSize();
+  const size_t compressedSizeOffset = rowsOffset + 4 + 4 + 1 + 1;
+  for (size_t offset : { rowsOffset, compressedSizeOffset }) {
+    std::string corrupt = contents;
+    memset(&corrupt[offset], 0, 4);
+    std::ofstream(tempfile.c_str(), std::ios::binary | std::ios::trunc) << corrupt;
+    sm::MatrixArchive loaded;
+    EXPECT_THROW(loaded.load(tempfile), sm::MatrixArchiveException) << "offset " << offset;
+  }
+  unlink(tempfile.c_str());
+}
+
+TEST(MatrixArchive, testByteSwap64) {
+  for (size_t n : { 0, 1, 2, 3, 5, 8, 13, 64, 101 }) {
+    std::vector<boost::uint64_t> values(n), swapped(n), inPlace(n);
+    for (size_t i = 0; i < n; ++i) {
+      values[i] = 0x0102030405060708ull * (i + 1);
+    }
+    inPlace = values;
+    sm::matrix_archive::byteSwap64(values.data(), swapped.data(), n);
+    sm::matrix_archive::byteSwap64(inPlace.data(), inPlace.data(), n);
+    for (size_t i = 0; i < n; ++i) {
+      EXPECT_EQ(boost::endian::endian_reverse(values[i]), swapped[i]);
+      EXPECT_EQ(swapped[i], inPlace[i]);
+    }
+  }
+}
+
+TEST(MatrixArchive, testOtherByteOrderRoundTrip) {
+  try {
+    const sm::MatrixArchive::ByteOrder other = sm::matrix_archive::kHostIsLittleEndian ?
+        sm::MatrixArchive::BIG_ENDIAN_ARCHIVE : sm::MatrixArchive::LITTLE_ENDIAN_ARCHIVE;
+    Eigen::MatrixXd smooth(2, 1000);
+    for (int i = 0; i < smooth.cols(); ++i) {
+      smooth(0, i) = i;
+      smooth(1, i) = cos(i * 1e-2);
+    }
+    Eigen::MatrixXd random = Eigen::MatrixXd::Random(7, 3);
+    std::string tempfile("/tmp/testMatrixArchiveByteOrder.ama");
+
+    for (sm::matrix_archive::Codec codec : { sm::matrix_archive::CODEC_NONE, sm::matrix_archive::CODEC_LZ4 }) {
+      sm::MatrixArchive archive;
+      archive.setByteOrder(other);
+      archive.setCompression(codec);
+      archive.setMatrix("smooth", smooth);
+      archive.setMatrix("random", random);
+      archive.setString("s", "testString");
+      archive.save(tempfile);
+
+      // The number of rows of the first matrix is stored in the other byte order.
+      const std::string contents = readFile(tempfile);
+      const bool hasMarker = contents[0] == 'E';
+      EXPECT_EQ(other == sm::MatrixArchive::BIG_ENDIAN_ARCHIVE, hasMarker);
+      boost::uint32_t rows;
+      memcpy(&rows, contents.data() + (hasMarker ? 6 : 0) + 1 + sm::MatrixArchive().maxNameSize(), 4);
+      EXPECT_EQ(random.rows(), boost::endian::endian_reverse(rows));
+
+      sm::MatrixArchive loaded;
+      loaded.load(tempfile);
+      EXPECT_TRUE(smooth == loaded.getMatrix("smooth"));
+      EXPECT_TRUE(random == loaded.getMatrix("random"));
+      EXPECT_EQ("testString", loaded.getString("s"));
+    }
+    unlink(tempfile.c_str());
+  } catch (const std::exception & e) {
+    FAIL()<< e.what();
+  }
+}
+
+TEST(MatrixArchive, testNameIndex) {
+  sm::MatrixArchive archive;
+  const int N = 5000;
+  for (int i = 0; i < N; ++i) {
+    archive.setScalar("scalar_" + std::to_string(i), i);
+  }
+  archive.setString("scalar_7", "now a string");
+  archive.setMatrix("m", Eigen::MatrixXd::Identity(3, 3));
+  for (int i = 0; i < N; i += 2) {
+    archive.clear("scalar_" + std::to_string(i));
+  }
+  // The odd scalars without scalar_7, plus m.
+  EXPECT_EQ(N / 2u, archive.sizeMatrices());
+  EXPECT_EQ(1u, archive.sizeStrings());
+  for (int i = 1; i < N; i += 2) {
+    const std::string name = "scalar_" + std::to_string(i);
+    if (i == 7) {
+      EXPECT_EQ("now a string", archive.getString(name));
+      EXPECT_THROW(archive.getScalar(name), sm::MatrixArchiveException);
+      EXPECT_TRUE(archive.find(name) == archive.end());
+    } else {
+      EXPECT_EQ(i, archive.getScalar(name));
+      ASSERT_TRUE(archive.find(name) != archive.end());
+      EXPECT_EQ(name, archive.find(name)->first);
+    }
+  }
+  EXPECT_THROW(archive.getScalar("scalar_0"), sm::MatrixArchiveException);
+
+  // clear(name) removes strings as well.
+  archive.clear("scalar_7");
+  EXPECT_THROW(archive.getString("scalar_7"), sm::MatrixArchiveException);
+  EXPECT_EQ(0u, archive.sizeStrings());
+
+  // Copies have their own index.
+  sm::MatrixArchive copy(archive);
+  archive.getMatrix("m")(0, 0) = 2.0;
+  EXPECT_EQ(1.0, copy.getMatrix("m")(0, 0));
+  archive = copy;
+  EXPECT_EQ(1.0, archive.getMatrix("m")(0, 0));
+  copy.clear();
+  EXPECT_EQ(1, archive.getScalar("scalar_1"));
+
+  EXPECT_THROW(archive.setScalar("", 1.0), sm::MatrixArchiveException);
+  EXPECT_THROW(archive.setScalar("1abc", 1.0), sm::MatrixArchiveException);
+  EXPECT_THROW(archive.setScalar("ab-c", 1.0), sm::MatrixArchiveException);
+  EXPECT_THROW(archive.setScalar(std::string(33, 'a'), 1.0), sm::MatrixArchiveException);
+  archive.setScalar(std::string(32, 'a'), 1.0);
+  EXPECT_EQ(1.0, archive.getScalar(std::string(32, 'a')));
+
+  // Long names that share their first 32 characters are rejected, not
+  // merged into one entry.
+  const std::string base(32, 'b');
+  const size_t numMatrices = archive.sizeMatrices();
+  EXPECT_THROW(archive.createMatrix(base + "X", 2, 2), sm::MatrixArchiveException);
+  EXPECT_THROW(archive.createMatrix(base + "Y", 2, 2, false), sm::MatrixArchiveException);
+  EXPECT_EQ(numMatrices, archive.sizeMatrices());
+  EXPECT_THROW(archive.getMatrix(base), sm::MatrixArchiveException);
+  sm::matrix_archive::FlatNameIndex<int> index;
+  EXPECT_THROW(index[base + "X"], std::runtime_error);
+  EXPECT_TRUE(index.empty());
+}
+
+TEST(MatrixArchive, testCrc32c) {
+  // The check value of CRC-32C.
+  EXPECT_EQ(0xe3069283u, sm::matrix_archive::crc32c(0, "123456789", 9));
+  // Extending a checksum gives the same result as a single pass, at any alignment.
+  std::vector<char> data(1000);
+  for (size_t i = 0; i < data.size(); ++i) {
+    data[i] = static_cast<char>(i * 7 + 3);
+  }
+  const boost::uint32_t full = sm::matrix_archive::crc32c(0, &data[0], data.size());
+  for (size_t split : { 0, 1, 3, 8, 13, 999, 1000 }) {
+    const boost::uint32_t crc = sm::matrix_archive::crc32c(0, &data[0], split);
+    EXPECT_EQ(full, sm::matrix_archive::crc32c(crc, &data[split], data.size() - split));
+  }
+}
+
+TEST(MatrixArchive, testChecksums) {
+  try {
+    Eigen::MatrixXd smooth(2, 1000);
+    for (int i = 0; i < smooth.cols(); ++i) {
+      smooth(0, i) = i;
+      smooth(1, i) = sin(i * 1e-2);
+    }
+    Eigen::MatrixXd random = Eigen::MatrixXd::Random(7, 3);
+    std::string tempfile("/tmp/testMatrixArchiveChecksums.ama");
+
+    for (sm::MatrixArchive::ByteOrder byteOrder : { sm::MatrixArchive::LITTLE_ENDIAN_ARCHIVE, sm::MatrixArchive::BIG_ENDIAN_ARCHIVE }) {
+      for (sm::matrix_archive::Codec codec : { sm::matrix_archive::CODEC_NONE, sm::matrix_archive::CODEC_LZ4 }) {
+        sm::MatrixArchive archive;
+        archive.setChecksums(true);
+        archive.setByteOrder(byteOrder);
+        archive.setCompression(codec);
+        archive.setMatrix("smooth", smooth);
+        archive.setMatrix("random", random);
+        archive.setString("s", "testString");
+        archive.save(tempfile);
+        archive.verify(tempfile);
+
+        // The stream writer produces the same file.
+        {
+          std::ofstream fout(tempfile + ".stream", std::ios::binary);
+          archive.save(fout, std::set<std::string>());
+        }
+        EXPECT_EQ(readFile(tempfile), readFile(tempfile + ".stream"));
+        unlink((tempfile + ".stream").c_str());
+
+        sm::MatrixArchive loaded;
+        loaded.load(tempfile);
+        EXPECT_TRUE(smooth == loaded.getMatrix("smooth"));
+        EXPECT_TRUE(random == loaded.getMatrix("random"));
+        EXPECT_EQ("testString", loaded.getString("s"));
+
+        // Flip a bit in the last byte of the data of the string block.
+        std::string contents = readFile(tempfile);
+        const size_t offset = contents.size() - 6;
+        ASSERT_EQ('g', contents[offset]);
+        contents[offset] ^= 1;
+        {
+          std::ofstream fout(tempfile.c_str(), std::ios::binary);
+          fout.write(contents.data(), contents.size());
+        }
+        EXPECT_THROW(archive.verify(tempfile), sm::MatrixArchiveException);
+        sm::MatrixArchive corrupt;
+        EXPECT_THROW(corrupt.load(tempfile), sm::MatrixArchiveException);
+      }
+    }
+
+    // Archives without checksums still verify.
+    sm::MatrixArchive plain;
+    plain.setMatrix("random", random);
+    plain.save(tempfile);
+    plain.verify(tempfile);
+    unlink(tempfile.c_str());
+  } catch (const std::exception & e) {
+    FAIL()<< e.what();
+  }
+}
@@ -17,7 +17,7 @@ void smLogNamed(const std::string & name, sm::logging::Level level,
                                     line, 
                                     function.c_str(),
                                     message.c_str(),
-                                    logger->currentTimeString());
+                                    logger->currentTime());
     
     logger->log(event);
 
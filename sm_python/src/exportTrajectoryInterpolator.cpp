@@ -0,0 +1,91 @@
+#include <numpy_eigen/boost_python_headers.hpp>
+#include <sm/kinematics/TrajectoryInterpolator.hpp>
+#include <sm/assert_macros.hpp>
+#include <boost/cstdint.hpp>
+
+using namespace boost::python;
+using namespace sm::kinematics;
+
+typedef Eigen::Matrix<boost::int64_t, Eigen::Dynamic, 1> TimeVector;
+typedef Eigen::Matrix<double, Eigen::Dynamic, 4> QuaternionMatrix;
+typedef Eigen::Matrix<double, Eigen::Dynamic, 3> TranslationMatrix;
+
+// setPoses(times, Q, T) with one pose per row: Q is Nx4 (x, y, z, w), T is Nx3.
+void setPosesFromArrays(TrajectoryInterpolator * interpolator, const TimeVector & times,
+                        const QuaternionMatrix & Q, const TranslationMatrix & T)
+{
+  SM_ASSERT_EQ(std::runtime_error, times.size(), Q.rows(), "There must be one quaternion per time");
+  SM_ASSERT_EQ(std::runtime_error, times.size(), T.rows(), "There must be one translation per time");
+  std::vector<sm::timing::NsecTime> t(times.data(), times.data() + times.size());
+  std::vector<Transformation> poses(t.size());
+  for(size_t i = 0; i < t.size(); ++i)
+  {
+    poses[i] = Transformation(Q.row(i).transpose(), T.row(i).transpose());
+  }
+  interpolator->setPoses(t, poses);
+}
+
+// (Q, T) = getPoseArrays(times), one pose per row as in setPoses.
+tuple getPoseArrays(const TrajectoryInterpolator * interpolator, const TimeVector & times)
+{
+  std::vector<TransformationD> poses(times.size());
+  interpolator->getPoses(times.data(), times.size(), poses.data());
+  QuaternionMatrix Q(times.size(), 4);
+  TranslationMatrix T(times.size(), 3);
+  for(size_t i = 0; i < poses.size(); ++i)
+  {
+    Q.row(i) = poses[i].q().transpose();
+    T.row(i) = poses[i].t().transpose();
+  }
+  return make_tuple(Q, T);
+}
+
+list getPoseList(const TrajectoryInterpolator * interpolator, const TimeVector & times)
+{
+  std::vector<sm::timing::NsecTime> t(times.data(), times.data() + times.size());
+  std::vector<Transformation> poses;
+  interpolator->getPoses(t, poses);
+  list result;
+  for(size_t i = 0; i < poses.size(); ++i)
+  {
+    result.append(poses[i]);
+  }
+  return result;
+}
+
+TimeVector getTimes(const TrajectoryInterpolator * interpolator)
+{
+  const std::vector<sm::timing::NsecTime> & times = interpolator->times();
+  TimeVector result(times.size());
+  for(size_t i = 0; i < times.size(); ++i)
+  {
+    result[i] = times[i];
+  }
+  return result;
+}
+
+void exportTrajectoryInterpolator()
+{
+  enum_<TrajectoryInterpolator::Method>("TrajectoryInterpolationMethod")
+      .value("Slerp", TrajectoryInterpolator::Slerp)
+      .value("Linear", TrajectoryInterpolator::Linear)
+      .value("Cubic", TrajectoryInterpolator::Cubic)
+  ;
+
+  class_<TrajectoryInterpolator>("TrajectoryInterpolator", init<>())
+    .def(init<TrajectoryInterpolator::Method>())
+    .def("method", &TrajectoryInterpolator::method)
+    .def("setMethod", &TrajectoryInterpolator::setMethod)
+    .def("addPose", &TrajectoryInterpolator::addPose, "addPose(nsecTime, T_a_b), later than all poses so far")
+    .def("setPoses", &setPosesFromArrays, "setPoses(times, Q, T) replaces the trajectory. times are strictly increasing integer nanoseconds, Q is Nx4 (x, y, z, w) and T is Nx3")
+    .def("clear", &TrajectoryInterpolator::clear)
+    .def("size", &TrajectoryInterpolator::size)
+    .def("__len__", &TrajectoryInterpolator::size)
+    .def("minTime", &TrajectoryInterpolator::minTime)
+    .def("maxTime", &TrajectoryInterpolator::maxTime)
+    .def("times", &getTimes)
+    .def("getPose", &TrajectoryInterpolator::getPose, "T_a_b = getPose(nsecTime)")
+    .def("getPoses", &getPoseList, "[T_a_b] = getPoses(times), a list of Transformation")
+    .def("getPoseArrays", &getPoseArrays, "(Q, T) = getPoseArrays(times), the poses as rows of Nx4 and Nx3 arrays. Sorted times are the fast case.")
+    ;
+}
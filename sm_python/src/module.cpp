@@ -11,6 +11,7 @@ void export_transformations();
 void export_quaternion_algebra();
 void export_homogeneous_coordinates();
 void exportTransformation();
+void exportTrajectoryInterpolator();
 void exportHomogeneousPoint();
 void exportTimestampCorrectors();
 void exportPropertyTree();
@@ -40,6 +41,7 @@ BOOST_PYTHON_MODULE(libsm_python)
   export_quaternion_algebra();
   export_homogeneous_coordinates();
   exportTransformation();
+  exportTrajectoryInterpolator();
   exportHomogeneousPoint();
   exportTimestampCorrectors();
   exportPropertyTree();
@@ -51,5 +51,21 @@ class TestValueStore(unittest.TestCase):
         self.assertEqual(vs.getString("a"), "test")
 
 
+class TestTrajectoryInterpolator(unittest.TestCase):
+    def test_getPoseArrays(self):
+        if sm.numpy_eigen.IsBroken:
+            self.skipTest("numpy_eigen is broken (see #137)")
+        times = np.array([0, 1000000000, 2000000000], dtype=np.int64)
+        Q = np.array([[0., 0., 0., 1.]] * 3)
+        T = np.array([[0., 0., 0.], [1., 0., 0.], [2., 2., 0.]])
+        interpolator = sm.TrajectoryInterpolator(sm.TrajectoryInterpolationMethod.Linear)
+        interpolator.setPoses(times, Q, T)
+        self.assertEqual(len(interpolator), 3)
+        Qi, Ti = interpolator.getPoseArrays(np.array([500000000, 1500000000], dtype=np.int64))
+        self.assertTrue(np.allclose(Ti, [[0.5, 0., 0.], [1.5, 1., 0.]]))
+        self.assertTrue(np.allclose(Qi, Q[:2]))
+        self.assertTrue(np.allclose(interpolator.getPose(1000000000).t(), T[1]))
+
+
 if __name__ == '__main__':
     unittest.main()